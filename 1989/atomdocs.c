@@ -17,12 +17,17 @@
 *
 *   Call Format
 *   -----------
-*	calc_atomdocs <sign-weights> <concepts>
+*	calc_atomdocs <sign-weights> <concepts> [<atom-index>] [QUIET]
 *
 *   where <sign-weights> is the name of the file where the sign
 *   weights are listed, and <concepts> is the name of the file
 *   containing the list of atomic concepts. The resulting list
-*   is written to the standard output.
+*   is written to the standard output (ATOM_DOCS).
+*
+*   If <atom-index> is given, the list is also written to this
+*   file as a binary atom index (see atomidx.h), which contains
+*   the weight of each concept in each document as well. The
+*   programs reading ATOM_DOCS accept either form.
 *
 *****************************************************************
 *
@@ -50,7 +55,7 @@
 ****************************************************************/   
 
 #define PROG	"Atomic Concepts -> Doc List Generation (gh, 01/05/89)\n"
-#define USAGE   "Usage: calc_atomdocs <doc-descr> <concepts> [QUIET]\n"
+#define USAGE   "Usage: calc_atomdocs <doc-descr> <concepts> [<atom-index>] [QUIET]\n"
 
 #include <stdio.h>
 #include <malloc.h>
@@ -63,38 +68,29 @@
 
 #include "boolean.h"
 #include "list.h"
+#include "intlist.h"
 #include "util.h"
-
-#define LINE_LENGTH	100
+#include "reader.h"
+#include "descr.h"
+#include "atomidx.h"
+#include "invert.h"
 
 typedef
   struct {
     int		sign;     /* sign index */
-    LIST	docs;     /* list of documents where this sign occurs */
+    INTLIST	atoms;    /* atomic concepts of this sign */
   } SIGN_STRUCT;
 
-typedef
-  struct {
-    int		atom;     /* atom index */
-    LIST	signs;    /* list of signs where this atom occurs */
-  } ATOM_STRUCT;
-
-typedef
-  struct {
-    int		doc;      /* document number */
-  } DOC_STRUCT;
-
-typedef
-  struct {
-    int		sign;      /* sign index */
-  } SIGN_PTR;
-
 
 LIST
-  temp_list,
-  atom_list,   /* list of all atoms, element type ATOM_STRUCT */
   sign_list;   /* list of all signs, element type SIGN_STRUCT */
 
+INTLIST
+  atoms;       /* all atomic concepts */
+
+ATOM_INDEX
+  atom_index;  /* documents of each atomic concept */
+
 FILE
   *counter;	/* Virtual file used to output running counts */
 
@@ -105,77 +101,29 @@ FILE
 
 #ifndef BSDUNIX
 int main ( int, char *[] );
-void read_weights ( FILE * );
-void handle_concepts ( FILE * );
-void calc_results ( void );
-void add_doc ( LIST, int );
-int comp_doc ( ELEMENT, ELEMENT );
+void handle_concepts ( READER );
+INTLIST sign_concepts ( int );
+BOOL finish_atoms ( ELEMENT );
 int comp_signs ( ELEMENT, ELEMENT );
-int comp_atom ( ELEMENT, ELEMENT );
-int comp_sptr ( ELEMENT, ELEMENT );
-BOOL copy_docs ( ELEMENT );
-BOOL enum_signs ( ELEMENT );
-BOOL enum_docs ( ELEMENT );
-BOOL enum_atoms ( ELEMENT );
 #else
 int main ();
-void read_weights ();
 void handle_concepts ();
-void calc_results ();
-void add_doc ();
-int comp_doc ();
+INTLIST sign_concepts ();
+BOOL finish_atoms ();
 int comp_signs ();
-int comp_atom ();
-int comp_sptr ();
-BOOL copy_docs ();
-BOOL enum_signs ();
-BOOL enum_docs ();
-BOOL enum_atoms ();
 #endif
 
 
 /****************************************************************
-**  add_doc
+**  handle_concepts
 **
-**  Adds a document index to a list.
+**  Reads the atomic concepts of each sign.
 **
-**  IN  : d    = document index.
-**        list = list where d should be added.
-****************************************************************/ 
-
-int comp_doc
-      ( d1, d2 )
-ELEMENT
-  d1;
-ELEMENT
-  d2;
-{
-  return ( ((DOC_STRUCT *) d1) -> doc - ((DOC_STRUCT *) d2) -> doc );
-}
-
-
-void add_doc
-       ( list, d )
-LIST
-  list;
-int
-  d;
-{
-  DOC_STRUCT
-    *elt;
-    
-  elt = (DOC_STRUCT *) malloc ( sizeof ( DOC_STRUCT ) );
-  assert ( elt != NULL );
-  elt -> doc = d;
-  elt = (DOC_STRUCT *) add_list ( list, (ELEMENT) elt, comp_doc );
-  assert ( elt != NULL );
-}
-
-
-/****************************************************************
-**  read_weights
+**  IN  : r = reader of concept file.
 **
-**  IN  : f = handle to opened weight file.
+**  OUT : 'sign_list' holds the concepts of each sign, 'atoms'
+**        all concepts. In the lists of the signs, each concept
+**        is replaced by its position in 'atoms'.
 ****************************************************************/ 
   
 int comp_signs
@@ -189,225 +137,93 @@ ELEMENT
 }
 
 
-void read_weights
-       ( f )
-FILE 
-  *f;
+BOOL finish_atoms
+       ( s )
+ELEMENT
+  s;
 {
+  INTLIST
+    l;
   int
-    totaldocs = 0,
-    currdoc,
-    n, d;
-  double
-    w;
-  SIGN_STRUCT
-    *sgn;
-  char
-    line [ LINE_LENGTH ];
+    i;
 
-  /* Create sign list */
-  sign_list = create_list ();
-  assert ( sign_list != NULL );
-
-  /* Read file line by line */
-  while ( fgets ( line, LINE_LENGTH, f ) ) {
-  
-    /* Interpret as much fields as possible */
-    n = sscanf ( line, " %d %f", &d, &w );
-    switch ( n ) {
-      
-      case 1 :
-        /* One field -> new document number; update running count */
-	totaldocs ++;
-        currdoc = d;
-        fprintf ( counter, "%d\r", currdoc );
-        break;
-        
-      case 2 :
-        /* Two fields -> sign index and weight; add doc to list of sign */
-        sgn = (SIGN_STRUCT *) malloc ( sizeof ( SIGN_STRUCT ) );
-        assert ( sgn != NULL );
-        sgn -> sign = d;
-        sgn -> docs = NULL;
-        sgn = (SIGN_STRUCT *) add_list ( sign_list, (ELEMENT) sgn, 
-                                         comp_signs );
-        assert ( sgn != NULL );
-        if ( sgn -> docs == NULL ) {
-          /* Create new document list */
-          sgn -> docs = create_list ();
-          assert ( sgn -> docs != NULL );
-        }
-        add_doc ( sgn -> docs, currdoc );
-        break;
-    }
+  /* Positions in 'atoms' are in the same order as the concepts */
+  l = ((SIGN_STRUCT *) s) -> atoms;
+  finalize_intlist ( l );
+  for ( i = 0; i < count_intlist ( l ); i ++ ) {
+    intlist_key ( l, i ) = lookup_intlist ( atoms, intlist_key ( l, i ) );
   }
-  
-  /* The total number of documents is the first line in the output */
-  printf ( "%d documents\n", totaldocs );
-
-  fprintf ( counter, "\n" );
-}
-
-
-/****************************************************************
-**  handle_concepts
-**
-**  IN  : f = handle to opened concept file.
-****************************************************************/ 
-  
-int comp_atom
-      ( s1, s2 )
-ELEMENT
-  s1;
-ELEMENT
-  s2;
-{
-  return ( ((ATOM_STRUCT *) s1) -> atom - ((ATOM_STRUCT *) s2) -> atom );
-}
-
-
-int comp_sptr
-      ( s1, s2 )
-ELEMENT
-  s1;
-ELEMENT
-  s2;
-{
-  return ( ((SIGN_PTR *) s1) -> sign - ((SIGN_PTR *) s2) -> sign );
+  return ( TRUE );
 }
 
 
 void handle_concepts
-       ( f )
-FILE 
-  *f;
+       ( r )
+READER
+  r;
 {
-  ATOM_STRUCT
-    *atm;
-  SIGN_PTR
+  SIGN_STRUCT
     *sgn;
   int
     n, d, curr_sign;
-  char
-    line [ LINE_LENGTH ];
 
-  /* Create list of atomic concepts */
-  atom_list = create_list ();
-  assert ( atom_list != NULL );
-
-  /* Read file line by line */
-  while ( fgets ( line, LINE_LENGTH, f ) ) {
-  
-    /* Read a number */
-    n = sscanf ( line, " %d", &d );
-    assert ( n == 1 );
-    
-    /* If number followed by a colon, then this is a sign index */
-    if ( strchr ( line, ':' ) != NULL ) {
-      curr_sign = d;
-      fprintf ( counter, "%d\r", d );
+  /* Create list of signs and atomic concepts */
+  sign_list = create_list ();
+  assert ( sign_list != NULL );
+  atoms = create_intlist ( 0 );
+
+  /* Read one sign record at a time */
+  while ( next_record ( r, &curr_sign ) ) {
+    fprintf ( counter, "%d\r", curr_sign );
+
+    sgn = (SIGN_STRUCT *) malloc ( sizeof ( SIGN_STRUCT ) );
+    assert ( sgn != NULL );
+    sgn -> sign = curr_sign;
+    sgn -> atoms = NULL;
+    sgn = (SIGN_STRUCT *) add_list ( sign_list, (ELEMENT) sgn, comp_signs );
+    assert ( sgn != NULL );
+    if ( sgn -> atoms == NULL ) {
+      /* Create new concept list */
+      sgn -> atoms = create_intlist ( 0 );
     }
-    else {
-      /* no colon -> this is an atomic concept; add current sign to
-         list of this concept */
-      atm = (ATOM_STRUCT *) malloc ( sizeof ( ATOM_STRUCT ) );
-      assert ( atm != NULL );
-      atm -> atom = d;
-      atm -> signs = NULL;
-      atm = (ATOM_STRUCT *) add_list ( atom_list, (ELEMENT) atm, comp_atom );
-      assert ( atm != NULL );
-      if ( atm -> signs == NULL ) {
-        /* Create new sign list */
-        atm -> signs = create_list ();
-        assert ( atm -> signs != NULL );
-      }
-      sgn = (SIGN_PTR *) malloc ( sizeof ( SIGN_PTR ) );
-      assert ( sgn != NULL );
-      sgn -> sign = curr_sign;
-      sgn = (SIGN_PTR *) add_list ( atm -> signs, (ELEMENT) sgn, comp_sptr );
-      assert ( sgn != NULL );
+
+    while ( next_entry ( r ) ) {
+      /* Each entry is an atomic concept of the current sign */
+      n = get_int ( r, &d );
+      assert ( n );
+      append_intlist ( sgn -> atoms, d );
+      append_intlist ( atoms, d );
     }
   }
   
+  /* Sort concept lists of all signs */
+  finalize_intlist ( atoms );
+  enum_list ( sign_list, finish_atoms, ENUM_FORWARD );
+
   fprintf ( counter, "\n" );
 }
 
 
 /****************************************************************
-**  calc_results
+**  sign_concepts
 **
-**  Processes atomic concepts. For each concept, builds a list
-**  of documents where this concept occurs.
-****************************************************************/   
-
-BOOL copy_docs
-       ( d )
-ELEMENT 
-  d;
-{
-  /* Add document 'd' to temp_list */
-  add_doc ( temp_list, ((DOC_STRUCT *) d) -> doc );
-  return ( TRUE );
-}
-
+**  IN  : sign = index of a sign.
+**
+**  OUT : Function returns the positions in 'atoms' of the
+**        concepts of the sign, or NULL if it has none.
+****************************************************************/ 
 
-BOOL enum_signs
-       ( s )
-ELEMENT 
-  s;
+INTLIST sign_concepts
+          ( sign )
+int
+  sign;
 {
   SIGN_STRUCT
-    temp,
-    *sgn;
-
-  /* Get entry in sign list belonging to this sign */
-  temp.sign = ((SIGN_PTR *) s) -> sign;
-  sgn = (SIGN_STRUCT *) lookup_list ( sign_list, (ELEMENT) &temp, comp_signs );
-  
-  /* Add contents of this sign's document list to temp_list */
-  if ( sgn != NULL ) { 
-    /* some signs don't occur in any document */
-    enum_list ( sgn -> docs, copy_docs, ENUM_FORWARD );
-  }
-  return ( TRUE );
-}
-
-
-BOOL enum_docs
-       ( d )
-ELEMENT 
-  d;
-{
-  printf ( "\t%d\n", ((DOC_STRUCT *) d) -> doc );
-  return ( TRUE );
-}
-
-
-BOOL enum_atoms
-       ( a )
-ELEMENT 
-  a;
-{
-  /* Create new temporary list */
-  temp_list = create_list ();
-  
-  /* Enumerate list of signs belonging to this concept */
-  enum_list ( ((ATOM_STRUCT *) a) -> signs, enum_signs, ENUM_FORWARD );
-  
-  /* Print contents of temporary list */
-  printf ( "%d :\n", ((ATOM_STRUCT *) a) -> atom );
-  enum_list ( temp_list, enum_docs, ENUM_FORWARD );
-  
-  destroy_list ( &temp_list );
-  return ( TRUE );
-}
+    t, *sgn;
 
-
-void calc_results
-       ( )
-{
-  /* Write out documents for each atom */
-  enum_list ( atom_list, enum_atoms, ENUM_FORWARD );
+  t.sign = sign;
+  sgn = (SIGN_STRUCT *) lookup_list ( sign_list, (ELEMENT) &t, comp_signs );
+  return ( ( sgn != NULL ) ? sgn -> atoms : NULL );
 }
 
 
@@ -422,47 +238,62 @@ int
 char
   *argv [];
 {
+  READER
+    r;
+  DESCR
+    d;
   FILE
     *f;
+  char
+    *idxfile = NULL;
     
   /* Program title */
   fprintf ( stderr, PROG );
 
-  /* Get verbose or quiet mode */
-  if ( ( argc == 4 ) && ( *argv [3] == 'Q' ) ) {
+  /* Get verbose or quiet mode; an index file may precede QUIET */
+  if ( ( argc >= 4 ) && ( strcmp ( argv [ argc - 1 ], "QUIET" ) == 0 ) ) {
     /* in case of quiet mode: redirect running counts to /dev/null */
     counter = fopen ( "/dev/null", "r" );
     assert ( counter != NULL );
+    argc --;
   }
   else {
     /* verbose mode: redirect running counts to stderr */
     counter = stderr;
   }
+  if ( argc == 4 ) {
+    idxfile = argv [3];
+  }
 
   /* Check arguments */
-  if ( argc < 3 ) {
+  if ( ( argc < 3 ) || ( argc > 4 ) ) {
     fprintf ( stderr, USAGE );
     return ( 1 );
   }
   
-  /* Open weight file */
-  f = open_file ( argv [1] );
-  
-  /* Create a list of documents per sign */
-  fprintf ( stderr, "Reading weight table.\n" );
-  read_weights ( f );
-  fclose ( f );
-  
   /* Open concept space file */
-  f = open_file ( argv [2] );
+  r = open_reader ( argv [2] );
   
-  /* Process atomic concepts */
+  /* Read atomic concepts of each sign */
   fprintf ( stderr, "Processing atomic concepts\n" );
-  handle_concepts ( f );
-  fclose ( f );
+  handle_concepts ( r );
+  close_reader ( &r );
+  
+  /* Open weight file */
+  d = open_descr ( argv [1] );
+  
+  /* Create a list of documents per atomic concept */
+  fprintf ( stderr, "Reading weight table.\n" );
+  atom_index = invert_descr ( d, atoms, sign_concepts );
+  close_descr ( &d );
   
   /* Print results */
-  calc_results ();
+  write_index ( atom_index, stdout, FALSE );
+  if ( idxfile != NULL ) {
+    f = create_file ( idxfile );
+    write_index ( atom_index, f, TRUE );
+    fclose ( f );
+  }
 
   return ( 0 );
 }
@@ -0,0 +1,693 @@
+/****************************************************************
+*
+*           S O F T W A R E   S O U R C E   F I L E
+*
+*****************************************************************
+*
+*   Name of file   : atomidx.c
+*   Author         : Guido Hoss
+*   Project        : ETH Diploma Thesis (SS 1989)
+*   Creation Date  : 09/05/89
+*   Type of file   : C Language File
+*
+*   Description
+*   -----------
+*   Inverted file of the atomic concepts, see atomidx.h. The
+*   index is built in memory by adding concepts and postings in
+*   increasing order; binary files are mapped into memory.
+*
+*****************************************************************
+*
+*   COPYRIGHT (C) 1989, 2016 BY GUIDO HOSS.
+*
+*   This program is free software: you can redistribute it and/or 
+*   modify it under the terms of the GNU General Public License
+*   as published by the Free Software Foundation, either version 3
+*   of the License, or (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public
+*   License along with this program.  If not, see
+*   <http://www.gnu.org/licenses/>.
+*
+*   Git repository home: <https://github.com/ghoss/Thesis>
+*
+*****************************************************************
+* Date        :
+* Description :
+****************************************************************/   
+
+#include <stdio.h>
+#ifdef MSDOS
+#include <process.h>
+#else
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#endif
+#include <malloc.h>
+#include <assert.h>
+#include <string.h>
+
+#include "boolean.h"
+#include "util.h"
+#include "reader.h"
+#include "atomidx.h"
+
+#define MIN_ATOMS	256	/* Initial sizes of the tables */
+#define MIN_POSTINGS	4096
+#define MIN_SKIPS	64
+#define MIN_BYTES	16384
+
+
+/****************************************************************
+**  Forward declarations (compiler type checking)
+****************************************************************/
+
+#ifndef BSDUNIX
+void reserve_table ( char **, int *, int, unsigned );
+void put_number ( ATOM_INDEX, unsigned );
+ATOM_INDEX text_index ( READER );
+ATOM_INDEX map_index ( FILE *, AIDX_FILE * );
+#else
+void reserve_table ();
+void put_number ();
+ATOM_INDEX text_index ();
+ATOM_INDEX map_index ();
+#endif
+
+
+/****************************************************************
+**  reserve_table
+**
+**  Makes sure that a table of the index has room for 'need'
+**  elements.
+**
+**  IN  : t    = pointer to table.
+**        max  = pointer to number of allocated elements.
+**        need = number of elements required.
+**        size = size of an element.
+****************************************************************/
+
+void reserve_table
+       ( t, max, need, size )
+char
+  **t;
+int
+  *max;
+int
+  need;
+unsigned
+  size;
+{
+  if ( need <= *max ) return;
+  while ( *max < need ) {
+    *max *= 2;
+  }
+  *t = realloc ( *t, *max * size );
+  assert ( *t != NULL );
+}
+
+
+/****************************************************************
+**  create_index
+**
+**  Creates an empty index in memory.
+**
+**  IN  : num_docs = number of documents of the collection.
+**        weighted = TRUE if postings have weights.
+**
+**  OUT : Function returns a handle to the new index.
+****************************************************************/
+
+ATOM_INDEX create_index
+             ( num_docs, weighted )
+int
+  num_docs;
+BOOL
+  weighted;
+{
+  ATOM_INDEX
+    x;
+
+  x = (ATOM_INDEX) malloc ( sizeof ( ATOM_INDEX_HEADER ) );
+  assert ( x != NULL );
+  x -> max_atoms = MIN_ATOMS;
+  x -> max_postings = MIN_POSTINGS;
+  x -> max_skips = MIN_SKIPS;
+  x -> max_bytes = MIN_BYTES;
+  x -> atom = (AIDX_ATOM *) malloc ( MIN_ATOMS * sizeof ( AIDX_ATOM ) );
+  x -> skip = (AIDX_SKIP *) malloc ( MIN_SKIPS * sizeof ( AIDX_SKIP ) );
+  x -> post = (unsigned char *) malloc ( MIN_BYTES );
+  assert ( ( x -> atom != NULL ) && ( x -> skip != NULL ) && 
+           ( x -> post != NULL ) );
+  if ( weighted ) {
+    x -> wgt = (double *) malloc ( MIN_POSTINGS * sizeof ( double ) );
+    assert ( x -> wgt != NULL );
+  }
+  else {
+    x -> wgt = NULL;
+  }
+  x -> num_atoms = x -> num_postings = x -> num_skips = x -> num_bytes = 0;
+  x -> num_docs = num_docs;
+  x -> last = 0;
+  x -> map = NULL;
+  x -> size = 0;
+  return ( x );
+}
+
+
+/****************************************************************
+**  add_atom
+**
+**  Appends a concept with an empty list of postings.
+**
+**  IN  : x    = handle to index in memory.
+**        atom = index of concept; must be greater than that of
+**               the previous concept.
+****************************************************************/
+
+void add_atom
+       ( x, atom )
+ATOM_INDEX
+  x;
+int
+  atom;
+{
+  AIDX_ATOM
+    *a;
+
+  assert ( x -> map == NULL );
+  assert ( ( x -> num_atoms == 0 ) || 
+           ( atom > x -> atom [ x -> num_atoms - 1 ].atom ) );
+  reserve_table ( (char **) &x -> atom, &x -> max_atoms, x -> num_atoms + 1,
+                  sizeof ( AIDX_ATOM ) );
+  a = &x -> atom [ x -> num_atoms ++ ];
+  a -> atom = atom;
+  a -> df = 0;
+  a -> first = x -> num_postings;
+  a -> pos = x -> num_bytes;
+  a -> skip = x -> num_skips;
+}
+
+
+/****************************************************************
+**  put_number
+**
+**  Appends a number to the encoded postings as a varint: 7 bits
+**  per byte, least significant group first; the high bit of a
+**  byte is set if another byte follows. A 32-bit number takes
+**  1 to 5 bytes.
+**
+**  IN  : x = handle to index in memory.
+**        v = number to be appended.
+****************************************************************/
+
+void put_number
+       ( x, v )
+ATOM_INDEX
+  x;
+unsigned
+  v;
+{
+  reserve_table ( (char **) &x -> post, &x -> max_bytes, x -> num_bytes + 5, 1 );
+  while ( v >= 0x80 ) {
+    x -> post [ x -> num_bytes ++ ] = (unsigned char) ( v | 0x80 );
+    v >>= 7;
+  }
+  x -> post [ x -> num_bytes ++ ] = (unsigned char) v;
+}
+
+
+/****************************************************************
+**  add_posting
+**
+**  Appends a posting to the last concept of an index.
+**
+**  IN  : x      = handle to index in memory.
+**        doc    = document; must be greater than the previous
+**                 document of the concept.
+**        weight = weight of concept in doc (ignored if the index
+**                 is not weighted).
+****************************************************************/
+
+void add_posting
+       ( x, doc, weight )
+ATOM_INDEX
+  x;
+int
+  doc;
+double
+  weight;
+{
+  AIDX_ATOM
+    *a;
+
+  assert ( ( x -> map == NULL ) && ( x -> num_atoms > 0 ) );
+  a = &x -> atom [ x -> num_atoms - 1 ];
+  if ( a -> df == 0 ) {
+    /* First document: absolute value and sign */
+    put_number ( x, ( doc < 0 ) ? ( (unsigned) -doc << 1 ) | 1 :
+                                  (unsigned) doc << 1 );
+  }
+  else {
+    assert ( doc > x -> last );
+    if ( a -> df % SKIP_INTERVAL == 0 ) {
+      /* Skip entry for this posting */
+      reserve_table ( (char **) &x -> skip, &x -> max_skips, 
+                      x -> num_skips + 1, sizeof ( AIDX_SKIP ) );
+      x -> skip [ x -> num_skips ].doc = x -> last;
+      x -> skip [ x -> num_skips ].pos = x -> num_bytes;
+      x -> num_skips ++;
+    }
+    put_number ( x, (unsigned) ( doc - x -> last ) );
+  }
+
+  if ( x -> wgt != NULL ) {
+    reserve_table ( (char **) &x -> wgt, &x -> max_postings, 
+                    x -> num_postings + 1, sizeof ( double ) );
+    x -> wgt [ x -> num_postings ] = weight;
+  }
+  x -> num_postings ++;
+  a -> df ++;
+  x -> last = doc;
+}
+
+
+/****************************************************************
+**  text_index
+**
+**  Reads an atom index in text form (ATOM_DOCS) into memory.
+**
+**  IN  : r = reader of ATOM_DOCS file.
+**
+**  OUT : Function returns a handle to the index.
+****************************************************************/
+
+ATOM_INDEX text_index
+             ( r )
+READER
+  r;
+{
+  ATOM_INDEX
+    x;
+  int
+    n, atom, doc;
+
+  /* The first line contains the number of documents */
+  n = read_line ( r ) && get_int ( r, &doc );
+  assert ( n );
+  x = create_index ( doc, FALSE );
+
+  /* Read one concept at a time */
+  while ( next_record ( r, &atom ) ) {
+    add_atom ( x, atom );
+    while ( next_entry ( r ) ) {
+      n = get_int ( r, &doc );
+      assert ( n );
+      add_posting ( x, doc, 0.0 );
+    }
+  }
+  return ( x );
+}
+
+
+/****************************************************************
+**  map_index
+**
+**  Maps an atom index in binary form into memory.
+**
+**  IN  : f   = index file.
+**        hdr = header of f, already read.
+**
+**  OUT : Function returns a handle to the index.
+****************************************************************/
+
+ATOM_INDEX map_index
+             ( f, hdr )
+FILE
+  *f;
+AIDX_FILE
+  *hdr;
+{
+  ATOM_INDEX
+    x;
+  char
+    *p;
+#ifndef MSDOS
+  struct stat
+    st;
+  int
+    res;
+#else
+  size_t
+    n;
+#endif
+
+  assert ( hdr -> version == AIDX_VERSION );
+  x = (ATOM_INDEX) malloc ( sizeof ( ATOM_INDEX_HEADER ) );
+  assert ( x != NULL );
+  x -> num_atoms = hdr -> num_atoms;
+  x -> num_docs = hdr -> num_docs;
+  x -> num_postings = hdr -> num_postings;
+  x -> num_skips = hdr -> num_skips;
+  x -> num_bytes = hdr -> num_bytes;
+  x -> size = sizeof ( AIDX_FILE ) + x -> num_atoms * sizeof ( AIDX_ATOM ) +
+              x -> num_skips * sizeof ( AIDX_SKIP ) + x -> num_bytes;
+  if ( hdr -> weighted ) {
+    x -> size += x -> num_postings * sizeof ( double );
+  }
+
+#ifndef MSDOS
+  /* File must hold exactly the tables given by the header */
+  res = fstat ( fileno ( f ), &st );
+  assert ( ( res == 0 ) && ( st.st_size == (off_t) x -> size ) );
+  x -> map = mmap ( NULL, x -> size, PROT_READ, MAP_PRIVATE,
+                    fileno ( f ), (off_t) 0 );
+  assert ( x -> map != (char *) MAP_FAILED );
+#else
+  x -> map = malloc ( x -> size );
+  assert ( x -> map != NULL );
+  rewind ( f );
+  n = fread ( x -> map, 1, x -> size, f );
+  assert ( n == x -> size );
+#endif
+
+  /* Weights come first, since they need the strictest alignment */
+  p = x -> map + sizeof ( AIDX_FILE );
+  if ( hdr -> weighted ) {
+    x -> wgt = (double *) p;
+    p += x -> num_postings * sizeof ( double );
+  }
+  else {
+    x -> wgt = NULL;
+  }
+  x -> atom = (AIDX_ATOM *) p;
+  p += x -> num_atoms * sizeof ( AIDX_ATOM );
+  x -> skip = (AIDX_SKIP *) p;
+  p += x -> num_skips * sizeof ( AIDX_SKIP );
+  x -> post = (unsigned char *) p;
+  x -> max_atoms = x -> max_postings = x -> max_skips = x -> max_bytes = 0;
+  return ( x );
+}
+
+
+/****************************************************************
+**  open_index
+**
+**  Opens an atom index in text or binary form. Like 'open_file',
+**  the program is aborted if the file cannot be opened.
+**
+**  IN  : s = pointer to null-terminated file name.
+**
+**  OUT : Function returns a handle to the index.
+****************************************************************/
+
+ATOM_INDEX open_index
+             ( s )
+char
+  *s;
+{
+  FILE
+    *f;
+  READER
+    r;
+  ATOM_INDEX
+    x;
+  AIDX_FILE
+    hdr;
+
+  /* Binary files start with AIDX_MAGIC */
+  f = open_file ( s );
+  if ( ( fread ( &hdr, sizeof ( AIDX_FILE ), 1, f ) == 1 ) &&
+       ( memcmp ( hdr.magic, AIDX_MAGIC, sizeof ( hdr.magic ) ) == 0 ) ) {
+    x = map_index ( f, &hdr );
+    fclose ( f );
+  }
+  else {
+    fclose ( f );
+    r = open_reader ( s );
+    x = text_index ( r );
+    close_reader ( &r );
+  }
+  return ( x );
+}
+
+
+/****************************************************************
+**  close_index
+**
+**  Frees an atom index.
+**
+**  IN  : x = pointer to handle of index.
+**  OUT : '*x' is set to NULL.
+****************************************************************/
+
+void close_index
+       ( x )
+ATOM_INDEX
+  *x;
+{
+  if ( *x == NULL ) return;
+  if ( (*x) -> map != NULL ) {
+#ifndef MSDOS
+    munmap ( (*x) -> map, (*x) -> size );
+#else
+    free ( (*x) -> map );
+#endif
+  }
+  else {
+    free ( (char *) (*x) -> atom );
+    free ( (char *) (*x) -> skip );
+    free ( (char *) (*x) -> post );
+    if ( (*x) -> wgt != NULL ) free ( (char *) (*x) -> wgt );
+  }
+  free ( (char *) *x );
+  *x = NULL;
+}
+
+
+/****************************************************************
+**  write_index
+**
+**  Writes an atom index to a file.
+**
+**  IN  : x      = handle to index.
+**        f      = output file.
+**        binary = TRUE  --> write binary form.
+**                 FALSE --> write text form (without weights).
+****************************************************************/
+
+void write_index
+       ( x, f, binary )
+ATOM_INDEX
+  x;
+FILE
+  *f;
+BOOL
+  binary;
+{
+  AIDX_FILE
+    hdr;
+  POSTINGS
+    p;
+  int
+    i, n;
+
+  if ( binary ) {
+    memcpy ( hdr.magic, AIDX_MAGIC, sizeof ( hdr.magic ) );
+    hdr.version = AIDX_VERSION;
+    hdr.num_atoms = x -> num_atoms;
+    hdr.num_docs = x -> num_docs;
+    hdr.num_postings = x -> num_postings;
+    hdr.num_skips = x -> num_skips;
+    hdr.num_bytes = x -> num_bytes;
+    hdr.weighted = ( x -> wgt != NULL );
+    n = fwrite ( &hdr, sizeof ( AIDX_FILE ), 1, f );
+    assert ( n == 1 );
+    if ( x -> wgt != NULL ) {
+      n = fwrite ( x -> wgt, sizeof ( double ), x -> num_postings, f );
+      assert ( n == x -> num_postings );
+    }
+    n = fwrite ( x -> atom, sizeof ( AIDX_ATOM ), x -> num_atoms, f );
+    assert ( n == x -> num_atoms );
+    n = fwrite ( x -> skip, sizeof ( AIDX_SKIP ), x -> num_skips, f );
+    assert ( n == x -> num_skips );
+    n = fwrite ( x -> post, 1, x -> num_bytes, f );
+    assert ( n == x -> num_bytes );
+  }
+  else {
+    /* The total number of documents is the first line */
+    fprintf ( f, "%d documents\n", x -> num_docs );
+    for ( i = 0; i < x -> num_atoms; i ++ ) {
+      fprintf ( f, "%d :\n", index_atom ( x, i ) );
+      open_postings ( x, i, &p );
+      while ( next_posting ( &p ) ) {
+        fprintf ( f, "\t%d\n", p.doc );
+      }
+    }
+  }
+}
+
+
+/****************************************************************
+**  find_atom
+**
+**  Finds a concept in an index.
+**
+**  IN  : x    = handle to index.
+**        atom = index of concept.
+**
+**  OUT : Function returns the number of the concept in x, or
+**        -1 if it is not in the index.
+****************************************************************/
+
+int find_atom
+      ( x, atom )
+ATOM_INDEX
+  x;
+int
+  atom;
+{
+  int
+    low, high, mid;
+
+  low = 0;
+  high = x -> num_atoms - 1;
+  while ( low <= high ) {
+    mid = ( low + high ) / 2;
+    if ( x -> atom [ mid ].atom < atom ) {
+      low = mid + 1;
+    }
+    else if ( x -> atom [ mid ].atom > atom ) {
+      high = mid - 1;
+    }
+    else {
+      return ( mid );
+    }
+  }
+  return ( -1 );
+}
+
+
+/****************************************************************
+**  open_postings, next_posting
+**
+**  'open_postings' positions a cursor before the first posting
+**  of a concept; 'next_posting' reads the next posting into the
+**  fields 'doc' and 'weight' of the cursor.
+**
+**  IN  : x = handle to index.
+**        i = number of concept in x.
+**        p = pointer to cursor.
+**
+**  OUT : 'next_posting' returns FALSE at the end of the list.
+****************************************************************/
+
+void open_postings
+       ( x, i, p )
+ATOM_INDEX
+  x;
+int
+  i;
+POSTINGS
+  *p;
+{
+  p -> index = x;
+  p -> atom = &x -> atom [i];
+  p -> pos = x -> post + p -> atom -> pos;
+  p -> n = 0;
+  p -> doc = 0;
+  p -> weight = 0.0;
+}
+
+
+BOOL next_posting
+       ( p )
+POSTINGS
+  *p;
+{
+  unsigned
+    v;
+  int
+    shift;
+
+  if ( p -> n == p -> atom -> df ) return ( FALSE );
+
+  /* Decode number */
+  v = 0;
+  shift = 0;
+  while ( *p -> pos & 0x80 ) {
+    v |= (unsigned) ( *p -> pos ++ & 0x7f ) << shift;
+    shift += 7;
+  }
+  v |= (unsigned) *p -> pos ++ << shift;
+
+  if ( p -> n == 0 ) {
+    p -> doc = ( v & 1 ) ? - (int) ( v >> 1 ) : (int) ( v >> 1 );
+  }
+  else {
+    p -> doc += (int) v;
+  }
+  if ( p -> index -> wgt != NULL ) {
+    p -> weight = p -> index -> wgt [ p -> atom -> first + p -> n ];
+  }
+  p -> n ++;
+  return ( TRUE );
+}
+
+
+/****************************************************************
+**  skip_postings
+**
+**  Advances a cursor to the first posting whose document is
+**  not less than a given document. Skip entries are used to
+**  pass over blocks of postings without decoding them.
+**
+**  IN  : p   = pointer to cursor.
+**        doc = document.
+**
+**  OUT : The function returns FALSE if there is no such posting.
+****************************************************************/
+
+BOOL skip_postings
+       ( p, doc )
+POSTINGS
+  *p;
+int
+  doc;
+{
+  AIDX_SKIP
+    *s;
+  int
+    j, k, num_skips;
+
+  if ( ( p -> n > 0 ) && ( p -> doc >= doc ) ) return ( TRUE );
+
+  /* Skip entry j leads to posting ( j + 1 ) * SKIP_INTERVAL; find
+     the last entry ahead of the cursor which passes only postings
+     less than doc */
+  num_skips = ( p -> atom -> df > 0 ) ? 
+              ( p -> atom -> df - 1 ) / SKIP_INTERVAL : 0;
+  s = p -> index -> skip + p -> atom -> skip;
+  k = p -> n / SKIP_INTERVAL;
+  j = k;
+  while ( ( j < num_skips ) && ( s [j].doc < doc ) ) {
+    j ++;
+  }
+  if ( j > k ) {
+    p -> n = j * SKIP_INTERVAL;
+    p -> pos = p -> index -> post + s [ j - 1 ].pos;
+    p -> doc = s [ j - 1 ].doc;
+  }
+
+  /* Scan remaining postings */
+  while ( next_posting ( p ) ) {
+    if ( p -> doc >= doc ) return ( TRUE );
+  }
+  return ( FALSE );
+}
@@ -0,0 +1,168 @@
+/****************************************************************
+*
+*           S O F T W A R E   S O U R C E   F I L E
+*
+*****************************************************************
+*
+*   Name of file   : atomidx.h
+*   Author         : Guido Hoss
+*   Project        : ETH Diploma Thesis (SS 1989)
+*   Creation Date  : 09/05/89
+*   Type of file   : C Header File
+*
+*****************************************************************
+*
+*   COPYRIGHT (C) 1989, 2016 BY GUIDO HOSS.
+*
+*   This program is free software: you can redistribute it and/or 
+*   modify it under the terms of the GNU General Public License
+*   as published by the Free Software Foundation, either version 3
+*   of the License, or (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public
+*   License along with this program.  If not, see
+*   <http://www.gnu.org/licenses/>.
+*
+*   Git repository home: <https://github.com/ghoss/Thesis>
+*
+*****************************************************************
+* Date        :
+* Description :
+****************************************************************/   
+
+/* An atom index is the inverted file of the atomic concepts: for
+   each atomic concept, it gives the documents (and queries) in whose
+   description the concept occurs, and optionally the weight of the
+   concept in each of them. It is written by calc_atomdocs.
+
+   In text form (ATOM_DOCS), the first line is the number of
+   documents of the collection, followed by one record per concept:
+
+      17 :
+   	-3
+   	139
+
+   The binary form consists of
+
+      header     AIDX_FILE
+      weights    double [num_postings]   (only if 'weighted')
+      atoms      AIDX_ATOM [num_atoms]   (in increasing order)
+      skips      AIDX_SKIP [num_skips]
+      postings   num_bytes bytes
+
+   with all numbers in the byte order of the machine which wrote the
+   file. The documents of a concept are stored in increasing order,
+   each as the difference to its predecessor in a variable number of
+   bytes (7 bits per byte, the high bit set in all but the last
+   byte). The first document of a concept is stored as its absolute
+   value times 2, plus 1 if it is negative. Every SKIP_INTERVAL
+   postings, a skip entry gives the position of the next posting
+   and the document preceding it, so long lists can be entered in
+   the middle. A binary file is mapped into memory; text files are
+   read into memory in the same layout, without weights. */
+#define AIDX_MAGIC	"AIDX"
+#define AIDX_VERSION	1
+#define SKIP_INTERVAL	64
+
+typedef
+  struct {
+    char	magic [4];	/* AIDX_MAGIC */
+    int		version;	/* AIDX_VERSION */
+    int		num_atoms;	/* Number of atomic concepts */
+    int		num_docs;	/* Number of documents of collection */
+    int		num_postings;	/* Number of postings */
+    int		num_skips;	/* Number of skip entries */
+    int		num_bytes;	/* Size of encoded postings */
+    int		weighted;	/* 1 if weights are present */
+  } AIDX_FILE;
+
+typedef
+  struct {
+    int		atom;		/* Index of atomic concept */
+    int		df;		/* Number of postings */
+    int		first;		/* Number of first posting */
+    int		pos;		/* Position of first posting in bytes */
+    int		skip;		/* Number of first skip entry */
+  } AIDX_ATOM;
+
+typedef
+  struct {
+    int		doc;		/* Document preceding the skipped-to posting */
+    int		pos;		/* Position of this posting in bytes */
+  } AIDX_SKIP;
+
+typedef
+  struct {
+    AIDX_ATOM	*atom;		/* Atom table */
+    AIDX_SKIP	*skip;		/* Skip entries */
+    double	*wgt;		/* Weights, NULL if not weighted */
+    unsigned char
+		*post;		/* Encoded postings */
+    int		num_atoms;
+    int		num_docs;
+    int		num_postings;
+    int		num_skips;
+    int		num_bytes;
+    int		max_atoms;	/* Allocated sizes (index in memory) */
+    int		max_postings;
+    int		max_skips;
+    int		max_bytes;
+    int		last;		/* Last document added */
+    char	*map;		/* Mapped binary file, NULL if in memory */
+    size_t	size;		/* Size of mapping */
+  } ATOM_INDEX_HEADER;
+
+typedef
+  ATOM_INDEX_HEADER *ATOM_INDEX;
+
+/* A cursor on the postings of one concept */
+typedef
+  struct {
+    ATOM_INDEX	index;
+    AIDX_ATOM	*atom;		/* Concept of the postings */
+    unsigned char
+		*pos;		/* Next encoded posting */
+    int		n;		/* Number of postings read */
+    int		doc;		/* Current document */
+    double	weight;		/* Current weight, 0.0 if not weighted */
+  } POSTINGS;
+
+
+/* Access to the concepts of an index; concepts are numbered
+   0 .. index_atoms - 1 in increasing order */
+#define index_atoms(x)		( (x) -> num_atoms )
+#define index_docs(x)		( (x) -> num_docs )
+#define index_atom(x,i)		( (x) -> atom [i].atom )
+#define index_df(x,i)		( (x) -> atom [i].df )
+#define index_weighted(x)	( (x) -> wgt != NULL )
+
+
+/* Functions defined on atom indexes */
+#ifndef BSDUNIX
+ATOM_INDEX create_index ( int, BOOL );
+void add_atom ( ATOM_INDEX, int );
+void add_posting ( ATOM_INDEX, int, double );
+ATOM_INDEX open_index ( char * );
+void close_index ( ATOM_INDEX * );
+void write_index ( ATOM_INDEX, FILE *, BOOL );
+int find_atom ( ATOM_INDEX, int );
+void open_postings ( ATOM_INDEX, int, POSTINGS * );
+BOOL next_posting ( POSTINGS * );
+BOOL skip_postings ( POSTINGS *, int );
+#else
+ATOM_INDEX create_index ();
+void add_atom ();
+void add_posting ();
+ATOM_INDEX open_index ();
+void close_index ();
+void write_index ();
+int find_atom ();
+void open_postings ();
+BOOL next_posting ();
+BOOL skip_postings ();
+#endif
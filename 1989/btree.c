@@ -0,0 +1,1581 @@
+/****************************************************************
+*
+*           S O F T W A R E   S O U R C E   F I L E
+*
+*****************************************************************
+*
+*   Name of file   : btree.c
+*   Author         : Guido Hoss
+*   Project        : ETH Diploma Thesis (SS 1989)
+*   Creation Date  : 27/04/89
+*   Type of file   : C Language File
+*
+*   Description
+*   -----------
+*   Alternative implementation of the abstract data type LIST
+*   (see list.h). The list is stored as a B+-tree: the elements
+*   are kept in leaves of LEAF_SIZE entries which are chained in
+*   increasing order, and the inner nodes contain the smallest
+*   element of each of their sons as separator keys.
+*
+*   In contrast to list.c, adding an element only moves the
+*   entries of one leaf, so building a list of n elements costs
+*   O(n log n) instead of O(n^2). Link with btree.o instead of
+*   list.o to use this implementation.
+*
+*****************************************************************
+*
+*   COPYRIGHT (C) 1989, 2016 BY GUIDO HOSS.
+*
+*   This program is free software: you can redistribute it and/or
+*   modify it under the terms of the GNU General Public License
+*   as published by the Free Software Foundation, either version 3
+*   of the License, or (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public
+*   License along with this program.  If not, see
+*   <http://www.gnu.org/licenses/>.
+*
+*   Git repository home: <https://github.com/ghoss/Thesis>
+*
+*****************************************************************
+* Date        :
+* Description :
+****************************************************************/
+
+#include <stdio.h>
+#ifdef MSDOS
+#include <process.h>
+#endif
+#include <malloc.h>
+#include <assert.h>
+
+#include "boolean.h"
+#include "list.h"
+#include "listsort.h"
+#include "util.h"
+
+
+#define LEAF_SIZE	64	/* Max. number of elements in a leaf */
+#define NODE_SIZE	64	/* Max. number of sons of an inner node */
+#define MAX_HEIGHT	16	/* Max. number of inner node levels */
+
+/* find_union_gallop and find_diff_gallop only gallop if one list
+   is more than GALLOP_RATIO times longer than the other */
+#ifndef GALLOP_RATIO
+#define GALLOP_RATIO	32
+#endif
+
+/* Leaves contain the list elements in increasing order. All leaves
+   of a tree are chained, so the list can be enumerated without
+   visiting the inner nodes. */
+typedef
+  struct leaf {
+    int		num;			/* Number of elements in leaf */
+    struct leaf	*next;			/* Next leaf (greater elements) */
+    struct leaf	*prev;			/* Previous leaf (smaller elements) */
+    ELEMENT	elt [ LEAF_SIZE ];	/* Elements of this leaf */
+  } LEAF;
+
+/* key[i] is the smallest element in the subtree of son[i]. key[0]
+   is never used for comparisons. */
+typedef
+  struct node {
+    int		num;			/* Number of sons */
+    ELEMENT	key [ NODE_SIZE ];	/* Separator keys */
+    char	*son [ NODE_SIZE ];	/* Sons (LEAF or NODE) */
+  } NODE;
+
+/* The list header contains the root of the tree. If height = 0,
+   then the root is a leaf, otherwise it is an inner node. */
+struct list_header {
+  char	*root;		/* Root of the tree */
+  int	height;		/* Number of inner node levels */
+  int	num;		/* Number of elements in list */
+  LEAF	*first;		/* Leftmost leaf */
+  LEAF	*last;		/* Rightmost leaf */
+  ELEMENT *pending;	/* Elements added by list_append_unsorted */
+  int	npending;	/* Number of pending elements */
+  int	tpending;	/* Size of pending array */
+  ARENA	arena;		/* Arena of the elements, or NULL */
+};
+
+/* Key function for list_finalize_int */
+#ifndef BSDUNIX
+int
+  (*glob_key) ( ELEMENT );
+#else
+int
+  (*glob_key) ();
+#endif
+
+
+/****************************************************************
+**  Forward declarations (compiler type checking)
+****************************************************************/
+
+#ifndef BSDUNIX
+int leaf_search ( LEAF *, ELEMENT, int (*) ( ELEMENT, ELEMENT ) );
+int node_search ( NODE *, ELEMENT, int (*) ( ELEMENT, ELEMENT ) );
+LEAF *new_leaf ( void );
+NODE *new_node ( void );
+void free_tree ( char *, int );
+ELEMENT tree_add ( LIST, ELEMENT, int (*) ( ELEMENT, ELEMENT ), BOOL );
+int comp_glob_key ( ELEMENT, ELEMENT );
+void insert_pending ( LIST, int (*) ( ELEMENT, ELEMENT ),
+                      void (*) ( ELEMENT, ELEMENT ) );
+BOOL seek_pos ( LIST, LEAF **, int *, ELEMENT, int (*) ( ELEMENT, ELEMENT ) );
+#else
+int leaf_search ();
+int node_search ();
+LEAF *new_leaf ();
+NODE *new_node ();
+void free_tree ();
+ELEMENT tree_add ();
+int comp_glob_key ();
+void insert_pending ();
+BOOL seek_pos ();
+#endif
+
+
+/****************************************************************
+**  leaf_search
+**
+**  Does a binary search on the elements of a leaf.
+**
+**  IN  : 'leaf' = leaf to be searched.
+**        'key'  = the element to be searched.
+**        'comp' = the compare function (see add_list).
+**
+**  OUT : If 'key' does NOT occur in the leaf, the index of the
+**        element which must follow 'key' if 'key' were inserted
+**        is returned. Otherwise, '-index - 1' is returned
+**        (same convention as binary_search in list.c).
+****************************************************************/
+
+int leaf_search
+      ( leaf, key, comp )
+LEAF
+  *leaf;
+ELEMENT
+  key;
+#ifndef BSDUNIX
+int
+  (*comp) ( ELEMENT, ELEMENT );
+#else
+int
+  (*comp) ();
+#endif
+{
+  int
+    compare,
+    low, high, mid;
+
+  low = 0;
+  high = leaf -> num - 1;
+
+  while ( low <= high ) {
+    mid = ( low + high ) / 2;
+    compare = (*comp) ( key, leaf -> elt [ mid ] );
+
+    if ( compare < 0 ) {
+      high = mid - 1;
+    }
+    else if ( compare > 0 ) {
+      low = mid + 1;
+    }
+    else {
+      /* found at position 'mid' */
+      return ( (-mid) - 1 );
+    }
+  }
+  return ( low );
+}
+
+
+/****************************************************************
+**  node_search
+**
+**  Finds the son of an inner node whose subtree must contain
+**  a given element.
+**
+**  IN  : 'node' = inner node to be searched.
+**        'key'  = the element to be searched.
+**        'comp' = the compare function.
+**
+**  OUT : The index of the son is returned, i.e. the greatest i
+**        with key[i] <= 'key', or 0 if there is no such son.
+****************************************************************/
+
+int node_search
+      ( node, key, comp )
+NODE
+  *node;
+ELEMENT
+  key;
+#ifndef BSDUNIX
+int
+  (*comp) ( ELEMENT, ELEMENT );
+#else
+int
+  (*comp) ();
+#endif
+{
+  int
+    low, high, mid;
+
+  /* key[0] is smaller than everything, so start searching at 1 */
+  low = 1;
+  high = node -> num - 1;
+
+  while ( low <= high ) {
+    mid = ( low + high ) / 2;
+    if ( (*comp) ( key, node -> key [ mid ] ) < 0 ) {
+      high = mid - 1;
+    }
+    else {
+      low = mid + 1;
+    }
+  }
+  return ( high );
+}
+
+
+/****************************************************************
+**  new_leaf, new_node
+**
+**  Allocate an empty leaf resp. inner node.
+****************************************************************/
+
+LEAF *new_leaf
+        ( )
+{
+  LEAF
+    *leaf;
+
+  leaf = (LEAF *) malloc ( sizeof ( LEAF ) );
+  assert ( leaf != NULL );
+  leaf -> num = 0;
+  leaf -> next = leaf -> prev = NULL;
+  return ( leaf );
+}
+
+
+NODE *new_node
+        ( )
+{
+  NODE
+    *node;
+
+  node = (NODE *) malloc ( sizeof ( NODE ) );
+  assert ( node != NULL );
+  node -> num = 0;
+  return ( node );
+}
+
+
+/****************************************************************
+**  create_list
+**
+**  Creates a new, empty list.
+**
+**  OUT : A handle to the new list, or NULL if the function did
+**        not succeed.
+****************************************************************/
+
+LIST create_list
+       ( )
+{
+  HEADER
+    *header;
+
+  header = (HEADER *) malloc ( sizeof ( HEADER ) );
+
+  /* An empty tree consists of one empty leaf */
+  if ( header != NULL ) {
+    header -> first = header -> last = new_leaf ();
+    header -> root = (char *) header -> first;
+    header -> height = 0;
+    header -> num = 0;
+    header -> pending = NULL;
+    header -> npending = header -> tpending = 0;
+    header -> arena = NULL;
+  }
+  return ( header );
+}
+
+
+/****************************************************************
+**  create_list_sized
+**
+**  Creates a new, empty list. The size hint is ignored, since a
+**  B+-tree grows one leaf at a time without copying elements.
+**
+**  IN  : size = expected number of list elements.
+**
+**  OUT : A handle to the new list, or NULL if the function did
+**        not succeed.
+****************************************************************/
+
+LIST create_list_sized
+       ( size )
+int
+  size;
+{
+  return ( create_list () );
+}
+
+
+/****************************************************************
+**  destroy_list
+**
+**  Deallocates all memory used by an existing list, thereby
+**  destroying its contents. It must be possible to deallocate
+**  the list elements with calls to free(), unless the elements
+**  are allocated in an arena (see list_set_arena).
+**
+**  IN  : list = Pointer to handle of list to be destroyed.
+**  OUT : '*list' is set to NULL.
+****************************************************************/
+
+void free_tree
+       ( t, height )
+char
+  *t;
+int
+  height;
+{
+  int
+    i;
+  NODE
+    *node;
+
+  /* Leaves are freed by destroy_list */
+  if ( height == 0 ) return;
+
+  node = (NODE *) t;
+  for ( i = 0; i < node -> num; i ++ ) {
+    free_tree ( node -> son [i], height - 1 );
+  }
+  free ( node );
+}
+
+
+void destroy_list
+       ( list )
+LIST
+  *list;
+{
+  int
+    i;
+  LEAF
+    *leaf, *next;
+
+  if ( *list == NULL ) return;
+
+  /* Free all elements and leaves */
+  for ( leaf = (*list) -> first; leaf != NULL; leaf = next ) {
+    if ( (*list) -> arena == NULL ) {
+      for ( i = 0; i < leaf -> num; i ++ ) {
+        free ( leaf -> elt [i] );
+      }
+    }
+    next = leaf -> next;
+    free ( leaf );
+  }
+
+  /* Free elements which have not been finalized */
+  if ( (*list) -> arena == NULL ) {
+    for ( i = 0; i < (*list) -> npending; i ++ ) {
+      free ( (*list) -> pending [i] );
+    }
+  }
+  if ( (*list) -> pending != NULL ) free ( (*list) -> pending );
+
+  /* Free inner nodes and header */
+  free_tree ( (*list) -> root, (*list) -> height );
+  free ( *list );
+  *list = NULL;
+}
+
+
+/****************************************************************
+**  tree_add
+**
+**  Function for add_list and lookup_list.
+**
+**  IN  : 'list', 'elt', and 'comp' correspond to their
+**        counterparts in add_list and lookup_list.
+**        enter = FALSE --> return NULL if element not found.
+**                TRUE  --> add element if not found and return
+**                          pointer to it.
+**
+**  OUT : See 'IN'.
+****************************************************************/
+
+ELEMENT tree_add
+          ( list, elt, comp, enter )
+LIST
+  list;
+ELEMENT
+  elt;
+#ifndef BSDUNIX
+int
+  (*comp) ( ELEMENT, ELEMENT );
+#else
+int
+  (*comp) ();
+#endif
+BOOL
+  enter;
+{
+  NODE
+    *path [ MAX_HEIGHT ],	/* Inner nodes visited, path[1] = parent of leaf */
+    *node, *new;
+  int
+    index [ MAX_HEIGHT ],	/* Index of son taken in path[] */
+    i, h, n, pos, result;
+  BOOL
+    rightmost;
+  LEAF
+    *leaf, *right, *target;
+  ELEMENT
+    sep;
+  char
+    *son;
+
+  assert ( list != NULL );
+  assert ( elt != NULL );
+
+  /* Descend from the root to the leaf which must contain 'elt' */
+  son = list -> root;
+  rightmost = TRUE;
+  for ( h = list -> height; h > 0; h -- ) {
+    node = (NODE *) son;
+    i = node_search ( node, elt, comp );
+    path [h] = node;
+    index [h] = i;
+    rightmost = rightmost && ( i == node -> num - 1 );
+    son = node -> son [i];
+  }
+  leaf = (LEAF *) son;
+  result = leaf_search ( leaf, elt, comp );
+
+  if ( result < 0 ) {
+    /* element occurs in list */
+    if ( enter ) {
+      if ( list -> arena != NULL ) {
+        arena_release ( list -> arena, elt );
+      }
+      else {
+        free ( elt );
+      }
+    }
+    return ( leaf -> elt [ -result - 1 ] );
+  }
+  if ( ! enter ) {
+    /* not in list, don't enter -> return NULL */
+    return ( NULL );
+  }
+  list -> num ++;
+
+  if ( leaf -> num < LEAF_SIZE ) {
+    /* Enough room in leaf; make a hole at elt[result] */
+    for ( i = leaf -> num; i > result; i -- ) {
+      leaf -> elt [i] = leaf -> elt [ i - 1 ];
+    }
+    leaf -> elt [ result ] = elt;
+    leaf -> num ++;
+    return ( elt );
+  }
+
+  /* Leaf is full and must be split. If elements are added in
+     increasing order, the new leaf only receives the new element,
+     so that all other leaves remain completely filled. */
+  right = new_leaf ();
+  if ( ( leaf == list -> last ) && ( result == LEAF_SIZE ) ) {
+    right -> elt [0] = elt;
+    right -> num = 1;
+  }
+  else {
+    n = LEAF_SIZE / 2;
+    for ( i = n; i < LEAF_SIZE; i ++ ) {
+      right -> elt [ i - n ] = leaf -> elt [i];
+    }
+    right -> num = LEAF_SIZE - n;
+    leaf -> num = n;
+
+    /* Insert new element into the correct half */
+    target = leaf;
+    if ( result > n ) {
+      target = right;
+      result -= n;
+    }
+    for ( i = target -> num; i > result; i -- ) {
+      target -> elt [i] = target -> elt [ i - 1 ];
+    }
+    target -> elt [ result ] = elt;
+    target -> num ++;
+  }
+
+  /* Chain new leaf behind the old one */
+  right -> prev = leaf;
+  right -> next = leaf -> next;
+  if ( leaf -> next != NULL ) {
+    leaf -> next -> prev = right;
+  }
+  else {
+    list -> last = right;
+  }
+  leaf -> next = right;
+
+  /* Insert separator and new son into the parent nodes, splitting
+     them as long as they are full */
+  sep = right -> elt [0];
+  son = (char *) right;
+  for ( h = 1; h <= list -> height; h ++ ) {
+    node = path [h];
+    pos = index [h] + 1;
+
+    if ( node -> num < NODE_SIZE ) {
+      for ( i = node -> num; i > pos; i -- ) {
+        node -> key [i] = node -> key [ i - 1 ];
+        node -> son [i] = node -> son [ i - 1 ];
+      }
+      node -> key [ pos ] = sep;
+      node -> son [ pos ] = son;
+      node -> num ++;
+      return ( elt );
+    }
+
+    /* Split inner node */
+    new = new_node ();
+    if ( rightmost && ( pos == NODE_SIZE ) ) {
+      new -> key [0] = sep;
+      new -> son [0] = son;
+      new -> num = 1;
+    }
+    else {
+      n = NODE_SIZE / 2;
+      for ( i = n; i < NODE_SIZE; i ++ ) {
+        new -> key [ i - n ] = node -> key [i];
+        new -> son [ i - n ] = node -> son [i];
+      }
+      new -> num = NODE_SIZE - n;
+      node -> num = n;
+      if ( pos > n ) {
+        node = new;
+        pos -= n;
+      }
+      for ( i = node -> num; i > pos; i -- ) {
+        node -> key [i] = node -> key [ i - 1 ];
+        node -> son [i] = node -> son [ i - 1 ];
+      }
+      node -> key [ pos ] = sep;
+      node -> son [ pos ] = son;
+      node -> num ++;
+    }
+
+    /* The smallest key of the new node is passed to the parent */
+    sep = new -> key [0];
+    son = (char *) new;
+  }
+
+  /* The root has been split; the tree grows by one level */
+  assert ( list -> height + 1 < MAX_HEIGHT );
+  node = new_node ();
+  node -> son [0] = list -> root;
+  node -> key [1] = sep;
+  node -> son [1] = son;
+  node -> num = 2;
+  list -> root = (char *) node;
+  list -> height ++;
+  return ( elt );
+}
+
+
+/****************************************************************
+**  add_list
+**
+**  Inserts an element in a list.
+**
+**  IN  : list = handle to list created with create_list.
+**        elt  = pointer to new element. The pointer must have
+**               been obtained by a call to malloc or calloc!
+**        comp = compare function for 2 elements e1 and e2.
+**               Must return < 0 if e1 < e2,
+**                           = 0 if e1 = e2,
+**                           > 0 if e1 > e2.
+**
+**  OUT : If the element already is in the list, then a pointer
+**        is returned to the previously stored element. In this
+**        case, 'elt' is automatically deallocated.
+**        Otherwise, the element is inserted and 'elt' is returned.
+****************************************************************/
+
+ELEMENT add_list
+	  ( list, elt, comp )
+LIST
+  list;
+ELEMENT
+  elt;
+#ifndef BSDUNIX
+int
+  (*comp) ( ELEMENT, ELEMENT );
+#else
+int
+  (*comp) ();
+#endif
+{
+  return ( tree_add ( list, elt, comp, TRUE ) );
+}
+
+
+/****************************************************************
+**  lookup_list
+**
+**  Tests if a list contains a specified element.
+**
+**  IN  : list = handle to list created with create_list.
+**        elt  = pointer to element to be searched.
+**        comp = compare function (see add_list).
+**
+**  OUT : If the element is in the list, a pointer to the stored
+**        element (not to 'elt') is returned. Otherwise, the
+**        function returns NULL.
+****************************************************************/
+
+ELEMENT lookup_list
+	  ( list, elt, comp )
+LIST
+  list;
+ELEMENT
+  elt;
+#ifndef BSDUNIX
+int
+  (*comp) ( ELEMENT, ELEMENT );
+#else
+int
+  (*comp) ();
+#endif
+{
+  return ( tree_add ( list, elt, comp, FALSE ) );
+}
+
+
+/****************************************************************
+**  delete_list
+**
+**  Deletes an element from a list.
+**
+**  IN  : list = handle to list created with create_list.
+**        elt  = pointer to an element. The element MUST be in
+**               the list.
+**        comp = compare function (see add_list).
+**
+**  OUT : The element is deleted from the list. Memory allocated
+**        for the element is NOT freed. Leaves and inner nodes
+**        which become empty are removed from the tree, but
+**        nodes are not merged with their neighbours.
+****************************************************************/
+
+void delete_list
+       ( list, elt, comp )
+LIST
+  list;
+ELEMENT
+  elt;
+#ifndef BSDUNIX
+int
+  (*comp) ( ELEMENT, ELEMENT );
+#else
+int
+  (*comp) ();
+#endif
+{
+  NODE
+    *path [ MAX_HEIGHT ],
+    *node;
+  int
+    index [ MAX_HEIGHT ],
+    i, h, pos, level;
+  LEAF
+    *leaf;
+  char
+    *son;
+  ELEMENT
+    min;
+
+  assert ( list != NULL );
+  assert ( elt != NULL );
+
+  /* Descend to the leaf containing 'elt' */
+  son = list -> root;
+  for ( h = list -> height; h > 0; h -- ) {
+    node = (NODE *) son;
+    i = node_search ( node, elt, comp );
+    path [h] = node;
+    index [h] = i;
+    son = node -> son [i];
+  }
+  leaf = (LEAF *) son;
+  pos = leaf_search ( leaf, elt, comp );
+  assert ( pos < 0 );
+  pos = -pos - 1;
+
+  /* Remove element from leaf */
+  for ( i = pos; i < leaf -> num - 1; i ++ ) {
+    leaf -> elt [i] = leaf -> elt [ i + 1 ];
+  }
+  leaf -> num --;
+  list -> num --;
+
+  /* level = lowest level which still contains the subtree of 'elt' */
+  level = 0;
+  if ( ( leaf -> num == 0 ) && ( list -> height > 0 ) ) {
+    /* Unchain and free empty leaf */
+    if ( leaf -> prev != NULL ) {
+      leaf -> prev -> next = leaf -> next;
+    }
+    else {
+      list -> first = leaf -> next;
+    }
+    if ( leaf -> next != NULL ) {
+      leaf -> next -> prev = leaf -> prev;
+    }
+    else {
+      list -> last = leaf -> prev;
+    }
+    free ( leaf );
+
+    /* Remove son from its parents as long as they become empty; the
+       root never becomes empty since it has at least two sons */
+    for ( level = 1; level <= list -> height; level ++ ) {
+      node = path [ level ];
+      for ( i = index [ level ]; i < node -> num - 1; i ++ ) {
+        node -> key [i] = node -> key [ i + 1 ];
+        node -> son [i] = node -> son [ i + 1 ];
+      }
+      node -> num --;
+      if ( node -> num > 0 ) break;
+      free ( node );
+    }
+    assert ( level <= list -> height );
+
+    /* If the removed son was not the first one, its separator key
+       was removed with it, so no other key refers to 'elt' */
+    if ( index [ level ] > 0 ) pos = -1;
+  }
+
+  /* If 'elt' was the smallest element in a subtree, then the
+     separator key referring to it must be replaced */
+  if ( pos == 0 ) {
+    for ( h = level + 1; ( h <= list -> height ) && ( index [h] == 0 ); h ++ )
+      ;
+    if ( h <= list -> height ) {
+      /* Find new smallest element in subtree path[h] -> son[index[h]] */
+      son = path [h] -> son [ index [h] ];
+      for ( i = h - 1; i > 0; i -- ) {
+        son = ((NODE *) son) -> son [0];
+      }
+      min = ((LEAF *) son) -> elt [0];
+      path [h] -> key [ index [h] ] = min;
+    }
+  }
+
+  /* Remove root nodes with only one son */
+  while ( ( list -> height > 0 ) && ( ((NODE *) list -> root) -> num == 1 ) ) {
+    node = (NODE *) list -> root;
+    list -> root = node -> son [0];
+    list -> height --;
+    free ( node );
+  }
+}
+
+
+/****************************************************************
+**  enum_list
+**
+**  Returns the contents of a list one by one.
+**
+**  IN  : list = handle to list created with create_list.
+**        enum = function which is called for each list element.
+**               If the function returns FALSE, enum_list aborts.
+**        direction = either ENUM_FORWARD or ENUM_BACKWARD.
+**
+**  OUT : The function returns the result of the last call to
+**        'enum'.
+****************************************************************/
+
+BOOL enum_list
+       ( list, enum_proc, direction )
+LIST
+  list;
+#ifndef BSDUNIX
+BOOL
+  (*enum_proc) ( ELEMENT );
+#else
+BOOL
+  (*enum_proc) ();
+#endif
+int
+  direction;
+{
+  int
+    i;
+  LEAF
+    *leaf;
+  BOOL
+    result;
+
+  assert ( ( direction == ENUM_FORWARD ) || ( direction == ENUM_BACKWARD ) );
+
+  result = TRUE;
+
+  if ( direction == ENUM_FORWARD ) {
+    for ( leaf = list -> first; leaf != NULL; leaf = leaf -> next ) {
+      for ( i = 0; i < leaf -> num; i ++ ) {
+        result = (*enum_proc) ( leaf -> elt [i] );
+        if ( ! result ) return ( result );
+      }
+    }
+  }
+  else {
+    for ( leaf = list -> last; leaf != NULL; leaf = leaf -> prev ) {
+      for ( i = leaf -> num - 1; i >= 0; i -- ) {
+        result = (*enum_proc) ( leaf -> elt [i] );
+        if ( ! result ) return ( result );
+      }
+    }
+  }
+
+  return ( result );
+}
+
+
+/****************************************************************
+**  count_list
+**
+**  Returns the number of elements in a list.
+**
+**  IN  : list = handle to list created with create_list.
+**
+**  OUT : The function returns the number of elements in 'list'
+**        or 0 if the list is empty.
+****************************************************************/
+
+int count_list
+      ( list )
+LIST
+  list;
+{
+  if ( list == NULL ) {
+    return ( 0 );
+  }
+  else {
+    return ( list -> num );
+  }
+}
+
+
+/****************************************************************
+**  Leaf cursors used by find_union, find_diff and merge_lists.
+**  A cursor is a pair (leaf, position); leaf = NULL denotes the
+**  end of the list. Only the root leaf of a tree may be empty.
+****************************************************************/
+
+#define first_pos(list,leaf,pos)	{ (leaf) = (list) -> first; \
+  (pos) = 0; if ( (leaf) -> num == 0 ) (leaf) = NULL; }
+
+#define next_pos(leaf,pos)	{ if ( ++ (pos) >= (leaf) -> num ) { \
+  (leaf) = (leaf) -> next; (pos) = 0; } }
+
+
+/****************************************************************
+**  find_union
+**
+**  Calls a user-specified procedure for each element that occurs
+**  simultaneously in two lists.
+**
+**  IN  : list1, list2 = handles to two lists with elements of
+**                       the same type.
+**
+**        compare = a function which accepts pointers to two
+**                  elements e1, e2 and returns -1 if e1 "<" e2,
+**                  0 if e1 "=" e2, and +1 if e1 ">" e2.
+**
+**        call = a function to be called with e1 and e2 if
+**               e1 "=" e2. If the function returns FALSE,
+**               find_union returns immediately.
+**
+**  OUT : The function returns the result of the last call to
+**        "call".
+****************************************************************/
+
+BOOL find_union
+       ( list1, list2, compare, call )
+LIST
+  list1;
+LIST
+  list2;
+#ifndef BSDUNIX
+int
+  (*compare) ( ELEMENT, ELEMENT );
+BOOL
+  (*call) ( ELEMENT, ELEMENT );
+#else
+int
+  (*compare) ();
+BOOL
+  (*call) ();
+#endif
+{
+  LEAF
+    *l1, *l2;
+  int
+    i, j, res;
+  ELEMENT
+    e1, e2;
+  BOOL
+    ok;
+
+  assert ( list1 != NULL );
+  assert ( list2 != NULL );
+
+  first_pos ( list1, l1, i );
+  first_pos ( list2, l2, j );
+  ok = TRUE;
+  while ( ( l1 != NULL ) && ( l2 != NULL ) && ok ) {
+
+    /* Remember that lists are sorted in increasing order */
+    e1 = l1 -> elt [i];
+    e2 = l2 -> elt [j];
+    res = (*compare) ( e1, e2 );
+
+    if ( res < 0 ) {
+      /* e1 is smaller than e2 */
+      next_pos ( l1, i );
+    }
+    else if ( res > 0 ) {
+      /* e2 is smaller than e1 */
+      next_pos ( l2, j );
+    }
+    else {
+      /* both are equal */
+      ok = (*call) ( e1, e2 );
+      next_pos ( l1, i );
+      next_pos ( l2, j );
+    }
+  }
+  return ( ok );
+}
+
+
+/****************************************************************
+**  find_diff
+**
+**  Calls a user-specified procedure for each element that
+**  occurs in the first list but not in the second.
+**
+**  IN  : list1, list2 = handles to two lists with elements of
+**                       the same type.
+**
+**        compare = a function which accepts pointers to two
+**                  elements e1, e2 and returns -1 if e1 "<" e2,
+**                  0 if e1 "=" e2, and +1 if e1 ">" e2.
+**
+**        call = a function to be called with e if e in list1 and
+**               not e in list2. If the function returns FALSE,
+**               find_diff returns immediately.
+**
+**  OUT : The function returns the result of the last call to
+**        "call".
+****************************************************************/
+
+BOOL find_diff
+       ( list1, list2, compare, call )
+LIST
+  list1;
+LIST
+  list2;
+#ifndef BSDUNIX
+int
+  (*compare) ( ELEMENT, ELEMENT );
+BOOL
+  (*call) ( ELEMENT );
+#else
+int
+  (*compare) ();
+BOOL
+  (*call) ();
+#endif
+{
+  LEAF
+    *l1, *l2;
+  int
+    i, j, res;
+  ELEMENT
+    e1, e2;
+  BOOL
+    ok;
+
+  assert ( list1 != NULL );
+  assert ( list2 != NULL );
+
+  first_pos ( list1, l1, i );
+  first_pos ( list2, l2, j );
+  ok = TRUE;
+  while ( ( l1 != NULL ) && ( l2 != NULL ) && ok ) {
+
+    /* Remember that lists are sorted in increasing order */
+    e1 = l1 -> elt [i];
+    e2 = l2 -> elt [j];
+    res = (*compare) ( e1, e2 );
+
+    if ( res < 0 ) {
+      /* e1 is smaller than e2, output e1 */
+      ok = (*call) ( e1 );
+      next_pos ( l1, i );
+    }
+    else if ( res > 0 ) {
+      /* e2 is smaller than e1 */
+      next_pos ( l2, j );
+    }
+    else {
+      /* both are equal */
+      next_pos ( l1, i );
+      next_pos ( l2, j );
+    }
+  }
+
+  /* Dump remainders of list1 */
+  while ( ( l1 != NULL ) && ok ) {
+    ok = (*call) ( l1 -> elt [i] );
+    next_pos ( l1, i );
+  }
+  return ( ok );
+}
+
+
+/****************************************************************
+**  seek_pos
+**
+**  Advances a leaf cursor to the first element which is greater
+**  or equal to a given element. The current and the next leaf
+**  are tried first; if the element lies further ahead, the leaf
+**  is found by descending from the root. Elements of list1 are
+**  thus searched in list2 in O(log n) instead of O(n) steps.
+**
+**  IN  : list       = list of the cursor.
+**        leaf, pos  = cursor, must not be at the end of the list.
+**        key, comp  = element to be searched and compare function.
+**
+**  OUT : The cursor points to the first element >= 'key', or to
+**        the end of the list. The function returns TRUE if the
+**        element found is equal to 'key'.
+****************************************************************/
+
+BOOL seek_pos
+       ( list, leaf, pos, key, comp )
+LIST
+  list;
+LEAF
+  **leaf;
+int
+  *pos;
+ELEMENT
+  key;
+#ifndef BSDUNIX
+int
+  (*comp) ( ELEMENT, ELEMENT );
+#else
+int
+  (*comp) ();
+#endif
+{
+  LEAF
+    *l;
+  char
+    *p;
+  int
+    h, res;
+
+  l = *leaf;
+  if ( (*comp) ( key, l -> elt [ l -> num - 1 ] ) > 0 ) {
+    l = l -> next;
+    if ( ( l != NULL ) &&
+         ( (*comp) ( key, l -> elt [ l -> num - 1 ] ) > 0 ) ) {
+      /* Far ahead: descend from the root */
+      p = list -> root;
+      for ( h = list -> height; h > 0; h -- ) {
+        p = ((NODE *) p) -> son [ node_search ( (NODE *) p, key, comp ) ];
+      }
+      l = (LEAF *) p;
+      if ( (*comp) ( key, l -> elt [ l -> num - 1 ] ) > 0 ) {
+        l = l -> next;
+      }
+    }
+  }
+
+  *leaf = l;
+  if ( l == NULL ) {
+    *pos = 0;
+    return ( FALSE );
+  }
+
+  res = leaf_search ( l, key, comp );
+  if ( res < 0 ) {
+    *pos = -res - 1;
+    return ( TRUE );
+  }
+  assert ( res < l -> num );
+  *pos = res;
+  return ( FALSE );
+}
+
+
+/****************************************************************
+**  find_union_gallop, find_diff_gallop
+**
+**  Same as find_union and find_diff, with the same arguments and
+**  callback contract. If one list is more than GALLOP_RATIO times
+**  longer than the other, the elements of the shorter list are
+**  searched in the longer one by seek_pos. Otherwise,
+**  find_union resp. find_diff are called.
+****************************************************************/
+
+BOOL find_union_gallop
+       ( list1, list2, compare, call )
+LIST
+  list1;
+LIST
+  list2;
+#ifndef BSDUNIX
+int
+  (*compare) ( ELEMENT, ELEMENT );
+BOOL
+  (*call) ( ELEMENT, ELEMENT );
+#else
+int
+  (*compare) ();
+BOOL
+  (*call) ();
+#endif
+{
+  LEAF
+    *l1, *l2;
+  int
+    i, j;
+  BOOL
+    ok;
+
+  assert ( list1 != NULL );
+  assert ( list2 != NULL );
+
+  first_pos ( list1, l1, i );
+  first_pos ( list2, l2, j );
+  ok = TRUE;
+
+  if ( list1 -> num / GALLOP_RATIO > list2 -> num ) {
+    /* Search elements of list2 in list1 */
+    while ( ( l1 != NULL ) && ( l2 != NULL ) && ok ) {
+      if ( seek_pos ( list1, &l1, &i, l2 -> elt [j], compare ) ) {
+        ok = (*call) ( l1 -> elt [i], l2 -> elt [j] );
+        next_pos ( l1, i );
+      }
+      next_pos ( l2, j );
+    }
+  }
+  else if ( list2 -> num / GALLOP_RATIO > list1 -> num ) {
+    /* Search elements of list1 in list2 */
+    while ( ( l1 != NULL ) && ( l2 != NULL ) && ok ) {
+      if ( seek_pos ( list2, &l2, &j, l1 -> elt [i], compare ) ) {
+        ok = (*call) ( l1 -> elt [i], l2 -> elt [j] );
+        next_pos ( l2, j );
+      }
+      next_pos ( l1, i );
+    }
+  }
+  else {
+    /* Sizes are similar, merging is cheaper */
+    ok = find_union ( list1, list2, compare, call );
+  }
+  return ( ok );
+}
+
+
+BOOL find_diff_gallop
+       ( list1, list2, compare, call )
+LIST
+  list1;
+LIST
+  list2;
+#ifndef BSDUNIX
+int
+  (*compare) ( ELEMENT, ELEMENT );
+BOOL
+  (*call) ( ELEMENT );
+#else
+int
+  (*compare) ();
+BOOL
+  (*call) ();
+#endif
+{
+  LEAF
+    *l1, *l2;
+  int
+    i, j;
+  BOOL
+    ok;
+
+  assert ( list1 != NULL );
+  assert ( list2 != NULL );
+
+  if ( list2 -> num / GALLOP_RATIO <= list1 -> num ) {
+    /* All elements of list1 must be visited anyway */
+    return ( find_diff ( list1, list2, compare, call ) );
+  }
+
+  /* Search elements of list1 in list2 */
+  first_pos ( list1, l1, i );
+  first_pos ( list2, l2, j );
+  ok = TRUE;
+  while ( ( l1 != NULL ) && ok ) {
+    if ( ( l2 == NULL ) ||
+         ! seek_pos ( list2, &l2, &j, l1 -> elt [i], compare ) ) {
+      ok = (*call) ( l1 -> elt [i] );
+    }
+    next_pos ( l1, i );
+  }
+  return ( ok );
+}
+
+
+/****************************************************************
+**  merge_lists
+**
+**  Calls a user-specified procedure for each element that occurs
+**  in either list. Elements occurring in both lists are passed
+**  only once (the element of list1).
+**
+**  IN  : list1, list2 = handles to two lists with elements of
+**                       the same type.
+**
+**        call = a function to be called with an element of either
+**               list. If the function returns FALSE,
+**               merge_lists returns immediately.
+**
+**        compare = a function which accepts pointers to two
+**                  elements e1, e2 and returns -1 if e1 "<" e2,
+**                  0 if e1 "=" e2, and +1 if e1 ">" e2.
+**
+**  OUT : The function returns the result of the last call to
+**        "call".
+****************************************************************/
+
+BOOL merge_lists
+       ( list1, list2, call, compare )
+LIST
+  list1;
+LIST
+  list2;
+#ifndef BSDUNIX
+BOOL
+  (*call) ( ELEMENT );
+int
+  (*compare) ( ELEMENT, ELEMENT );
+#else
+BOOL
+  (*call) ();
+int
+  (*compare) ();
+#endif
+{
+  LEAF
+    *l1, *l2;
+  int
+    i, j, res;
+  ELEMENT
+    e1, e2;
+  BOOL
+    ok;
+
+  assert ( list1 != NULL );
+  assert ( list2 != NULL );
+
+  first_pos ( list1, l1, i );
+  first_pos ( list2, l2, j );
+  ok = TRUE;
+  while ( ( l1 != NULL ) && ( l2 != NULL ) && ok ) {
+
+    /* Remember that lists are sorted in increasing order */
+    e1 = l1 -> elt [i];
+    e2 = l2 -> elt [j];
+    res = (*compare) ( e1, e2 );
+
+    if ( res < 0 ) {
+      /* e1 is smaller than e2 */
+      ok = (*call) ( e1 );
+      next_pos ( l1, i );
+    }
+    else if ( res > 0 ) {
+      /* e2 is smaller than e1 */
+      ok = (*call) ( e2 );
+      next_pos ( l2, j );
+    }
+    else {
+      /* both are equal */
+      ok = (*call) ( e1 );
+      next_pos ( l1, i );
+      next_pos ( l2, j );
+    }
+  }
+
+  /* Dump remainders of one list */
+  while ( ( l1 != NULL ) && ok ) {
+    ok = (*call) ( l1 -> elt [i] );
+    next_pos ( l1, i );
+  }
+  while ( ( l2 != NULL ) && ok ) {
+    ok = (*call) ( l2 -> elt [j] );
+    next_pos ( l2, j );
+  }
+  return ( ok );
+}
+
+
+/****************************************************************
+**  list_append_unsorted
+**
+**  Appends an element to a list without keeping the list in
+**  order. The elements are kept in a separate array until
+**  list_finalize or list_finalize_int is called.
+**
+**  IN  : list = handle to list created with create_list.
+**        elt  = pointer to new element. The pointer must have
+**               been obtained by a call to malloc or calloc!
+****************************************************************/
+
+void list_append_unsorted
+       ( list, elt )
+LIST
+  list;
+ELEMENT
+  elt;
+{
+  assert ( list != NULL );
+  assert ( elt != NULL );
+
+  if ( list -> npending >= list -> tpending ) {
+    list -> tpending = 2 * list -> tpending + LEAF_SIZE;
+    list -> pending = (ELEMENT *) realloc ( list -> pending,
+                        list -> tpending * sizeof ( ELEMENT ) );
+    assert ( list -> pending != NULL );
+  }
+  list -> pending [ list -> npending ++ ] = elt;
+}
+
+
+/****************************************************************
+**  insert_pending
+**
+**  Inserts the sorted, duplicate-free pending elements into the
+**  tree. Elements which are already in the tree are passed to
+**  'merge' and deallocated. If the tree is empty, the elements
+**  are appended at the right border, so that all leaves (except
+**  the last one) are filled completely.
+****************************************************************/
+
+void insert_pending
+       ( list, comp, merge )
+LIST
+  list;
+#ifndef BSDUNIX
+int
+  (*comp) ( ELEMENT, ELEMENT );
+void
+  (*merge) ( ELEMENT, ELEMENT );
+#else
+int
+  (*comp) ();
+void
+  (*merge) ();
+#endif
+{
+  int
+    i;
+  ELEMENT
+    elt, old;
+  BOOL
+    empty;
+
+  empty = ( list -> num == 0 );
+  for ( i = 0; i < list -> npending; i ++ ) {
+    elt = list -> pending [i];
+    old = empty ? NULL : tree_add ( list, elt, comp, FALSE );
+    if ( old != NULL ) {
+      if ( merge != NULL ) (*merge) ( old, elt );
+      if ( list -> arena == NULL ) free ( elt );
+    }
+    else {
+      elt = tree_add ( list, elt, comp, TRUE );
+      assert ( elt != NULL );
+    }
+  }
+
+  free ( list -> pending );
+  list -> pending = NULL;
+  list -> npending = list -> tpending = 0;
+}
+
+
+/****************************************************************
+**  list_finalize
+**
+**  Sorts the elements added by list_append_unsorted, removes
+**  duplicates and inserts them into the tree. The result is the
+**  same as if all elements had been inserted with add_list in
+**  the order in which they were appended.
+**
+**  IN  : list  = handle to list.
+**        comp  = compare function (see add_list).
+**        merge = function called as merge ( kept, duplicate )
+**                for each duplicate before it is deallocated
+**                (may be NULL).
+****************************************************************/
+
+void list_finalize
+       ( list, comp, merge )
+LIST
+  list;
+#ifndef BSDUNIX
+int
+  (*comp) ( ELEMENT, ELEMENT );
+void
+  (*merge) ( ELEMENT, ELEMENT );
+#else
+int
+  (*comp) ();
+void
+  (*merge) ();
+#endif
+{
+  assert ( list != NULL );
+
+  sort_elements ( list -> pending, list -> npending, comp );
+  list -> npending = unique_elements ( list -> pending, list -> npending,
+                                       comp, NULL, merge,
+                                       list -> arena == NULL );
+  insert_pending ( list, comp, merge );
+}
+
+
+/****************************************************************
+**  list_finalize_int
+**
+**  Same as list_finalize for lists which are ordered by an
+**  integer key. The pending elements are sorted by a radix sort.
+**
+**  IN  : list  = handle to list.
+**        key   = function returning the key of an element. The
+**                compare function used with this list must
+**                order elements by increasing keys.
+**        merge = see list_finalize.
+****************************************************************/
+
+int comp_glob_key
+      ( e1, e2 )
+ELEMENT
+  e1;
+ELEMENT
+  e2;
+{
+  int
+    k1, k2;
+
+  k1 = (*glob_key) ( e1 );
+  k2 = (*glob_key) ( e2 );
+  return ( ( k1 < k2 ) ? -1 : ( k1 > k2 ) );
+}
+
+
+void list_finalize_int
+       ( list, key, merge )
+LIST
+  list;
+#ifndef BSDUNIX
+int
+  (*key) ( ELEMENT );
+void
+  (*merge) ( ELEMENT, ELEMENT );
+#else
+int
+  (*key) ();
+void
+  (*merge) ();
+#endif
+{
+  assert ( list != NULL );
+
+  radix_elements ( list -> pending, list -> npending, key );
+  list -> npending = unique_elements ( list -> pending, list -> npending,
+                                       NULL, key, merge,
+                                       list -> arena == NULL );
+  glob_key = key;
+  insert_pending ( list, comp_glob_key, merge );
+}
+
+
+/****************************************************************
+**  list_set_arena
+**
+**  Declares that the elements of a list are allocated in an
+**  arena. The list will not free() its elements any more.
+**
+**  IN  : list  = handle to list.
+**        arena = arena of the elements (see util.h).
+****************************************************************/
+
+void list_set_arena
+       ( list, arena )
+LIST
+  list;
+ARENA
+  arena;
+{
+  assert ( list != NULL );
+  list -> arena = arena;
+}
+
+
+/****************************************************************
+**  destroy_list_arena
+**
+**  Destroys a list together with the arena of its elements. All
+**  elements are freed at once. The arena must not be used by
+**  other lists.
+**
+**  IN  : list = pointer to handle of list to be destroyed.
+**  OUT : '*list' is set to NULL.
+****************************************************************/
+
+void destroy_list_arena
+       ( list )
+LIST
+  *list;
+{
+  ARENA
+    arena;
+
+  if ( *list == NULL ) return;
+  arena = (*list) -> arena;
+  assert ( arena != NULL );
+  destroy_list ( list );
+  destroy_arena ( &arena );
+}
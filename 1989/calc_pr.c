@@ -63,8 +63,7 @@
 #include "boolean.h"
 #include "list.h"
 #include "util.h"
-
-#define LINE_LENGTH	100
+#include "reader.h"
 
 
 typedef
@@ -125,8 +124,8 @@ FILE
 ****************************************************************/  
 
 #ifndef BSDUNIX
-void load_rsv ( FILE * );
-void load_relevant ( FILE * );
+void load_rsv ( READER );
+void load_relevant ( READER );
 int comp_doc ( ELEMENT, ELEMENT );
 int comp_query ( ELEMENT, ELEMENT );
 int comp_relevant ( ELEMENT, ELEMENT );
@@ -182,12 +181,10 @@ ELEMENT
 
 
 void load_relevant
-       ( f )
-FILE
-  *f;
+       ( r )
+READER
+  r;
 {
-  char
-    line [ LINE_LENGTH ];
   int
     n, res;
   QUERY_STRUCT
@@ -199,39 +196,36 @@ FILE
   queries = create_list ();
   assert ( queries != NULL );
 
-  /* Read file one line at a time */
-  while ( fgets ( line, LINE_LENGTH, f ) ) {
-    
-    /* Line contains number, optionally followed by colon */
-    res = sscanf ( line, " %d", &n );
-    assert ( res == 1 );
+  /* Read one query record at a time */
+  while ( next_record ( r, &n ) ) {
     
-    /* If number followed by a colon, then this is a query index;
-       create new list entry for this query */
-    if ( strchr ( line, ':' ) != NULL ) {
-      if ( n >= 0 ) {
-        /* Query numbers must be made negative */
-        n = -n;
-      }
-      q = (QUERY_STRUCT *) malloc ( sizeof ( QUERY_STRUCT ) );
-      assert ( q != NULL );
-      q -> index = n;
-      q -> relevant = NULL;
-      q -> handled = FALSE;
-      q = (QUERY_STRUCT *) add_list ( queries, (ELEMENT) q, comp_query );
-      assert ( q != NULL );
-      if ( q -> relevant == NULL ) {
-        /* Make new list of relevant documents for this query */
-        q -> relevant = create_list ();
-        assert ( q -> relevant != NULL );
-      }
-      curr_query = q;
-
-      /* Running count */
-      fprintf ( counter, "%d\r", n );
+    /* Record header is the query index; create new list entry for
+       this query */
+    if ( n >= 0 ) {
+      /* Query numbers must be made negative */
+      n = -n;
+    }
+    q = (QUERY_STRUCT *) malloc ( sizeof ( QUERY_STRUCT ) );
+    assert ( q != NULL );
+    q -> index = n;
+    q -> relevant = NULL;
+    q -> handled = FALSE;
+    q = (QUERY_STRUCT *) add_list ( queries, (ELEMENT) q, comp_query );
+    assert ( q != NULL );
+    if ( q -> relevant == NULL ) {
+      /* Make new list of relevant documents for this query */
+      q -> relevant = create_list ();
+      assert ( q -> relevant != NULL );
     }
-    else {
-      /* document relevant to 'curr_query' */
+    curr_query = q;
+
+    /* Running count */
+    fprintf ( counter, "%d\r", n );
+
+    /* Record entries are documents relevant to 'curr_query' */
+    while ( next_entry ( r ) ) {
+      res = get_int ( r, &n );
+      assert ( res );
       d = (RLV_STRUCT *) malloc ( sizeof ( RLV_STRUCT ) );
       assert ( d != NULL );
       d -> reldoc = n;
@@ -285,12 +279,10 @@ ELEMENT
 
 
 void load_rsv
-       ( f )
-FILE
-  *f;
+       ( r )
+READER
+  r;
 {
-  char
-    line [ LINE_LENGTH ];
   int
     i, query, curr_query,
     doc, res;
@@ -308,11 +300,12 @@ FILE
   doc_list = NULL;
   q = NULL;
 
-  while ( fgets ( line, LINE_LENGTH, f ) ) {
+  while ( read_line ( r ) ) {
   
     /* We expect 3 arguments: query, document, rsv */
-    res = sscanf ( line, " %d %d %f", &query, &doc, &rsv );
-    assert ( res == 3 );
+    res = get_int ( r, &query ) && get_int ( r, &doc ) && 
+          get_float ( r, &rsv );
+    assert ( res );
     
     /* find query index in 'queries'; queries are assumed to be
        grouped!*/
@@ -539,8 +532,8 @@ int
 char
   *argv [];
 {
-  FILE
-    *f;
+  READER
+    r;
   int
     i;
   double
@@ -567,10 +560,10 @@ char
   }
   
   /* Load list of relevant documents */
-  f = open_file ( argv [1] );
+  r = open_reader ( argv [1] );
   fprintf ( stderr, "Loading relevant documents.\n" );
-  load_relevant ( f );
-  fclose ( f );
+  load_relevant ( r );
+  close_reader ( &r );
   
   /* Initialize precision/recall graph to trace values in 0.05 increments */
   num_queries = 0;
@@ -580,10 +573,10 @@ char
   }
 
   /* Produce RSV ranking */
-  f = open_file ( argv [2] );
+  r = open_reader ( argv [2] );
   fprintf ( stderr, "Loading RSV values.\n" );
-  load_rsv ( f );
-  fclose ( f );
+  load_rsv ( r );
+  close_reader ( &r );
   
   /* Normalize histogram */
   printf ( "-------\nGlobal average for %d queries\n-------\n", num_queries );
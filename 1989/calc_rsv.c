@@ -15,7 +15,8 @@
 *
 *   Call Format
 *   -----------
-*	calc_rsv <doc-descr> <concepts> <atom-wgts>
+*	calc_rsv <doc-descr> <concepts> <atom-wgts> [--top-k <k>] [--dense]
+*		 [--update <rsv> <new-wgts>] [QUIET]
 *
 *   where <doc-descr> is the file containing the weights of each
 *   sign in each document, <concepts> is the list of the atomic
@@ -24,6 +25,42 @@
 *   is initialized with the IDF of each atom before the first
 *   optimization step.
 *
+*   The document descriptions are inverted into an atom index
+*   (see invert.h). For each query, the postings of its atomic
+*   concepts are added into an accumulator per document, so only
+*   the documents which share a concept with the query are ever
+*   looked at.
+*
+*   With --top-k, only the k highest RSV values of each query are
+*   written (ties are broken by the lower document index). They
+*   are the same lines which the full calculation writes for
+*   these documents. The documents are found with the MaxScore
+*   method: each concept has an upper bound of its contribution
+*   to an RSV value, and the postings of concepts whose bounds
+*   together cannot reach the k-th best value found so far are
+*   only searched (with skip entries) for the documents of the
+*   other concepts.
+*
+*   With --dense, the concepts of each document are stored as a
+*   vector, and each query is compared with every document by a
+*   scoring kernel (see rsvkern.h). This is faster if queries
+*   and documents share most of their concepts. The output is
+*   the same.
+*
+*   With --update, <rsv> is the output of a previous run with the
+*   weights <atom-wgts>, and <new-wgts> gives new weights of some
+*   atomic concepts (in the format of <atom-wgts>; the output of
+*   optimize can be used directly). Only the RSV values of the
+*   query/document pairs which share a concept whose weight has
+*   changed are calculated again; all other lines are copied from
+*   <rsv>. The output is the same as that of a full run with the
+*   new weights.
+*
+*   If compiled with THREADS, the queries are distributed over
+*   several threads (see 'thread_count'); queries with many
+*   postings are divided into ranges of documents. The output is
+*   the same as that of the sequential version.
+*
 *****************************************************************
 *
 *   COPYRIGHT (C) 1989, 2016 BY GUIDO HOSS.
@@ -50,7 +87,7 @@
 ****************************************************************/   
 
 #define PROG	"RSV Calculation (gh, 05/05/89)\n"
-#define USAGE	"calc_rsv <doc-descr> <concepts> <atom-wgts> [QUIET]\n"
+#define USAGE	"calc_rsv <doc-descr> <concepts> <atom-wgts> [--top-k <k>] [--dense]\n\t[--update <rsv> <new-wgts>] [QUIET]\n"
 
 #ifdef MSDOS
 #include <process.h>
@@ -60,46 +97,156 @@
 #include <assert.h>
 #include <malloc.h>
 #include <string.h>
+#include <stdlib.h>
+#ifdef THREADS
+#include <pthread.h>
+#endif
 
 #include "boolean.h"
 #include "list.h"
+#include "intlist.h"
 #include "util.h"
+#include "reader.h"
+#include "descr.h"
+#include "atomidx.h"
+#include "invert.h"
+#include "rsvkern.h"
+
+/* Relative error allowed for the sums of upper bounds, which are not
+   added in the same order as the RSV values */
+#define BOUND_SLACK	1e-9
 
-#define LINE_LENGTH	100
+#define BLOCK_POSTINGS	65536	/* Postings per unit of a divided query */
+#define MAX_LINE	400	/* Longest line of output */
 
 
 typedef
   struct {
-    int  sign;   /* number of this sign */
-    LIST atoms;  /* atomic concepts which belong to this sign */
+    int     sign;   /* number of this sign */
+    INTLIST atoms;  /* atomic concepts which belong to this sign,
+		       as positions in 'atoms' */
   } SIGN_STRUCT;
   
 typedef
   struct {
-    int  index;       /* number of this document */
-    LIST docatoms;    /* list of atoms occuring in the document */
+    int           index;     /* number of this query */
+    INTFLOAT_LIST docatoms;  /* atoms occuring in the query (positions
+				in 'atoms') and their weights */
   } DOC_STRUCT;
-  
+
+/* A concept of the query being processed in top-k mode */
+typedef
+  struct {
+    int      atom;    /* position of the concept in 'atoms' */
+    double   wgt;     /* weight of the concept in the query */
+    double   bound;   /* upper bound of its contribution to an RSV */
+    double   value;   /* contribution to the RSV of the current doc */
+    BOOL     found;   /* TRUE if the current document has the concept */
+    BOOL     done;    /* TRUE if all postings have been read */
+    POSTINGS p;       /* postings of the concept */
+  } TERM_STRUCT;
+
+/* An entry of the top-k heap */
+typedef
+  struct {
+    int      doc;
+    double   rsv;
+  } TOP_STRUCT;
+
+/* The work is divided into units, each covering the documents
+   lo .. hi - 1 of a query. The output of a unit is collected in a
+   buffer, which is written when all previous units have been
+   written. */
 typedef
   struct {
-    int    atom;        /* number of an atomic concept */
-    double weight;	/* atomic concept's weight */
-  } ATOM_STRUCT;
+    DOC_STRUCT	*query;
+    int		lo, hi;		/* Range of documents */
+    char	*out;		/* Output of unit */
+    unsigned	outlen;		/* Bytes used in 'out' */
+    unsigned	outsize;	/* Size of 'out' */
+    BOOL	done;		/* TRUE if unit has been calculated */
+  } UNIT;
+
+/* Work space of a thread */
+typedef
+  struct {
+    double	*score;		/* RSV accumulator of each document */
+    char	*scored;	/* TRUE if score [d] is in use */
+    INTLIST	hits;		/* documents with an accumulator */
+    TOP_STRUCT	*top;		/* heap of the best RSV values (top-k
+				   mode), worst value first */
+    int		num_top;	/* number of entries in 'top' */
+    double	*qw;		/* weight of each concept in the query
+				   (dense mode) */
+  } SCORER;
   
 
 LIST
-  glob_list,   /* global list used by 'calc_rsv' */
-  doc_list,    /* all documents which occur in the EVAL_PREF file */
-  atom_list,   /* all atomic concepts and their matrix indices */
+  query_list,  /* all queries of the document descriptions */
   sign_list;   /* signs used in documents */
 
-/* Global variables used for RSV calculation */
+INTLIST
+  atoms;       /* all atomic concepts */
+
+INTFLOAT_LIST
+  glob_list;   /* global list used by 'make_docatoms' */
+
+ATOM_INDEX
+  atom_index;  /* documents of each atomic concept */
+
+double
+  *atom_wgt,   /* weight of each atomic concept, by position */
+  *max_wgt,    /* highest and lowest weight of each atomic concept */
+  *min_wgt,    /* in a document, by position (top-k mode) */
+  glob_wgt;
+
+int
+  num_docs,    /* highest document index + 1 */
+  top_k;       /* number of RSV values per query, 0 = all */
+
+/* Concept vectors of the documents (dense mode): the concepts of
+   document d are doc_atom [i], with weights doc_wgt [i], for
+   doc_first [d] <= i < doc_first [d+1] */
+BOOL
+  dense;       /* TRUE in dense mode */
+int
+  *doc_first,
+  *doc_atom;
 double
-  glob_wgt,
-  glob_rsv;
+  *doc_wgt;
+RSV_KERNEL
+  kernel;      /* scoring kernel of dense mode */
+
+/* Previous RSV file (update mode): line i starts at old_text
+   [ old_line [i] ] and gives the RSV of query old_query [i] and
+   document old_doc [i]; old_line [ num_lines ] is the end of the
+   text */
+BOOL
+  update;      /* TRUE in update mode */
+char
+  *old_text,
+  *changed;    /* TRUE if the weight of a concept has changed */
+int
+  *old_line,
+  *old_query,
+  *old_doc,
+  num_lines;
+
+UNIT
+  *unit;       /* units of work in order of output */
+int
+  num_units,
+  glob_threads;  /* number of threads, used by 'count_units' */
+
+#ifdef THREADS
+pthread_mutex_t
+  unit_lock = PTHREAD_MUTEX_INITIALIZER;
+pthread_cond_t
+  unit_cond = PTHREAD_COND_INITIALIZER;
+int
+  next_unit;   /* Next unit to be calculated */
+#endif
 
-DOC_STRUCT
-  *glob_query;
 FILE
   *counter;	/* Virtual file used to output running counts */
 
@@ -110,30 +257,64 @@ FILE
 
 #ifndef BSDUNIX
 int main ( int, char * [] );  
-double calc_rsv ( DOC_STRUCT *, DOC_STRUCT * );
 int comp_doc ( ELEMENT, ELEMENT );
 int comp_sign ( ELEMENT, ELEMENT );
-int comp_atom ( ELEMENT, ELEMENT );
-void process_documents ( FILE * );
-void process_concepts ( FILE * );
-void load_weights ( FILE * );
-BOOL make_docatoms ( ELEMENT );
-BOOL enum_query ( ELEMENT );
-BOOL enum_doc ( ELEMENT );
-BOOL union_proc ( ELEMENT, ELEMENT );
+void merge_signs ( ELEMENT, ELEMENT );
+BOOL finish_sign ( ELEMENT );
+INTLIST sign_concepts ( int );
+void process_queries ( DESCR );
+void process_concepts ( READER );
+void load_weights ( READER, BOOL );
+void make_docatoms ( INTLIST );
+SCORER *create_scorer ( void );
+void print_rsv ( UNIT *, SCORER * );
+void score_unit ( UNIT *, SCORER * );
+void find_bounds ( void );
+BOOL worse_top ( TOP_STRUCT *, TOP_STRUCT * );
+void add_top ( SCORER *, int, double );
+void topk_unit ( UNIT *, SCORER * );
+void make_vectors ( void );
+void dense_unit ( UNIT *, SCORER * );
+void load_rsv ( char * );
+int find_line ( int, int );
+void update_unit ( UNIT *, SCORER * );
+BOOL count_units ( ELEMENT );
+void make_units ( int );
+void run_unit ( UNIT *, SCORER * );
+void calc_units ( int );
+#ifdef THREADS
+void *rsv_worker ( void * );
+#endif
 #else
 int main ();  
-double calc_rsv ();
 int comp_doc ();
 int comp_sign ();
-int comp_atom ();
-void process_documents ();
+void merge_signs ();
+BOOL finish_sign ();
+INTLIST sign_concepts ();
+void process_queries ();
 void process_concepts ();
 void load_weights ();
-BOOL make_docatoms ();
-BOOL enum_query ();
-BOOL enum_doc ();
-BOOL union_proc ();
+void make_docatoms ();
+SCORER *create_scorer ();
+void print_rsv ();
+void score_unit ();
+void find_bounds ();
+BOOL worse_top ();
+void add_top ();
+void topk_unit ();
+void make_vectors ();
+void dense_unit ();
+void load_rsv ();
+int find_line ();
+void update_unit ();
+BOOL count_units ();
+void make_units ();
+void run_unit ();
+void calc_units ();
+#ifdef THREADS
+void *rsv_worker ();
+#endif
 #endif
 
 
@@ -147,7 +328,10 @@ BOOL union_proc ();
 **  sign weights for this document are read. Otherwise, the
 **  document and its signs are ignored.
 **
-**  IN  : f = handle to the open DOCU_DESC file.
+**  IN  : r = reader of the DOCU_DESC file.
+**
+**  OUT : 'atoms' holds all concepts; in the lists of the signs,
+**        each concept is replaced by its position in 'atoms'.
 ****************************************************************/ 
 
 int comp_sign
@@ -161,180 +345,203 @@ ELEMENT
 }
 
 
-int comp_atom
-      ( s1, s2 )
+/* Signs normally occur only once in the CONCEPTS file. If a sign
+   occurs again, its atoms are copied to the first entry. */
+
+void merge_signs
+       ( s1, s2 )
 ELEMENT
   s1;
 ELEMENT
   s2;
 {
-  return ( ((ATOM_STRUCT *) s1) -> atom - ((ATOM_STRUCT *) s2) -> atom );
+  INTLIST
+    atoms;
+  int
+    i;
+
+  atoms = ((SIGN_STRUCT *) s2) -> atoms;
+  for ( i = 0; i < count_intlist ( atoms ); i ++ ) {
+    add_intlist ( ((SIGN_STRUCT *) s1) -> atoms, intlist_key ( atoms, i ) );
+  }
+  destroy_intlist ( &((SIGN_STRUCT *) s2) -> atoms );
+}
+
+
+BOOL finish_sign
+       ( s )
+ELEMENT
+  s;
+{
+  INTLIST
+    l;
+  int
+    i;
+
+  l = ((SIGN_STRUCT *) s) -> atoms;
+  for ( i = 0; i < count_intlist ( l ); i ++ ) {
+    intlist_key ( l, i ) = lookup_intlist ( atoms, intlist_key ( l, i ) );
+  }
+  return ( TRUE );
+}
+
+
+INTLIST sign_concepts
+          ( sign )
+int
+  sign;
+{
+  SIGN_STRUCT
+    t, *sgn;
+
+  /* Every sign of a document must be in the CONCEPTS file */
+  t.sign = sign;
+  sgn = (SIGN_STRUCT *) lookup_list ( sign_list, (ELEMENT) &t, comp_sign );
+  assert ( sgn != NULL );
+  return ( sgn -> atoms );
 }
 
 
 void process_concepts
-       ( f )
-FILE 
-  *f;
+       ( r )
+READER
+  r;
 {
-  char
-    line [ LINE_LENGTH ];
   SIGN_STRUCT
     *sgn;
-  LIST
+  INTLIST
     list;
   int
     d, n;
-  ATOM_STRUCT
-    *atm, *atm2;
 
   /* Create list of ALL atomic concepts */
-  atom_list = create_list ();
+  atoms = create_intlist ( 0 );
   sign_list = create_list ();
-  
-  assert ( atom_list != NULL );
   assert ( sign_list != NULL );
+  list_set_arena ( sign_list, main_arena () );
 
-  /* Read file line by line */
-  while ( fgets ( line, LINE_LENGTH, f ) ) {
+  /* Read one sign record at a time */
+  while ( next_record ( r, &d ) ) {
   
-    /* Read a number */
-    n = sscanf ( line, " %d", &d );
-    assert ( n == 1 );
-    
-    /* If number followed by a colon, then this is a sign index */
-    if ( strchr ( line, ':' ) != NULL ) {
-      /* Add sign entry to sign_list */
-      sgn = (SIGN_STRUCT *) malloc ( sizeof ( SIGN_STRUCT ) );
-      assert ( sgn != NULL );
-      sgn -> sign = d;
-      sgn -> atoms = NULL;
-      sgn = (SIGN_STRUCT *) add_list ( sign_list, (ELEMENT) sgn, comp_sign );
-      assert ( sgn != NULL );
-      if ( sgn -> atoms == NULL ) {
-        sgn -> atoms = create_list ();
-        assert ( sgn -> atoms != NULL );
-      }
-      list = sgn -> atoms;
+    /* Add sign entry to sign_list */
+    sgn = (SIGN_STRUCT *) arena_alloc ( main_arena (), sizeof ( SIGN_STRUCT ) );
+    sgn -> sign = d;
+    sgn -> atoms = create_intlist ( 0 );
+    list_append_unsorted ( sign_list, (ELEMENT) sgn );
+    list = sgn -> atoms;
       
-      /* running count */
-      fprintf ( counter, "%d\r", d );
-    }
+    /* running count */
+    fprintf ( counter, "%d\r", d );
     
-    else {
-      /* no colon -> this is an atomic concept; add atom to atom_list,
+    while ( next_entry ( r ) ) {
+      /* Each entry is an atomic concept; add atom to 'atoms',
          which contains ALL atomic concepts */
-      atm = (ATOM_STRUCT *) malloc ( sizeof ( ATOM_STRUCT ) );
-      assert ( atm != NULL );
-      atm -> atom = d;
-      atm -> weight = -999.9;  /* error value */
-      atm = (ATOM_STRUCT *) add_list ( atom_list, (ELEMENT) atm, comp_atom );
-      assert ( atm != NULL );
+      n = get_int ( r, &d );
+      assert ( n );
+      append_intlist ( atoms, d );
 
       /* Add atomic concept to concept list of current sign */
-      atm2 = (ATOM_STRUCT *) malloc ( sizeof ( ATOM_STRUCT ) );
-      assert ( atm2 != NULL );
-      atm2 -> atom = d;
-      atm2 = (ATOM_STRUCT *) add_list ( list, (ELEMENT) atm2, comp_atom );
+      append_intlist ( list, d );
     }
+
+    /* Sort atoms of sign */
+    finalize_intlist ( list );
   }
   
+  /* Sort all lists; the CONCEPTS file is ordered by signs, so only
+     'atoms' really needs to be sorted */
+  list_finalize ( sign_list, comp_sign, merge_signs );
+  finalize_intlist ( atoms );
+  enum_list ( sign_list, finish_sign, ENUM_FORWARD );
+
+  /* Atomic concepts without a weight get an error value */
+  atom_wgt = (double *) malloc ( ( count_intlist ( atoms ) + 1 ) * 
+                                 sizeof ( double ) );
+  assert ( atom_wgt != NULL );
+  for ( n = 0; n < count_intlist ( atoms ); n ++ ) {
+    atom_wgt [n] = -999.9;
+  }
+
   fprintf ( counter, "\n" );
 }
 
 
 /****************************************************************
-**  process_documents
+**  process_queries
 **
-**  Looks at each document description in the DOCU-DESC file;
-**  if the document occurs in a preference relation, then the
-**  sign weights for this document are read. Otherwise, the
-**  document and its signs are ignored.
+**  Looks at each document description in the DOCU-DESC file
+**  and collects the atomic concepts of each query with their
+**  weights. The weight of a concept is the sum of the weights
+**  of its signs.
+**
+**  IN  : d = document descriptions (DOCU_DESC file).
 **
-**  IN  : f = handle to the open DOCU_DESC file.
+**  OUT : 'query_list' holds the queries, 'num_docs' is set.
 ****************************************************************/ 
 
-BOOL make_docatoms
-       ( e )
-ELEMENT 
-  e;
+void make_docatoms
+       ( atoms )
+INTLIST 
+  atoms;
 {
-  ATOM_STRUCT
-    *a;
-
-  /* duplicate atom and add to 'glob_list' */
-  a = (ATOM_STRUCT *) malloc ( sizeof ( ATOM_STRUCT ) );
-  assert ( a != NULL );
-  a -> atom = ((ATOM_STRUCT *) e) -> atom;
-  a -> weight = 0.0;
-  a = (ATOM_STRUCT *) add_list ( glob_list, (ELEMENT) a, comp_atom );
-  assert ( a != NULL );
+  int
+    i, pos;
+
+  for ( i = 0; i < count_intlist ( atoms ); i ++ ) {
+    /* add atom to 'glob_list' */
+    pos = add_iflist ( glob_list, intlist_key ( atoms, i ), 0.0 );
   
-  /* atom might already have been entered previously, so ADD weight */
-  a -> weight += glob_wgt;
-  return ( TRUE );
+    /* atom might already have been entered previously, so ADD weight */
+    iflist_val ( glob_list, pos ) += glob_wgt;
+  }
 }
 
 
-void process_documents
-       ( f )
-FILE 
-  *f;
+void process_queries
+       ( d )
+DESCR
+  d;
 {
-  char
-    line [ LINE_LENGTH ];
-  SIGN_STRUCT
-    t, *sgn;
   DOC_STRUCT
     *doc;
-  double
-    w;
-  float 
-    w1;
+  DESCR_WGT
+    *w;
   int
-    d, n;
+    i, j;
 
-  /* Create document list */
-  doc_list = create_list ();
-  assert ( doc_list != NULL );
+  /* Create query list */
+  query_list = create_list ();
+  assert ( query_list != NULL );
+  list_set_arena ( query_list, main_arena () );
+  num_docs = 0;
 
-  /* Read file line by line */
-  while ( fgets ( line, LINE_LENGTH, f ) ) {
-  
-    /* Interpret as much fields as possible */
-    n = sscanf ( line, " %d %f", &d, &w1 );
-    w = (double) w1;
-    switch ( n ) {
-      
-      case 1 :
-        /* One field -> new document number; update running count */
-        fprintf ( counter, "%d\r", d );
-        
-        doc = (DOC_STRUCT *) malloc ( sizeof ( DOC_STRUCT ) );
-        assert ( doc != NULL );
-        doc -> index = d;
-        doc -> docatoms = NULL;
-        doc = (DOC_STRUCT *) add_list ( doc_list, (ELEMENT) doc, comp_doc );
-        assert ( doc != NULL );
-        assert ( doc -> docatoms == NULL );
-        doc -> docatoms = create_list ();
-        glob_list = doc -> docatoms;
-        assert ( glob_list != NULL );
-        break;
-        
-      case 2 :
-        /* Two fields -> sign index and weight; add all atoms of sign 
-           to list of doc. */
-           
-        /* Find sign in sign_list */
-        t.sign = d;
-        sgn = (SIGN_STRUCT *) lookup_list ( sign_list, (ELEMENT) &t, comp_sign );
-        assert ( sgn != NULL );
+  /* Look at one document at a time */
+  for ( i = 0; i < descr_docs ( d ); i ++ ) {
+    if ( descr_index ( d, i ) >= 0 ) {
+      /* Documents are only counted */
+      if ( descr_index ( d, i ) >= num_docs ) {
+        num_docs = descr_index ( d, i ) + 1;
+      }
+      continue;
+    }
+
+    /* Update running count */
+    fprintf ( counter, "%d\r", descr_index ( d, i ) );
         
-        /* Add atoms of sign to 'glob_list' */
-        glob_wgt = w;
-        enum_list ( sgn -> atoms, make_docatoms, ENUM_FORWARD );
-        break;
+    doc = (DOC_STRUCT *) arena_alloc ( main_arena (), sizeof ( DOC_STRUCT ) );
+    doc -> index = descr_index ( d, i );
+    doc -> docatoms = NULL;
+    doc = (DOC_STRUCT *) add_list ( query_list, (ELEMENT) doc, comp_doc );
+    assert ( doc != NULL );
+    assert ( doc -> docatoms == NULL );
+    doc -> docatoms = create_iflist ( 0 );
+    glob_list = doc -> docatoms;
+
+    /* Add all atoms of each sign of the query to list of query */
+    w = descr_wgts ( d, i );
+    for ( j = 0; j < descr_count ( d, i ); j ++ ) {
+      glob_wgt = (double) w [j].weight;
+      make_docatoms ( sign_concepts ( w [j].sign ) );
     }
   }
   
@@ -354,144 +561,949 @@ ELEMENT
 
 
 /****************************************************************
-**  calc_rsv
+**  create_scorer
 **
-**  IN  : 
+**  Allocates the work space of a thread.
 **
-**  OUT : The vector v is filled with the appropriate values.
+**  OUT : Function returns the new work space.
 ****************************************************************/
 
-BOOL union_proc
-       ( a1, a2 )
-ELEMENT
-  a1;
-ELEMENT
-  a2;
+SCORER *create_scorer
+          ( )
 {
-  ATOM_STRUCT
-    *atm, *at1, *at2;
-  
-  at1 = (ATOM_STRUCT *) a1;
-  at2 = (ATOM_STRUCT *) a2;
-  assert ( at1 -> atom == at2 -> atom );
-  
-  /* For each atom which occurs in both query and document: find weight */
-  atm = (ATOM_STRUCT *) lookup_list ( atom_list, a1, comp_atom );
-  assert ( atm != NULL );
-  
-  /* Multiply weights with weight of atomic concept */
-  glob_rsv += ( at1 -> weight * at2 -> weight * atm -> weight );
-  return ( TRUE );
+  SCORER
+    *s;
+
+  s = (SCORER *) malloc ( sizeof ( SCORER ) );
+  assert ( s != NULL );
+  s -> score = (double *) malloc ( ( num_docs + 1 ) * sizeof ( double ) );
+  s -> scored = (char *) calloc ( num_docs + 1, sizeof ( char ) );
+  assert ( ( s -> score != NULL ) && ( s -> scored != NULL ) );
+  s -> hits = create_intlist ( 0 );
+  s -> top = NULL;
+  if ( top_k > 0 ) {
+    s -> top = (TOP_STRUCT *) malloc ( top_k * sizeof ( TOP_STRUCT ) );
+    assert ( s -> top != NULL );
+  }
+  s -> num_top = 0;
+  s -> qw = NULL;
+  if ( dense || update ) {
+    s -> qw = (double *) calloc ( count_intlist ( atoms ) + 1, sizeof ( double ) );
+    assert ( s -> qw != NULL );
+  }
+  return ( s );
 }
 
 
-double calc_rsv
-       ( q, d )
-DOC_STRUCT
-  *q, *d;
+/****************************************************************
+**  score_unit
+**
+**  Calculates the RSV values of a query with a range of
+**  documents. The RSV of query q and document d is the sum of
+**  w(q,a) * w(d,a) * w(a) over all atoms a they share. The
+**  atoms of the query are visited in increasing order, so each
+**  sum is formed in the same order as by a merge of the concept
+**  lists of q and d.
+**
+**  IN  : u = unit of work.
+**        s = work space of the calling thread.
+**
+**  OUT : Nonzero RSV values are written to the output of u,
+**        ordered by document.
+****************************************************************/
+
+void print_rsv
+       ( u, s )
+UNIT
+  *u;
+SCORER
+  *s;
 {
-  glob_rsv = 0.0;
-  find_union ( q -> docatoms, d -> docatoms, comp_atom, union_proc );
-  return ( glob_rsv );
+  int
+    i, doc;
+
+  /* Print RSV values of 'hits' in order of documents */
+  finalize_intlist ( s -> hits );
+  for ( i = 0; i < count_intlist ( s -> hits ); i ++ ) {
+    doc = intlist_key ( s -> hits, i );
+    if ( s -> score [ doc ] > 0.0 ) {
+      /* don't print zero rsv values */
+      reserve ( &u -> out, &u -> outsize, u -> outlen + MAX_LINE );
+      u -> outlen += sprintf ( u -> out + u -> outlen, "%d\t%d\t%f\n", 
+                               u -> query -> index, doc, s -> score [ doc ] );
+    }
+    s -> scored [ doc ] = FALSE;
+  }
+}
+
+
+void score_unit
+       ( u, s )
+UNIT
+  *u;
+SCORER
+  *s;
+{
+  INTFLOAT_LIST
+    l;
+  POSTINGS
+    p;
+  double
+    w, aw;
+  int
+    i, a, doc;
+
+  l = u -> query -> docatoms;
+  clear_intlist ( s -> hits );
+
+  for ( i = 0; i < count_iflist ( l ); i ++ ) {
+    a = iflist_key ( l, i );
+    w = iflist_val ( l, i );
+    aw = atom_wgt [a];
+
+    /* Queries precede the documents in the postings */
+    open_postings ( atom_index, a, &p );
+    if ( ! skip_postings ( &p, u -> lo ) ) continue;
+    do {
+      doc = p.doc;
+      if ( doc >= u -> hi ) break;
+      if ( ! s -> scored [ doc ] ) {
+        s -> scored [ doc ] = TRUE;
+        s -> score [ doc ] = 0.0;
+        append_intlist ( s -> hits, doc );
+      }
+      s -> score [ doc ] += ( w * p.weight * aw );
+    } while ( next_posting ( &p ) );
+  }
+
+  print_rsv ( u, s );
 }
 
 
 /****************************************************************
-**  calc_equations
+**  find_bounds
 **
-**  Calculates the constraint equations which must be satisfied
-**  by the optimized weights, as well as the cost function.
+**  Finds the highest and lowest weight of each atomic concept
+**  in a document.
 **
-**  IN  : x = vector containing the inverse document frequency
-**            of all atomic concepts. This vector is used to
-**            generate equations (4.2, 4.3) on p.78 of the thesis.
+**  OUT : 'max_wgt' and 'min_wgt' are set.
+****************************************************************/
+
+void find_bounds
+       ()
+{
+  POSTINGS
+    p;
+  int
+    a, n;
+
+  n = index_atoms ( atom_index );
+  max_wgt = (double *) malloc ( ( n + 1 ) * sizeof ( double ) );
+  min_wgt = (double *) malloc ( ( n + 1 ) * sizeof ( double ) );
+  assert ( ( max_wgt != NULL ) && ( min_wgt != NULL ) );
+
+  for ( a = 0; a < n; a ++ ) {
+    max_wgt [a] = min_wgt [a] = 0.0;
+    open_postings ( atom_index, a, &p );
+    if ( ! skip_postings ( &p, 0 ) ) continue;
+    max_wgt [a] = min_wgt [a] = p.weight;
+    while ( next_posting ( &p ) ) {
+      if ( p.weight > max_wgt [a] ) max_wgt [a] = p.weight;
+      if ( p.weight < min_wgt [a] ) min_wgt [a] = p.weight;
+    }
+  }
+}
+
+
+/****************************************************************
+**  worse_top, add_top
 **
-**  OUT : The global vectors min_weights, max_weights, rsv_eq,
-**        and cost are initialized with the appropriate values.
-**        These vectors constitute the optimization matrix.
+**  The k best RSV values of a query are kept in a heap whose
+**  first entry is the worst one.
+**
+**  IN  : s   = work space holding the heap.
+**        doc = document.
+**        rsv = RSV value of the document.
 ****************************************************************/
 
-BOOL enum_doc
-       ( e )
-ELEMENT
-  e;
+BOOL worse_top
+       ( t1, t2 )
+TOP_STRUCT
+  *t1, *t2;
+{
+  /* Of equal values, the one of the higher document is worse */
+  return ( ( t1 -> rsv < t2 -> rsv ) || 
+           ( ( t1 -> rsv == t2 -> rsv ) && ( t1 -> doc > t2 -> doc ) ) );
+}
+
+
+void add_top
+       ( s, doc, rsv )
+SCORER
+  *s;
+int
+  doc;
+double
+  rsv;
+{
+  TOP_STRUCT
+    t, *top;
+  int
+    i, j;
+
+  top = s -> top;
+  t.doc = doc;
+  t.rsv = rsv;
+  if ( s -> num_top < top_k ) {
+    /* Sift new entry up from the end */
+    i = s -> num_top ++;
+    while ( ( i > 0 ) && worse_top ( &t, &top [ ( i - 1 ) / 2 ] ) ) {
+      top [i] = top [ ( i - 1 ) / 2 ];
+      i = ( i - 1 ) / 2;
+    }
+    top [i] = t;
+  }
+  else if ( worse_top ( &top [0], &t ) ) {
+    /* Replace worst entry and sift it down */
+    i = 0;
+    while ( ( j = 2 * i + 1 ) < s -> num_top ) {
+      if ( ( j + 1 < s -> num_top ) && 
+           worse_top ( &top [ j + 1 ], &top [j] ) ) {
+        j ++;
+      }
+      if ( ! worse_top ( &top [j], &t ) ) break;
+      top [i] = top [j];
+      i = j;
+    }
+    top [i] = t;
+  }
+}
+
+
+/****************************************************************
+**  topk_unit
+**
+**  Calculates the k best RSV values of a query. The concepts of
+**  the query are ordered by their upper bounds; the concepts
+**  with the lowest bounds, whose sum does not exceed the k-th
+**  best value, are "non-essential": a document which has none
+**  of the other concepts cannot enter the top k. Documents are
+**  visited in increasing order from the postings of the
+**  essential concepts, and the non-essential ones are only
+**  searched while the document can still reach the top k. The
+**  RSV of a document is added in the same order as in
+**  'score_unit'.
+**
+**  IN  : u = unit of work (covering all documents).
+**        s = work space of the calling thread.
+**
+**  OUT : The k best nonzero RSV values are written to the
+**        output of u, ordered by document.
+****************************************************************/
+
+void topk_unit
+       ( u, s )
+UNIT
+  *u;
+SCORER
+  *s;
+{
+  INTFLOAT_LIST
+    l;
+  TERM_STRUCT
+    *terms, *t;
+  int
+    *order,		/* concepts by increasing bound */
+    i, j, n, a, doc,
+    first;		/* number of non-essential concepts */
+  double
+    *bound_sum,		/* bound_sum [j] = sum of bounds of order [0..j] */
+    rsv, hi, lo, threshold;
+
+  l = u -> query -> docatoms;
+  n = count_iflist ( l );
+  terms = (TERM_STRUCT *) malloc ( ( n + 1 ) * sizeof ( TERM_STRUCT ) );
+  order = (int *) malloc ( ( n + 1 ) * sizeof ( int ) );
+  bound_sum = (double *) malloc ( ( n + 1 ) * sizeof ( double ) );
+  assert ( ( terms != NULL ) && ( order != NULL ) && ( bound_sum != NULL ) );
+
+  for ( i = 0; i < n; i ++ ) {
+    t = &terms [i];
+    a = iflist_key ( l, i );
+    t -> atom = a;
+    t -> wgt = iflist_val ( l, i );
+
+    /* A contribution is linear in the weight of the document */
+    hi = t -> wgt * max_wgt [a] * atom_wgt [a];
+    lo = t -> wgt * min_wgt [a] * atom_wgt [a];
+    t -> bound = ( hi > lo ) ? hi : lo;
+    if ( t -> bound < 0.0 ) t -> bound = 0.0;
+
+    /* Queries precede the documents in the postings */
+    open_postings ( atom_index, a, &t -> p );
+    t -> done = ! skip_postings ( &t -> p, 0 );
+
+    /* Insert into 'order' */
+    for ( j = i; ( j > 0 ) && ( terms [ order [ j - 1 ] ].bound > t -> bound );
+          j -- ) {
+      order [j] = order [ j - 1 ];
+    }
+    order [j] = i;
+  }
+  for ( j = 0; j < n; j ++ ) {
+    bound_sum [j] = terms [ order [j] ].bound + ( ( j > 0 ) ? bound_sum [ j - 1 ] : 0.0 );
+  }
+
+  s -> num_top = 0;
+  threshold = 0.0;
+  first = 0;
+  for (;;) {
+    /* Next document is the lowest one of the essential concepts */
+    doc = -1;
+    for ( j = first; j < n; j ++ ) {
+      t = &terms [ order [j] ];
+      if ( ! t -> done && ( ( doc < 0 ) || ( t -> p.doc < doc ) ) ) {
+        doc = t -> p.doc;
+      }
+    }
+    if ( doc < 0 ) break;
+
+    rsv = 0.0;
+    for ( i = 0; i < n; i ++ ) {
+      terms [i].found = FALSE;
+    }
+    for ( j = first; j < n; j ++ ) {
+      t = &terms [ order [j] ];
+      if ( ! t -> done && ( t -> p.doc == doc ) ) {
+        t -> found = TRUE;
+        t -> value = t -> wgt * t -> p.weight * atom_wgt [ t -> atom ];
+        rsv += t -> value;
+        t -> done = ! next_posting ( &t -> p );
+      }
+    }
+
+    /* Search non-essential concepts, highest bound first */
+    for ( j = first - 1; j >= 0; j -- ) {
+      hi = rsv + bound_sum [j];
+      if ( hi + BOUND_SLACK * ( fabs ( rsv ) + bound_sum [j] ) <= threshold ) {
+        break;
+      }
+      t = &terms [ order [j] ];
+      if ( ! t -> done && ( t -> p.doc < doc ) ) {
+        t -> done = ! skip_postings ( &t -> p, doc );
+      }
+      if ( ! t -> done && ( t -> p.doc == doc ) ) {
+        t -> found = TRUE;
+        t -> value = t -> wgt * t -> p.weight * atom_wgt [ t -> atom ];
+        rsv += t -> value;
+      }
+    }
+    if ( j >= 0 ) continue;	/* document cannot reach the top k */
+
+    /* Add contributions in the order of the concepts */
+    rsv = 0.0;
+    for ( i = 0; i < n; i ++ ) {
+      if ( terms [i].found ) rsv += terms [i].value;
+    }
+    if ( rsv <= 0.0 ) continue;
+
+    add_top ( s, doc, rsv );
+    if ( s -> num_top == top_k ) {
+      /* Update threshold and non-essential concepts */
+      threshold = s -> top [0].rsv;
+      while ( ( first < n ) && 
+              ( bound_sum [ first ] * ( 1.0 + BOUND_SLACK ) <= threshold ) ) {
+        first ++;
+      }
+    }
+  }
+
+  /* Print top k in order of documents */
+  clear_intlist ( s -> hits );
+  for ( i = 0; i < s -> num_top; i ++ ) {
+    s -> score [ s -> top [i].doc ] = s -> top [i].rsv;
+    append_intlist ( s -> hits, s -> top [i].doc );
+  }
+  print_rsv ( u, s );
+
+  free ( (char *) terms );
+  free ( (char *) order );
+  free ( (char *) bound_sum );
+}
+
+
+/****************************************************************
+**  make_vectors
+**
+**  Builds the concept vectors of the documents from the atom
+**  index. The concepts of each document are in increasing order.
+**
+**  OUT : 'doc_first', 'doc_atom' and 'doc_wgt' are set.
+****************************************************************/
+
+void make_vectors
+       ()
+{
+  POSTINGS
+    p;
+  int
+    *fill,		/* position of next concept of each document */
+    a, d, n;
+
+  doc_first = (int *) calloc ( num_docs + 2, sizeof ( int ) );
+  fill = (int *) calloc ( num_docs + 1, sizeof ( int ) );
+  assert ( ( doc_first != NULL ) && ( fill != NULL ) );
+
+  /* Count concepts of each document */
+  for ( a = 0; a < index_atoms ( atom_index ); a ++ ) {
+    open_postings ( atom_index, a, &p );
+    if ( ! skip_postings ( &p, 0 ) ) continue;
+    do {
+      doc_first [ p.doc + 1 ] ++;
+    } while ( next_posting ( &p ) );
+  }
+  for ( d = 0; d < num_docs; d ++ ) {
+    doc_first [ d + 1 ] += doc_first [d];
+    fill [d] = doc_first [d];
+  }
+
+  /* Distribute the postings of each concept */
+  n = doc_first [ num_docs ];
+  doc_atom = (int *) malloc ( ( n + 1 ) * sizeof ( int ) );
+  doc_wgt = (double *) malloc ( ( n + 1 ) * sizeof ( double ) );
+  assert ( ( doc_atom != NULL ) && ( doc_wgt != NULL ) );
+  for ( a = 0; a < index_atoms ( atom_index ); a ++ ) {
+    open_postings ( atom_index, a, &p );
+    if ( ! skip_postings ( &p, 0 ) ) continue;
+    do {
+      doc_atom [ fill [ p.doc ] ] = a;
+      doc_wgt [ fill [ p.doc ] ++ ] = p.weight;
+    } while ( next_posting ( &p ) );
+  }
+  free ( (char *) fill );
+}
+
+
+/****************************************************************
+**  dense_unit
+**
+**  Calculates the RSV values of a query with a range of
+**  documents in dense mode. The query is scattered into a
+**  dense array, and the scoring kernel compares it with the
+**  concept vectors of the documents.
+**
+**  IN  : u = unit of work.
+**        s = work space of the calling thread.
+**
+**  OUT : Nonzero RSV values are written to the output of u,
+**        ordered by document.
+****************************************************************/
+
+void dense_unit
+       ( u, s )
+UNIT
+  *u;
+SCORER
+  *s;
 {
+  INTFLOAT_LIST
+    l;
+  int
+    i, doc;
+
+  l = u -> query -> docatoms;
+  for ( i = 0; i < count_iflist ( l ); i ++ ) {
+    s -> qw [ iflist_key ( l, i ) ] = iflist_val ( l, i );
+  }
+
+  (*kernel) ( u -> hi - u -> lo, doc_first + u -> lo, doc_atom, doc_wgt,
+              s -> qw, atom_wgt, s -> score + u -> lo );
+
+  for ( doc = u -> lo; doc < u -> hi; doc ++ ) {
+    if ( s -> score [ doc ] > 0.0 ) {
+      /* don't print zero rsv values */
+      reserve ( &u -> out, &u -> outsize, u -> outlen + MAX_LINE );
+      u -> outlen += sprintf ( u -> out + u -> outlen, "%d\t%d\t%f\n", 
+                               u -> query -> index, doc, s -> score [ doc ] );
+    }
+  }
+
+  for ( i = 0; i < count_iflist ( l ); i ++ ) {
+    s -> qw [ iflist_key ( l, i ) ] = 0.0;
+  }
+}
+
+
+/****************************************************************
+**  load_rsv
+**
+**  Reads a previous RSV file into memory (update mode). The
+**  lines must be ordered by query and document, as written by
+**  calc_rsv.
+**
+**  IN  : name = name of file.
+**
+**  OUT : 'old_text', 'old_line', 'old_query', 'old_doc' and
+**        'num_lines' are set.
+****************************************************************/
+
+void load_rsv
+       ( name )
+char
+  *name;
+{
+  FILE
+    *f;
+  char
+    *p, *end;
+  unsigned
+    len, size, n;
+  int
+    max_lines;
+
+  /* Read whole file */
+  f = open_file ( name );
+  old_text = NULL;
+  len = size = 0;
+  do {
+    reserve ( &old_text, &size, len + 65536 );
+    n = fread ( old_text + len, 1, size - len - 1, f );
+    len += n;
+  } while ( n > 0 );
+  fclose ( f );
+  old_text [ len ] = '\0';
+
+  /* Find lines */
+  max_lines = 0;
+  num_lines = 0;
+  old_line = old_query = old_doc = NULL;
+  for ( p = old_text; *p != '\0'; p = end ) {
+    if ( num_lines + 1 >= max_lines ) {
+      max_lines = ( max_lines == 0 ) ? 4096 : 2 * max_lines;
+      old_line = (int *) realloc ( old_line, max_lines * sizeof ( int ) );
+      old_query = (int *) realloc ( old_query, max_lines * sizeof ( int ) );
+      old_doc = (int *) realloc ( old_doc, max_lines * sizeof ( int ) );
+      assert ( ( old_line != NULL ) && ( old_query != NULL ) && 
+               ( old_doc != NULL ) );
+    }
+    old_line [ num_lines ] = p - old_text;
+    old_query [ num_lines ] = (int) strtol ( p, &end, 10 );
+    old_doc [ num_lines ] = (int) strtol ( end, &end, 10 );
+    assert ( ( num_lines == 0 ) || 
+             ( old_query [ num_lines ] > old_query [ num_lines - 1 ] ) ||
+             ( ( old_query [ num_lines ] == old_query [ num_lines - 1 ] ) &&
+               ( old_doc [ num_lines ] > old_doc [ num_lines - 1 ] ) ) );
+    num_lines ++;
+
+    /* Next line */
+    while ( ( *end != '\0' ) && ( *end != '\n' ) ) end ++;
+    if ( *end == '\n' ) end ++;
+  }
+  if ( old_line != NULL ) {
+    /* End of last line */
+    old_line [ num_lines ] = len;
+  }
+}
+
+
+/****************************************************************
+**  find_line
+**
+**  IN  : q   = query.
+**        doc = document.
+**
+**  OUT : Function returns the number of the first line of the
+**        previous RSV file which is not ahead of (q, doc).
+****************************************************************/
+
+int find_line
+      ( q, doc )
+int
+  q;
+int
+  doc;
+{
+  int
+    low, high, mid;
+
+  low = 0;
+  high = num_lines;
+  while ( low < high ) {
+    mid = ( low + high ) / 2;
+    if ( ( old_query [ mid ] < q ) || 
+         ( ( old_query [ mid ] == q ) && ( old_doc [ mid ] < doc ) ) ) {
+      low = mid + 1;
+    }
+    else {
+      high = mid;
+    }
+  }
+  return ( low );
+}
+
+
+/****************************************************************
+**  update_unit
+**
+**  Calculates the RSV values of a query with a range of
+**  documents in update mode. The documents which have a changed
+**  concept of the query are found in the postings of these
+**  concepts; their RSV values are calculated again from the
+**  concept vectors, in the same order as in 'score_unit'. The
+**  lines of all other documents are copied from the previous
+**  RSV file.
+**
+**  IN  : u = unit of work.
+**        s = work space of the calling thread.
+**
+**  OUT : The RSV values are written to the output of u, ordered
+**        by document.
+****************************************************************/
+
+void update_unit
+       ( u, s )
+UNIT
+  *u;
+SCORER
+  *s;
+{
+  INTFLOAT_LIST
+    l;
+  POSTINGS
+    p;
   double
     rsv;
-  DOC_STRUCT
-    *d;
+  int
+    i, j, a, doc, line, end;
+
+  l = u -> query -> docatoms;
+  clear_intlist ( s -> hits );
+  for ( i = 0; i < count_iflist ( l ); i ++ ) {
+    a = iflist_key ( l, i );
+    s -> qw [a] = iflist_val ( l, i );
+    if ( ! changed [a] ) continue;
 
-  d = (DOC_STRUCT *) e;
-  if ( d -> index >= 0 ) {
-    rsv = calc_rsv ( glob_query, d );
+    /* Collect documents of changed concept */
+    open_postings ( atom_index, a, &p );
+    if ( ! skip_postings ( &p, u -> lo ) ) continue;
+    do {
+      doc = p.doc;
+      if ( doc >= u -> hi ) break;
+      if ( ! s -> scored [ doc ] ) {
+        s -> scored [ doc ] = TRUE;
+        append_intlist ( s -> hits, doc );
+      }
+    } while ( next_posting ( &p ) );
+  }
+  finalize_intlist ( s -> hits );
+
+  /* Merge previous lines with new RSV values */
+  line = find_line ( u -> query -> index, u -> lo );
+  end = find_line ( u -> query -> index, u -> hi );
+  j = 0;
+  while ( ( line < end ) || ( j < count_intlist ( s -> hits ) ) ) {
+    doc = ( j < count_intlist ( s -> hits ) ) ? intlist_key ( s -> hits, j ) 
+                                               : u -> hi;
+    if ( ( line < end ) && ( old_doc [ line ] < doc ) ) {
+      /* Copy unchanged line */
+      i = old_line [ line + 1 ] - old_line [ line ];
+      reserve ( &u -> out, &u -> outsize, u -> outlen + i );
+      memcpy ( u -> out + u -> outlen, old_text + old_line [ line ], i );
+      u -> outlen += i;
+      line ++;
+      continue;
+    }
+    if ( ( line < end ) && ( old_doc [ line ] == doc ) ) {
+      /* Previous value is replaced */
+      line ++;
+    }
+    dense_scalar ( 1, doc_first + doc, doc_atom, doc_wgt, s -> qw, atom_wgt,
+                   &rsv );
     if ( rsv > 0.0 ) {
-      /* don't print zero rsv values */
-      printf ( "%d\t%d\t%f\n", glob_query -> index, d -> index, rsv );
+      reserve ( &u -> out, &u -> outsize, u -> outlen + MAX_LINE );
+      u -> outlen += sprintf ( u -> out + u -> outlen, "%d\t%d\t%f\n", 
+                               u -> query -> index, doc, rsv );
     }
+    s -> scored [ doc ] = FALSE;
+    j ++;
+  }
 
-    /* Running count */
-    fprintf ( counter, "%d %d\r", glob_query -> index, d -> index );
+  for ( i = 0; i < count_iflist ( l ); i ++ ) {
+    s -> qw [ iflist_key ( l, i ) ] = 0.0;
   }
-  return ( TRUE );
 }
 
 
-BOOL enum_query
+/****************************************************************
+**  make_units
+**
+**  Divides the work into units. A unit is a query, or a range
+**  of documents of a query with many postings; the units of a
+**  query cover the documents in increasing order. In top-k
+**  mode, queries are never divided.
+**
+**  IN  : n = number of threads.
+**
+**  OUT : 'unit' and 'num_units' are set.
+****************************************************************/
+
+BOOL count_units
        ( e )
 ELEMENT
   e;
 {
-  DOC_STRUCT
-    *q;
+  INTFLOAT_LIST
+    l;
+  int
+    i, b, num_blocks;
+  unsigned
+    cost;
 
-  q = (DOC_STRUCT *) e;
+  /* The cost of a query is the number of its postings, or of all
+     document concepts in dense mode */
+  l = ((DOC_STRUCT *) e) -> docatoms;
+  cost = 0;
+  if ( dense ) {
+    cost = doc_first [ num_docs ];
+  }
+  else {
+    for ( i = 0; i < count_iflist ( l ); i ++ ) {
+      if ( ! update || changed [ iflist_key ( l, i ) ] ) {
+        cost += index_df ( atom_index, iflist_key ( l, i ) );
+      }
+    }
+  }
+  num_blocks = 1;
+  if ( ( top_k == 0 ) && ( glob_threads > 1 ) ) {
+    num_blocks = cost / BLOCK_POSTINGS + 1;
+    if ( num_blocks > glob_threads ) num_blocks = glob_threads;
+  }
 
-  if ( q -> index < 0 ) {
-    /* This is a query, calculate RSV with all documents */
-    glob_query = q;
-    enum_list ( doc_list, enum_doc, ENUM_FORWARD );
+  for ( b = 0; b < num_blocks; b ++ ) {
+    if ( unit != NULL ) {
+      unit [ num_units ].query = (DOC_STRUCT *) e;
+      unit [ num_units ].lo = (int) ( (double) num_docs * b / num_blocks );
+      unit [ num_units ].hi = (int) ( (double) num_docs * ( b + 1 ) / num_blocks );
+      unit [ num_units ].out = NULL;
+      unit [ num_units ].outlen = unit [ num_units ].outsize = 0;
+      unit [ num_units ].done = FALSE;
+    }
+    num_units ++;
   }
   return ( TRUE );
 }
 
 
+void make_units
+       ( n )
+int
+  n;
+{
+  /* Count units first, then fill them in */
+  glob_threads = n;
+  unit = NULL;
+  num_units = 0;
+  enum_list ( query_list, count_units, ENUM_FORWARD );
+  unit = (UNIT *) malloc ( ( num_units + 1 ) * sizeof ( UNIT ) );
+  assert ( unit != NULL );
+  num_units = 0;
+  enum_list ( query_list, count_units, ENUM_FORWARD );
+}
+
+
+/****************************************************************
+**  run_unit
+**
+**  Calculates the RSV values of a unit of work.
+**
+**  IN  : u = unit of work.
+**        s = work space of the calling thread.
+****************************************************************/
+
+void run_unit
+       ( u, s )
+UNIT
+  *u;
+SCORER
+  *s;
+{
+  if ( top_k > 0 ) {
+    topk_unit ( u, s );
+  }
+  else if ( dense ) {
+    dense_unit ( u, s );
+  }
+  else if ( update ) {
+    update_unit ( u, s );
+  }
+  else {
+    score_unit ( u, s );
+  }
+}
+
+
+#ifdef THREADS
+
+/****************************************************************
+**  rsv_worker
+**
+**  Main function of a worker thread. Takes the next unit of
+**  work until none are left.
+**
+**  IN  : arg = not used.
+****************************************************************/
+
+void *rsv_worker
+        ( arg )
+void
+  *arg;
+{
+  SCORER
+    *s;
+  UNIT
+    *u;
+
+  s = create_scorer ();
+  while ( TRUE ) {
+    /* Get next unit */
+    pthread_mutex_lock ( &unit_lock );
+    if ( next_unit == num_units ) {
+      pthread_mutex_unlock ( &unit_lock );
+      break;
+    }
+    u = &unit [ next_unit ++ ];
+    pthread_mutex_unlock ( &unit_lock );
+
+    run_unit ( u, s );
+
+    pthread_mutex_lock ( &unit_lock );
+    u -> done = TRUE;
+    pthread_cond_broadcast ( &unit_cond );
+    pthread_mutex_unlock ( &unit_lock );
+  }
+  return ( NULL );
+}
+
+#endif
+
+
+/****************************************************************
+**  calc_units
+**
+**  Calculates the RSV values of all units and writes them to
+**  standard output in the order of the units. With more than
+**  one thread, the units are taken by the worker threads in
+**  this order, and the main thread writes each unit as soon as
+**  it is done.
+**
+**  IN  : n = number of threads.
+****************************************************************/
+
+void calc_units
+       ( n )
+int
+  n;
+{
+  SCORER
+    *s;
+  UNIT
+    *u;
+  int
+    i;
+#ifdef THREADS
+  pthread_t
+    *worker;
+  int
+    res;
+#endif
+
+  s = NULL;
+  if ( n <= 1 ) {
+    s = create_scorer ();
+  }
+#ifdef THREADS
+  else {
+    next_unit = 0;
+    worker = (pthread_t *) malloc ( n * sizeof ( pthread_t ) );
+    assert ( worker != NULL );
+    for ( i = 0; i < n; i ++ ) {
+      res = pthread_create ( &worker [i], NULL, rsv_worker, NULL );
+      assert ( res == 0 );
+    }
+  }
+#endif
+
+  for ( i = 0; i < num_units; i ++ ) {
+    u = &unit [i];
+    if ( s != NULL ) {
+      run_unit ( u, s );
+    }
+#ifdef THREADS
+    else {
+      pthread_mutex_lock ( &unit_lock );
+      while ( ! u -> done ) {
+        pthread_cond_wait ( &unit_cond, &unit_lock );
+      }
+      pthread_mutex_unlock ( &unit_lock );
+    }
+#endif
+    fprintf ( counter, "%d\r", u -> query -> index );
+    if ( u -> outlen > 0 ) {
+      fwrite ( u -> out, 1, u -> outlen, stdout );
+    }
+    if ( u -> out != NULL ) free ( u -> out );
+  }
+
+#ifdef THREADS
+  if ( s == NULL ) {
+    for ( i = 0; i < n; i ++ ) {
+      pthread_join ( worker [i], NULL );
+    }
+    free ( worker );
+  }
+#endif
+}
+
+
 /****************************************************************
 **  load_weights
 **
 **  Loads the weight of each atomic concept into memory.
 **
-**  IN  : f = handle to open ATOM_WGTS file.
+**  IN  : r     = reader of the ATOM_WGTS file.
+**        delta = TRUE if the weights replace previous ones; the
+**                concepts whose weights change are marked in
+**                'changed'.
 ****************************************************************/
 
 void load_weights
-       ( f )
-FILE
-  *f;
+       ( r, delta )
+READER
+  r;
+BOOL
+  delta;
 {
-  char
-    line [ LINE_LENGTH ];
   int
-    d, res;
+    d, res, pos;
   double
     wgt;
   float
     w;
-  ATOM_STRUCT
-    t, *atm;
 
-  while ( fgets ( line, LINE_LENGTH, f ) ) {
+  while ( read_line ( r ) ) {
      
     /* Get number of atomic concept and weight */
-    res = sscanf ( line, " %d %f", &d, &w );
-    assert ( res == 2 );
-    wgt = (double) w;   /* Argument to sscanf MUST be float */
+    res = get_int ( r, &d ) && get_float ( r, &w );
+    assert ( res );
+    wgt = (double) w;
 
     /* Search atomic concept in list */
-    t.atom = d;
-    atm = (ATOM_STRUCT *) lookup_list ( atom_list, (ELEMENT) &t,
-                                        comp_atom );
-    assert ( atm != NULL );
-    atm -> weight = wgt;
+    pos = lookup_intlist ( atoms, d );
+    assert ( pos >= 0 );
+    if ( delta && ( atom_wgt [ pos ] != wgt ) ) {
+      changed [ pos ] = TRUE;
+    }
+    atom_wgt [ pos ] = wgt;
 
     /* running count */
     fprintf ( counter, "%d\r", d );
@@ -511,50 +1523,106 @@ int
 char
   *argv [];
 {
-  FILE
-    *f;
+  READER
+    r;
+  DESCR
+    d;
+  char
+    *name,
+    *rsvfile = NULL,
+    *wgtfile = NULL;
+  int
+    i, n;
     
   /* Program title */
   fprintf ( stderr, PROG );
 
   /* Get verbose or quiet mode */
-  if ( ( argc == 5 ) && ( *argv [4] == 'Q' ) ) {
+  if ( ( argc >= 5 ) && ( strcmp ( argv [ argc - 1 ], "QUIET" ) == 0 ) ) {
     /* in case of quiet mode: redirect running counts to /dev/null */
     counter = fopen ( "/dev/null", "r" );
     assert ( counter != NULL );
+    argc --;
   }
   else {
     /* verbose mode: redirect running counts to stderr */
     counter = stderr;
   }
   
+  /* Get options */
+  top_k = 0;
+  dense = FALSE;
+  for ( i = 4; i < argc; i ++ ) {
+    if ( ( strcmp ( argv [i], "--top-k" ) == 0 ) && ( i + 1 < argc ) ) {
+      top_k = atoi ( argv [ ++ i ] );
+    }
+    else if ( strcmp ( argv [i], "--dense" ) == 0 ) {
+      dense = TRUE;
+    }
+    else if ( ( strcmp ( argv [i], "--update" ) == 0 ) && ( i + 2 < argc ) ) {
+      rsvfile = argv [ ++ i ];
+      wgtfile = argv [ ++ i ];
+    }
+    else {
+      top_k = -1;
+    }
+  }
+
   /* Check parameters */
-  if ( argc < 4 ) {
+  update = ( rsvfile != NULL );
+  if ( ( argc < 4 ) || ( top_k < 0 ) || ( dense && ( top_k > 0 ) ) ||
+       ( update && ( dense || ( top_k > 0 ) ) ) ) {
     fprintf ( stderr, USAGE );
     return ( 1 );
   }
   
   /* Read atomic concepts of each sign */
   fprintf ( stderr, "Reading atomic concepts.\n" );
-  f = open_file ( argv [2] );
-  process_concepts ( f );
-  fclose ( f );
+  r = open_reader ( argv [2] );
+  process_concepts ( r );
+  close_reader ( &r );
   
   /* Load weights of atomic concepts */
   fprintf ( stderr, "Reading weights.\n" );
-  f = open_file ( argv [3] );
-  load_weights ( f );
-  fclose ( f );
+  r = open_reader ( argv [3] );
+  load_weights ( r, FALSE );
+  close_reader ( &r );
+  if ( update ) {
+    /* Apply new weights */
+    changed = (char *) calloc ( count_intlist ( atoms ) + 1, sizeof ( char ) );
+    assert ( changed != NULL );
+    r = open_reader ( wgtfile );
+    load_weights ( r, TRUE );
+    close_reader ( &r );
+
+    /* Load previous RSV values */
+    fprintf ( stderr, "Reading previous RSV values.\n" );
+    load_rsv ( rsvfile );
+  }
   
   /* Read document descriptions */
   fprintf ( stderr, "Reading document descriptions.\n" );
-  f = open_file ( argv [1] );
-  process_documents ( f );
-  fclose ( f );
+  d = open_descr ( argv [1] );
+  process_queries ( d );
+  atom_index = invert_descr ( d, atoms, sign_concepts );
+  close_descr ( &d );
   
   /* Calculate RSV values */
   fprintf ( stderr, "Calculating RSV values.\n" );
-  enum_list ( doc_list, enum_query, ENUM_FORWARD );
+  if ( top_k > 0 ) {
+    find_bounds ();
+  }
+  if ( dense || update ) {
+    make_vectors ();
+  }
+  if ( dense ) {
+    kernel = select_kernel ( &name );
+    fprintf ( stderr, "Scoring kernel: %s\n", name );
+  }
+  n = thread_count ();
+  make_units ( n );
+  calc_units ( n );
+  fprintf ( counter, "\n" );
 
   return ( 0 );
 }
@@ -23,11 +23,22 @@
 *
 *   Call Format
 *   -----------
-*	calc_docdescr <doc_freq> <sign_file>
+*	calc_docdescr <doc_freq> <sign_file> <dictionary> [QUIET]
 *
 *   where <doc_freq> is the name of the document term frequency
-*   file and <sign_file> is the name of the sign file.
-*   The calculated weights are written to the standard output.
+*   file, <sign_file> is the name of the sign file and
+*   <dictionary> the name of the dictionary written together
+*   with <doc_freq>. The calculated weights are written to the
+*   standard output.
+*
+*   If <doc_freq> is "-", the document term frequencies are read
+*   from the standard input. The collection is read only once;
+*   the sign file and the dictionary are not opened before the
+*   end of <doc_freq>, so that the output of parse_itemcoll may
+*   be piped directly into calc_docdescr.
+*
+*   If the string QUIET is specified as the last parameter,
+*   running counts are not written to the screen.
 *
 *****************************************************************
 *
@@ -55,7 +66,7 @@
 ****************************************************************/   
 
 #define PROG	"Sign Weight Calculation (gh, 29/04/89)\n"
-#define USAGE	"Usage: calc_docdescr <doc_freq> <sign_file> [QUIET]\n"
+#define USAGE	"Usage: calc_docdescr <doc_freq> <sign_file> <dictionary> [QUIET]\n"
 
 #include <ctype.h>
 #include <stdio.h>
@@ -69,10 +80,14 @@
 
 #include "boolean.h"
 #include "list.h"
+#include "listsort.h"
 #include "util.h"
+#include "hash.h"
+#include "reader.h"
 
 #define MAX_WORDLEN	100
-#define LINE_LENGTH	100
+#define DICT_TERMS	16384	/* Initial size of dictionary */
+#define SPOOL_SIZE	1048576	/* Number of term records kept in memory */
 
 
 typedef
@@ -81,22 +96,59 @@ typedef
     char   *term;   /* term interpretation of sign t=a(s) */
     int    df;      /* document frequency df(t) */
     double idf;     /* inverse document frequency idf(t) */
+    int    freq;    /* frequency of sign in current document */
+    BOOL   in_doc;  /* TRUE if sign is in 'doc_signs' */
   } SIGN_STRUCT;
 
 typedef
   struct {
-    int sign;      /* sign index */
-    int freq;      /* term frequency */
-  } WGT_STRUCT;
+    int freq;      /* term frequency, or index of a new document */
+    int w1;        /* number of first word, -1 for a new document */
+    int w2;        /* number of second word, -1 for a single word */
+  } TERM_REC;
+
+
+/* The document frequency file refers to words by their numbers
+   in the dictionary. 'word_sign' gives the sign of each word
+   number, or NULL if the word is not a sign. Signs consisting of
+   two words are found in 'compound_signs' by the pair of numbers
+   of their words; the value of a hash entry is the index of the
+   sign in 'compound'. */
+HASH
+  dictionary,
+  compound_signs;
+SIGN_STRUCT
+  **word_sign,
+  **compound;
+int
+  num_words,
+  num_compounds = 0;
+
+/* The document frequency file is read once into 'spool', one
+   record per document and term. When the spool is full, its
+   records are appended to the temporary file 'spill'. Both the
+   df/idf and the weight calculation replay the spool. */
+TERM_REC
+  *spool;
+int
+  spool_size = 0,	/* Allocated records in 'spool' */
+  spool_used = 0,	/* Records written to 'spool' */
+  spool_pos,		/* Replay position in 'spool' */
+  spool_avail;		/* Records available for replay */
+FILE
+  *spill = NULL;
 
+/* Signs of the current document, in order of first occurrence */
+SIGN_STRUCT
+  **doc_signs = NULL;
+int
+  num_doc_signs = 0,
+  max_doc_signs = 0;
 
-LIST
-  doc_signs = NULL,
-  sign_list;
 int
   docnum = 0;   /* Number of documents in collection */
 double
-  norm = 0.0;   /* global variable used by enum_wgts */
+  norm = 0.0;   /* norm of current document */
 FILE
   *counter;	/* Virtual file used to output running counts */
   
@@ -107,93 +159,159 @@ FILE
 
 #ifndef BSDUNIX
 int main ( int, char *[] );
-void load_signs ( FILE * );
-int comp_sign ( ELEMENT, ELEMENT );
-void read_descr ( FILE *, BOOL );
+void load_dictionary ( READER );
+void load_signs ( READER );
+void spool_term ( int, int, int );
+void replay_spool ( void );
+TERM_REC *next_term ( void );
+void read_descr ( READER );
+SIGN_STRUCT *find_compound ( int, int );
+SIGN_STRUCT *term_sign ( TERM_REC * );
+void calc_df ( void );
+void add_freq ( SIGN_STRUCT *, int );
+int comp_signs ( ELEMENT, ELEMENT );
 void dump_weights ( int );
-BOOL enum_wgts ( ELEMENT );
-int comp_wgts ( ELEMENT, ELEMENT );
-SIGN_STRUCT *find_sign ( char * );
-WGT_STRUCT *find_wgt ( int );
+void calc_weights ( void );
 #else
 int main ();
+void load_dictionary ();
 void load_signs ();
-int comp_sign ();
+void spool_term ();
+void replay_spool ();
+TERM_REC *next_term ();
 void read_descr ();
+SIGN_STRUCT *find_compound ();
+SIGN_STRUCT *term_sign ();
+void calc_df ();
+void add_freq ();
+int comp_signs ();
 void dump_weights ();
-BOOL enum_wgts ();
-int comp_wgts ();
-SIGN_STRUCT *find_sign ();
-WGT_STRUCT *find_wgt ();
+void calc_weights ();
 #endif
 
 
 /****************************************************************
-**  load_signs
-**
-**  Loads all signs from the sign file into memory.
+**  load_dictionary
 **
-**  IN  : f = Handle to open sign file.
+**  Loads the dictionary into the hash table 'dictionary'. The
+**  value of each entry is the number of the word.
 **
-**  OUT : Global variable 'sign_list' is filled.
+**  IN  : r = Reader of dictionary.
 ****************************************************************/   
 
-int comp_sign 
-      ( s1, s2 )
-ELEMENT
-  s1;
-ELEMENT
-  s2;
+void load_dictionary 
+       ( r )
+READER
+  r;
 {
-  /* Order of sign structures = lexicographical order of strings */
-  return ( strcmp ( ((SIGN_STRUCT *) s1) -> term,
-                    ((SIGN_STRUCT *) s2) -> term ) );
+  int
+    n;
+  BOOL
+    res;
+  char
+    w [ MAX_WORDLEN ];
+
+  dictionary = create_hash ( DICT_TERMS );
+  num_words = 0;
+  while ( read_line ( r ) ) {
+    if ( ! get_int ( r, &n ) ) continue;
+    res = get_word ( r, w, MAX_WORDLEN );
+    assert ( res && ( n >= 0 ) );
+    add_hash ( dictionary, w, strlen ( w ) ) -> val = n;
+    if ( n >= num_words ) num_words = n + 1;
+  }
+
+  /* No word is a sign yet */
+  word_sign = (SIGN_STRUCT **) calloc ( num_words + 1, 
+                                        sizeof ( SIGN_STRUCT * ) );
+  assert ( word_sign != NULL );
 }
 
 
+/****************************************************************
+**  load_signs
+**
+**  Loads all signs from the sign file into memory. Signs whose
+**  words are not in the dictionary are ignored, since they do
+**  not occur in any document.
+**
+**  IN  : r = Reader of sign file.
+**
+**  OUT : Global variables 'word_sign' and 'compound_signs' are
+**        filled. If a term occurs more than once, the first
+**        sign is used.
+****************************************************************/   
+
 void load_signs 
-       ( f )
-FILE
-  *f;
+       ( r )
+READER
+  r;
 {
   int
-    res;
+    res,
+    total = 0,
+    pair [2];
   char
-    line [ LINE_LENGTH ],
-    *s;
+    *s,
+    *blank;
   SIGN_STRUCT
     *elt;
+  HASH_ENTRY
+    *e1, *e2;
 
-  /* Create sign list */
-  sign_list = create_list ();
-  assert ( sign_list != NULL );
+  compound_signs = create_hash ( 0 );
   
   /* Read sign file one line at a time */
-  while ( fgets ( line, LINE_LENGTH, f ) ) {
+  while ( read_line ( r ) ) {
   
-    /* Get rid of trailing newline character (also included in string) */
-    line [ strlen ( line ) - 1 ] = '\0';
-    
     /* Create new list element for this sign */
-    elt = (SIGN_STRUCT *) malloc ( sizeof ( SIGN_STRUCT ) );
+    elt = (SIGN_STRUCT *) arena_alloc ( main_arena (), sizeof ( SIGN_STRUCT ) );
     assert ( elt != NULL );
     elt -> df = 0;
     elt -> idf = 0.0;
+    elt -> freq = 0;
+    elt -> in_doc = FALSE;
 
     /* Extract sign index */
-    res = sscanf ( line, " %d", &( elt -> idx ) );
-    assert ( res == 1 );
+    res = get_int ( r, &( elt -> idx ) );
+    assert ( res );
     
     /* Extract term interpretation (skip line to beginning of word) */
-    s = line;
+    s = line_string ( r );
     while ( ! isalpha ( *s ) ) {
       s ++;
     }
     elt -> term = duplicate ( s );
     
-    /* Add 'elt' to list, sorted by terms */
-    elt = (SIGN_STRUCT *) add_list ( sign_list, (ELEMENT) elt, comp_sign );
-    assert ( elt != NULL );
+    /* Look up the number(s) of the word(s) of the term */
+    blank = strchr ( elt -> term, ' ' );
+    if ( blank == NULL ) {
+      e1 = lookup_hash ( dictionary, elt -> term, strlen ( elt -> term ) );
+      if ( ( e1 != NULL ) && ( word_sign [ e1 -> val ] == NULL ) ) {
+        word_sign [ e1 -> val ] = elt;
+      }
+    }
+    else {
+      e1 = lookup_hash ( dictionary, elt -> term, blank - elt -> term );
+      e2 = lookup_hash ( dictionary, blank + 1, strlen ( blank + 1 ) );
+      if ( ( e1 != NULL ) && ( e2 != NULL ) ) {
+        pair [0] = e1 -> val;
+        pair [1] = e2 -> val;
+        e1 = add_hash ( compound_signs, (char *) pair, sizeof ( pair ) );
+        if ( count_hash ( compound_signs ) > num_compounds ) {
+          /* New compound term */
+          if ( num_compounds == total ) {
+            total = ( total == 0 ) ? 64 : 2 * total;
+            compound = (SIGN_STRUCT **) ( ( num_compounds == 0 ) ?
+              malloc ( total * sizeof ( SIGN_STRUCT * ) ) :
+              realloc ( compound, total * sizeof ( SIGN_STRUCT * ) ) );
+            assert ( compound != NULL );
+          }
+          e1 -> val = num_compounds;
+          compound [ num_compounds ++ ] = elt;
+        }
+      }
+    }
     
     /* Running count */
     fprintf ( counter, "%d\r", elt -> idx );
@@ -203,243 +321,382 @@ FILE
 
 
 /****************************************************************
-**  dump_weights
+**  spool_term
 **
-**  Prints out weight of each term in 'doc_signs'.
+**  Appends a record to the spool.
 **
-**  IN  : currdoc = number of current document.
+**  IN  : freq   = term frequency or document index.
+**        w1, w2 = word numbers of the term (see TERM_REC).
 ****************************************************************/ 
 
-BOOL enum_wgts
-       ( w )
-ELEMENT
-  w;
+void spool_term
+       ( freq, w1, w2 )
+int
+  freq;
+int
+  w1;
+int
+  w2;
 {
-  WGT_STRUCT
-    *wg;
-  double 
-    wgt;
+  int
+    n;
+
+  if ( spool_used == spool_size ) {
+    if ( spool_size < SPOOL_SIZE ) {
+      /* Enlarge spool in memory */
+      spool_size = ( spool_size == 0 ) ? 4096 : 2 * spool_size;
+      spool = (TERM_REC *) ( ( spool_used == 0 ) ?
+        malloc ( spool_size * sizeof ( TERM_REC ) ) :
+        realloc ( spool, spool_size * sizeof ( TERM_REC ) ) );
+      assert ( spool != NULL );
+    }
+    else {
+      /* Spool is full; move its contents to temporary file */
+      if ( spill == NULL ) {
+        spill = tmpfile ();
+        assert ( spill != NULL );
+      }
+      n = fwrite ( spool, sizeof ( TERM_REC ), spool_used, spill );
+      assert ( n == spool_used );
+      spool_used = 0;
+    }
+  }
+  spool [ spool_used ].freq = freq;
+  spool [ spool_used ].w1 = w1;
+  spool [ spool_used ].w2 = w2;
+  spool_used ++;
+}
 
-  /* Print sign value followed by weight */
-  wg = (WGT_STRUCT *) w;
-  
-  if ( wg -> freq > 0 ) {
-    wgt = (double) ( wg -> freq ) / norm;
-    printf ( "\t%d\t%f\n", wg -> sign, wgt );
+
+/****************************************************************
+**  replay_spool, next_term
+**
+**  'replay_spool' starts reading the spool from the beginning;
+**  'next_term' returns the next record, or NULL at its end.
+****************************************************************/ 
+
+void replay_spool
+       ( )
+{
+  int
+    n;
+
+  if ( spill != NULL ) {
+    /* Move remaining records to temporary file and rewind it */
+    if ( spool_used > 0 ) {
+      n = fwrite ( spool, sizeof ( TERM_REC ), spool_used, spill );
+      assert ( n == spool_used );
+      spool_used = 0;
+    }
+    rewind ( spill );
+    spool_avail = 0;
+  }
+  else {
+    spool_avail = spool_used;
   }
-  return ( TRUE );
+  spool_pos = 0;
 }
 
 
-void dump_weights
-       ( currdoc )
-int 
-  currdoc;
+TERM_REC *next_term
+            ( )
 {
-  norm = sqrt ( norm );
-  if ( doc_signs != NULL ) {
-    printf ( "%d\n", currdoc );
-  
-    /* List all terms with non-zero weight */
-    enum_list ( doc_signs, enum_wgts, ENUM_FORWARD );
-  
-    /* Clear list for next document */
-    destroy_list ( &doc_signs );
+  if ( spool_pos == spool_avail ) {
+    if ( spill == NULL ) return ( NULL );
+
+    /* Read next block of records from temporary file */
+    spool_avail = fread ( spool, sizeof ( TERM_REC ), spool_size, spill );
+    spool_pos = 0;
+    if ( spool_avail == 0 ) return ( NULL );
   }
-  
-  doc_signs = create_list ();
-  assert ( doc_signs != NULL );
+  return ( &spool [ spool_pos ++ ] );
 }
 
 
 /****************************************************************
-**  find_sign
-**
-**  Finds the entry of the specified sign in 'sign_list'.
+**  read_descr
 **
-**  IN  : s = character representation of a sign.
+**  Reads the document description file into the spool.
 **
-**  OUT : The function returns a pointer to the sign's entry
-**        or NULL if the sign is not in 'sign_list'.
+**  IN  : r = Reader of document description file.
 ****************************************************************/ 
 
-SIGN_STRUCT *find_sign
-               ( s )
-char
-  *s;
+void read_descr
+       ( r )
+READER
+  r;
 {
-  SIGN_STRUCT
-    temp, *sgn;
+  int
+    doc, w1, w2;
 
-  temp.term = s;
-  return ( (SIGN_STRUCT *) lookup_list ( sign_list, (ELEMENT) &temp,
-                                         comp_sign ) );
+  /* Read input file line by line */
+  while ( read_line ( r ) ) {
+
+    /* Try to interpret text; assign as much fields as possible */
+    if ( ! get_int ( r, &doc ) ) continue;
+    if ( ! get_int ( r, &w1 ) ) {
+      /* Index of new document in 'doc' */
+      fprintf ( counter, "%d\r", doc );
+      spool_term ( doc, -1, -1 );
+    }
+    else {
+      /* Frequency in 'doc' and one or two word numbers */
+      assert ( w1 >= 0 );
+      if ( get_int ( r, &w2 ) ) {
+        assert ( w2 >= 0 );
+      }
+      else {
+        w2 = -1;
+      }
+      spool_term ( doc, w1, w2 );
+    }
+  }
+  fprintf ( counter, "\n" );
 }
 
 
 /****************************************************************
-**  find_wgt
+**  find_compound
 **
-**  Finds the entry of the specified sign in 'doc_signs'.
+**  Finds the sign of a compound term.
 **
-**  IN  : s = number of a sign.
+**  IN  : w1, w2 = numbers of the words of the term.
 **
-**  OUT : The function returns a pointer to the sign's entry.
-**        If the sign did not exist, it is created automatically.
+**  OUT : The function returns a pointer to the sign's entry
+**        or NULL if the term is not a sign.
 ****************************************************************/ 
 
-WGT_STRUCT *find_wgt
-              ( s )
+SIGN_STRUCT *find_compound
+               ( w1, w2 )
+int
+  w1;
 int
-  s;
+  w2;
+{
+  int
+    pair [2];
+  HASH_ENTRY
+    *e;
+
+  if ( num_compounds == 0 ) return ( NULL );
+  pair [0] = w1;
+  pair [1] = w2;
+  e = lookup_hash ( compound_signs, (char *) pair, sizeof ( pair ) );
+  return ( ( e != NULL ) ? compound [ e -> val ] : NULL );
+}
+
+
+/****************************************************************
+**  term_sign
+**
+**  Finds the sign of a term record.
+**
+**  IN  : t = term record of the spool.
+**
+**  OUT : The function returns a pointer to the sign's entry
+**        or NULL if the term is not a sign.
+****************************************************************/ 
+
+SIGN_STRUCT *term_sign
+               ( t )
+TERM_REC
+  *t;
 {
-  WGT_STRUCT
-    *wgt;
-
-  wgt = (WGT_STRUCT *) malloc ( sizeof ( WGT_STRUCT ) );
-  assert ( wgt != NULL );
-  wgt -> sign = s;
-  wgt -> freq = 0;
-  wgt = (WGT_STRUCT *) add_list ( doc_signs, (ELEMENT) wgt,
-                                  comp_wgts );
-  assert ( wgt != NULL );
-  return ( wgt );
+  assert ( t -> w1 < num_words );
+  if ( t -> w2 < 0 ) {
+    return ( word_sign [ t -> w1 ] );
+  }
+  assert ( t -> w2 < num_words );
+  return ( find_compound ( t -> w1, t -> w2 ) );
 }
 
 
 /****************************************************************
-**  read_descr
+**  calc_df
+**
+**  Calculates the number of documents and the document
+**  frequency of each sign.
+****************************************************************/ 
+
+void calc_df
+       ( )
+{
+  TERM_REC
+    *t;
+  SIGN_STRUCT
+    *elt, *part1, *part2;
+
+  replay_spool ();
+  while ( ( t = next_term () ) != NULL ) {
+    if ( t -> w1 < 0 ) {
+      /* idf/df values need number of documents */
+      docnum ++;
+      continue;
+    }
+
+    elt = term_sign ( t );
+    if ( elt != NULL ) {
+      /* term exists as a sign; increase document frequency */
+      elt -> df ++;
+      if ( t -> w2 >= 0 ) {
+        /* Decrease document frequency of individual components */
+        part1 = word_sign [ t -> w1 ];
+        part2 = word_sign [ t -> w2 ];
+        assert ( part1 != NULL );
+        assert ( part2 != NULL );
+        part1 -> df --;
+        part2 -> df --;
+      }
+    }
+  }
+}
+
+
+/****************************************************************
+**  dump_weights
 **
-**  Read document description file. Depending on mode, either
-**  calculates df/idf or weights.
+**  Prints out weight of each sign in 'doc_signs' and clears
+**  'doc_signs'.
 **
-**  IN  : f    = Handle to open document description file.
-**        mode = FALSE --> Calculate df/idf values.
-**               TRUE  --> Calculate and print weights.
+**  IN  : currdoc = number of current document.
 ****************************************************************/ 
 
-int comp_wgts
-      ( w1, w2 )
+void add_freq
+       ( elt, freq )
+SIGN_STRUCT
+  *elt;
+int
+  freq;
+{
+  if ( ! elt -> in_doc ) {
+    /* First occurrence of sign in current document */
+    if ( num_doc_signs == max_doc_signs ) {
+      max_doc_signs = ( max_doc_signs == 0 ) ? 256 : 2 * max_doc_signs;
+      doc_signs = (SIGN_STRUCT **) ( ( num_doc_signs == 0 ) ?
+        malloc ( max_doc_signs * sizeof ( SIGN_STRUCT * ) ) :
+        realloc ( doc_signs, max_doc_signs * sizeof ( SIGN_STRUCT * ) ) );
+      assert ( doc_signs != NULL );
+    }
+    doc_signs [ num_doc_signs ++ ] = elt;
+    elt -> in_doc = TRUE;
+  }
+  elt -> freq += freq;
+}
+
+
+int comp_signs
+      ( s1, s2 )
 ELEMENT
-  w1;
+  s1;
 ELEMENT 
-  w2;
+  s2;
+{
+  /* order signs by sign index */
+  return ( ((SIGN_STRUCT *) s1) -> idx - ((SIGN_STRUCT *) s2) -> idx );
+}
+
+
+void dump_weights
+       ( currdoc )
+int 
+  currdoc;
 {
   int
-    a, b;
-    
-  /* order pairs ( sign, term freq ) by sign index */
-  a = ((WGT_STRUCT *) w1 ) -> sign;
-  b = ((WGT_STRUCT *) w2 ) -> sign;
-  
-  return ( a - b );
+    i, freq;
+  double
+    wgt;
+
+  norm = sqrt ( norm );
+  printf ( "%d\n", currdoc );
+
+  /* List all signs with non-zero weight; different signs with the
+     same index are added up */
+  sort_elements ( (ELEMENT *) doc_signs, num_doc_signs, comp_signs );
+  freq = 0;
+  for ( i = 0; i < num_doc_signs; i ++ ) {
+    freq += doc_signs [i] -> freq;
+    doc_signs [i] -> freq = 0;
+    doc_signs [i] -> in_doc = FALSE;
+    if ( ( i + 1 < num_doc_signs ) &&
+         ( doc_signs [ i + 1 ] -> idx == doc_signs [i] -> idx ) ) {
+      continue;
+    }
+
+    /* Print sign value followed by weight */
+    if ( freq > 0 ) {
+      wgt = (double) freq / norm;
+      printf ( "\t%d\t%f\n", doc_signs [i] -> idx, wgt );
+    }
+    freq = 0;
+  }
+
+  /* Clear list for next document */
+  num_doc_signs = 0;
 }
 
 
-void read_descr
-       ( f, mode )
-FILE
-  *f;
-BOOL
-  mode;
+/****************************************************************
+**  calc_weights
+**
+**  Calculates and prints the weights of the signs of each
+**  document.
+****************************************************************/ 
+
+void calc_weights
+       ( )
 {
-  char
-    w1 [ MAX_WORDLEN ],
-    w2 [ MAX_WORDLEN ],
-    line [ LINE_LENGTH ];
+  TERM_REC
+    *t;
   SIGN_STRUCT
-    *part1, *part2,
     *elt;
-  WGT_STRUCT
-    *wgt;
   int
-    n, currdoc, doc;
+    currdoc;
+  BOOL
+    started = FALSE;
   double
     log2, nrm;
 
   log2 = log ( 2.0 );
 
-  /* Read input file line by line */
-  while ( fgets ( line, LINE_LENGTH, f ) ) {
+  replay_spool ();
+  while ( ( t = next_term () ) != NULL ) {
+    if ( t -> w1 < 0 ) {
+      /* New document; dump weights of previous doc and clear */
+      if ( started ) {
+        dump_weights ( currdoc );
+      }
+      started = TRUE;
+      norm = 0.0;
+      currdoc = t -> freq;
+      fprintf ( counter, "%d\r", currdoc );
+      continue;
+    }
 
-    /* Try to interpret text; sscanf will assign as much fields as possible */
-    n = sscanf ( line, " %d %s %s", &doc, w1, w2 );
-    
-    switch ( n ) {
-    
-      case 1 :
-        /* Index of new document in 'doc' */
-        fprintf ( counter, "%d\r", doc );
-        if ( ! mode ) {
-          /* idf/df values need number of documents */
-          docnum ++;
-        }
-        else {
-          /* weight calculation; dump weights of previous doc and clear */
-          dump_weights ( currdoc );
-          norm = 0.0;
-          currdoc = doc;
-        }
-        break;
-        
-      case 2 :
-      case 3 :
-        /* Frequency in 'doc' and one or two words */
-        if ( n == 3 ) {
-          /* two words; concatenate them */
-          part1 = find_sign ( w1 );
-          part2 = find_sign ( w2 );
-          strcat ( w1, " " );
-          strcat ( w1, w2 );
-        }
-        
-        /* we now have a word in w1; make dummy sign structure */
-        elt = find_sign ( w1 );
-        if ( ! mode ) {
-          /* idf/df calculation */
-          if ( elt != NULL ) {
-            /* w1 exists as a sign; increase document frequency */
-            elt -> df ++;
-	    if ( n == 3 ) {
-	      /* Decrease document frequency of individual components */
-	      assert ( part1 != NULL );
-	      assert ( part2 != NULL );
-	      part1 -> df --;
-	      part2 -> df --;
-	    }
-          }
-        }
-        else {
-          /* weight calculation; add term to list for this document */
-          if ( elt != NULL ) {
+    elt = term_sign ( t );
+    if ( elt != NULL ) {
           
-            /* idf already calculated? */
-            if ( ( elt -> df > 0 ) && ( elt -> idf == 0.0 ) ) {
-              elt -> idf = log ( (double) docnum / (double) elt -> df ) / log2;
-            }
+      /* idf already calculated? */
+      if ( ( elt -> df > 0 ) && ( elt -> idf == 0.0 ) ) {
+        elt -> idf = log ( (double) docnum / (double) elt -> df ) / log2;
+      }
             
-            /* Calculate norm(d) of current document */
-            nrm = (double) doc * elt -> idf;
-            norm += nrm * nrm;
+      /* Calculate norm(d) of current document */
+      nrm = (double) t -> freq * elt -> idf;
+      norm += nrm * nrm;
             
-            /* Add term */
-            wgt = find_wgt ( elt -> idx );
-            wgt -> freq += doc;
-            if ( n == 3 ) {
-              /* This was a multiword term, decrement freqs of
-                 individual components */
-              wgt = find_wgt ( part1 -> idx );
-              wgt -> freq -= doc;
-              wgt = find_wgt ( part2 -> idx );
-              wgt -> freq -= doc;
-            }
-          }
-        }
-        break;
+      /* Add term */
+      add_freq ( elt, t -> freq );
+      if ( t -> w2 >= 0 ) {
+        /* This was a multiword term, decrement freqs of
+           individual components */
+        add_freq ( word_sign [ t -> w1 ], - t -> freq );
+        add_freq ( word_sign [ t -> w2 ], - t -> freq );
+      }
     }
   }
+
   /* Dump last document */
-  if ( mode ) {
+  if ( started ) {
     dump_weights ( currdoc );
   }
   fprintf ( counter, "\n" );
@@ -457,14 +714,14 @@ int
 char
   *argv [];
 {
-  FILE
-    *f;
+  READER
+    r;
 
   /* Program title */
   fprintf ( stderr, PROG );
 
   /* Get verbose or quiet mode */
-  if ( ( argc == 4 ) && ( *argv [3] == 'Q' ) ) {
+  if ( ( argc == 5 ) && ( *argv [4] == 'Q' ) ) {
     /* in case of quiet mode: redirect running counts to /dev/null */
     counter = fopen ( "/dev/null", "r" );
     assert ( counter != NULL );
@@ -475,31 +732,42 @@ char
   }
 
   /* Check arguments */
-  if ( argc < 3 ) {
+  if ( argc < 4 ) {
     fprintf ( stderr, USAGE );
     return ( 1 );
   }
   
+  /* Read document description once; "-" is the standard input */
+  fprintf ( stderr, "Reading document description.\n" );
+  if ( strcmp ( argv [1], "-" ) == 0 ) {
+    r = stream_reader ( stdin );
+  }
+  else {
+    r = open_reader ( argv [1] );
+  }
+  read_descr ( r );
+  close_reader ( &r );
+
+  /* Load dictionary; it is complete only after the end of the
+     document description if both are written by parse_itemcoll */
+  fprintf ( stderr, "Loading dictionary.\n" );
+  r = open_reader ( argv [3] );
+  load_dictionary ( r );
+  close_reader ( &r );
+
   /* Open sign file */
-  f = open_file ( argv [2] );
+  r = open_reader ( argv [2] );
   
   /* Load signs into memory */
   fprintf ( stderr, "Loading signs.\n" );
-  load_signs ( f );
-  fclose ( f );
-  
-  /* Open document description */
-  f = open_file ( argv [1] );
+  load_signs ( r );
+  close_reader ( &r );
   
-  /* Read document description the first time */
   fprintf ( stderr, "Calculating df and idf values.\n" );
-  read_descr ( f, FALSE );
+  calc_df ();
   
-  /* Read document description again */
   fprintf ( stderr, "Calculating weights.\n" );
-  rewind ( f );
-  read_descr ( f, TRUE );
+  calc_weights ();
   
-  fclose ( f );
   return ( 0 );
 }
@@ -19,7 +19,8 @@
 *	cluster <atom-docs>
 *
 *   where <atom-docs> is a file containing a list of atomic concepts
-*   and the documents each occurs in. Each cluster and its members
+*   and the documents each occurs in (ATOM_DOCS or a binary atom
+*   index). Each cluster and its members
 *   is written to the standard output.
 *
 *****************************************************************
@@ -61,18 +62,20 @@
 
 #include "boolean.h"
 #include "list.h"
+#include "intlist.h"
 #include "util.h"
+#include "atomidx.h"
 
 
-#define LINE_LENGTH	100
 
 #define MAX_CLUSTERSIZE	30	/* Max. no. of concepts in a cluster */
 
 
 /* A vector is represented by a list which contains all non-zero elements
-   of the vector. Element type VECTOR_ELT */
+   of the vector. The keys are document indices, the values are the
+   frequencies of the atomic concepts in the documents. */
 typedef
-  LIST VECTOR;
+  INTFLOAT_LIST VECTOR;
 
 typedef
   struct C_NODE {
@@ -83,12 +86,6 @@ typedef
     struct C_NODE	*son_right;	/* hierarchical cluster tree */
   } CLUSTER_NODE;
 
-typedef
-  struct {
-    int		doc;	/* Index of document */
-    double	freq;	/* Frequency of atomic concept in document */
-  } VECTOR_ELT;
-
 
 LIST
   cluster_list;		/* List of all clusters */
@@ -119,19 +116,17 @@ FILE
 ****************************************************************/   
 
 #ifndef BSDUNIX
-void read_concepts ( FILE * );
+void read_concepts ( ATOM_INDEX );
 double calc_distance ( CLUSTER_NODE *, CLUSTER_NODE * );
 VECTOR calc_centroid ( CLUSTER_NODE *, CLUSTER_NODE * );
 int comp_node ( ELEMENT, ELEMENT );
-int comp_vector ( ELEMENT, ELEMENT );
 CLUSTER_NODE *add_node ( int, VECTOR );
 BOOL enum_primary ( ELEMENT );
 BOOL enum_secondary ( ELEMENT );
-BOOL enum_common ( ELEMENT, ELEMENT );
-BOOL enum_noncommon ( ELEMENT );
-BOOL enum_common1 ( ELEMENT, ELEMENT );
-BOOL enum_noncommon1 ( ELEMENT );
-void add_elt ( VECTOR, int, double );
+BOOL enum_common ( int, double, double );
+BOOL enum_noncommon ( int, double );
+BOOL enum_common1 ( int, double, double );
+BOOL enum_noncommon1 ( int, double );
 void build_tree ( void );
 void output_tree ( CLUSTER_NODE * );
 void traverse_tree ( CLUSTER_NODE * );
@@ -141,7 +136,6 @@ void read_concepts ();
 double calc_distance ();
 VECTOR calc_centroid ();
 int comp_node ();
-int comp_vector ();
 CLUSTER_NODE *add_node ();
 BOOL enum_primary ();
 BOOL enum_secondary ();
@@ -149,7 +143,6 @@ BOOL enum_common ();
 BOOL enum_noncommon ();
 BOOL enum_common1 ();
 BOOL enum_noncommon1 ();
-void add_elt ();
 void build_tree ();
 void output_tree ();
 void traverse_tree ();
@@ -195,10 +188,9 @@ VECTOR
     *node = NULL;
     
   /* Create a cluster node for the specified atomic concept */
-  if ( count_list ( vector ) > 0 ) {
+  if ( count_iflist ( vector ) > 0 ) {
     /* Only needs to be done if atomic concept occurs in a document */
-    node = (CLUSTER_NODE *) malloc ( sizeof ( CLUSTER_NODE ) );
-    assert ( node != NULL );
+    node = (CLUSTER_NODE *) arena_alloc ( main_arena (), sizeof ( CLUSTER_NODE ) );
     node -> centroid = vector;
     node -> num = 1;	/* Default value for initial clusters, will be overwritten */
     node -> key = key;
@@ -211,50 +203,6 @@ VECTOR
 }
 
 
-/****************************************************************
-**  add_elt
-**
-**  Adds a new vector component to a vector.
-**
-**  IN  : vector = vector to which component should be added.
-**        index  = component index
-**        value  = component value
-****************************************************************/   
-
-int comp_vector
-      ( a, b )
-ELEMENT
-  a;
-ELEMENT
-  b;
-{
-  return ( ((VECTOR_ELT *) a) -> doc - ((VECTOR_ELT *) b) -> doc );
-}
-
-
-void add_elt 
-       ( vector, index, value )
-VECTOR
-  vector;
-int
-  index;
-double
-  value;
-{
-  VECTOR_ELT
-    *elt;
-  
-  elt = (VECTOR_ELT *) malloc ( sizeof ( VECTOR_ELT ) );
-  assert ( elt != NULL );
-  
-  elt -> doc = index;
-  elt -> freq = value;
-  
-  elt = (VECTOR_ELT *) add_list ( vector, (ELEMENT) elt, comp_vector );
-  assert ( elt != NULL );
-}
-
-
 /****************************************************************
 **  read_concepts
 **
@@ -263,60 +211,46 @@ double
 **  concept. The centroid vector of such a cluster is the
 **  representation of the atomic concept in the document space.
 **
-**  IN  : Handle to open 'ATOM_DOCS' file.
+**  IN  : x = atom index ('ATOM_DOCS' file).
 ****************************************************************/   
 
 void read_concepts
-       ( f )
-FILE
-  *f;
+       ( x )
+ATOM_INDEX
+  x;
 {
   VECTOR
     vector;
+  POSTINGS
+    p;
   int
-    n, d, curr_atom;
-  char
-    line [ LINE_LENGTH ];
+    i, curr_atom;
 
   /* Create empty cluster list */
   cluster_list = create_list ();
   assert ( cluster_list != NULL );
+  list_set_arena ( cluster_list, main_arena () );
   
-  curr_atom = -1;
-  
-  /* Ignore first line of ATOM_DOCS */
-  fgets ( line, LINE_LENGTH, f );
-  
-  /* Read ATOM_DOCS line by line */
-  while ( fgets ( line, LINE_LENGTH, f ) ) {
-    /* Read a number */
-    n = sscanf ( line, " %d", &d );
-    assert ( n == 1 );
-    
-    /* If number followed by a colon, then this is an atomic concept */
-    if ( strchr ( line, ':' ) != NULL ) {
+  /* Read ATOM_DOCS one atomic concept at a time */
+  for ( i = 0; i < index_atoms ( x ); i ++ ) {
+    curr_atom = index_atom ( x, i );
     
-      if ( curr_atom != -1 ) {
-        /* Create cluster node and add to cluster list */
-        add_node ( curr_atom, vector );
-      }
+    /* Create empty vector */
+    vector = create_iflist ( 0 );
       
-      /* Create empty vector */
-      vector = create_list ();
-      assert ( vector != NULL );
-      curr_atom = d;
-      
-      /* Running count */
-      fprintf ( counter, "%d\r", d );
-    }
-    else {
-      /* number is a document index; add to centroid vector */
-      add_elt ( vector, (int) d, 1.0 );
+    /* Running count */
+    fprintf ( counter, "%d\r", curr_atom );
+
+    /* Entries are document indices; add to centroid vector */
+    open_postings ( x, i, &p );
+    while ( next_posting ( &p ) ) {
+      append_iflist ( vector, p.doc, 1.0 );
     }
+
+    /* Create cluster node and add to cluster list */
+    finalize_iflist ( vector );
+    add_node ( curr_atom, vector );
   }
-  
-  /* Process last concept */
-  add_node ( curr_atom, vector );
   fprintf ( counter, "\n" );
 }
 
@@ -337,36 +271,31 @@ FILE
 ****************************************************************/   
 
 BOOL enum_noncommon
-       ( e )
-ELEMENT
-  e;
+       ( doc, freq )
+int
+  doc;
+double
+  freq;
 {
-  double
-    t;
-  
-  t = ((VECTOR_ELT *) e) -> freq;
-  glob_sum += t * t;
+  glob_sum += freq * freq;
   return ( TRUE );
 }
 
 
 BOOL enum_common
-       ( e1, e2 )
-ELEMENT
-  e1;
-ELEMENT
-  e2;
+       ( doc, freq1, freq2 )
+int
+  doc;
+double
+  freq1;
+double
+  freq2;
 {
-  VECTOR_ELT
-    *c1, *c2;
   double
     t;
     
-  c1 = (VECTOR_ELT *) e1;
-  c2 = (VECTOR_ELT *) e2;
-  
   /* Subtract vector components */
-  t = c1 -> freq - c2 -> freq;
+  t = freq1 - freq2;
   glob_sum += t * t;
   
   return ( TRUE );
@@ -383,13 +312,13 @@ CLUSTER_NODE
   glob_sum = 0.0;
     
   /* Get symmetric set difference A - B */
-  find_diff ( a -> centroid, b -> centroid, comp_vector, enum_noncommon );
+  find_diff_if ( a -> centroid, b -> centroid, enum_noncommon );
   
   /* Get symmetric set difference B - A */
-  find_diff ( b -> centroid, a -> centroid, comp_vector, enum_noncommon );
+  find_diff_if ( b -> centroid, a -> centroid, enum_noncommon );
   
   /* Get union A AND B */
-  find_union ( a -> centroid, b -> centroid, comp_vector, enum_common );
+  find_union_if ( a -> centroid, b -> centroid, enum_common );
   
   /* Return weighted distance measure */
   return ( ( (double) a -> num * (double) b -> num * glob_sum ) / 
@@ -411,37 +340,30 @@ CLUSTER_NODE
 ****************************************************************/   
 
 BOOL enum_noncommon1
-       ( e )
-ELEMENT
-  e;
+       ( doc, freq )
+int
+  doc;
+double
+  freq;
 {
-  VECTOR_ELT
-    *elt;
-  
-  elt = (VECTOR_ELT *) e;
-  
   /* Create new vector element */
-  add_elt ( glob_centroid, elt -> doc, elt -> freq * glob_multiplier );
+  append_iflist ( glob_centroid, doc, freq * glob_multiplier );
   return ( TRUE );
 }
 
 
 BOOL enum_common1
-       ( e1, e2 )
-ELEMENT
-  e1;
-ELEMENT
-  e2;
+       ( doc, freq1, freq2 )
+int
+  doc;
+double
+  freq1;
+double
+  freq2;
 {
-  VECTOR_ELT
-    *elt1, *elt2;
-  
-  elt1 = (VECTOR_ELT *) e1;
-  elt2 = (VECTOR_ELT *) e2;
-    
   /* Create new vector element */
-  add_elt ( glob_centroid, elt1 -> doc, 
-            ( elt1 -> freq * glob_n1 + elt2 -> freq * glob_n2 ) / glob_div );
+  append_iflist ( glob_centroid, doc, 
+                  ( freq1 * glob_n1 + freq2 * glob_n2 ) / glob_div );
 
   return ( TRUE );
 }
@@ -455,8 +377,8 @@ CLUSTER_NODE
   *b;
 {
   /* Add vector elements to centroid which do not occur in both vectors */
-  glob_centroid = create_list ();
-  assert ( glob_centroid != NULL );
+  glob_centroid = create_iflist ( count_iflist ( a -> centroid ) +
+                                  count_iflist ( b -> centroid ) );
   
   glob_div = (double) ( a -> num + b -> num );
   glob_n1 = (double) a -> num;
@@ -464,14 +386,17 @@ CLUSTER_NODE
   
   /* Get symmetric set difference A - B */
   glob_multiplier = glob_n1 / glob_div;
-  find_diff ( a -> centroid, b -> centroid, comp_vector, enum_noncommon1 );
+  find_diff_if ( a -> centroid, b -> centroid, enum_noncommon1 );
   
   /* Get symmetric set difference B - A */
   glob_multiplier = glob_n2 / glob_div;
-  find_diff ( b -> centroid, a -> centroid, comp_vector, enum_noncommon1 );
+  find_diff_if ( b -> centroid, a -> centroid, enum_noncommon1 );
   
   /* Get union A AND B */
-  find_union ( a -> centroid, b -> centroid, comp_vector, enum_common1 );
+  find_union_if ( a -> centroid, b -> centroid, enum_common1 );
+
+  /* The three parts were appended separately; sort them */
+  finalize_iflist ( glob_centroid );
 
   return ( glob_centroid );
 }
@@ -633,8 +558,8 @@ int
 char
   *argv [];
 {
-  FILE
-    *f;
+  ATOM_INDEX
+    x;
     
   /* Program title */
   fprintf ( stderr, PROG );
@@ -657,11 +582,12 @@ char
   }
   
   /* Open atom-docs file */
-  f = open_file ( argv [1] );
+  x = open_index ( argv [1] );
   
   /* Read concepts and build initial clusters */
   fprintf ( stderr, "Reading concepts.\n" );
-  read_concepts ( f );
+  read_concepts ( x );
+  close_index ( &x );
   
   /* Build hierarchical cluster tree */
   fprintf ( stderr, "Building cluster tree.\n" );
@@ -61,8 +61,8 @@
 #include "boolean.h"
 #include "list.h"
 #include "util.h"
+#include "reader.h"
 
-#define LINE_LENGTH	100
 
 
 typedef
@@ -83,6 +83,10 @@ typedef
 LIST
   atom_list,     /* Temporary list of atoms for a sign */
   sign_list;     /* List of all signs */
+
+ARENA
+  temp_arena;    /* Arena of atom_list */
+
 int
   maxatom = 1;   /* Highest atomic concept so far; must be <> 0 */
   
@@ -108,15 +112,15 @@ FILE
 
 #ifndef BSDUNIX
 int main ( int, char *[] );
-void load_signs ( FILE * );
-void handle_situations ( FILE * );
-void handle_abstractions ( FILE * );
+void load_signs ( READER );
+void handle_situations ( READER );
+void handle_abstractions ( READER );
 int comp_sign ( ELEMENT, ELEMENT );
 int comp_atom ( ELEMENT, ELEMENT );
 BOOL enum_atoms ( ELEMENT );
 BOOL enum_signs ( ELEMENT );
 BOOL build_atoms ( ELEMENT );
-void add_atom ( LIST, int, SIGN_STRUCT * );
+void add_atom ( LIST, ARENA, int, SIGN_STRUCT * );
 SIGN_STRUCT *find_sign ( int );
 BOOL check_synonym ( SIGN_STRUCT * );
 void pop_call ( void );
@@ -142,9 +146,10 @@ void pop_call ();
 **
 **  Adds an atomic concept to a specified list.
 **
-**  IN  : list = Handle to list with elements of type ATOM_STRUCT.
-**        s    = Sign value (or undefined if this is a reference).
-**        r    = Reference (or NULL if none).
+**  IN  : list  = Handle to list with elements of type ATOM_STRUCT.
+**        arena = Arena of the list elements.
+**        s     = Sign value (or undefined if this is a reference).
+**        r     = Reference (or NULL if none).
 **
 **  Negative values: subtract 1 from the negative sign value
 **  (because +0 and -0 are identical).
@@ -181,9 +186,11 @@ ELEMENT
 
 
 void add_atom 
-       ( list, s, r )
+       ( list, arena, s, r )
 LIST
   list;
+ARENA
+  arena;
 int
   s;
 SIGN_STRUCT
@@ -192,8 +199,7 @@ SIGN_STRUCT
   ATOM_STRUCT
     *atm;
 
-  atm = (ATOM_STRUCT *) malloc ( sizeof ( ATOM_STRUCT ) );
-  assert ( atm != NULL );
+  atm = (ATOM_STRUCT *) arena_alloc ( arena, sizeof ( ATOM_STRUCT ) );
   atm -> atom = s;
   atm -> ref = r;
   atm = (ATOM_STRUCT *) add_list ( list, (ELEMENT) atm, comp_atom );
@@ -206,7 +212,7 @@ SIGN_STRUCT
 **
 **  Loads all signs from the sign file into memory.
 **
-**  IN  : f = Handle to open sign file.
+**  IN  : r = Reader of sign file.
 **
 **  OUT : Global variable 'sign_list' is filled.
 ****************************************************************/   
@@ -224,36 +230,35 @@ ELEMENT
 
 
 void load_signs 
-       ( f )
-FILE
-  *f;
+       ( r )
+READER
+  r;
 {
   int
     initatom,
     res;
-  char
-    line [ LINE_LENGTH ];
   SIGN_STRUCT
     *elt;
 
   /* Create sign list */
   sign_list = create_list ();
   assert ( sign_list != NULL );
+  list_set_arena ( sign_list, main_arena () );
   
   /* Read sign file one line at a time */
-  while ( fgets ( line, LINE_LENGTH, f ) ) {
+  while ( read_line ( r ) ) {
   
     /* Create new list element for this sign */
-    elt = (SIGN_STRUCT *) malloc ( sizeof ( SIGN_STRUCT ) );
-    assert ( elt != NULL );
+    elt = (SIGN_STRUCT *) arena_alloc ( main_arena (), sizeof ( SIGN_STRUCT ) );
 
     /* Extract sign index */
-    res = sscanf ( line, " %d", &( elt -> sign ) );
-    assert ( res == 1 );
+    res = get_int ( r, &( elt -> sign ) );
+    assert ( res );
     
     /* Create empty list of atomic concepts */
     elt -> atoms = create_list ();
     assert ( elt -> atoms != NULL );
+    list_set_arena ( elt -> atoms, main_arena () );
     
     /* Add sign to list */
     elt = (SIGN_STRUCT *) add_list ( sign_list, (ELEMENT) elt, comp_sign );
@@ -271,7 +276,7 @@ FILE
     
     /* Add atomic concept (either new or atom of synonym) to list for
        current sign */
-    add_atom ( elt -> atoms, initatom, NULL );
+    add_atom ( elt -> atoms, main_arena (), initatom, NULL );
     elt -> initatom = elt -> newinit = initatom;
 
     /* Running count */
@@ -314,23 +319,22 @@ int
 
 
 void handle_situations
-       ( f )
-FILE
-  *f;
+       ( r )
+READER
+  r;
 {
-  char
-    line [ LINE_LENGTH ];
   int
     ag, ob, ia, io, res, n;
   SIGN_STRUCT
     *agn, *obj, *iag, *iob;
 
   /* Read one situation at a time */
-  while ( fgets ( line, LINE_LENGTH, f ) ) {
+  while ( read_line ( r ) ) {
   
     /* Get situation no. and agn,obj,iag,iob values */
-    res = sscanf ( line, "%d %d %d %d %d", &n, &ag, &ob, &ia, &io );
-    assert ( res == 5 );
+    res = get_int ( r, &n ) && get_int ( r, &ag ) && get_int ( r, &ob ) &&
+          get_int ( r, &ia ) && get_int ( r, &io );
+    assert ( res );
     
     /* Find corresponding list entries */
     agn = find_sign ( ag );
@@ -339,15 +343,15 @@ FILE
     iob = find_sign ( io );
     
     /* c(iag) is a subset of c(agn); add reference to agn */
-    add_atom ( agn -> atoms, ia, iag );
+    add_atom ( agn -> atoms, main_arena (), ia, iag );
     
     /* c(iob) is a subset of c(obj); add reference to obj */
-    add_atom ( obj -> atoms, io, iob );
+    add_atom ( obj -> atoms, main_arena (), io, iob );
     
     /* c(iag) and c(iob) have a common atomic concept; this concept
        has a negative index */
-    add_atom ( iag -> atoms, -maxatom, NULL );
-    add_atom ( iob -> atoms, -maxatom, NULL );
+    add_atom ( iag -> atoms, main_arena (), -maxatom, NULL );
+    add_atom ( iob -> atoms, main_arena (), -maxatom, NULL );
     maxatom ++;
     
     /* running count */
@@ -362,16 +366,14 @@ FILE
 **
 **  Loads abstractions from file into memory.
 **
-**  IN  : f = handle to open abstraction file.
+**  IN  : r = reader of abstraction file.
 ****************************************************************/ 
 
 void handle_abstractions
-       ( f )
-FILE
-  *f;
+       ( r )
+READER
+  r;
 {
-  char
-    line [ LINE_LENGTH ];
   int
     i = 1,
     res,
@@ -382,16 +384,16 @@ FILE
     *spc;
   
   /* Read one abstraction per line */
-  while ( fgets ( line, LINE_LENGTH, f ) ) {
+  while ( read_line ( r ) ) {
   
     /* Extract specific and general term */
-    res = sscanf ( line, " %d %d", &specific, &general );
-    assert ( res == 2 );
+    res = get_int ( r, &specific ) && get_int ( r, &general );
+    assert ( res );
     
     /* Make a reference from general term to specific term */
     gen = find_sign ( general );
     spc = find_sign ( specific );
-    add_atom ( gen -> atoms, specific, spc );
+    add_atom ( gen -> atoms, main_arena (), specific, spc );
     
     /* running count */
     fprintf ( counter, "%d\r", i );
@@ -499,7 +501,7 @@ ELEMENT
       /* Handle common concept spaces of synonyms */
       atom = curr_sign -> newinit;
     }
-    add_atom ( atom_list, atom, NULL );
+    add_atom ( atom_list, temp_arena, atom, NULL );
   }
   return ( TRUE );
 }
@@ -517,6 +519,8 @@ ELEMENT
   /* Create list which holds all atoms for this sign */
   atom_list = create_list ();
   assert ( atom_list != NULL );
+  temp_arena = create_arena ( 4096 );
+  list_set_arena ( atom_list, temp_arena );
   
   /* Resolve references */
   assert ( stackmax == 0 );      /* stack must be empty */
@@ -527,8 +531,8 @@ ELEMENT
   /* Print all atomic concepts which belong to sign */
   enum_list ( atom_list, enum_atoms, ENUM_FORWARD );
 
-  /* Destroy atom list */
-  destroy_list ( &atom_list );
+  /* Destroy atom list and its elements */
+  destroy_list_arena ( &atom_list );
   return ( TRUE );
 }
 
@@ -544,8 +548,8 @@ int
 char
   *argv [];
 {
-  FILE
-    *f;
+  READER
+    r;
 
   /* Program title */
   fprintf ( stderr, PROG );
@@ -568,28 +572,28 @@ char
   }
   
   /* Open sign file */
-  f = open_file ( argv [1] );
+  r = open_reader ( argv [1] );
   
   /* Load signs into memory */
   fprintf ( stderr, "Loading signs.\n" );
-  load_signs ( f );
-  fclose ( f );
+  load_signs ( r );
+  close_reader ( &r );
   
   /* Open situation file */
-  f = open_file ( argv [2] );
+  r = open_reader ( argv [2] );
   
   /* Process situations */
   fprintf ( stderr, "Processing situations.\n" );
-  handle_situations ( f );
-  fclose ( f );
+  handle_situations ( r );
+  close_reader ( &r );
   
   /* Open abstraction file */
-  f = open_file ( argv [3] );
+  r = open_reader ( argv [3] );
   
   /* Process explicit abstractions */
   fprintf ( stderr, "Processing abstractions.\n" );
-  handle_abstractions ( f );
-  fclose ( f );
+  handle_abstractions ( r );
+  close_reader ( &r );
   
   /* Print results */
   enum_list ( sign_list, enum_signs, ENUM_FORWARD );
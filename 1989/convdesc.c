@@ -0,0 +1,98 @@
+/****************************************************************
+*
+*           S O F T W A R E   S O U R C E   F I L E
+*
+*****************************************************************
+*
+*   Name of file   : convdesc.c
+*   Author         : Guido Hoss
+*   Project        : ETH Diploma Thesis (SS 1989)
+*   Creation Date  : 08/05/89
+*   Type of file   : C Language File
+*
+*   Description
+*   -----------
+*   This utility program converts a document description file
+*   (DOC_DESCR) from text to binary form or vice versa (see
+*   descr.h). All programs reading DOC_DESCR accept both forms.
+*
+*   Call Format
+*   -----------
+*	convert_descr <doc-descr>
+*
+*   If <doc-descr> is a text file, its binary form is written to
+*   the standard output, otherwise its text form.
+*
+*****************************************************************
+*
+*   COPYRIGHT (C) 1989, 2016 BY GUIDO HOSS.
+*
+*   This program is free software: you can redistribute it and/or 
+*   modify it under the terms of the GNU General Public License
+*   as published by the Free Software Foundation, either version 3
+*   of the License, or (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public
+*   License along with this program.  If not, see
+*   <http://www.gnu.org/licenses/>.
+*
+*   Git repository home: <https://github.com/ghoss/Thesis>
+*
+*****************************************************************
+* Date        :
+* Description :
+****************************************************************/   
+
+#define PROG	"Document description converter (gh, 08/05/89)\n"
+#define USAGE	"Usage: convert_descr <doc-descr>\n"
+
+#include <stdio.h>
+#ifdef MSDOS
+#include <process.h>
+#endif
+#include <assert.h>
+
+#include "boolean.h"
+#include "util.h"
+#include "descr.h"
+
+
+/****************************************************************
+**  main
+****************************************************************/   
+
+int main
+      ( argc, argv )
+int
+  argc;
+char
+  *argv [];
+{
+  DESCR
+    d;
+  BOOL
+    binary;
+    
+  /* Program title */
+  fprintf ( stderr, PROG );
+  if ( argc != 2 ) {
+    fprintf ( stderr, USAGE );
+    return ( 1 );
+  }
+  
+  /* Read input file; a binary file is mapped */
+  d = open_descr ( argv [1] );
+  binary = ( d -> map == NULL );
+  fprintf ( stderr, "%d documents, %d weights; writing %s form.\n",
+            descr_docs ( d ), d -> num_wgts, binary ? "binary" : "text" );
+
+  write_descr ( d, stdout, binary );
+  
+  close_descr ( &d );
+  return ( 0 );
+}
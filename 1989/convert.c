@@ -55,10 +55,9 @@
 #endif
 #include <assert.h>
 
+#include "boolean.h"
 #include "util.h"
-
-
-#define LINE_LENGTH	100
+#include "reader.h"
 
 
 /****************************************************************
@@ -87,10 +86,8 @@ char
     res, 
     query, doc,
     curr_query;
-  char
-    line [ LINE_LENGTH ];
-  FILE
-    *f;
+  READER
+    r;
     
   /* Program title */
   fprintf ( stderr, PROG );
@@ -100,15 +97,15 @@ char
   }
   
   /* Open input file */
-  f = open_file ( argv [1] );
+  r = open_reader ( argv [1] );
   curr_query = -1;
   
   /* Read one line at a time */
-  while ( fgets ( line, LINE_LENGTH, f ) ) {
+  while ( read_line ( r ) ) {
   
     /* Original line must contain at least two numbers */
-    res = sscanf ( line, " %d %d", &query, &doc );
-    assert ( res == 2 );
+    res = get_int ( r, &query ) && get_int ( r, &doc );
+    assert ( res );
     
     /* Don't print query number on every line */
     if ( query != curr_query ) {
@@ -119,7 +116,7 @@ char
     printf ( "\t%d\n", doc );
   }
   
-  fclose ( f );
+  close_reader ( &r );
   fprintf ( stderr, "\n" );
   return ( 0 );
 }
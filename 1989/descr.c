@@ -0,0 +1,424 @@
+/****************************************************************
+*
+*           S O F T W A R E   S O U R C E   F I L E
+*
+*****************************************************************
+*
+*   Name of file   : descr.c
+*   Author         : Guido Hoss
+*   Project        : ETH Diploma Thesis (SS 1989)
+*   Creation Date  : 08/05/89
+*   Type of file   : C Language File
+*
+*   Description
+*   -----------
+*   Access to document descriptions in text or binary form, see
+*   descr.h. Binary files are mapped into memory; text files
+*   are parsed once into the same tables.
+*
+*****************************************************************
+*
+*   COPYRIGHT (C) 1989, 2016 BY GUIDO HOSS.
+*
+*   This program is free software: you can redistribute it and/or 
+*   modify it under the terms of the GNU General Public License
+*   as published by the Free Software Foundation, either version 3
+*   of the License, or (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public
+*   License along with this program.  If not, see
+*   <http://www.gnu.org/licenses/>.
+*
+*   Git repository home: <https://github.com/ghoss/Thesis>
+*
+*****************************************************************
+* Date        :
+* Description :
+****************************************************************/   
+
+#include <stdio.h>
+#ifdef MSDOS
+#include <process.h>
+#else
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#endif
+#include <malloc.h>
+#include <assert.h>
+#include <string.h>
+
+#include "boolean.h"
+#include "list.h"
+#include "listsort.h"
+#include "util.h"
+#include "reader.h"
+#include "descr.h"
+
+#define MIN_DOCS	1024	/* Initial size of document table */
+#define MIN_WGTS	16384	/* Initial size of weight table */
+
+
+/****************************************************************
+**  Forward declarations (compiler type checking)
+****************************************************************/
+
+#ifndef BSDUNIX
+DESCR load_text ( READER );
+DESCR load_binary ( FILE *, DESCR_FILE * );
+int comp_index ( ELEMENT, ELEMENT );
+#else
+DESCR load_text ();
+DESCR load_binary ();
+int comp_index ();
+#endif
+
+
+/****************************************************************
+**  load_text
+**
+**  Reads a document description in text form into memory.
+**
+**  IN  : r = reader of DOC_DESCR file.
+**
+**  OUT : Function returns a handle to the description.
+****************************************************************/
+
+DESCR load_text
+        ( r )
+READER
+  r;
+{
+  DESCR
+    d;
+  DESCR_DOC
+    *doc = NULL;
+  int
+    n, max_docs, max_wgts;
+  float
+    w;
+
+  d = (DESCR) malloc ( sizeof ( DESCR_HEADER ) );
+  assert ( d != NULL );
+  max_docs = MIN_DOCS;
+  max_wgts = MIN_WGTS;
+  d -> doc = (DESCR_DOC *) malloc ( max_docs * sizeof ( DESCR_DOC ) );
+  d -> wgt = (DESCR_WGT *) malloc ( max_wgts * sizeof ( DESCR_WGT ) );
+  assert ( ( d -> doc != NULL ) && ( d -> wgt != NULL ) );
+  d -> num_docs = d -> num_wgts = 0;
+
+  /* Read file line by line */
+  while ( read_line ( r ) ) {
+    if ( ! get_int ( r, &n ) ) continue;
+
+    if ( ! get_float ( r, &w ) ) {
+      /* One field -> new document number */
+      if ( d -> num_docs == max_docs ) {
+        max_docs *= 2;
+        d -> doc = (DESCR_DOC *) realloc ( d -> doc,
+                                           max_docs * sizeof ( DESCR_DOC ) );
+        assert ( d -> doc != NULL );
+      }
+      doc = &d -> doc [ d -> num_docs ++ ];
+      doc -> index = n;
+      doc -> first = d -> num_wgts;
+      doc -> count = 0;
+    }
+    else {
+      /* Two fields -> sign index and weight of current document */
+      assert ( doc != NULL );
+      if ( d -> num_wgts == max_wgts ) {
+        max_wgts *= 2;
+        d -> wgt = (DESCR_WGT *) realloc ( d -> wgt,
+                                           max_wgts * sizeof ( DESCR_WGT ) );
+        assert ( d -> wgt != NULL );
+      }
+      d -> wgt [ d -> num_wgts ].sign = n;
+      d -> wgt [ d -> num_wgts ].weight = w;
+      d -> num_wgts ++;
+      doc -> count ++;
+    }
+  }
+
+  d -> order = NULL;
+  d -> map = NULL;
+  d -> size = 0;
+  return ( d );
+}
+
+
+/****************************************************************
+**  load_binary
+**
+**  Maps a document description in binary form into memory.
+**
+**  IN  : f   = DOC_DESCR file.
+**        hdr = header of f, already read.
+**
+**  OUT : Function returns a handle to the description.
+****************************************************************/
+
+DESCR load_binary
+        ( f, hdr )
+FILE
+  *f;
+DESCR_FILE
+  *hdr;
+{
+  DESCR
+    d;
+#ifndef MSDOS
+  struct stat
+    st;
+  int
+    res;
+#else
+  unsigned
+    n;
+#endif
+
+  assert ( hdr -> version == DESCR_VERSION );
+  d = (DESCR) malloc ( sizeof ( DESCR_HEADER ) );
+  assert ( d != NULL );
+  d -> num_docs = hdr -> num_docs;
+  d -> num_wgts = hdr -> num_wgts;
+  d -> size = sizeof ( DESCR_FILE ) + d -> num_docs * sizeof ( DESCR_DOC ) +
+              d -> num_wgts * sizeof ( DESCR_WGT );
+
+#ifndef MSDOS
+  /* File must hold exactly the tables given by the header */
+  res = fstat ( fileno ( f ), &st );
+  assert ( ( res == 0 ) && ( st.st_size == (off_t) d -> size ) );
+  d -> map = mmap ( NULL, (size_t) d -> size, PROT_READ, MAP_PRIVATE,
+                    fileno ( f ), (off_t) 0 );
+  assert ( d -> map != (char *) MAP_FAILED );
+#else
+  d -> map = malloc ( d -> size );
+  assert ( d -> map != NULL );
+  rewind ( f );
+  n = fread ( d -> map, 1, d -> size, f );
+  assert ( n == d -> size );
+#endif
+
+  d -> doc = (DESCR_DOC *) ( d -> map + sizeof ( DESCR_FILE ) );
+  d -> wgt = (DESCR_WGT *) ( d -> doc + d -> num_docs );
+  d -> order = NULL;
+  return ( d );
+}
+
+
+/****************************************************************
+**  open_descr
+**
+**  Opens a document description in text or binary form. Like
+**  'open_file', the program is aborted if the file cannot be
+**  opened.
+**
+**  IN  : s = pointer to null-terminated file name.
+**
+**  OUT : Function returns a handle to the description.
+****************************************************************/
+
+DESCR open_descr
+        ( s )
+char
+  *s;
+{
+  FILE
+    *f;
+  READER
+    r;
+  DESCR
+    d;
+  DESCR_FILE
+    hdr;
+
+  /* Binary files start with DESCR_MAGIC */
+  f = open_file ( s );
+  if ( ( fread ( &hdr, sizeof ( DESCR_FILE ), 1, f ) == 1 ) &&
+       ( memcmp ( hdr.magic, DESCR_MAGIC, sizeof ( hdr.magic ) ) == 0 ) ) {
+    d = load_binary ( f, &hdr );
+    fclose ( f );
+  }
+  else {
+    fclose ( f );
+    r = open_reader ( s );
+    d = load_text ( r );
+    close_reader ( &r );
+  }
+  return ( d );
+}
+
+
+/****************************************************************
+**  close_descr
+**
+**  Frees a document description.
+**
+**  IN  : d = pointer to handle of description.
+**  OUT : '*d' is set to NULL.
+****************************************************************/
+
+void close_descr
+       ( d )
+DESCR
+  *d;
+{
+  if ( *d == NULL ) return;
+  if ( (*d) -> map != NULL ) {
+#ifndef MSDOS
+    munmap ( (*d) -> map, (size_t) (*d) -> size );
+#else
+    free ( (*d) -> map );
+#endif
+  }
+  else {
+    free ( (char *) (*d) -> doc );
+    free ( (char *) (*d) -> wgt );
+  }
+  if ( (*d) -> order != NULL ) free ( (char *) (*d) -> order );
+  free ( (char *) *d );
+  *d = NULL;
+}
+
+
+/****************************************************************
+**  sort_descr
+**
+**  Sorts the documents of a description by index; afterwards,
+**  'descr_sorted(d,k)' gives the number of the document with
+**  the k-th smallest index. Documents with equal indices keep
+**  their order.
+**
+**  IN  : d = handle to description.
+****************************************************************/
+
+int comp_index
+      ( d1, d2 )
+ELEMENT
+  d1;
+ELEMENT
+  d2;
+{
+  return ( ((DESCR_DOC *) d1) -> index - ((DESCR_DOC *) d2) -> index );
+}
+
+
+void sort_descr
+       ( d )
+DESCR
+  d;
+{
+  int
+    i;
+
+  if ( d -> order != NULL ) return;
+  d -> order = (DESCR_DOC **) malloc ( ( d -> num_docs + 1 ) *
+                                       sizeof ( DESCR_DOC * ) );
+  assert ( d -> order != NULL );
+  for ( i = 0; i < d -> num_docs; i ++ ) {
+    d -> order [i] = &d -> doc [i];
+  }
+  sort_elements ( (ELEMENT *) d -> order, d -> num_docs, comp_index );
+}
+
+
+/****************************************************************
+**  find_descr
+**
+**  Finds a document by its index.
+**
+**  IN  : d   = handle to description.
+**        doc = index of document.
+**
+**  OUT : Function returns the number of the document in d, or
+**        -1 if there is no such document. If the index occurs
+**        more than once, the first document is returned.
+****************************************************************/
+
+int find_descr
+      ( d, doc )
+DESCR
+  d;
+int
+  doc;
+{
+  int
+    low, high, mid;
+
+  /* Sort document table by index at the first call */
+  sort_descr ( d );
+
+  /* Binary search for the first document with this index */
+  low = 0;
+  high = d -> num_docs;
+  while ( low < high ) {
+    mid = ( low + high ) / 2;
+    if ( d -> order [ mid ] -> index < doc ) {
+      low = mid + 1;
+    }
+    else {
+      high = mid;
+    }
+  }
+  if ( ( low < d -> num_docs ) && ( d -> order [ low ] -> index == doc ) ) {
+    return ( d -> order [ low ] - d -> doc );
+  }
+  return ( -1 );
+}
+
+
+/****************************************************************
+**  write_descr
+**
+**  Writes a document description to a file.
+**
+**  IN  : d      = handle to description.
+**        f      = output file.
+**        binary = TRUE  --> write binary form.
+**                 FALSE --> write text form.
+****************************************************************/
+
+void write_descr
+       ( d, f, binary )
+DESCR
+  d;
+FILE
+  *f;
+BOOL
+  binary;
+{
+  DESCR_FILE
+    hdr;
+  DESCR_WGT
+    *w;
+  int
+    i, j, n;
+
+  if ( binary ) {
+    memcpy ( hdr.magic, DESCR_MAGIC, sizeof ( hdr.magic ) );
+    hdr.version = DESCR_VERSION;
+    hdr.num_docs = d -> num_docs;
+    hdr.num_wgts = d -> num_wgts;
+    n = fwrite ( &hdr, sizeof ( DESCR_FILE ), 1, f );
+    assert ( n == 1 );
+    n = fwrite ( d -> doc, sizeof ( DESCR_DOC ), d -> num_docs, f );
+    assert ( n == d -> num_docs );
+    n = fwrite ( d -> wgt, sizeof ( DESCR_WGT ), d -> num_wgts, f );
+    assert ( n == d -> num_wgts );
+  }
+  else {
+    for ( i = 0; i < d -> num_docs; i ++ ) {
+      fprintf ( f, "%d\n", descr_index ( d, i ) );
+      w = descr_wgts ( d, i );
+      for ( j = 0; j < descr_count ( d, i ); j ++ ) {
+        fprintf ( f, "\t%d\t%f\n", w [j].sign, w [j].weight );
+      }
+    }
+  }
+}
@@ -0,0 +1,121 @@
+/****************************************************************
+*
+*           S O F T W A R E   S O U R C E   F I L E
+*
+*****************************************************************
+*
+*   Name of file   : descr.h
+*   Author         : Guido Hoss
+*   Project        : ETH Diploma Thesis (SS 1989)
+*   Creation Date  : 08/05/89
+*   Type of file   : C Header File
+*
+*****************************************************************
+*
+*   COPYRIGHT (C) 1989, 2016 BY GUIDO HOSS.
+*
+*   This program is free software: you can redistribute it and/or 
+*   modify it under the terms of the GNU General Public License
+*   as published by the Free Software Foundation, either version 3
+*   of the License, or (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public
+*   License along with this program.  If not, see
+*   <http://www.gnu.org/licenses/>.
+*
+*   Git repository home: <https://github.com/ghoss/Thesis>
+*
+*****************************************************************
+* Date        :
+* Description :
+****************************************************************/   
+
+/* A document description (DOC_DESCR file, written by calc_docdescr)
+   gives the weight of each sign in each document. As text, every
+   document is a line with its index, followed by one indented line
+   "sign  weight" per sign:
+
+      17
+   	4	0.213775
+   	139	0.540132
+
+   The binary form of the same file consists of
+
+      header     DESCR_FILE
+      documents  DESCR_DOC [num_docs]   (in the order of the text)
+      weights    DESCR_WGT [num_wgts]   (grouped by document)
+
+   with all numbers stored as 32-bit values in the byte order of the
+   machine which wrote the file. A binary file is mapped into memory
+   and can be used without any parsing; the weights of a document are
+   found through its entry in the document table. Text files are
+   read into memory in the same layout, so programs accept both. */
+#define DESCR_MAGIC	"DSCR"
+#define DESCR_VERSION	1
+
+typedef
+  struct {
+    char	magic [4];	/* DESCR_MAGIC */
+    int		version;	/* DESCR_VERSION */
+    int		num_docs;	/* Number of documents */
+    int		num_wgts;	/* Number of sign weights */
+  } DESCR_FILE;
+
+typedef
+  struct {
+    int		index;		/* Document index */
+    int		first;		/* Position of first weight */
+    int		count;		/* Number of weights */
+  } DESCR_DOC;
+
+typedef
+  struct {
+    int		sign;		/* Sign index */
+    float	weight;		/* Weight of sign in document */
+  } DESCR_WGT;
+
+typedef
+  struct {
+    DESCR_DOC	*doc;		/* Document table */
+    DESCR_WGT	*wgt;		/* Sign weights */
+    int		num_docs;	/* Number of documents */
+    int		num_wgts;	/* Number of sign weights */
+    DESCR_DOC	**order;	/* Documents sorted by index (sort_descr) */
+    char	*map;		/* Mapped binary file, NULL for text */
+    unsigned	size;		/* Size of mapping */
+  } DESCR_HEADER;
+
+typedef
+  DESCR_HEADER *DESCR;
+
+
+/* Access to the documents of a description; documents are
+   numbered 0 .. descr_docs - 1 in the order of the file */
+#define descr_docs(d)		( (d) -> num_docs )
+#define descr_index(d,i)	( (d) -> doc [i].index )
+#define descr_count(d,i)	( (d) -> doc [i].count )
+#define descr_wgts(d,i)		( (d) -> wgt + (d) -> doc [i].first )
+
+/* Number of the document with the k-th smallest index (sort_descr) */
+#define descr_sorted(d,k)	( (d) -> order [k] - (d) -> doc )
+
+
+/* Functions defined on document descriptions */
+#ifndef BSDUNIX
+DESCR open_descr ( char * );
+void close_descr ( DESCR * );
+void sort_descr ( DESCR );
+int find_descr ( DESCR, int );
+void write_descr ( DESCR, FILE *, BOOL );
+#else
+DESCR open_descr ();
+void close_descr ();
+void sort_descr ();
+int find_descr ();
+void write_descr ();
+#endif
@@ -67,8 +67,8 @@
 #include "boolean.h"
 #include "list.h"
 #include "util.h"
+#include "reader.h"
 
-#define LINE_LENGTH	100
 
 
 /* Low and high bounds of atomic concept weights */
@@ -104,6 +104,9 @@ LIST
   queries,	/* List of queries and relevant documents */
   doc_list;	/* temporary ranking list for a query */
 
+ARENA
+  doc_arena;	/* Arena of doc_list */
+
 int
   req_query,
   useful_plus,
@@ -118,7 +121,8 @@ int
 DOC_STRUCT
   *glob_doc;
 LIST 
-  glob_ranking;
+  glob_ranking,
+  glob_relevant;	/* Used by 'merge_queries' */
 FILE
   *counter;	/* Virtual file used to output running counts */
 
@@ -128,11 +132,13 @@ FILE
 ****************************************************************/  
 
 #ifndef BSDUNIX
-void load_rsv ( FILE * );
-void load_relevant ( FILE * );
+void load_rsv ( READER );
+void load_relevant ( READER );
 int comp_doc ( ELEMENT, ELEMENT );
 int comp_query ( ELEMENT, ELEMENT );
 int comp_relevant ( ELEMENT, ELEMENT );
+BOOL copy_relevant ( ELEMENT );
+void merge_queries ( ELEMENT, ELEMENT );
 BOOL enum_doc1 ( ELEMENT );
 BOOL enum_doc2 ( ELEMENT );
 void enum_query ( QUERY_STRUCT * );
@@ -144,6 +150,8 @@ void load_relevant ();
 int comp_doc ();
 int comp_query ();
 int comp_relevant ();
+BOOL copy_relevant ();
+void merge_queries ();
 BOOL enum_doc1 ();
 BOOL enum_doc2 ();
 void enum_query ();
@@ -157,7 +165,7 @@ int main ();
 **  Loads a list of relevant documents for each query into
 **  memory.
 **
-**  IN  : f = handle to open RELEVANT file.
+**  IN  : r = reader of RELEVANT file.
 ****************************************************************/   
 
 int comp_query
@@ -182,61 +190,88 @@ ELEMENT
 }
 
 
+/* If a query occurs more than once in the RELEVANT file, the
+   relevant documents of all entries are merged into the first
+   entry of this query. */
+
+BOOL copy_relevant
+       ( d )
+ELEMENT
+  d;
+{
+  RLV_STRUCT
+    *r;
+
+  r = (RLV_STRUCT *) arena_alloc ( main_arena (), sizeof ( RLV_STRUCT ) );
+  *r = *((RLV_STRUCT *) d);
+  r = (RLV_STRUCT *) add_list ( glob_relevant, (ELEMENT) r, comp_relevant );
+  assert ( r != NULL );
+  return ( TRUE );
+}
+
+
+void merge_queries
+       ( q1, q2 )
+ELEMENT
+  q1;
+ELEMENT
+  q2;
+{
+  glob_relevant = ((QUERY_STRUCT *) q1) -> relevant;
+  enum_list ( ((QUERY_STRUCT *) q2) -> relevant, copy_relevant,
+	      ENUM_FORWARD );
+  destroy_list ( &((QUERY_STRUCT *) q2) -> relevant );
+}
+
+
 void load_relevant
-       ( f )
-FILE
-  *f;
+       ( r )
+READER
+  r;
 {
-  char
-    line [ LINE_LENGTH ];
   int
     level, n, res;
   QUERY_STRUCT
-    *curr_query, *q;
+    *curr_query = NULL, *q;
   RLV_STRUCT
     *d;
 
   /* Create global 'queries' list */
   queries = create_list ();
   assert ( queries != NULL );
+  list_set_arena ( queries, main_arena () );
   
-  /* Read file one line at a time */
-  while ( fgets ( line, LINE_LENGTH, f ) ) {
+  /* Read one query record at a time */
+  while ( next_record ( r, &n ) ) {
     
-    /* Line contains number, optionally followed by colon */
-    res = sscanf ( line, " %d %d", &n, &level );
-    assert ( res >= 1 );
-    
-    /* If number followed by a colon, then this is a query index;
-       create new list entry for this query */
-    if ( strchr ( line, ':' ) != NULL ) {
-      if ( n >= 0 ) {
-        /* Query numbers must be made negative */
-        n = -n;
-      }
-      q = (QUERY_STRUCT *) malloc ( sizeof ( QUERY_STRUCT ) );
-      assert ( q != NULL );
-      q -> index = n;
-      q -> relevant = NULL;
-      q -> handled = FALSE;
-      q = (QUERY_STRUCT *) add_list ( queries, (ELEMENT) q, comp_query );
-      assert ( q != NULL );
-      if ( q -> relevant == NULL ) {
-        /* Make new list of relevant documents for this query */
-        q -> relevant = create_list ();
-        assert ( q -> relevant != NULL );
-      }
-      curr_query = q;
-      
-      /* Running count */
-      fprintf ( counter, "%d\r", n );
+    /* Record header is the query index; create new list entry for
+       this query */
+    if ( n >= 0 ) {
+      /* Query numbers must be made negative */
+      n = -n;
     }
-    else {
-      /* document relevant to 'curr_query' */
-      d = (RLV_STRUCT *) malloc ( sizeof ( RLV_STRUCT ) );
-      assert ( d != NULL );
+    q = (QUERY_STRUCT *) arena_alloc ( main_arena (),
+                                       sizeof ( QUERY_STRUCT ) );
+    q -> index = n;
+    q -> handled = FALSE;
+
+    /* Make new list of relevant documents for this query */
+    q -> relevant = create_list ();
+    assert ( q -> relevant != NULL );
+    list_set_arena ( q -> relevant, main_arena () );
+    list_append_unsorted ( queries, (ELEMENT) q );
+    curr_query = q;
+      
+    /* Running count */
+    fprintf ( counter, "%d\r", n );
+
+    /* Record entries are documents relevant to 'curr_query' */
+    while ( next_entry ( r ) ) {
+      res = get_int ( r, &n );
+      assert ( res );
+      d = (RLV_STRUCT *) arena_alloc ( main_arena (), sizeof ( RLV_STRUCT ) );
       d -> reldoc = n;
-      if ( res == 2 ) {
+      if ( get_int ( r, &level ) ) {
         /* Relevance level specified */
         d -> rellevel = level;
       }
@@ -245,12 +280,16 @@ FILE
         d -> rellevel = 1;
       }
       d -> seen = FALSE;
-      d = (RLV_STRUCT *) add_list ( curr_query -> relevant, (ELEMENT) d,
-                                    comp_relevant );
-      assert ( d != NULL );
+      list_append_unsorted ( curr_query -> relevant, (ELEMENT) d );
     }
+
+    /* Sort relevant documents of query */
+    list_finalize ( curr_query -> relevant, comp_relevant, NULL );
   }
   
+  /* Sort the query list */
+  list_finalize ( queries, comp_query, merge_queries );
+
   fprintf ( counter, "\n" );
 }
 
@@ -281,9 +320,7 @@ ELEMENT
   rdoc = (RLV_STRUCT *) d;
   if ( rdoc -> seen ) return ( TRUE );
   
-  doc = (DOC_STRUCT *) malloc ( sizeof ( DOC_STRUCT ) );
-  assert ( doc != NULL );
-  
+  doc = (DOC_STRUCT *) arena_alloc ( doc_arena, sizeof ( DOC_STRUCT ) );
   doc -> doc = ((RLV_STRUCT *) d ) -> reldoc;
   doc -> rlevel = ((RLV_STRUCT *) d ) -> rellevel;
   doc -> rsv = 0.0;
@@ -312,7 +349,7 @@ LIST
 **
 **  Loads RSV values between queries and documents.
 **
-**  IN  : f = handle to open RSV file.
+**  IN  : r = reader of RSV file.
 ****************************************************************/   
 
 int comp_doc
@@ -346,12 +383,10 @@ ELEMENT
 
 
 void load_rsv
-       ( f )
-FILE
-  *f;
+       ( r )
+READER
+  r;
 {
-  char
-    line [ LINE_LENGTH ];
   int
     i, query, curr_query,
     doc, res;
@@ -372,11 +407,12 @@ FILE
   q = NULL;
 
   /* Read RSV values line by line */
-  while ( fgets ( line, LINE_LENGTH, f ) ) {
+  while ( read_line ( r ) ) {
   
     /* We expect 3 arguments: query, document, rsv */
-    res = sscanf ( line, " %d %d %f", &query, &doc, &rsv );
-    assert ( res == 3 );
+    res = get_int ( r, &query ) && get_int ( r, &doc ) && 
+          get_float ( r, &rsv );
+    assert ( res );
     
     /* find query index in 'queries'; queries are assumed to be
        grouped!*/
@@ -399,17 +435,18 @@ FILE
       /* If this isn't the first query, destroy document lists of
          the previous query and recreate them */
       if ( doc_list != NULL ) {
-	destroy_list ( &doc_list );
+	destroy_list_arena ( &doc_list );
       }
       doc_list = create_list ();
       assert ( doc_list != NULL );
+      doc_arena = create_arena ( 0 );
+      list_set_arena ( doc_list, doc_arena );
       curr_query = query;
       q -> handled = TRUE;
     }
     
     /* add current document to ranking list */
-    d = (DOC_STRUCT *) malloc ( sizeof ( DOC_STRUCT ) );
-    assert ( d != NULL );
+    d = (DOC_STRUCT *) arena_alloc ( doc_arena, sizeof ( DOC_STRUCT ) );
     
     /* look if document is relevant */
     t1.reldoc = doc;
@@ -565,8 +602,8 @@ int
 char
   *argv [];
 {
-  FILE
-    *f;
+  READER
+    r;
   char 
     *query;
 
@@ -608,18 +645,18 @@ char
   }
 
   /* Load list of relevant documents */
-  f = open_file ( argv [1] );
+  r = open_reader ( argv [1] );
   fprintf ( stderr, "Loading relevant documents.\n" );
-  load_relevant ( f );
-  fclose ( f );
+  load_relevant ( r );
+  close_reader ( &r );
   
   total_plus = total_minus = useful_plus = useful_minus = 0;
   
   /* Produce RSV ranking */
-  f = open_file ( argv [2] );
+  r = open_reader ( argv [2] );
   fprintf ( stderr, "Generating preferences.\n" );
-  load_rsv ( f );
-  fclose ( f );
+  load_rsv ( r );
+  close_reader ( &r );
   
   fprintf ( stderr, "Total + : %d, total - : %d\n", total_plus, total_minus );
   fprintf ( stderr, "Useful + : %d, useful - : %d\n", useful_plus, useful_minus );
@@ -21,10 +21,12 @@
 *   Call Format
 *   -----------
 *
-*      generate_ida <doc-freq>
+*      generate_ida <doc-freq> <dictionary>
 *
 *   where <doc-freq> is the path of the document term frequency
-*   file. The signs are written to the standard output.
+*   file and <dictionary> the path of the dictionary written by
+*   parse_itemcoll. The signs are written to the standard output,
+*   in alphabetical order.
 *
 *****************************************************************
 *
@@ -52,7 +54,7 @@
 ****************************************************************/   
 
 #define PROG	"Initial Domain Algebra Generation (gh, 29/04/89)\n"
-#define USAGE	"Usage: generate_ida <doc-freq> [QUIET]\n"
+#define USAGE	"Usage: generate_ida <doc-freq> <dictionary> [QUIET]\n"
 
 #include <stdio.h>
 #include <string.h>
@@ -64,14 +66,21 @@
 
 #include "boolean.h"
 #include "list.h"
+#include "listsort.h"
 #include "util.h"
+#include "reader.h"
 
 #define MAX_WORDLEN	100
-#define LINE_LENGTH	100
 
 
-LIST
-  wordlist;
+/* The words of the dictionary, indexed by their numbers; 'used'
+   tells which of them occur as single words */
+char
+  **word;
+BOOL
+  *used;
+int
+  num_words;
 
 FILE
   *counter;	/* Virtual file used to output running counts */
@@ -83,31 +92,76 @@ FILE
 
 #ifndef BSDUNIX
 int main ( int, char* [] );
-BOOL enumproc ( ELEMENT );
+void load_dictionary ( READER );
+int comp_word ( ELEMENT, ELEMENT );
 #else
 int main ();
-BOOL enumproc ();
+void load_dictionary ();
+int comp_word ();
 #endif
 
 
 /****************************************************************
-**  enumproc
+**  load_dictionary
+**
+**  Loads the dictionary into the array 'word'.
 **
-**  Enumeration procedure used to print out a list of all signs.
-**  Called by 'enum_list'.
+**  IN  : r = reader of dictionary.
 ****************************************************************/
 
-BOOL enumproc
-       ( s )
-ELEMENT
-  s;
+void load_dictionary
+       ( r )
+READER
+  r;
 {
-  static int
-    index = 0;
+  int
+    n, total;
+  BOOL
+    res;
+  char
+    w [ MAX_WORDLEN ];
+
+  num_words = 0;
+  total = 1024;
+  word = (char **) malloc ( total * sizeof ( char * ) );
+  assert ( word != NULL );
+
+  while ( read_line ( r ) ) {
+    if ( ! get_int ( r, &n ) ) continue;
+    res = get_word ( r, w, MAX_WORDLEN );
+    assert ( res );
+
+    /* Grow array if necessary */
+    while ( n >= total ) {
+      total *= 2;
+      word = (char **) realloc ( word, total * sizeof ( char * ) );
+      assert ( word != NULL );
+    }
+    while ( num_words <= n ) {
+      word [ num_words ++ ] = NULL;
+    }
+    word [n] = duplicate ( w );
+  }
+
+  used = (BOOL *) calloc ( num_words + 1, sizeof ( BOOL ) );
+  assert ( used != NULL );
+}
+
+
+/****************************************************************
+**  comp_word
+**
+**  Compares two words for sorting.
+****************************************************************/
 
-  printf ( "%d\t%s\n", index, (char *) s );
-  index ++;
-  return ( TRUE );
+int comp_word
+      ( w1, w2 )
+ELEMENT
+  w1;
+ELEMENT
+  w2;
+{
+  return ( strcmp ( (char *) w1, (char *) w2 ) );
 }
 
    
@@ -122,22 +176,20 @@ int
 char
   *argv [];
 {
-  FILE
-    *doc_descr;
+  READER
+    doc_descr;
   int
-    n, doc;
+    i, n, doc,
+    w1, w2,
+    num_signs;
   char
-    line [ LINE_LENGTH ],
-    w1 [ MAX_WORDLEN ],
-    w2 [ MAX_WORDLEN ];
-  ELEMENT
-    res;
+    **sign;
 
   /* Program title */
   fprintf ( stderr, PROG );
 
   /* Get verbose or quiet mode */
-  if ( ( argc == 3 ) && ( *argv [2] == 'Q' ) ) {
+  if ( ( argc == 4 ) && ( *argv [3] == 'Q' ) ) {
     /* in case of quiet mode: redirect running counts to /dev/null */
     counter = fopen ( "/dev/null", "r" );
     assert ( counter != NULL );
@@ -148,25 +200,32 @@ char
   }
 
   /* Check if number of parameters ok */
-  if ( argc < 2 ) {
+  if ( argc < 3 ) {
     fprintf ( stderr, USAGE );
     return ( 1 );
   }
   
+  /* Load dictionary */
+  fprintf ( stderr, "Loading dictionary.\n" );
+  doc_descr = open_reader ( argv [2] );
+  load_dictionary ( doc_descr );
+  close_reader ( &doc_descr );
+
   /* Open document description file */
   fprintf ( stderr, "Reading document description.\n" );
-  doc_descr = open_file ( argv [1] );
-
-  /* Create word list */
-  wordlist = create_list ();
-  assert ( wordlist != NULL );
-  
+  doc_descr = open_reader ( argv [1] );
   
   /* Read input file line by line */
-  while ( fgets ( line, LINE_LENGTH, doc_descr ) ) {
+  while ( read_line ( doc_descr ) ) {
 
-    /* Try to interpret text; sscanf will assign as much fields as possible */
-    n = sscanf ( line, " %d %s %s", &doc, w1, w2 );
+    /* Try to interpret text; assign as much fields as possible */
+    n = 0;
+    if ( get_int ( doc_descr, &doc ) ) {
+      n = 1;
+      if ( get_int ( doc_descr, &w1 ) ) {
+        n = get_int ( doc_descr, &w2 ) ? 3 : 2;
+      }
+    }
     
     switch ( n ) {
     
@@ -176,14 +235,9 @@ char
         break;
         
       case 2 :
-        /* Frequency and one word; add word to list */
-#ifndef BSDUNIX
-        res = add_list ( wordlist, duplicate ( w1 ), 
-                (int (*) ( ELEMENT, ELEMENT )) strcmp );
-#else
-        res = add_list ( wordlist, duplicate ( w1 ), strcmp );
-#endif
-        assert ( res != NULL );
+        /* Frequency and one word; mark word as used */
+        assert ( ( w1 >= 0 ) && ( w1 < num_words ) );
+        used [ w1 ] = TRUE;
         break;
       
       case 3 :
@@ -192,11 +246,26 @@ char
     }
   }
 
-  /* Enumerate all words in list */
-  enum_list ( wordlist, enumproc, ENUM_FORWARD );
+  close_reader ( &doc_descr );
+
+  /* Sort used words and print them as signs */
+  sign = (char **) malloc ( ( num_words + 1 ) * sizeof ( char * ) );
+  assert ( sign != NULL );
+  num_signs = 0;
+  for ( i = 0; i < num_words; i ++ ) {
+    if ( used [i] ) {
+      assert ( word [i] != NULL );
+      sign [ num_signs ++ ] = word [i];
+    }
+  }
+  sort_elements ( (ELEMENT *) sign, num_signs, comp_word );
+  for ( i = 0; i < num_signs; i ++ ) {
+    printf ( "%d\t%s\n", i, sign [i] );
+  }
   
-  fclose ( doc_descr );
-  fprintf ( stderr, "\nsigns: %d\n", count_list ( wordlist ) );
-  destroy_list ( &wordlist );
+  fprintf ( stderr, "\nsigns: %d\n", num_signs );
+  free ( sign );
+  free ( used );
+  free ( word );
   return ( 0 );
 }
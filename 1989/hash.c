@@ -0,0 +1,372 @@
+/****************************************************************
+*
+*           S O F T W A R E   S O U R C E   F I L E
+*
+*****************************************************************
+*
+*   Name of file   : hash.c 
+*   Author         : Guido Hoss
+*   Project        : ETH Diploma Thesis (SS 1989)
+*   Creation Date  : 04/05/89
+*   Type of file   : C Language File
+*
+*   Description
+*   -----------
+*   Hash tables mapping strings to integers, see hash.h. The
+*   table uses open addressing with linear probing; it is kept
+*   at most half full. Entries and their keys are allocated in
+*   an arena, so clearing a table for reuse is cheap.
+*
+*****************************************************************
+*
+*   COPYRIGHT (C) 1989, 2016 BY GUIDO HOSS.
+*
+*   This program is free software: you can redistribute it and/or 
+*   modify it under the terms of the GNU General Public License
+*   as published by the Free Software Foundation, either version 3
+*   of the License, or (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public
+*   License along with this program.  If not, see
+*   <http://www.gnu.org/licenses/>.
+*
+*   Git repository home: <https://github.com/ghoss/Thesis>
+*
+*****************************************************************
+* Date        :
+* Description :
+****************************************************************/   
+
+#include <stdio.h>
+#ifdef MSDOS
+#include <process.h>
+#endif
+#include <malloc.h>
+#include <assert.h>
+#include <string.h>
+
+#include "boolean.h"
+#include "util.h"
+#include "hash.h"
+
+#define MIN_SLOTS	64	/* Minimum size of slot table */
+#define ENTRY_ARENA	4096	/* Block size of entry arena */
+
+/* Growth policy of the entry array, see list.c */
+#ifndef GROW_PERCENT
+#define GROW_PERCENT	50
+#endif
+#define GROW_MIN	10
+
+
+/****************************************************************
+**  Forward declarations (compiler type checking)
+****************************************************************/
+
+#ifndef BSDUNIX
+HASH_ENTRY **find_slot ( HASH, char *, int, unsigned );
+void grow_slots ( HASH );
+#else
+HASH_ENTRY **find_slot ();
+void grow_slots ();
+#endif
+
+
+/****************************************************************
+**  hash_code
+**
+**  Computes the hash code of a key (FNV-1a).
+**
+**  IN  : key, len = key and its length.
+**
+**  OUT : Function returns the hash code.
+****************************************************************/
+
+unsigned hash_code
+           ( key, len )
+char
+  *key;
+int
+  len;
+{
+  unsigned
+    h;
+
+  h = 2166136261U;
+  while ( len -- > 0 ) {
+    h ^= (unsigned char) *key ++;
+    h *= 16777619U;
+  }
+  return ( h );
+}
+
+
+/****************************************************************
+**  find_slot
+**
+**  Searches the slot table for a key.
+**
+**  IN  : table    = handle to hash table.
+**        key, len = key and its length.
+**        code     = hash code of key.
+**
+**  OUT : Function returns a pointer to the slot holding the
+**        entry of the key, or to the free slot where the key
+**        must be inserted.
+****************************************************************/
+
+HASH_ENTRY **find_slot
+               ( table, key, len, code )
+HASH
+  table;
+char
+  *key;
+int
+  len;
+unsigned
+  code;
+{
+  unsigned
+    i;
+  HASH_ENTRY
+    *e;
+
+  i = code & table -> mask;
+  while ( ( e = table -> slot [i] ) != NULL ) {
+    if ( ( e -> code == code ) && ( e -> len == len ) &&
+         ( memcmp ( e -> key, key, len ) == 0 ) ) {
+      break;
+    }
+    i = ( i + 1 ) & table -> mask;
+  }
+  return ( &( table -> slot [i] ) );
+}
+
+
+/****************************************************************
+**  grow_slots
+**
+**  Doubles the size of the slot table and reinserts all entries.
+**
+**  IN  : table = handle to hash table.
+****************************************************************/
+
+void grow_slots
+       ( table )
+HASH
+  table;
+{
+  int
+    n;
+  unsigned
+    i;
+  HASH_ENTRY
+    *e;
+
+  free ( table -> slot );
+  table -> mask = table -> mask * 2 + 1;
+  table -> slot = (HASH_ENTRY **) calloc ( table -> mask + 1, 
+                                           sizeof ( HASH_ENTRY * ) );
+  assert ( table -> slot != NULL );
+
+  for ( n = 0; n < table -> num; n ++ ) {
+    e = table -> entry [n];
+    i = e -> code & table -> mask;
+    while ( table -> slot [i] != NULL ) {
+      i = ( i + 1 ) & table -> mask;
+    }
+    table -> slot [i] = e;
+  }
+}
+
+
+/****************************************************************
+**  create_hash
+**
+**  Creates an empty hash table.
+**
+**  IN  : size = expected number of entries, or 0 if unknown.
+**
+**  OUT : Function returns a handle to the new table.
+****************************************************************/
+
+HASH create_hash
+       ( size )
+int
+  size;
+{
+  HASH
+    table;
+  unsigned
+    slots;
+
+  /* Keep table at most half full */
+  slots = MIN_SLOTS;
+  while ( slots < 2 * (unsigned) size ) {
+    slots *= 2;
+  }
+
+  table = (HASH) malloc ( sizeof ( HASH_HEADER ) );
+  assert ( table != NULL );
+  table -> slot = (HASH_ENTRY **) calloc ( slots, sizeof ( HASH_ENTRY * ) );
+  assert ( table -> slot != NULL );
+  table -> mask = slots - 1;
+  table -> entry = NULL;
+  table -> num = table -> total = 0;
+  table -> arena = create_arena ( ENTRY_ARENA );
+  return ( table );
+}
+
+
+/****************************************************************
+**  destroy_hash
+**
+**  Frees a hash table with all its entries.
+**
+**  IN  : table = pointer to handle of table.
+**  OUT : '*table' is set to NULL.
+****************************************************************/
+
+void destroy_hash
+       ( table )
+HASH
+  *table;
+{
+  if ( *table == NULL ) return;
+  free ( (*table) -> slot );
+  if ( (*table) -> entry != NULL ) free ( (*table) -> entry );
+  destroy_arena ( &( (*table) -> arena ) );
+  free ( *table );
+  *table = NULL;
+}
+
+
+/****************************************************************
+**  clear_hash
+**
+**  Removes all entries from a hash table. The memory of the
+**  table is kept for reuse. Only the slots which are in use are
+**  cleared, so the cost depends on the number of entries and not
+**  on the size of the table.
+**
+**  IN  : table = handle to hash table.
+****************************************************************/
+
+void clear_hash
+       ( table )
+HASH
+  table;
+{
+  int
+    n;
+  unsigned
+    i;
+  HASH_ENTRY
+    *e;
+
+  for ( n = 0; n < table -> num; n ++ ) {
+    e = table -> entry [n];
+    i = e -> code & table -> mask;
+    while ( table -> slot [i] != e ) {
+      i = ( i + 1 ) & table -> mask;
+    }
+    table -> slot [i] = NULL;
+  }
+  table -> num = 0;
+  clear_arena ( table -> arena );
+}
+
+
+/****************************************************************
+**  add_hash
+**
+**  Adds a key to a hash table, unless it is already present.
+**
+**  IN  : table    = handle to hash table.
+**        key, len = key and its length. 'key' need not be
+**                   null-terminated.
+**
+**  OUT : Function returns the entry of the key. The value of a
+**        new entry is 0.
+****************************************************************/
+
+HASH_ENTRY *add_hash
+              ( table, key, len )
+HASH
+  table;
+char
+  *key;
+int
+  len;
+{
+  unsigned
+    code;
+  HASH_ENTRY
+    **slot,
+    *e;
+
+  code = hash_code ( key, len );
+  slot = find_slot ( table, key, len, code );
+  if ( *slot != NULL ) return ( *slot );
+
+  /* New key: entry and key are allocated in one piece */
+  e = (HASH_ENTRY *) arena_alloc ( table -> arena, 
+                                   sizeof ( HASH_ENTRY ) + len + 1 );
+  e -> key = (char *) ( e + 1 );
+  memcpy ( e -> key, key, len );
+  e -> key [ len ] = '\0';
+  e -> len = len;
+  e -> val = 0;
+  e -> code = code;
+  *slot = e;
+
+  if ( table -> num == table -> total ) {
+    table -> total += table -> total * GROW_PERCENT / 100 + GROW_MIN;
+    if ( table -> entry == NULL ) {
+      table -> entry = (HASH_ENTRY **) malloc ( table -> total *
+                                                sizeof ( HASH_ENTRY * ) );
+    }
+    else {
+      table -> entry = (HASH_ENTRY **) realloc ( (char *) table -> entry,
+                         table -> total * sizeof ( HASH_ENTRY * ) );
+    }
+    assert ( table -> entry != NULL );
+  }
+  table -> entry [ table -> num ++ ] = e;
+
+  /* Keep table at most half full */
+  if ( (unsigned) table -> num * 2 > table -> mask + 1 ) {
+    grow_slots ( table );
+  }
+  return ( e );
+}
+
+
+/****************************************************************
+**  lookup_hash
+**
+**  Searches a key in a hash table.
+**
+**  IN  : table    = handle to hash table.
+**        key, len = key and its length.
+**
+**  OUT : Function returns the entry of the key, or NULL if the
+**        key is not in the table.
+****************************************************************/
+
+HASH_ENTRY *lookup_hash
+              ( table, key, len )
+HASH
+  table;
+char
+  *key;
+int
+  len;
+{
+  return ( *find_slot ( table, key, len, hash_code ( key, len ) ) );
+}
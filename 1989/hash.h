@@ -0,0 +1,91 @@
+/****************************************************************
+*
+*           S O F T W A R E   S O U R C E   F I L E
+*
+*****************************************************************
+*
+*   Name of file   : hash.h
+*   Author         : Guido Hoss
+*   Project        : ETH Diploma Thesis (SS 1989)
+*   Creation Date  : 04/05/89
+*   Type of file   : C Header File
+*
+*****************************************************************
+*
+*   COPYRIGHT (C) 1989, 2016 BY GUIDO HOSS.
+*
+*   This program is free software: you can redistribute it and/or 
+*   modify it under the terms of the GNU General Public License
+*   as published by the Free Software Foundation, either version 3
+*   of the License, or (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public
+*   License along with this program.  If not, see
+*   <http://www.gnu.org/licenses/>.
+*
+*   Git repository home: <https://github.com/ghoss/Thesis>
+*
+*****************************************************************
+* Date        :
+* Description :
+****************************************************************/   
+
+/* A hash table maps character strings to integer values. It is
+   used where strings are only looked up by spelling, so the order
+   of a LIST is not needed. Keys are given as (pointer, length);
+   they need not be null-terminated. The table keeps its own copy
+   of each key, null-terminated.
+
+   Entries are numbered 0 .. count - 1 in the order in which they
+   were added. The array of entries may be reordered by the caller
+   (e.g. sorted for output); this does not affect lookups. */
+typedef
+  struct {
+    char	*key;	/* Null-terminated copy of key */
+    int		len;	/* Length of key */
+    int		val;	/* Value attached to key, 0 for a new entry */
+    unsigned	code;	/* Hash code of key */
+  } HASH_ENTRY;
+
+typedef
+  struct {
+    HASH_ENTRY	**slot;		/* Open addressing table, NULL = free */
+    unsigned	mask;		/* Size of slot table - 1 */
+    HASH_ENTRY	**entry;	/* Entries in order of insertion */
+    int		num;		/* Number of entries */
+    int		total;		/* Size of entry array */
+    struct arena_header
+		*arena;		/* Memory for entries and keys */
+  } HASH_HEADER;
+
+typedef
+  HASH_HEADER *HASH;
+
+
+/* Access to the entries of a table */
+#define count_hash(h)		( (h) -> num )
+#define hash_entry(h,i)		( (h) -> entry [i] )
+#define hash_entries(h)		( (h) -> entry )
+
+
+/* Functions defined on hash tables */
+#ifndef BSDUNIX
+HASH create_hash ( int );
+void destroy_hash ( HASH * );
+void clear_hash ( HASH );
+HASH_ENTRY *add_hash ( HASH, char *, int );
+HASH_ENTRY *lookup_hash ( HASH, char *, int );
+unsigned hash_code ( char *, int );
+#else
+HASH create_hash ();
+void destroy_hash ();
+void clear_hash ();
+HASH_ENTRY *add_hash ();
+HASH_ENTRY *lookup_hash ();
+unsigned hash_code ();
+#endif
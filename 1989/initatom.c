@@ -21,8 +21,8 @@
 *	init_atomwgts <atom-docs>
 *
 *   where <atom-docs> is the file which contains the documents, 
-*   indexed by atomic concept. The results are written to the
-*   standard output.
+*   indexed by atomic concept (ATOM_DOCS or a binary atom index).
+*   The results are written to the standard output.
 *
 *****************************************************************
 *
@@ -62,8 +62,8 @@
 
 #include "boolean.h"
 #include "util.h"
+#include "atomidx.h"
 
-#define LINE_LENGTH	100
 
 
 double
@@ -78,7 +78,7 @@ FILE
 
 #ifndef BSDUNIX
 int main ( int, char *[] );
-void read_concepts ( FILE * );
+void read_concepts ( ATOM_INDEX );
 double calc_idf ( double, int );
 #else
 int main ();
@@ -125,60 +125,29 @@ int
 **  Reads the documents containing each atomic concept and
 **  counts them.
 **
-**  IN  : f = handle to opened atom-idf file.
+**  IN  : x = atom index (atom-docs file).
 ****************************************************************/ 
 
 void read_concepts
-       ( f )
-FILE
-  *f;
+       ( x )
+ATOM_INDEX
+  x;
 {
-  BOOL
-    first = TRUE,
-    ok;
-  char
-    line [ LINE_LENGTH ];
   double
     totaldocs;
   int
-    d, curratom,
-    df, n, res;
-
-  /* The first line of the file must contain the number of documents */
-  ok = ( fgets ( line, LINE_LENGTH, f ) != NULL );
-  assert ( ok );
-  res = sscanf ( line, " %d", &n );
-  assert ( res == 1 );
-  fprintf ( counter, "%d document(s)\n", n );
-  totaldocs = (double) n;
-  
-  /* Read file line by line */
-  while ( fgets ( line, LINE_LENGTH, f ) ) {
+    i, curratom;
+
+  /* The index knows the number of documents */
+  fprintf ( counter, "%d document(s)\n", index_docs ( x ) );
+  totaldocs = (double) index_docs ( x );
   
-    /* Read a number */
-    n = sscanf ( line, " %d", &d );
-    assert ( n == 1 );
-    
-    /* If number followed by a colon, then this is an atomic concept */
-    if ( strchr ( line, ':' ) != NULL ) {
-      if ( ! first ) {
-        /* don't do anything after first document index */
-        printf ( "%d\t%f\n", curratom, calc_idf ( totaldocs, df ) );
-        fprintf ( counter, "%d\r", curratom );
-      }
-      else {
-        first = FALSE;
-      }
-      curratom = d;
-      df = 0;
-    }
-    else {
-      /* no colon -> this is a document index; increase count */
-      df ++;
-    }
+  /* The document frequency is the length of the document list */
+  for ( i = 0; i < index_atoms ( x ); i ++ ) {
+    curratom = index_atom ( x, i );
+    printf ( "%d\t%f\n", curratom, calc_idf ( totaldocs, index_df ( x, i ) ) );
+    fprintf ( counter, "%d\r", curratom );
   }
-  /* Process last document */
-  printf ( "%d\t%f\n", curratom, calc_idf ( totaldocs, df ) );
   
   fprintf ( counter, "\n" );
 }
@@ -195,8 +164,8 @@ int
 char
   *argv [];
 {
-  FILE
-    *f;
+  ATOM_INDEX
+    x;
 
   /* Program title */
   fprintf ( stderr, PROG );
@@ -220,12 +189,12 @@ char
   }
   
   /* Open idf file */
-  f = open_file ( argv [1] );
+  x = open_index ( argv [1] );
   
   /* Process */
   fprintf ( stderr, "Processing concepts.\n" );
-  read_concepts ( f );
-  fclose ( f );
+  read_concepts ( x );
+  close_index ( &x );
 
   return ( 0 );
 }
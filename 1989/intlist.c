@@ -0,0 +1,1249 @@
+/****************************************************************
+*
+*           S O F T W A R E   S O U R C E   F I L E
+*
+*****************************************************************
+*
+*   Name of file   : intlist.c 
+*   Author         : Guido Hoss
+*   Project        : ETH Diploma Thesis (SS 1989)
+*   Creation Date  : 02/05/89
+*   Type of file   : C Language File
+*
+*   Description
+*   -----------
+*   Sorted lists of integers (INTLIST) and of integers with an
+*   associated double value (INTFLOAT_LIST), see intlist.h.
+*   Keys and values are stored in dynamic arrays which grow in
+*   the same way as the arrays of list.c. Lists built in bulk
+*   are sorted by a stable radix sort.
+*
+*****************************************************************
+*
+*   COPYRIGHT (C) 1989, 2016 BY GUIDO HOSS.
+*
+*   This program is free software: you can redistribute it and/or 
+*   modify it under the terms of the GNU General Public License
+*   as published by the Free Software Foundation, either version 3
+*   of the License, or (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public
+*   License along with this program.  If not, see
+*   <http://www.gnu.org/licenses/>.
+*
+*   Git repository home: <https://github.com/ghoss/Thesis>
+*
+*****************************************************************
+* Date        :
+* Description :
+****************************************************************/   
+
+#include <stdio.h>
+#ifdef MSDOS
+#include <process.h>
+#endif
+#include <stdlib.h>
+#include <string.h>
+#include <malloc.h>
+#include <assert.h>
+
+#include "boolean.h"
+#include "intlist.h"
+
+/* SIMD kernels need the vector extensions of GNU C on x86-64 */
+#if defined ( __GNUC__ ) && defined ( __x86_64__ ) && ! defined ( NO_SIMD )
+#define SIMD_KERNELS
+#include <immintrin.h>
+#endif
+
+/* Growth policy, see list.c */
+#ifndef GROW_PERCENT
+#define GROW_PERCENT	50
+#endif
+#define GROW_MIN	10
+
+#define RADIX_BITS	8	/* Bits per radix sort pass */
+#define RADIX_SIZE	( 1 << RADIX_BITS )
+#define SIGN_BIT	( (unsigned) 1 << ( sizeof ( int ) * 8 - 1 ) )
+
+/* Set operations gallop through the longer list if it is more than
+   GALLOP_RATIO times longer than the other. Otherwise, both lists
+   are merged by a block kernel (see select_isect_kernel): the SIMD
+   kernels compare a block of 4 or 8 keys of one list with a block
+   of the other at once; the scalar kernel scans the second list
+   in blocks of SKIP_BLOCK keys. */
+#ifndef GALLOP_RATIO
+#define GALLOP_RATIO	32
+#endif
+#define SKIP_BLOCK	8
+
+/* A merge kernel calls 'call' for the keys of a[0..na-1] which
+   occur in b[0..nb-1] (common = TRUE) or which do not occur in
+   it (common = FALSE), in increasing order */
+#ifndef BSDUNIX
+typedef BOOL ( *MERGE_KERNEL ) ( int *, int, int *, int, BOOL, 
+                                 BOOL (*) ( int ) );
+#else
+typedef BOOL ( *MERGE_KERNEL ) ();
+#endif
+
+MERGE_KERNEL
+  merge_kernel = NULL;	/* Selected by select_isect_kernel */
+
+
+/****************************************************************
+**  Forward declarations (compiler type checking)
+****************************************************************/
+
+#ifndef BSDUNIX
+int search_keys ( int [], int, int );
+int seek_key ( int [], int, int, int, BOOL );
+BOOL call_keys ( int *, int, unsigned, BOOL, BOOL (*) ( int ) );
+BOOL merge_rest ( int *, int, int *, int, unsigned, BOOL, 
+                  BOOL (*) ( int ) );
+BOOL merge_scalar ( int *, int, int *, int, BOOL, BOOL (*) ( int ) );
+#ifdef SIMD_KERNELS
+BOOL merge_sse ( int *, int, int *, int, BOOL, BOOL (*) ( int ) );
+__attribute__ (( target ( "avx2" ) ))
+BOOL merge_avx2 ( int *, int, int *, int, BOOL, BOOL (*) ( int ) );
+#endif
+int grow_size ( int );
+void sort_keys ( int [], double [], int );
+int unique_keys ( int [], double [], int );
+#else
+int search_keys ();
+int seek_key ();
+BOOL call_keys ();
+BOOL merge_rest ();
+BOOL merge_scalar ();
+int grow_size ();
+void sort_keys ();
+int unique_keys ();
+#endif
+
+
+/****************************************************************
+**  search_keys
+**
+**  Does a binary search on a sorted key array.
+**
+**  IN  : key = key array.
+**        num = number of keys.
+**        k   = key to be searched.
+**
+**  OUT : If 'k' does not occur in the array, the index where it
+**        must be inserted is returned. Otherwise, '-index - 1'
+**        is returned (same convention as binary_search in list.c).
+****************************************************************/
+
+int search_keys
+      ( key, num, k )
+int
+  key [];
+int
+  num;
+int
+  k;
+{
+  int
+    low, high, mid;
+
+  /* Keys are often added in increasing order */
+  if ( ( num == 0 ) || ( k > key [ num - 1 ] ) ) return ( num );
+
+  low = 0;
+  high = num - 1;
+  while ( low <= high ) {
+    mid = ( low + high ) / 2;
+    if ( k < key [ mid ] ) {
+      high = mid - 1;
+    }
+    else if ( k > key [ mid ] ) {
+      low = mid + 1;
+    }
+    else {
+      return ( (-mid) - 1 );
+    }
+  }
+  return ( low );
+}
+
+
+/****************************************************************
+**  seek_key
+**
+**  Searches a key in key[low..num-1]. Used by the set operations
+**  to advance in the second list while stepping through the
+**  first one.
+**
+**  IN  : key    = sorted key array.
+**        low    = first index to be considered.
+**        num    = number of keys in the array.
+**        k      = key to be searched.
+**        gallop = TRUE  --> exponential search: key[low],
+**                           key[low+1], key[low+3], ... are
+**                           probed, then the last interval is
+**                           searched binary. O(log d) steps if
+**                           the result is d keys ahead.
+**                 FALSE --> linear scan; SKIP_BLOCK keys are
+**                           skipped at once by looking at the last
+**                           key of the block only.
+**
+**  OUT : Same as search_keys; the index refers to the whole
+**        array and is at least 'low'.
+****************************************************************/
+
+int seek_key
+      ( key, low, num, k, gallop )
+int
+  key [];
+int
+  low;
+int
+  num;
+int
+  k;
+BOOL
+  gallop;
+{
+  int
+    high, step, res;
+
+  if ( gallop ) {
+    high = low;
+    step = 1;
+    while ( ( high < num ) && ( key [ high ] < k ) ) {
+      low = high + 1;
+      high += step;
+      step += step;
+    }
+    if ( high >= num ) high = num - 1;
+
+    res = search_keys ( &key [ low ], high - low + 1, k );
+    return ( ( res < 0 ) ? res - low : res + low );
+  }
+
+  while ( ( low + SKIP_BLOCK <= num ) && ( key [ low + SKIP_BLOCK - 1 ] < k ) ) {
+    low += SKIP_BLOCK;
+  }
+  while ( ( low < num ) && ( key [ low ] < k ) ) {
+    low ++;
+  }
+  return ( ( ( low < num ) && ( key [ low ] == k ) ) ? -low - 1 : low );
+}
+
+
+/****************************************************************
+**  call_keys
+**
+**  Calls a procedure for the keys of a block which are marked
+**  (common = TRUE) or not marked (common = FALSE) in a bit mask.
+**
+**  IN  : key  = first key of the block.
+**        n    = number of keys in the block.
+**        hit  = bit i is set if key[i] is marked.
+**
+**  OUT : The function returns the result of the last call to
+**        'call'.
+****************************************************************/
+
+BOOL call_keys
+       ( key, n, hit, common, call )
+int
+  *key;
+int
+  n;
+unsigned
+  hit;
+BOOL
+  common;
+#ifndef BSDUNIX
+BOOL
+  (*call) ( int );
+#else
+BOOL
+  (*call) ();
+#endif
+{
+  int
+    i;
+  BOOL
+    ok;
+
+  ok = TRUE;
+  for ( i = 0; ( i < n ) && ok; i ++ ) {
+    if ( ( ( hit >> i ) & 1 ) == ( common ? 1 : 0 ) ) {
+      ok = (*call) ( key [i] );
+    }
+  }
+  return ( ok );
+}
+
+
+/****************************************************************
+**  merge_rest
+**
+**  Merges two key arrays with seek_key (see MERGE_KERNEL). The
+**  SIMD kernels use it for the keys left over after their last
+**  full block.
+**
+**  IN  : hit = bit i is set if a[i] is already known to occur
+**              in b (i < SKIP_BLOCK).
+****************************************************************/
+
+BOOL merge_rest
+       ( a, na, b, nb, hit, common, call )
+int
+  *a;
+int
+  na;
+int
+  *b;
+int
+  nb;
+unsigned
+  hit;
+BOOL
+  common;
+#ifndef BSDUNIX
+BOOL
+  (*call) ( int );
+#else
+BOOL
+  (*call) ();
+#endif
+{
+  int
+    i, j, res;
+  BOOL
+    found, ok;
+
+  j = 0;
+  ok = TRUE;
+  for ( i = 0; ( i < na ) && ok; i ++ ) {
+    if ( common && ( j >= nb ) && ( ( i >= SKIP_BLOCK ) || ( hit >> i ) == 0 ) ) {
+      break;
+    }
+    res = seek_key ( b, j, nb, a [i], FALSE );
+    if ( res < 0 ) {
+      found = TRUE;
+      j = -res;
+    }
+    else {
+      found = ( i < SKIP_BLOCK ) && ( ( hit >> i ) & 1 );
+      j = res;
+    }
+    if ( found == common ) {
+      ok = (*call) ( a [i] );
+    }
+  }
+  return ( ok );
+}
+
+
+/****************************************************************
+**  merge_scalar
+**
+**  Scalar merge kernel, used on all processors.
+****************************************************************/
+
+BOOL merge_scalar
+       ( a, na, b, nb, common, call )
+int
+  *a;
+int
+  na;
+int
+  *b;
+int
+  nb;
+BOOL
+  common;
+#ifndef BSDUNIX
+BOOL
+  (*call) ( int );
+#else
+BOOL
+  (*call) ();
+#endif
+{
+  return ( merge_rest ( a, na, b, nb, 0, common, call ) );
+}
+
+
+#ifdef SIMD_KERNELS
+
+/****************************************************************
+**  merge_sse, merge_avx2
+**
+**  SIMD merge kernels (same parameters as merge_scalar). A block
+**  of a is compared with all rotations of a block of b; the
+**  matches are collected in 'hit'. The block with the smaller
+**  last key is then replaced by the next one (both if the last
+**  keys are equal). A block of a is passed to call_keys when
+**  it is replaced, since no later block of b can match it.
+****************************************************************/
+
+BOOL merge_sse
+       ( a, na, b, nb, common, call )
+int
+  *a;
+int
+  na;
+int
+  *b;
+int
+  nb;
+BOOL
+  common;
+#ifndef BSDUNIX
+BOOL
+  (*call) ( int );
+#else
+BOOL
+  (*call) ();
+#endif
+{
+  __m128i
+    va, vb, m;
+  unsigned
+    hit;
+  int
+    i, j, amax, bmax;
+  BOOL
+    ok;
+
+  i = j = 0;
+  hit = 0;
+  ok = TRUE;
+  while ( ( i + 4 <= na ) && ( j + 4 <= nb ) && ok ) {
+    va = _mm_loadu_si128 ( (__m128i *) ( a + i ) );
+    vb = _mm_loadu_si128 ( (__m128i *) ( b + j ) );
+    m = _mm_cmpeq_epi32 ( va, vb );
+    m = _mm_or_si128 ( m, _mm_cmpeq_epi32 ( va, _mm_shuffle_epi32 ( vb, 0x39 ) ) );
+    m = _mm_or_si128 ( m, _mm_cmpeq_epi32 ( va, _mm_shuffle_epi32 ( vb, 0x4e ) ) );
+    m = _mm_or_si128 ( m, _mm_cmpeq_epi32 ( va, _mm_shuffle_epi32 ( vb, 0x93 ) ) );
+    hit |= (unsigned) _mm_movemask_ps ( _mm_castsi128_ps ( m ) );
+    amax = a [ i + 3 ];
+    bmax = b [ j + 3 ];
+    if ( amax <= bmax ) {
+      ok = call_keys ( a + i, 4, hit, common, call );
+      i += 4;
+      hit = 0;
+    }
+    if ( bmax <= amax ) {
+      j += 4;
+    }
+  }
+  if ( ! ok ) return ( FALSE );
+  return ( merge_rest ( a + i, na - i, b + j, nb - j, hit, common, call ) );
+}
+
+
+__attribute__ (( target ( "avx2" ) ))
+BOOL merge_avx2
+       ( a, na, b, nb, common, call )
+int
+  *a;
+int
+  na;
+int
+  *b;
+int
+  nb;
+BOOL
+  common;
+#ifndef BSDUNIX
+BOOL
+  (*call) ( int );
+#else
+BOOL
+  (*call) ();
+#endif
+{
+  __m256i
+    va, vb, m, rot;
+  unsigned
+    hit;
+  int
+    i, j, k, amax, bmax;
+  BOOL
+    ok;
+
+  rot = _mm256_setr_epi32 ( 1, 2, 3, 4, 5, 6, 7, 0 );
+  i = j = 0;
+  hit = 0;
+  ok = TRUE;
+  while ( ( i + 8 <= na ) && ( j + 8 <= nb ) && ok ) {
+    va = _mm256_loadu_si256 ( (__m256i *) ( a + i ) );
+    vb = _mm256_loadu_si256 ( (__m256i *) ( b + j ) );
+    m = _mm256_cmpeq_epi32 ( va, vb );
+    for ( k = 1; k < 8; k ++ ) {
+      vb = _mm256_permutevar8x32_epi32 ( vb, rot );
+      m = _mm256_or_si256 ( m, _mm256_cmpeq_epi32 ( va, vb ) );
+    }
+    hit |= (unsigned) _mm256_movemask_ps ( _mm256_castsi256_ps ( m ) );
+    amax = a [ i + 7 ];
+    bmax = b [ j + 7 ];
+    if ( amax <= bmax ) {
+      ok = call_keys ( a + i, 8, hit, common, call );
+      i += 8;
+      hit = 0;
+    }
+    if ( bmax <= amax ) {
+      j += 8;
+    }
+  }
+  if ( ! ok ) return ( FALSE );
+  return ( merge_rest ( a + i, na - i, b + j, nb - j, hit, common, call ) );
+}
+
+#endif
+
+
+/****************************************************************
+**  select_isect_kernel
+**
+**  Selects the fastest merge kernel the processor supports for
+**  find_union_int and find_diff_int. It is called by them on
+**  first use; the environment variable ISECT_KERNEL (scalar, sse
+**  or avx2) limits the choice.
+**
+**  OUT : Function returns the name of the kernel.
+****************************************************************/
+
+char *select_isect_kernel
+        ()
+{
+  char
+    *s;
+
+  s = getenv ( "ISECT_KERNEL" );
+  if ( s == NULL ) s = "avx2";
+#ifdef SIMD_KERNELS
+  __builtin_cpu_init ();
+  if ( ( strcmp ( s, "avx2" ) == 0 ) && __builtin_cpu_supports ( "avx2" ) ) {
+    merge_kernel = merge_avx2;
+    return ( "avx2" );
+  }
+  if ( ( strcmp ( s, "avx2" ) == 0 ) || ( strcmp ( s, "sse" ) == 0 ) ) {
+    merge_kernel = merge_sse;
+    return ( "sse" );
+  }
+#endif
+  merge_kernel = merge_scalar;
+  return ( "scalar" );
+}
+
+
+/****************************************************************
+**  grow_size
+**
+**  Returns the new size of a full array with 'total' entries.
+****************************************************************/
+
+int grow_size
+      ( total )
+int
+  total;
+{
+  int
+    newsize;
+
+  newsize = total + ( total / 100 ) * GROW_PERCENT;
+  if ( newsize < total + GROW_MIN ) newsize = total + GROW_MIN;
+  return ( newsize );
+}
+
+
+/****************************************************************
+**  sort_keys
+**
+**  Sorts a key array (and optionally a value array in parallel)
+**  by a stable LSD radix sort.
+**
+**  IN  : key = key array.
+**        val = value array or NULL.
+**        n   = number of keys.
+**
+**  OUT : key is sorted in increasing order; val[i] still belongs
+**        to key[i]. Of equal keys, the first appended comes first.
+****************************************************************/
+
+void sort_keys
+       ( key, val, n )
+int
+  key [];
+double
+  val [];
+int
+  n;
+{
+  unsigned
+    *k, *k2, *kt;
+  double
+    *v, *v2, *vt;
+  int
+    count [ RADIX_SIZE ],
+    shift, i, b, sum, c;
+
+  /* Test for sorted input */
+  for ( i = 1; ( i < n ) && ( key [ i - 1 ] <= key [i] ); i ++ )
+    ;
+  if ( i >= n ) return;
+
+  k = (unsigned *) malloc ( n * sizeof ( unsigned ) );
+  k2 = (unsigned *) malloc ( n * sizeof ( unsigned ) );
+  assert ( ( k != NULL ) && ( k2 != NULL ) );
+  v = val;
+  v2 = NULL;
+  if ( val != NULL ) {
+    v2 = (double *) malloc ( n * sizeof ( double ) );
+    assert ( v2 != NULL );
+  }
+
+  for ( i = 0; i < n; i ++ ) {
+    k [i] = ( (unsigned) key [i] ) ^ SIGN_BIT;
+  }
+
+  for ( shift = 0; shift < sizeof ( int ) * 8; shift += RADIX_BITS ) {
+
+    /* Count occurrences of each digit; skip pass if all equal */
+    for ( b = 0; b < RADIX_SIZE; b ++ ) count [b] = 0;
+    for ( i = 0; i < n; i ++ ) {
+      count [ ( k [i] >> shift ) & ( RADIX_SIZE - 1 ) ] ++;
+    }
+    if ( count [ ( k [0] >> shift ) & ( RADIX_SIZE - 1 ) ] == n ) continue;
+
+    sum = 0;
+    for ( b = 0; b < RADIX_SIZE; b ++ ) {
+      c = count [b];
+      count [b] = sum;
+      sum += c;
+    }
+
+    /* Distribute keys and values */
+    for ( i = 0; i < n; i ++ ) {
+      b = count [ ( k [i] >> shift ) & ( RADIX_SIZE - 1 ) ] ++;
+      k2 [b] = k [i];
+      if ( v != NULL ) v2 [b] = v [i];
+    }
+    kt = k; k = k2; k2 = kt;
+    vt = v; v = v2; v2 = vt;
+  }
+
+  /* Copy result back */
+  for ( i = 0; i < n; i ++ ) {
+    key [i] = (int) ( k [i] ^ SIGN_BIT );
+  }
+  if ( ( val != NULL ) && ( v != val ) ) {
+    for ( i = 0; i < n; i ++ ) {
+      val [i] = v [i];
+    }
+    v2 = v;
+  }
+  if ( v2 != NULL ) free ( v2 );
+  free ( k );
+  free ( k2 );
+}
+
+
+/****************************************************************
+**  unique_keys
+**
+**  Removes duplicate keys from a sorted key array. The first of
+**  several equal keys and its value are kept.
+**
+**  OUT : The number of remaining keys is returned.
+****************************************************************/
+
+int unique_keys
+      ( key, val, n )
+int
+  key [];
+double
+  val [];
+int
+  n;
+{
+  int
+    i, m;
+
+  if ( n == 0 ) return ( 0 );
+
+  m = 0;
+  for ( i = 1; i < n; i ++ ) {
+    if ( key [i] != key [m] ) {
+      m ++;
+      key [m] = key [i];
+      if ( val != NULL ) val [m] = val [i];
+    }
+  }
+  return ( m + 1 );
+}
+
+
+/****************************************************************
+**  create_intlist
+**
+**  Creates a new, empty integer list.
+**
+**  IN  : size = expected number of keys (may be 0).
+**
+**  OUT : A handle to the new list.
+****************************************************************/
+
+INTLIST create_intlist
+          ( size )
+int
+  size;
+{
+  INTLIST
+    list;
+
+  if ( size < 1 ) size = 1;
+
+  list = (INTLIST) malloc ( sizeof ( INTLIST_HEADER ) );
+  assert ( list != NULL );
+  list -> key = (int *) malloc ( size * sizeof ( int ) );
+  assert ( list -> key != NULL );
+  list -> num = 0;
+  list -> total = size;
+  return ( list );
+}
+
+
+/****************************************************************
+**  destroy_intlist
+**
+**  Deallocates an integer list.
+**
+**  IN  : list = pointer to handle of list to be destroyed.
+**  OUT : '*list' is set to NULL.
+****************************************************************/
+
+void destroy_intlist
+       ( list )
+INTLIST
+  *list;
+{
+  if ( *list == NULL ) return;
+  free ( (*list) -> key );
+  free ( *list );
+  *list = NULL;
+}
+
+
+/****************************************************************
+**  clear_intlist
+**
+**  Removes all keys from an integer list. The key array is kept
+**  for reuse.
+****************************************************************/
+
+void clear_intlist
+       ( list )
+INTLIST
+  list;
+{
+  list -> num = 0;
+}
+
+
+/****************************************************************
+**  add_intlist
+**
+**  Inserts a key into an integer list.
+**
+**  IN  : list = handle to integer list.
+**        k    = key to be inserted.
+**
+**  OUT : The function returns the index of 'k' in the list. If
+**        'k' was already in the list, the list is unchanged.
+****************************************************************/
+
+int add_intlist
+      ( list, k )
+INTLIST
+  list;
+int
+  k;
+{
+  int
+    i, pos;
+
+  pos = search_keys ( list -> key, list -> num, k );
+  if ( pos < 0 ) return ( -pos - 1 );
+
+  if ( list -> num >= list -> total ) {
+    list -> total = grow_size ( list -> total );
+    list -> key = (int *) realloc ( list -> key, list -> total * sizeof ( int ) );
+    assert ( list -> key != NULL );
+  }
+
+  /* Make a hole at key[pos] */
+  for ( i = list -> num; i > pos; i -- ) {
+    list -> key [i] = list -> key [ i - 1 ];
+  }
+  list -> key [ pos ] = k;
+  list -> num ++;
+  return ( pos );
+}
+
+
+/****************************************************************
+**  lookup_intlist
+**
+**  Searches a key in an integer list.
+**
+**  OUT : The index of 'k' in the list, or -1 if not found.
+****************************************************************/
+
+int lookup_intlist
+      ( list, k )
+INTLIST
+  list;
+int
+  k;
+{
+  int
+    pos;
+
+  pos = search_keys ( list -> key, list -> num, k );
+  return ( ( pos < 0 ) ? -pos - 1 : -1 );
+}
+
+
+/****************************************************************
+**  append_intlist, finalize_intlist
+**
+**  Bulk loading of integer lists (see list_append_unsorted and
+**  list_finalize in list.c). After append_intlist, the list
+**  must be sorted with finalize_intlist before it can be used.
+****************************************************************/
+
+void append_intlist
+       ( list, k )
+INTLIST
+  list;
+int
+  k;
+{
+  if ( list -> num >= list -> total ) {
+    list -> total = grow_size ( list -> total );
+    list -> key = (int *) realloc ( list -> key, list -> total * sizeof ( int ) );
+    assert ( list -> key != NULL );
+  }
+  list -> key [ list -> num ++ ] = k;
+}
+
+
+void finalize_intlist
+       ( list )
+INTLIST
+  list;
+{
+  sort_keys ( list -> key, (double *) NULL, list -> num );
+  list -> num = unique_keys ( list -> key, (double *) NULL, list -> num );
+}
+
+
+/****************************************************************
+**  find_union_int
+**
+**  Calls a procedure for each key that occurs in both lists,
+**  in increasing order (see find_union in list.c). If the lists
+**  are of similar length, they are merged by the merge kernel;
+**  otherwise the keys of the shorter list are searched in the
+**  longer one with seek_key.
+**
+**  OUT : The function returns the result of the last call to
+**        'call'.
+****************************************************************/
+
+BOOL find_union_int
+       ( list1, list2, call )
+INTLIST
+  list1;
+INTLIST
+  list2;
+#ifndef BSDUNIX
+BOOL
+  (*call) ( int );
+#else
+BOOL
+  (*call) ();
+#endif
+{
+  INTLIST
+    t;
+  int
+    i, j, res;
+  BOOL
+    gallop, ok;
+
+  /* Order is irrelevant since only the keys are passed to 'call' */
+  if ( list1 -> num > list2 -> num ) {
+    t = list1; list1 = list2; list2 = t;
+  }
+  gallop = ( list2 -> num / GALLOP_RATIO > list1 -> num );
+  if ( ! gallop ) {
+    if ( merge_kernel == NULL ) select_isect_kernel ();
+    return ( (*merge_kernel) ( list1 -> key, list1 -> num, list2 -> key, 
+                               list2 -> num, TRUE, call ) );
+  }
+
+  j = 0;
+  ok = TRUE;
+  for ( i = 0; ( i < list1 -> num ) && ( j < list2 -> num ) && ok; i ++ ) {
+    res = seek_key ( list2 -> key, j, list2 -> num, list1 -> key [i], gallop );
+    if ( res < 0 ) {
+      ok = (*call) ( list1 -> key [i] );
+      j = -res;
+    }
+    else {
+      j = res;
+    }
+  }
+  return ( ok );
+}
+
+
+/****************************************************************
+**  find_diff_int
+**
+**  Calls a procedure for each key that occurs in list1 but not
+**  in list2, in increasing order (see find_diff in list.c). As
+**  in find_union_int, lists of similar length are merged by the
+**  merge kernel.
+**
+**  OUT : The function returns the result of the last call to
+**        'call'.
+****************************************************************/
+
+BOOL find_diff_int
+       ( list1, list2, call )
+INTLIST
+  list1;
+INTLIST
+  list2;
+#ifndef BSDUNIX
+BOOL
+  (*call) ( int );
+#else
+BOOL
+  (*call) ();
+#endif
+{
+  int
+    i, j, res;
+  BOOL
+    gallop, ok;
+
+  gallop = ( list2 -> num / GALLOP_RATIO > list1 -> num );
+  if ( ! gallop ) {
+    if ( merge_kernel == NULL ) select_isect_kernel ();
+    return ( (*merge_kernel) ( list1 -> key, list1 -> num, list2 -> key, 
+                               list2 -> num, FALSE, call ) );
+  }
+
+  j = 0;
+  ok = TRUE;
+  for ( i = 0; ( i < list1 -> num ) && ok; i ++ ) {
+    res = seek_key ( list2 -> key, j, list2 -> num, list1 -> key [i], gallop );
+    if ( res < 0 ) {
+      j = -res;
+    }
+    else {
+      ok = (*call) ( list1 -> key [i] );
+      j = res;
+    }
+  }
+  return ( ok );
+}
+
+
+/****************************************************************
+**  create_iflist
+**
+**  Creates a new, empty integer/float list.
+**
+**  IN  : size = expected number of keys (may be 0).
+**
+**  OUT : A handle to the new list.
+****************************************************************/
+
+INTFLOAT_LIST create_iflist
+                ( size )
+int
+  size;
+{
+  INTFLOAT_LIST
+    list;
+
+  if ( size < 1 ) size = 1;
+
+  list = (INTFLOAT_LIST) malloc ( sizeof ( IFLIST_HEADER ) );
+  assert ( list != NULL );
+  list -> key = (int *) malloc ( size * sizeof ( int ) );
+  list -> val = (double *) malloc ( size * sizeof ( double ) );
+  assert ( ( list -> key != NULL ) && ( list -> val != NULL ) );
+  list -> num = 0;
+  list -> total = size;
+  return ( list );
+}
+
+
+/****************************************************************
+**  destroy_iflist
+**
+**  Deallocates an integer/float list.
+**
+**  IN  : list = pointer to handle of list to be destroyed.
+**  OUT : '*list' is set to NULL.
+****************************************************************/
+
+void destroy_iflist
+       ( list )
+INTFLOAT_LIST
+  *list;
+{
+  if ( *list == NULL ) return;
+  free ( (*list) -> key );
+  free ( (*list) -> val );
+  free ( *list );
+  *list = NULL;
+}
+
+
+/****************************************************************
+**  add_iflist
+**
+**  Inserts a key and its value into an integer/float list.
+**
+**  IN  : list = handle to integer/float list.
+**        k    = key to be inserted.
+**        v    = value of the key.
+**
+**  OUT : The function returns the index of 'k' in the list. If
+**        'k' was already in the list, its value is NOT changed.
+****************************************************************/
+
+int add_iflist
+      ( list, k, v )
+INTFLOAT_LIST
+  list;
+int
+  k;
+double
+  v;
+{
+  int
+    i, pos;
+
+  pos = search_keys ( list -> key, list -> num, k );
+  if ( pos < 0 ) return ( -pos - 1 );
+
+  if ( list -> num >= list -> total ) {
+    list -> total = grow_size ( list -> total );
+    list -> key = (int *) realloc ( list -> key, list -> total * sizeof ( int ) );
+    list -> val = (double *) realloc ( list -> val,
+                                       list -> total * sizeof ( double ) );
+    assert ( ( list -> key != NULL ) && ( list -> val != NULL ) );
+  }
+
+  /* Make a hole at position pos */
+  for ( i = list -> num; i > pos; i -- ) {
+    list -> key [i] = list -> key [ i - 1 ];
+    list -> val [i] = list -> val [ i - 1 ];
+  }
+  list -> key [ pos ] = k;
+  list -> val [ pos ] = v;
+  list -> num ++;
+  return ( pos );
+}
+
+
+/****************************************************************
+**  lookup_iflist
+**
+**  Searches a key in an integer/float list.
+**
+**  OUT : The index of 'k' in the list, or -1 if not found.
+****************************************************************/
+
+int lookup_iflist
+      ( list, k )
+INTFLOAT_LIST
+  list;
+int
+  k;
+{
+  int
+    pos;
+
+  pos = search_keys ( list -> key, list -> num, k );
+  return ( ( pos < 0 ) ? -pos - 1 : -1 );
+}
+
+
+/****************************************************************
+**  append_iflist, finalize_iflist
+**
+**  Bulk loading of integer/float lists. Of several equal keys,
+**  the value appended first is kept.
+****************************************************************/
+
+void append_iflist
+       ( list, k, v )
+INTFLOAT_LIST
+  list;
+int
+  k;
+double
+  v;
+{
+  if ( list -> num >= list -> total ) {
+    list -> total = grow_size ( list -> total );
+    list -> key = (int *) realloc ( list -> key, list -> total * sizeof ( int ) );
+    list -> val = (double *) realloc ( list -> val,
+                                       list -> total * sizeof ( double ) );
+    assert ( ( list -> key != NULL ) && ( list -> val != NULL ) );
+  }
+  list -> key [ list -> num ] = k;
+  list -> val [ list -> num ] = v;
+  list -> num ++;
+}
+
+
+void finalize_iflist
+       ( list )
+INTFLOAT_LIST
+  list;
+{
+  sort_keys ( list -> key, list -> val, list -> num );
+  list -> num = unique_keys ( list -> key, list -> val, list -> num );
+}
+
+
+/****************************************************************
+**  find_union_if
+**
+**  Calls a procedure for each key that occurs in both lists,
+**  in increasing order. 'call' is called with the key and its
+**  values in list1 and list2. The keys of the shorter list are
+**  searched in the longer one with seek_key.
+**
+**  OUT : The function returns the result of the last call to
+**        'call'.
+****************************************************************/
+
+BOOL find_union_if
+       ( list1, list2, call )
+INTFLOAT_LIST
+  list1;
+INTFLOAT_LIST
+  list2;
+#ifndef BSDUNIX
+BOOL
+  (*call) ( int, double, double );
+#else
+BOOL
+  (*call) ();
+#endif
+{
+  int
+    i, j, res;
+  BOOL
+    gallop, ok;
+
+  ok = TRUE;
+  if ( list1 -> num <= list2 -> num ) {
+    /* Search keys of list1 in list2 */
+    gallop = ( list2 -> num / GALLOP_RATIO > list1 -> num );
+    j = 0;
+    for ( i = 0; ( i < list1 -> num ) && ( j < list2 -> num ) && ok; i ++ ) {
+      res = seek_key ( list2 -> key, j, list2 -> num, list1 -> key [i],
+                       gallop );
+      if ( res < 0 ) {
+        j = -res - 1;
+        ok = (*call) ( list1 -> key [i], list1 -> val [i], list2 -> val [j] );
+        j ++;
+      }
+      else {
+        j = res;
+      }
+    }
+  }
+  else {
+    /* Search keys of list2 in list1 */
+    gallop = ( list1 -> num / GALLOP_RATIO > list2 -> num );
+    i = 0;
+    for ( j = 0; ( j < list2 -> num ) && ( i < list1 -> num ) && ok; j ++ ) {
+      res = seek_key ( list1 -> key, i, list1 -> num, list2 -> key [j],
+                       gallop );
+      if ( res < 0 ) {
+        i = -res - 1;
+        ok = (*call) ( list2 -> key [j], list1 -> val [i], list2 -> val [j] );
+        i ++;
+      }
+      else {
+        i = res;
+      }
+    }
+  }
+  return ( ok );
+}
+
+
+/****************************************************************
+**  find_diff_if
+**
+**  Calls a procedure for each key that occurs in list1 but not
+**  in list2, in increasing order. 'call' is called with the key
+**  and its value in list1.
+**
+**  OUT : The function returns the result of the last call to
+**        'call'.
+****************************************************************/
+
+BOOL find_diff_if
+       ( list1, list2, call )
+INTFLOAT_LIST
+  list1;
+INTFLOAT_LIST
+  list2;
+#ifndef BSDUNIX
+BOOL
+  (*call) ( int, double );
+#else
+BOOL
+  (*call) ();
+#endif
+{
+  int
+    i, j, res;
+  BOOL
+    gallop, ok;
+
+  gallop = ( list2 -> num / GALLOP_RATIO > list1 -> num );
+
+  j = 0;
+  ok = TRUE;
+  for ( i = 0; ( i < list1 -> num ) && ok; i ++ ) {
+    res = seek_key ( list2 -> key, j, list2 -> num, list1 -> key [i], gallop );
+    if ( res < 0 ) {
+      j = -res;
+    }
+    else {
+      ok = (*call) ( list1 -> key [i], list1 -> val [i] );
+      j = res;
+    }
+  }
+  return ( ok );
+}
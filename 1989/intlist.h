@@ -0,0 +1,118 @@
+/****************************************************************
+*
+*           S O F T W A R E   S O U R C E   F I L E
+*
+*****************************************************************
+*
+*   Name of file   : intlist.h 
+*   Author         : Guido Hoss
+*   Project        : ETH Diploma Thesis (SS 1989)
+*   Creation Date  : 02/05/89
+*   Type of file   : C Header File
+*
+*****************************************************************
+*
+*   COPYRIGHT (C) 1989, 2016 BY GUIDO HOSS.
+*
+*   This program is free software: you can redistribute it and/or 
+*   modify it under the terms of the GNU General Public License
+*   as published by the Free Software Foundation, either version 3
+*   of the License, or (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public
+*   License along with this program.  If not, see
+*   <http://www.gnu.org/licenses/>.
+*
+*   Git repository home: <https://github.com/ghoss/Thesis>
+*
+*****************************************************************
+* Date        :
+* Description :
+****************************************************************/   
+
+/* Integer lists are sorted sets of integers. In contrast to LIST,
+   the keys are stored directly in a dynamic array, so no memory is
+   allocated per element and no compare function is needed.
+
+   Integer/float lists (INTFLOAT_LIST) additionally store a double
+   value with each key. */
+typedef
+  struct {
+    int		*key;	/* Keys in increasing order */
+    int		num;	/* Number of keys used */
+    int		total;	/* Size of key array */
+  } INTLIST_HEADER;
+
+typedef
+  INTLIST_HEADER *INTLIST;
+
+typedef
+  struct {
+    int		*key;	/* Keys in increasing order */
+    double	*val;	/* val[i] is the value of key[i] */
+    int		num;	/* Number of keys used */
+    int		total;	/* Size of key and value arrays */
+  } IFLIST_HEADER;
+
+typedef
+  IFLIST_HEADER *INTFLOAT_LIST;
+
+
+/* Access to the elements of a list; elements are numbered
+   0 .. count - 1 in increasing key order */
+#define count_intlist(l)	( (l) -> num )
+#define intlist_key(l,i)	( (l) -> key [i] )
+
+#define count_iflist(l)		( (l) -> num )
+#define iflist_key(l,i)		( (l) -> key [i] )
+#define iflist_val(l,i)		( (l) -> val [i] )
+
+
+/* Functions defined on integer lists */
+#ifndef BSDUNIX
+INTLIST create_intlist ( int );
+void destroy_intlist ( INTLIST * );
+void clear_intlist ( INTLIST );
+int add_intlist ( INTLIST, int );
+int lookup_intlist ( INTLIST, int );
+void append_intlist ( INTLIST, int );
+void finalize_intlist ( INTLIST );
+BOOL find_union_int ( INTLIST, INTLIST, BOOL (*) ( int ) );
+BOOL find_diff_int ( INTLIST, INTLIST, BOOL (*) ( int ) );
+char *select_isect_kernel ( void );
+
+INTFLOAT_LIST create_iflist ( int );
+void destroy_iflist ( INTFLOAT_LIST * );
+int add_iflist ( INTFLOAT_LIST, int, double );
+int lookup_iflist ( INTFLOAT_LIST, int );
+void append_iflist ( INTFLOAT_LIST, int, double );
+void finalize_iflist ( INTFLOAT_LIST );
+BOOL find_union_if ( INTFLOAT_LIST, INTFLOAT_LIST,
+                     BOOL (*) ( int, double, double ) );
+BOOL find_diff_if ( INTFLOAT_LIST, INTFLOAT_LIST, BOOL (*) ( int, double ) );
+#else
+INTLIST create_intlist ();
+void destroy_intlist ();
+void clear_intlist ();
+int add_intlist ();
+int lookup_intlist ();
+void append_intlist ();
+void finalize_intlist ();
+BOOL find_union_int ();
+BOOL find_diff_int ();
+char *select_isect_kernel ();
+
+INTFLOAT_LIST create_iflist ();
+void destroy_iflist ();
+int add_iflist ();
+int lookup_iflist ();
+void append_iflist ();
+void finalize_iflist ();
+BOOL find_union_if ();
+BOOL find_diff_if ();
+#endif
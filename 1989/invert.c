@@ -0,0 +1,172 @@
+/****************************************************************
+*
+*           S O F T W A R E   S O U R C E   F I L E
+*
+*****************************************************************
+*
+*   Name of file   : invert.c
+*   Author         : Guido Hoss
+*   Project        : ETH Diploma Thesis (SS 1989)
+*   Creation Date  : 10/05/89
+*   Type of file   : C Language File
+*
+*   Description
+*   -----------
+*   Builds the atom index of a set of document descriptions,
+*   see invert.h.
+*
+*****************************************************************
+*
+*   COPYRIGHT (C) 1989, 2016 BY GUIDO HOSS.
+*
+*   This program is free software: you can redistribute it and/or 
+*   modify it under the terms of the GNU General Public License
+*   as published by the Free Software Foundation, either version 3
+*   of the License, or (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public
+*   License along with this program.  If not, see
+*   <http://www.gnu.org/licenses/>.
+*
+*   Git repository home: <https://github.com/ghoss/Thesis>
+*
+*****************************************************************
+* Date        :
+* Description :
+****************************************************************/   
+
+#include <stdio.h>
+#include <malloc.h>
+#include <assert.h>
+
+#include "boolean.h"
+#include "list.h"
+#include "intlist.h"
+#include "descr.h"
+#include "atomidx.h"
+#include "invert.h"
+
+
+/****************************************************************
+**  invert_descr
+**
+**  Builds the atom index of document descriptions. Every sign
+**  weight w(d,s) yields a posting (d, w(d,s)) for each concept
+**  of s. The postings are sorted by concept in two passes over
+**  the documents (counting and distributing); since the
+**  documents are visited in order of their indices, the
+**  postings of each concept end up sorted by document. The
+**  weight of a concept in a document is the sum of the weights
+**  of its signs, added in the order of the signs.
+**
+**  IN  : d          = document descriptions.
+**        atoms      = all atomic concepts.
+**        sign_atoms = function returning the positions in
+**                     'atoms' of the concepts of a sign in
+**                     increasing order, or NULL if the sign
+**                     has no concepts.
+**
+**  OUT : Function returns the weighted index, whose concept i
+**        is the i-th element of 'atoms'.
+****************************************************************/ 
+
+ATOM_INDEX invert_descr
+             ( d, atoms, sign_atoms )
+DESCR
+  d;
+INTLIST
+  atoms;
+#ifndef BSDUNIX
+INTLIST
+  (*sign_atoms) ( int );
+#else
+INTLIST
+  (*sign_atoms) ();
+#endif
+{
+  ATOM_INDEX
+    x;
+  INTLIST
+    l;
+  DESCR_WGT
+    *w;
+  int
+    *start,		/* position of first posting of each concept */
+    *fill,		/* position of next posting of each concept */
+    *post_doc,		/* documents of the postings */
+    i, j, k, a, p, end,
+    num, doc;
+  double
+    *post_wgt,		/* weights of the postings */
+    wgt;
+  int
+    pass;
+
+  num = count_intlist ( atoms );
+  start = (int *) calloc ( num + 1, sizeof ( int ) );
+  fill = (int *) calloc ( num + 1, sizeof ( int ) );
+  assert ( ( start != NULL ) && ( fill != NULL ) );
+  post_doc = NULL;
+  post_wgt = NULL;
+
+  /* Pass 0 counts the postings of each concept, pass 1
+     distributes them */
+  sort_descr ( d );
+  for ( pass = 0; pass < 2; pass ++ ) {
+    for ( k = 0; k < descr_docs ( d ); k ++ ) {
+      i = descr_sorted ( d, k );
+      w = descr_wgts ( d, i );
+      for ( j = 0; j < descr_count ( d, i ); j ++ ) {
+        l = (*sign_atoms) ( w [j].sign );
+        if ( l == NULL ) continue;
+
+        for ( a = 0; a < count_intlist ( l ); a ++ ) {
+          p = fill [ intlist_key ( l, a ) ] ++;
+          if ( pass == 1 ) {
+            post_doc [p] = descr_index ( d, i );
+            post_wgt [p] = (double) w [j].weight;
+          }
+        }
+      }
+    }
+
+    if ( pass == 0 ) {
+      /* Turn counts into positions */
+      for ( a = 0; a < num; a ++ ) {
+        start [ a + 1 ] = start [a] + fill [a];
+        fill [a] = start [a];
+      }
+      post_doc = (int *) malloc ( ( start [ num ] + 1 ) * sizeof ( int ) );
+      post_wgt = (double *) malloc ( ( start [ num ] + 1 ) * sizeof ( double ) );
+      assert ( ( post_doc != NULL ) && ( post_wgt != NULL ) );
+    }
+  }
+
+  /* Copy postings into index; a document which contains several
+     signs of a concept occurs only once */
+  x = create_index ( descr_docs ( d ), TRUE );
+  for ( a = 0; a < num; a ++ ) {
+    add_atom ( x, intlist_key ( atoms, a ) );
+    p = start [a];
+    end = start [ a + 1 ];
+    while ( p < end ) {
+      doc = post_doc [p];
+      wgt = post_wgt [p ++];
+      while ( ( p < end ) && ( post_doc [p] == doc ) ) {
+        wgt += post_wgt [p ++];
+      }
+      add_posting ( x, doc, wgt );
+    }
+  }
+
+  free ( (char *) start );
+  free ( (char *) fill );
+  free ( (char *) post_doc );
+  free ( (char *) post_wgt );
+  return ( x );
+}
@@ -0,0 +1,47 @@
+/****************************************************************
+*
+*           S O F T W A R E   S O U R C E   F I L E
+*
+*****************************************************************
+*
+*   Name of file   : invert.h
+*   Author         : Guido Hoss
+*   Project        : ETH Diploma Thesis (SS 1989)
+*   Creation Date  : 10/05/89
+*   Type of file   : C Header File
+*
+*****************************************************************
+*
+*   COPYRIGHT (C) 1989, 2016 BY GUIDO HOSS.
+*
+*   This program is free software: you can redistribute it and/or 
+*   modify it under the terms of the GNU General Public License
+*   as published by the Free Software Foundation, either version 3
+*   of the License, or (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public
+*   License along with this program.  If not, see
+*   <http://www.gnu.org/licenses/>.
+*
+*   Git repository home: <https://github.com/ghoss/Thesis>
+*
+*****************************************************************
+* Date        :
+* Description :
+****************************************************************/   
+
+/* Inversion of the document descriptions into an atom index (see
+   atomidx.h). The concepts of the index are the elements of a
+   sorted list of all atomic concepts; a sign is mapped to its
+   concepts by a function returning their positions in this list. */
+
+#ifndef BSDUNIX
+ATOM_INDEX invert_descr ( DESCR, INTLIST, INTLIST (*) ( int ) );
+#else
+ATOM_INDEX invert_descr ();
+#endif
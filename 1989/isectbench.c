@@ -0,0 +1,394 @@
+/****************************************************************
+*
+*           S O F T W A R E   S O U R C E   F I L E
+*
+*****************************************************************
+*
+*   Name of file   : isectbench.c
+*   Author         : Guido Hoss
+*   Project        : ETH Diploma Thesis (SS 1989)
+*   Creation Date  : 03/05/89
+*   Type of file   : C Language File
+*
+*   Description
+*   -----------
+*   Measures the list intersection functions for pairs of lists
+*   with different length ratios, as they occur in the RSV
+*   calculation (short query vs. long document) and in the
+*   cluster and centroid programs. Compared are
+*
+*	find_union		element by element
+*	find_union_gallop	galloping search in the longer list
+*	find_union_int		integer lists (intlist.c), once
+*				with each merge kernel
+*
+*   find_diff_int is checked with each kernel: it must find the
+*   keys of the shorter list which find_union did not find.
+*
+*   The program is linked twice, once with each list
+*   implementation:
+*
+*	isectbench    = list.o  (sorted dynamic array)
+*	isectbench_bt = btree.o (B+-tree)
+*
+*   Call Format
+*   -----------
+*	isectbench [n]
+*
+*   'n' is the length of the longer list (default 100000). The
+*   shorter list has n / ratio elements for ratio = 1, 4, 16,
+*   ..., 4096. Half of the keys of the shorter list also occur
+*   in the longer one.
+*
+*****************************************************************
+*
+*   COPYRIGHT (C) 1989, 2016 BY GUIDO HOSS.
+*
+*   This program is free software: you can redistribute it and/or
+*   modify it under the terms of the GNU General Public License
+*   as published by the Free Software Foundation, either version 3
+*   of the License, or (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public
+*   License along with this program.  If not, see
+*   <http://www.gnu.org/licenses/>.
+*
+*   Git repository home: <https://github.com/ghoss/Thesis>
+*
+*****************************************************************
+* Date        :
+* Description :
+****************************************************************/
+
+#define PROG	"Intersection Benchmark (gh, 03/05/89)\n"
+#define USAGE	"Usage: isectbench [n]\n"
+
+#include <stdio.h>
+#ifdef MSDOS
+#include <process.h>
+#endif
+#include <stdlib.h>
+#include <string.h>
+#include <malloc.h>
+#include <assert.h>
+#include <time.h>
+
+#include "boolean.h"
+#include "list.h"
+#include "intlist.h"
+
+#ifndef CLOCKS_PER_SEC
+#define CLOCKS_PER_SEC	CLK_TCK
+#endif
+
+#define DEF_N		100000L	/* Default length of longer list */
+#define MAX_RATIO	4096	/* Largest length ratio */
+#define MIN_TIME	0.2	/* Min. measuring time per test (seconds) */
+
+typedef
+  struct {
+    int		key;		/* Element key */
+  } KEY_STRUCT;
+
+long
+  glob_count;			/* Number of common elements found */
+int
+  glob_last;			/* Last key passed to count_int */
+
+char
+  *kernels [] = { "ISECT_KERNEL=scalar", "ISECT_KERNEL=sse",
+                  "ISECT_KERNEL=avx2" };
+
+#define NUM_KERNELS	( (int) ( sizeof ( kernels ) / sizeof ( char * ) ) )
+
+
+/****************************************************************
+**  Procedure declarations
+****************************************************************/
+
+#ifndef BSDUNIX
+int main ( int, char * [] );
+int comp_key ( ELEMENT, ELEMENT );
+BOOL count_elt ( ELEMENT, ELEMENT );
+BOOL count_int ( int );
+long random_num ( void );
+void make_lists ( long, int, LIST *, LIST *, INTLIST *, INTLIST * );
+double time_union ( LIST, LIST, INTLIST, INTLIST, int, long * );
+#else
+int main ();
+int comp_key ();
+BOOL count_elt ();
+BOOL count_int ();
+long random_num ();
+void make_lists ();
+double time_union ();
+#endif
+
+
+/****************************************************************
+**  comp_key, count_elt, count_int
+**
+**  Compare function and intersection callbacks. count_int also
+**  checks that the keys arrive in increasing order.
+****************************************************************/
+
+int comp_key
+      ( k1, k2 )
+ELEMENT
+  k1;
+ELEMENT
+  k2;
+{
+  int
+    a, b;
+
+  a = ((KEY_STRUCT *) k1) -> key;
+  b = ((KEY_STRUCT *) k2) -> key;
+  return ( ( a < b ) ? -1 : ( a > b ) );
+}
+
+
+BOOL count_elt
+       ( e1, e2 )
+ELEMENT
+  e1;
+ELEMENT
+  e2;
+{
+  glob_count ++;
+  return ( TRUE );
+}
+
+
+BOOL count_int
+       ( k )
+int
+  k;
+{
+  assert ( ( glob_count == 0 ) || ( k > glob_last ) );
+  glob_last = k;
+  glob_count ++;
+  return ( TRUE );
+}
+
+
+/****************************************************************
+**  random_num
+**
+**  Returns a pseudo-random number in [0, 2^31) (see listbench.c).
+****************************************************************/
+
+long random_num
+       ( )
+{
+  static unsigned long
+    seed = 1;
+
+  seed = ( seed * 1103515245L + 12345L ) & 0xffffffffL;
+  return ( (long) ( ( seed >> 1 ) & 0x7fffffffL ) );
+}
+
+
+/****************************************************************
+**  make_lists
+**
+**  Builds a pair of lists, both as LIST and as INTLIST.
+**
+**  IN  : n     = length of the longer list.
+**        ratio = length ratio of the two lists.
+**
+**  OUT : *l1, *i1 = shorter list (n / ratio elements).
+**        *l2, *i2 = longer list (n elements).
+**        The longer list contains the even numbers 0 .. 2n-2.
+**        The keys of the shorter list are random numbers in the
+**        same range, so about half of them are common.
+****************************************************************/
+
+void make_lists
+       ( n, ratio, l1, l2, i1, i2 )
+long
+  n;
+int
+  ratio;
+LIST
+  *l1, *l2;
+INTLIST
+  *i1, *i2;
+{
+  KEY_STRUCT
+    *elt;
+  long
+    i, m;
+
+  m = n / ratio;
+  *l1 = create_list_sized ( (int) m );
+  *l2 = create_list_sized ( (int) n );
+  *i1 = create_intlist ( (int) m );
+  *i2 = create_intlist ( (int) n );
+
+  for ( i = 0; i < n; i ++ ) {
+    elt = (KEY_STRUCT *) malloc ( sizeof ( KEY_STRUCT ) );
+    assert ( elt != NULL );
+    elt -> key = (int) ( 2 * i );
+    list_append_unsorted ( *l2, (ELEMENT) elt );
+    append_intlist ( *i2, elt -> key );
+  }
+
+  for ( i = 0; i < m; i ++ ) {
+    elt = (KEY_STRUCT *) malloc ( sizeof ( KEY_STRUCT ) );
+    assert ( elt != NULL );
+    elt -> key = (int) ( random_num () % ( 2 * n ) );
+    list_append_unsorted ( *l1, (ELEMENT) elt );
+    append_intlist ( *i1, elt -> key );
+  }
+
+  list_finalize ( *l1, comp_key, NULL );
+  list_finalize ( *l2, comp_key, NULL );
+  finalize_intlist ( *i1 );
+  finalize_intlist ( *i2 );
+}
+
+
+/****************************************************************
+**  time_union
+**
+**  Repeats an intersection until MIN_TIME seconds have passed.
+**
+**  IN  : l1, l2, i1, i2 = lists (see make_lists).
+**        method         = 0 --> find_union
+**                         1 --> find_union_gallop
+**                         2 --> find_union_int
+**                         3 --> find_diff_int
+**
+**  OUT : The function returns the time of one intersection in
+**        microseconds. *found is the number of common elements.
+****************************************************************/
+
+double time_union
+         ( l1, l2, i1, i2, method, found )
+LIST
+  l1, l2;
+INTLIST
+  i1, i2;
+int
+  method;
+long
+  *found;
+{
+  clock_t
+    start, stop;
+  long
+    rep, r;
+
+  rep = 1;
+  for ( ;; ) {
+    start = clock ();
+    for ( r = 0; r < rep; r ++ ) {
+      glob_count = 0;
+      switch ( method ) {
+        case 0 :
+          find_union ( l1, l2, comp_key, count_elt );
+          break;
+        case 1 :
+          find_union_gallop ( l1, l2, comp_key, count_elt );
+          break;
+        case 2 :
+          find_union_int ( i1, i2, count_int );
+          break;
+        case 3 :
+          find_diff_int ( i1, i2, count_int );
+          break;
+      }
+    }
+    stop = clock ();
+    if ( (double) ( stop - start ) / (double) CLOCKS_PER_SEC >= MIN_TIME ) {
+      break;
+    }
+    rep *= 2;
+  }
+
+  *found = glob_count;
+  return ( (double) ( stop - start ) * 1000000.0 /
+           ( (double) CLOCKS_PER_SEC * (double) rep ) );
+}
+
+
+/****************************************************************
+**  main
+****************************************************************/
+
+int main
+      ( argc, argv )
+int
+  argc;
+char
+  *argv [];
+{
+  long
+    n, f0, f1, f2, f3;
+  int
+    ratio, k;
+  char
+    *name;
+  double
+    t0, t1, t2;
+  LIST
+    l1, l2;
+  INTLIST
+    i1, i2;
+
+  /* Program title */
+  fprintf ( stderr, PROG );
+
+  n = ( argc > 1 ) ? atol ( argv [1] ) : DEF_N;
+  if ( n < MAX_RATIO ) {
+    fprintf ( stderr, USAGE );
+    return ( 1 );
+  }
+
+  printf ( "Longer list: %ld elements, times in microseconds\n", n );
+  printf ( "%6s %8s %8s %12s %12s", "ratio", "short",
+           "common", "find_union", "gallop" );
+  for ( k = 0; k < NUM_KERNELS; k ++ ) {
+    printf ( " %12s", strchr ( kernels [k], '=' ) + 1 );
+  }
+  printf ( "\n" );
+
+  for ( ratio = 1; ratio <= MAX_RATIO; ratio *= 4 ) {
+    make_lists ( n, ratio, &l1, &l2, &i1, &i2 );
+
+    t0 = time_union ( l1, l2, i1, i2, 0, &f0 );
+    t1 = time_union ( l1, l2, i1, i2, 1, &f1 );
+    assert ( f0 == f1 );
+    printf ( "%6d %8d %8ld %12.1f %12.1f", ratio,
+             count_list ( l1 ), f0, t0, t1 );
+
+    /* Kernels which the processor does not support are skipped */
+    for ( k = 0; k < NUM_KERNELS; k ++ ) {
+      putenv ( kernels [k] );
+      name = select_isect_kernel ();
+      if ( strcmp ( name, strchr ( kernels [k], '=' ) + 1 ) != 0 ) {
+        printf ( " %12s", "-" );
+        continue;
+      }
+      t2 = time_union ( l1, l2, i1, i2, 2, &f2 );
+      time_union ( l1, l2, i1, i2, 3, &f3 );
+      assert ( ( f0 == f2 ) && ( f2 + f3 == count_intlist ( i1 ) ) );
+      printf ( " %12.1f", t2 );
+    }
+    printf ( "\n" );
+    fflush ( stdout );
+
+    destroy_list ( &l1 );
+    destroy_list ( &l2 );
+    destroy_intlist ( &i1 );
+    destroy_intlist ( &i2 );
+  }
+
+  return ( 0 );
+}
@@ -57,12 +57,50 @@
 ****************************************************************/
 
 #include "list.h"
+#include "listsort.h"
+#include "util.h"
+
+/* Lists are arrays of list elements, sorted in a user-defined order. */
+typedef
+  ELEMENT ARRAY [];
+
+/* The list header contains a pointer to the associated array and the
+   number of elements contained in it. */
+struct list_header {
+  ARRAY *array;  /* Pointer to base of array */
+  int   num;     /* Number of array entries used */
+  int   total;   /* Number of total array entries */
+  ARENA arena;   /* Arena of the elements, or NULL */
+};
+
+/* Growth policy: a full array is enlarged by GROW_PERCENT percent of
+   its size, but at least by GROW_MIN entries (GROW_PERCENT = 0 gives
+   the old behaviour of adding 10 entries at a time). If less than
+   SHRINK_PERCENT percent of the entries are used after a deletion,
+   the array is reduced to twice the number of used entries. */
+#ifndef GROW_PERCENT
+#define GROW_PERCENT	50
+#endif
+#ifndef SHRINK_PERCENT
+#define SHRINK_PERCENT	25
+#endif
+#define GROW_MIN	10
+
+/* find_union_gallop and find_diff_gallop only gallop if one list
+   is more than GALLOP_RATIO times longer than the other */
+#ifndef GALLOP_RATIO
+#define GALLOP_RATIO	32
+#endif
 
 #ifndef BSDUNIX
 int binary_search ( ARRAY, int, ELEMENT, int (*) ( ELEMENT, ELEMENT ) );
+int gallop_search ( ARRAY, int, int, ELEMENT, int (*) ( ELEMENT, ELEMENT ) );
+BOOL grow_array ( LIST );
 ELEMENT add ( LIST, ELEMENT, int (*) ( ELEMENT, ELEMENT ), BOOL );
 #else
 int binary_search ();
+int gallop_search ();
+BOOL grow_array ();
 ELEMENT add ();
 #endif
 
@@ -78,19 +116,44 @@ ELEMENT add ();
 
 LIST create_list
        ( )
+{
+  return ( create_list_sized ( 1 ) );
+}
+
+
+/****************************************************************
+**  create_list_sized
+**
+**  Creates a new, empty list with room for a given number of
+**  elements. Loaders which know the size of a list in advance
+**  should use this function to avoid reallocations.
+**
+**  IN  : size = expected number of list elements.
+**
+**  OUT : A handle to the new list, or NULL if the function did
+**        not succeed.
+****************************************************************/
+
+LIST create_list_sized
+       ( size )
+int
+  size;
 {
   HEADER
     *header;
 
+  if ( size < 1 ) size = 1;
+
   /* Allocate header */
   header = (HEADER *) malloc ( sizeof ( HEADER ) );
   
   /* Allocate header and initialized contents for empty list */
   if ( header != NULL ) {
-    header -> array = (ARRAY *) malloc ( sizeof ( ELEMENT ) );
+    header -> array = (ARRAY *) malloc ( size * sizeof ( ELEMENT ) );
     assert ( header -> array != NULL );
-    header -> total = 1;
+    header -> total = size;
     header -> num = 0;
+    header -> arena = NULL;
   }
   
   /* Return pointer to header */
@@ -103,7 +166,8 @@ LIST create_list
 **
 **  Deallocates all memory used by an existing list, thereby
 **  destroying its contents. It must be possible to deallocate
-**  the list elements with calls to free().
+**  the list elements with calls to free(), unless the elements
+**  are allocated in an arena (see list_set_arena).
 **
 **  IN  : list = Pointer to handle of list to be destroyed.
 **  OUT : '*list' is set to NULL.
@@ -124,8 +188,10 @@ LIST
   /* Free all array elements */
   arr = (*list) -> array;
   max = (*list) -> num;
-  for ( i = 0; i < max; i ++ ) {
-    free ( (*arr) [i] );
+  if ( (*list) -> arena == NULL ) {
+    for ( i = 0; i < max; i ++ ) {
+      free ( (*arr) [i] );
+    }
   }
   
   /* Free header */
@@ -198,6 +264,41 @@ int
 }
 
 
+/****************************************************************
+**  grow_array
+**
+**  Enlarges the array of a list according to the growth policy.
+**
+**  IN  : list = handle to list.
+**
+**  OUT : TRUE if successful, FALSE if out of memory (the list
+**        is unchanged in this case).
+****************************************************************/
+
+BOOL grow_array
+       ( list )
+LIST
+  list;
+{
+  ARRAY
+    *arr;
+  int
+    newsize, tot;
+
+  tot = list -> total;
+  newsize = tot + ( tot / 100 ) * GROW_PERCENT;
+  if ( newsize < tot + GROW_MIN ) newsize = tot + GROW_MIN;
+
+  arr = (ARRAY *) realloc ( list -> array, newsize * sizeof ( ELEMENT ) );
+  if ( arr == NULL ) {
+    return ( FALSE );
+  }
+  list -> total = newsize;
+  list -> array = arr;
+  return ( TRUE );
+}
+
+
 /****************************************************************
 **  add
 **
@@ -231,7 +332,7 @@ BOOL
   ARRAY
     *arr;
   int
-    newsize, i,
+    i,
     n, tot, result;
 
   assert ( list != NULL );
@@ -245,7 +346,14 @@ BOOL
   
   if ( result < 0 ) {
     /* element occurs in list; binary_search returns negative index - 1 */
-    if ( enter ) free ( elt );
+    if ( enter ) {
+      if ( list -> arena != NULL ) {
+        arena_release ( list -> arena, elt );
+      }
+      else {
+        free ( elt );
+      }
+    }
     return ( (*arr) [ -result - 1 ] );
   }
   else {
@@ -254,16 +362,10 @@ BOOL
     if ( enter ) {
       /* Test if still enough memory */
       if ( n >= tot ) {
-        /* reallocate memory; create 10 new entries */
-        newsize = tot + 10;
-        arr = (ARRAY *) realloc ( arr, newsize * sizeof ( ELEMENT ) );
-        if ( arr == NULL ) {
+        if ( ! grow_array ( list ) ) {
           return ( NULL );   /* no can do */
         }
-        else {
-          list -> total = newsize;
-          list -> array = arr;   /* may be changed by realloc */
-        }
+        arr = list -> array;   /* may be changed by realloc */
       }
 
       /* Make a hole at entry arr[result] */
@@ -339,7 +441,8 @@ int
 **                           > 0 if e1 > e2.
 **
 **  OUT : The element is deleted from the list. Memory allocated
-**        for the element is NOT freed.
+**        for the element is NOT freed, but the list array shrinks
+**        when it becomes sparsely used (see SHRINK_PERCENT).
 ****************************************************************/
 
 void delete_list
@@ -360,6 +463,7 @@ int
     *arr;
   int
     result,
+    newsize,
     n, i;
 
   assert ( list != NULL );
@@ -372,15 +476,25 @@ int
   assert ( result < 0 );
   
   /* binary_search returns negative index - 1 */
-  for ( i = ( -result - 1 ); i < n; i ++ ) {
+  for ( i = ( -result - 1 ); i < n - 1; i ++ ) {
     (*arr) [i] = (*arr) [ i + 1 ];
   }
   
   /* Decrease amount of elements */
-  list -> num --;
+  list -> num = -- n;
   
-  /* Theoretically, list array memory should be freed at this point.
-     Not implemented. */
+  /* Give memory back if the array is used sparsely. If realloc
+     fails, the old array is simply kept. */
+  if ( ( list -> total > GROW_MIN ) &&
+       ( n < ( list -> total / 100 ) * SHRINK_PERCENT ) ) {
+    newsize = 2 * n;
+    if ( newsize < GROW_MIN ) newsize = GROW_MIN;
+    arr = (ARRAY *) realloc ( arr, newsize * sizeof ( ELEMENT ) );
+    if ( arr != NULL ) {
+      list -> total = newsize;
+      list -> array = arr;
+    }
+  }
 }
 
 
@@ -682,6 +796,221 @@ BOOL
 }
 
 
+/****************************************************************
+**  gallop_search
+**
+**  Exponential ("galloping") search: finds the position of an
+**  element in array[low..num-1], probing array[low], array[low+1],
+**  array[low+3], array[low+7], ... until an element greater or
+**  equal to 'key' is found, then doing a binary search on the
+**  last interval. The cost is O(log d), where d is the distance
+**  from 'low' to the result.
+**
+**  IN  : 'array' = array to be searched.
+**        'low'   = first index to be considered.
+**        'num'   = number of entries in the array.
+**        'key', 'comp' = see binary_search.
+**
+**  OUT : Same as binary_search; the index refers to the whole
+**        array.
+****************************************************************/   
+
+int gallop_search
+      ( array, low, num, key, comp )
+ARRAY
+  array;
+int
+  low;
+int
+  num;
+ELEMENT
+  key;
+#ifndef BSDUNIX
+int
+  (*comp) ( ELEMENT, ELEMENT );
+#else
+int
+  (*comp) ();
+#endif
+{
+  int
+    high, step, res;
+
+  high = low;
+  step = 1;
+  while ( ( high < num ) && ( (*comp) ( key, array [ high ] ) > 0 ) ) {
+    low = high + 1;
+    high += step;
+    step += step;
+  }
+  if ( high >= num ) high = num - 1;
+
+  res = binary_search ( &array [ low ], high - low + 1, key, comp );
+  return ( ( res < 0 ) ? res - low : res + low );
+}
+
+
+/****************************************************************
+**  find_union_gallop, find_diff_gallop
+**
+**  Same as find_union and find_diff, with the same arguments and
+**  callback contract. If one list is more than GALLOP_RATIO times
+**  longer than the other, the elements of the shorter list are
+**  searched in the longer one by gallop_search instead of
+**  stepping through it element by element. This needs about
+**  m * log ( n / m ) instead of m + n comparisons. Otherwise,
+**  find_union resp. find_diff are called.
+****************************************************************/
+
+BOOL find_union_gallop
+       ( list1, list2, compare, call )
+LIST
+  list1;
+LIST
+  list2;
+#ifndef BSDUNIX
+int 
+  (*compare) ( ELEMENT, ELEMENT );
+BOOL 
+  (*call) ( ELEMENT, ELEMENT );
+#else
+int 
+  (*compare) ();
+BOOL 
+  (*call) ();
+#endif
+{
+  int
+    max1, max2,
+    i, j, res;
+  ARRAY
+    *arr1, *arr2;
+  BOOL
+    ok;
+
+  assert ( list1 != NULL );
+  assert ( list2 != NULL );
+  
+  max1 = list1 -> num;
+  arr1 = list1 -> array;
+  max2 = list2 -> num;
+  arr2 = list2 -> array;
+  
+  ok = TRUE;
+  if ( max1 / GALLOP_RATIO > max2 ) {
+    /* Search elements of list2 in list1 */
+    i = 0;
+    for ( j = 0; ( j < max2 ) && ( i < max1 ) && ok; j ++ ) {
+      res = gallop_search ( *arr1, i, max1, (*arr2) [j], compare );
+      if ( res < 0 ) {
+        i = -res - 1;
+        ok = (*call) ( (*arr1) [i], (*arr2) [j] );
+        i ++;
+      }
+      else {
+        i = res;
+      }
+    }
+  }
+  else if ( max2 / GALLOP_RATIO > max1 ) {
+    /* Search elements of list1 in list2 */
+    j = 0;
+    for ( i = 0; ( i < max1 ) && ( j < max2 ) && ok; i ++ ) {
+      res = gallop_search ( *arr2, j, max2, (*arr1) [i], compare );
+      if ( res < 0 ) {
+        j = -res - 1;
+        ok = (*call) ( (*arr1) [i], (*arr2) [j] );
+        j ++;
+      }
+      else {
+        j = res;
+      }
+    }
+  }
+  else {
+    /* Sizes are similar, merging is cheaper */
+    ok = find_union ( list1, list2, compare, call );
+  }
+  return ( ok );
+}
+
+
+BOOL find_diff_gallop
+       ( list1, list2, compare, call )
+LIST
+  list1;
+LIST
+  list2;
+#ifndef BSDUNIX
+int 
+  (*compare) ( ELEMENT, ELEMENT );
+BOOL 
+  (*call) ( ELEMENT );
+#else
+int 
+  (*compare) ();
+BOOL 
+  (*call) ();
+#endif
+{
+  int
+    max1, max2,
+    i, j, k, res;
+  ARRAY
+    *arr1, *arr2;
+  BOOL
+    ok;
+
+  assert ( list1 != NULL );
+  assert ( list2 != NULL );
+  
+  max1 = list1 -> num;
+  arr1 = list1 -> array;
+  max2 = list2 -> num;
+  arr2 = list2 -> array;
+  
+  ok = TRUE;
+  if ( max1 / GALLOP_RATIO > max2 ) {
+    /* Search elements of list2 in list1; output everything in
+       between */
+    i = 0;
+    for ( j = 0; ( j < max2 ) && ( i < max1 ) && ok; j ++ ) {
+      res = gallop_search ( *arr1, i, max1, (*arr2) [j], compare );
+      k = ( res < 0 ) ? -res - 1 : res;
+      for ( ; ( i < k ) && ok; i ++ ) {
+        ok = (*call) ( (*arr1) [i] );
+      }
+      if ( res < 0 ) i ++;
+    }
+
+    /* Dump remainders of list1 */
+    for ( ; ( i < max1 ) && ok; i ++ ) {
+      ok = (*call) ( (*arr1) [i] );
+    }
+  }
+  else if ( max2 / GALLOP_RATIO > max1 ) {
+    /* Search elements of list1 in list2 */
+    j = 0;
+    for ( i = 0; ( i < max1 ) && ok; i ++ ) {
+      res = ( j < max2 ) ? gallop_search ( *arr2, j, max2, (*arr1) [i], compare )
+                         : max2;
+      if ( res < 0 ) {
+        j = -res;
+      }
+      else {
+        ok = (*call) ( (*arr1) [i] );
+        j = res;
+      }
+    }
+  }
+  else {
+    /* Sizes are similar, merging is cheaper */
+    ok = find_diff ( list1, list2, compare, call );
+  }
+  return ( ok );
+}
+
+
 /****************************************************************
 **  merge_lists
 **
@@ -780,3 +1109,161 @@ int
   }
   return ( ok );
 }
+
+
+/****************************************************************
+**  list_append_unsorted
+**
+**  Appends an element to a list without keeping the list in
+**  order. The list must be put in order by list_finalize or
+**  list_finalize_int before any other list function is used.
+**
+**  IN  : list = handle to list created with create_list.
+**        elt  = pointer to new element. The pointer must have
+**               been obtained by a call to malloc or calloc!
+****************************************************************/
+
+void list_append_unsorted
+       ( list, elt )
+LIST
+  list;
+ELEMENT
+  elt;
+{
+  BOOL
+    ok;
+
+  assert ( list != NULL );
+  assert ( elt != NULL );
+
+  if ( list -> num >= list -> total ) {
+    ok = grow_array ( list );
+    assert ( ok );
+  }
+  (*list -> array) [ list -> num ++ ] = elt;
+}
+
+
+/****************************************************************
+**  list_finalize
+**
+**  Sorts a list built with list_append_unsorted and removes
+**  duplicate elements. The result is the same as if all
+**  elements had been inserted with add_list in the order in
+**  which they were appended.
+**
+**  IN  : list  = handle to list.
+**        comp  = compare function (see add_list).
+**        merge = function called as merge ( kept, duplicate )
+**                for each duplicate before it is deallocated
+**                (may be NULL).
+****************************************************************/
+
+void list_finalize
+       ( list, comp, merge )
+LIST
+  list;
+#ifndef BSDUNIX
+int
+  (*comp) ( ELEMENT, ELEMENT );
+void
+  (*merge) ( ELEMENT, ELEMENT );
+#else
+int
+  (*comp) ();
+void
+  (*merge) ();
+#endif
+{
+  assert ( list != NULL );
+
+  sort_elements ( *list -> array, list -> num, comp );
+  list -> num = unique_elements ( *list -> array, list -> num, comp,
+                                  NULL, merge, list -> arena == NULL );
+}
+
+
+/****************************************************************
+**  list_finalize_int
+**
+**  Same as list_finalize for lists which are ordered by an
+**  integer key. The list is sorted by a radix sort.
+**
+**  IN  : list  = handle to list.
+**        key   = function returning the key of an element. The
+**                compare function used with this list must
+**                order elements by increasing keys.
+**        merge = see list_finalize.
+****************************************************************/
+
+void list_finalize_int
+       ( list, key, merge )
+LIST
+  list;
+#ifndef BSDUNIX
+int
+  (*key) ( ELEMENT );
+void
+  (*merge) ( ELEMENT, ELEMENT );
+#else
+int
+  (*key) ();
+void
+  (*merge) ();
+#endif
+{
+  assert ( list != NULL );
+
+  radix_elements ( *list -> array, list -> num, key );
+  list -> num = unique_elements ( *list -> array, list -> num, NULL,
+                                  key, merge, list -> arena == NULL );
+}
+
+
+/****************************************************************
+**  list_set_arena
+**
+**  Declares that the elements of a list are allocated in an
+**  arena. The list will not free() its elements any more.
+**
+**  IN  : list  = handle to list.
+**        arena = arena of the elements (see util.h).
+****************************************************************/
+
+void list_set_arena
+       ( list, arena )
+LIST
+  list;
+ARENA
+  arena;
+{
+  assert ( list != NULL );
+  list -> arena = arena;
+}
+
+
+/****************************************************************
+**  destroy_list_arena
+**
+**  Destroys a list together with the arena of its elements. All
+**  elements are freed at once. The arena must not be used by
+**  other lists.
+**
+**  IN  : list = pointer to handle of list to be destroyed.
+**  OUT : '*list' is set to NULL.
+****************************************************************/
+
+void destroy_list_arena
+       ( list )
+LIST
+  *list;
+{
+  ARENA
+    arena;
+
+  if ( *list == NULL ) return;
+  arena = (*list) -> arena;
+  assert ( arena != NULL );
+  destroy_list ( list );
+  destroy_arena ( &arena );
+}
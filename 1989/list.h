@@ -40,25 +40,43 @@
 typedef
   char *ELEMENT;
 
-/* Lists are arrays of list elements, sorted in a user-defined order.
-   An ordering function must be specified when adding or searching an
-   element in a list. */
-typedef
-  ELEMENT ARRAY [];
+/* Lists are sorted in a user-defined order. An ordering function must
+   be specified when adding or searching an element in a list.
+
+   A list is identified by a handle to a list header. The layout of
+   the header depends on the list implementation which is selected
+   at link time:
 
-/* A list is identified by a list header which contains a pointer to
-   the associated array and the number of elements contained in it. */
+     list.o  = sorted dynamic array (binary search)
+     btree.o = B+-tree with linked leaves
+     
+   Both implementations provide exactly the same functions and the
+   same semantics. */
 typedef
-  struct {
-    ARRAY *array;  /* Pointer to base of array */
-    int   num;     /* Number of array entries used */
-    int   total;   /* Number of total array entries */
-  } HEADER;
+  struct list_header HEADER;
 
 typedef
   HEADER *LIST;
 
 
+/* Lists may also be built in bulk: elements are appended in any
+   order with list_append_unsorted, and list_finalize (or
+   list_finalize_int for integer keys) sorts the list once and
+   removes duplicates. No other list function may be called on a
+   list between these two steps. */
+
+/* The elements of a list may be allocated from an arena (see
+   util.h) instead of malloc. After list_set_arena, the list never
+   calls free() for an element: a duplicate passed to add_list is
+   given back with arena_release, and destroy_list only frees the
+   list itself. destroy_list_arena additionally destroys the arena
+   with all elements. */
+struct arena_header;
+
+/* find_union_gallop and find_diff_gallop are drop-in replacements
+   for find_union and find_diff which are faster if one list is
+   much shorter than the other. */
+
 /* Direction constants for 'enum_list' */
 #define ENUM_FORWARD	1
 #define ENUM_BACKWARD	-1
@@ -67,6 +85,7 @@ typedef
 /* Functions defined on lists */
 #ifndef BSDUNIX
 LIST create_list ( void );
+LIST create_list_sized ( int );
 void destroy_list ( LIST * );
 ELEMENT add_list ( LIST, ELEMENT, int (*) ( ELEMENT, ELEMENT ) );
 void delete_list ( LIST, ELEMENT, int (*) ( ELEMENT, ELEMENT ) );
@@ -78,8 +97,20 @@ BOOL find_union ( LIST, LIST, int (*) ( ELEMENT, ELEMENT ),
 BOOL merge_lists ( LIST, LIST, BOOL (*) ( ELEMENT ), int (*) ( ELEMENT, ELEMENT ) );
 BOOL find_diff ( LIST, LIST, int (*) ( ELEMENT, ELEMENT ), 
                  BOOL (*) ( ELEMENT ) );
+BOOL find_union_gallop ( LIST, LIST, int (*) ( ELEMENT, ELEMENT ), 
+                         BOOL (*) ( ELEMENT, ELEMENT ) );
+BOOL find_diff_gallop ( LIST, LIST, int (*) ( ELEMENT, ELEMENT ), 
+                        BOOL (*) ( ELEMENT ) );
+void list_append_unsorted ( LIST, ELEMENT );
+void list_finalize ( LIST, int (*) ( ELEMENT, ELEMENT ),
+                     void (*) ( ELEMENT, ELEMENT ) );
+void list_finalize_int ( LIST, int (*) ( ELEMENT ),
+                         void (*) ( ELEMENT, ELEMENT ) );
+void list_set_arena ( LIST, struct arena_header * );
+void destroy_list_arena ( LIST * );
 #else
 LIST create_list ();
+LIST create_list_sized ();
 void destroy_list ();
 void delete_list ();
 ELEMENT add_list ();
@@ -89,4 +120,11 @@ int count_list ();
 BOOL find_union ();
 BOOL merge_lists ();
 BOOL find_diff ();
+BOOL find_union_gallop ();
+BOOL find_diff_gallop ();
+void list_append_unsorted ();
+void list_finalize ();
+void list_finalize_int ();
+void list_set_arena ();
+void destroy_list_arena ();
 #endif
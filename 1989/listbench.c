@@ -0,0 +1,292 @@
+/****************************************************************
+*
+*           S O F T W A R E   S O U R C E   F I L E
+*
+*****************************************************************
+*
+*   Name of file   : listbench.c
+*   Author         : Guido Hoss
+*   Project        : ETH Diploma Thesis (SS 1989)
+*   Creation Date  : 27/04/89
+*   Type of file   : C Language File
+*
+*   Description
+*   -----------
+*   Measures insert and lookup throughput of the list manager
+*   for lists of 10^3 up to 10^max elements. The program is
+*   linked twice, once with each list implementation:
+*
+*	listbench    = list.o  (sorted dynamic array)
+*	listbench_bt = btree.o (B+-tree)
+*
+*   Call Format
+*   -----------
+*	listbench [max [SORTED]]
+*
+*   'max' is the exponent of the largest list size (default 7).
+*   Elements are inserted in random order unless SORTED is
+*   specified. Sizes whose projected insert time exceeds
+*   TIME_LIMIT seconds are skipped.
+*
+*****************************************************************
+*
+*   COPYRIGHT (C) 1989, 2016 BY GUIDO HOSS.
+*
+*   This program is free software: you can redistribute it and/or
+*   modify it under the terms of the GNU General Public License
+*   as published by the Free Software Foundation, either version 3
+*   of the License, or (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public
+*   License along with this program.  If not, see
+*   <http://www.gnu.org/licenses/>.
+*
+*   Git repository home: <https://github.com/ghoss/Thesis>
+*
+*****************************************************************
+* Date        :
+* Description :
+****************************************************************/
+
+#define PROG	"List Benchmark (gh, 27/04/89)\n"
+#define USAGE	"Usage: listbench [max [SORTED]]\n"
+
+#include <stdio.h>
+#ifdef MSDOS
+#include <process.h>
+#endif
+#include <stdlib.h>
+#include <malloc.h>
+#include <assert.h>
+#include <time.h>
+
+#include "boolean.h"
+#include "list.h"
+
+#ifndef CLOCKS_PER_SEC
+#define CLOCKS_PER_SEC	CLK_TCK
+#endif
+
+#define MIN_EXP		3	/* Smallest list has 10^3 elements */
+#define MAX_EXP		7	/* Default largest list: 10^7 elements */
+#define TIME_LIMIT	60.0	/* Max. projected insert time (seconds) */
+
+typedef
+  struct {
+    int		key;		/* Element key */
+  } KEY_STRUCT;
+
+
+/****************************************************************
+**  Procedure declarations
+****************************************************************/
+
+#ifndef BSDUNIX
+int main ( int, char * [] );
+int comp_key ( ELEMENT, ELEMENT );
+long random_num ( void );
+void make_keys ( int *, long, BOOL );
+double seconds ( clock_t, clock_t );
+#else
+int main ();
+int comp_key ();
+long random_num ();
+void make_keys ();
+double seconds ();
+#endif
+
+
+/****************************************************************
+**  comp_key
+**
+**  Compares two list elements.
+****************************************************************/
+
+int comp_key
+      ( k1, k2 )
+ELEMENT
+  k1;
+ELEMENT
+  k2;
+{
+  int
+    a, b;
+
+  a = ((KEY_STRUCT *) k1) -> key;
+  b = ((KEY_STRUCT *) k2) -> key;
+  return ( ( a < b ) ? -1 : ( a > b ) );
+}
+
+
+/****************************************************************
+**  random_num
+**
+**  Returns a pseudo-random number in [0, 2^31). The generator
+**  does not depend on RAND_MAX, so all systems use the same
+**  sequence of keys.
+****************************************************************/
+
+long random_num
+       ( )
+{
+  static unsigned long
+    seed = 1;
+
+  seed = ( seed * 1103515245L + 12345L ) & 0xffffffffL;
+  return ( (long) ( ( seed >> 1 ) & 0x7fffffffL ) );
+}
+
+
+/****************************************************************
+**  make_keys
+**
+**  Fills an array with the keys 0..n-1.
+**
+**  IN  : keys   = array of n integers.
+**        n      = number of keys.
+**        sorted = TRUE  --> keys are in increasing order.
+**                 FALSE --> keys are randomly permuted.
+****************************************************************/
+
+void make_keys
+       ( keys, n, sorted )
+int
+  *keys;
+long
+  n;
+BOOL
+  sorted;
+{
+  long
+    i, j;
+  int
+    t;
+
+  for ( i = 0; i < n; i ++ ) {
+    keys [i] = (int) i;
+  }
+  if ( sorted ) return;
+
+  for ( i = n - 1; i > 0; i -- ) {
+    j = random_num () % ( i + 1 );
+    t = keys [i];
+    keys [i] = keys [j];
+    keys [j] = t;
+  }
+}
+
+
+double seconds
+         ( start, stop )
+clock_t
+  start;
+clock_t
+  stop;
+{
+  return ( (double) ( stop - start ) / (double) CLOCKS_PER_SEC );
+}
+
+
+/****************************************************************
+**  main
+****************************************************************/
+
+int main
+      ( argc, argv )
+int
+  argc;
+char
+  *argv [];
+{
+  int
+    *keys,
+    max, e;
+  long
+    n, i, found;
+  double
+    t_ins, t_look,
+    t_prev;
+  clock_t
+    start;
+  BOOL
+    sorted;
+  LIST
+    list;
+  KEY_STRUCT
+    k, *elt;
+
+  /* Program title */
+  fprintf ( stderr, PROG );
+
+  max = ( argc > 1 ) ? atoi ( argv [1] ) : MAX_EXP;
+  sorted = ( argc > 2 ) && ( *argv [2] == 'S' );
+  if ( ( max < MIN_EXP ) || ( max > 9 ) ) {
+    fprintf ( stderr, USAGE );
+    return ( 1 );
+  }
+
+  printf ( "%s insertion\n", sorted ? "Sorted" : "Random" );
+  printf ( "%10s %10s %12s %10s %12s\n", "elements",
+	   "insert s", "inserts/s", "lookup s", "lookups/s" );
+
+  n = 1;
+  for ( e = 0; e < MIN_EXP; e ++ ) n *= 10;
+  t_prev = 0.0;
+  t_ins = 0.0;
+
+  for ( e = MIN_EXP; e <= max; e ++, n *= 10 ) {
+
+    /* Project the next insert time from the growth of the last step */
+    if ( ( t_prev > 0.0 ) && ( t_ins * ( t_ins / t_prev ) > TIME_LIMIT ) ) {
+      printf ( "%10ld skipped (projected insert time > %.0f s)\n",
+	       n, TIME_LIMIT );
+      continue;
+    }
+
+    keys = (int *) malloc ( (unsigned) n * sizeof ( int ) );
+    assert ( keys != NULL );
+    make_keys ( keys, n, sorted );
+
+    list = create_list ();
+    assert ( list != NULL );
+
+    /* Insert all keys */
+    start = clock ();
+    for ( i = 0; i < n; i ++ ) {
+      elt = (KEY_STRUCT *) malloc ( sizeof ( KEY_STRUCT ) );
+      assert ( elt != NULL );
+      elt -> key = keys [i];
+      elt = (KEY_STRUCT *) add_list ( list, (ELEMENT) elt, comp_key );
+      assert ( elt != NULL );
+    }
+    t_prev = t_ins;
+    t_ins = seconds ( start, clock () );
+    assert ( count_list ( list ) == n );
+
+    /* Look up all keys in a different random order */
+    make_keys ( keys, n, FALSE );
+    found = 0;
+    start = clock ();
+    for ( i = 0; i < n; i ++ ) {
+      k.key = keys [i];
+      if ( lookup_list ( list, (ELEMENT) &k, comp_key ) != NULL ) found ++;
+    }
+    t_look = seconds ( start, clock () );
+    assert ( found == n );
+
+    printf ( "%10ld %10.3f %12.0f %10.3f %12.0f\n", n,
+	     t_ins, ( t_ins > 0.0 ) ? n / t_ins : 0.0,
+	     t_look, ( t_look > 0.0 ) ? n / t_look : 0.0 );
+    fflush ( stdout );
+
+    destroy_list ( &list );
+    free ( keys );
+  }
+
+  return ( 0 );
+}
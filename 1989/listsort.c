@@ -0,0 +1,406 @@
+/****************************************************************
+*
+*           S O F T W A R E   S O U R C E   F I L E
+*
+*****************************************************************
+*
+*   Name of file   : listsort.c
+*   Author         : Guido Hoss
+*   Project        : ETH Diploma Thesis (SS 1989)
+*   Creation Date  : 28/04/89
+*   Type of file   : C Language File
+*
+*   Description
+*   -----------
+*   Sorting functions shared by the list implementations (list.c
+*   and btree.c). Lists built with list_append_unsorted are put
+*   in order by a merge sort or, for integer keys, by a radix
+*   sort. Input which is already sorted is detected in a single
+*   pass and is not touched.
+*
+*****************************************************************
+*
+*   COPYRIGHT (C) 1989, 2016 BY GUIDO HOSS.
+*
+*   This program is free software: you can redistribute it and/or 
+*   modify it under the terms of the GNU General Public License
+*   as published by the Free Software Foundation, either version 3
+*   of the License, or (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public
+*   License along with this program.  If not, see
+*   <http://www.gnu.org/licenses/>.
+*
+*   Git repository home: <https://github.com/ghoss/Thesis>
+*
+*****************************************************************
+* Date        :
+* Description :
+****************************************************************/   
+
+#include <stdio.h>
+#ifdef MSDOS
+#include <process.h>
+#endif
+#include <malloc.h>
+#include <assert.h>
+
+#include "boolean.h"
+#include "list.h"
+#include "listsort.h"
+
+#define INSERT_MAX	12	/* Max. run length for insertion sort */
+#define RADIX_BITS	8	/* Bits per radix sort pass */
+#define RADIX_SIZE	( 1 << RADIX_BITS )
+
+/* Flipping the sign bit maps signed keys to unsigned keys in the
+   same order */
+#define SIGN_BIT	( (unsigned) 1 << ( sizeof ( int ) * 8 - 1 ) )
+
+
+/****************************************************************
+**  Forward declarations (compiler type checking)
+****************************************************************/
+
+#ifndef BSDUNIX
+void merge_sort ( ELEMENT [], ELEMENT [], int, int,
+                  int (*) ( ELEMENT, ELEMENT ) );
+void reverse_elements ( ELEMENT [], int );
+#else
+void merge_sort ();
+void reverse_elements ();
+#endif
+
+
+/****************************************************************
+**  merge_sort
+**
+**  Sorts a part of an element array by a stable merge sort.
+**
+**  IN  : a      = element array.
+**        tmp    = scratch array with as many entries as 'a'.
+**        lo, hi = range to be sorted: a[lo] .. a[hi-1].
+**        comp   = compare function (see add_list).
+**
+**  OUT : a[lo] .. a[hi-1] are sorted.
+****************************************************************/
+
+void merge_sort
+       ( a, tmp, lo, hi, comp )
+ELEMENT
+  a [];
+ELEMENT
+  tmp [];
+int
+  lo;
+int
+  hi;
+#ifndef BSDUNIX
+int
+  (*comp) ( ELEMENT, ELEMENT );
+#else
+int
+  (*comp) ();
+#endif
+{
+  int
+    mid, i, j, k;
+  ELEMENT
+    x;
+
+  if ( hi - lo <= INSERT_MAX ) {
+    /* Short runs are sorted by insertion */
+    for ( i = lo + 1; i < hi; i ++ ) {
+      x = a [i];
+      for ( j = i; ( j > lo ) && ( (*comp) ( a [ j - 1 ], x ) > 0 ); j -- ) {
+        a [j] = a [ j - 1 ];
+      }
+      a [j] = x;
+    }
+    return;
+  }
+
+  mid = ( lo + hi ) / 2;
+  merge_sort ( a, tmp, lo, mid, comp );
+  merge_sort ( a, tmp, mid, hi, comp );
+
+  /* Nothing to merge if both halves are already in order */
+  if ( (*comp) ( a [ mid - 1 ], a [ mid ] ) <= 0 ) return;
+
+  /* Merge left half (copied to tmp) and right half back into a.
+     On equal elements, the left one goes first. */
+  for ( i = lo; i < mid; i ++ ) {
+    tmp [i] = a [i];
+  }
+  i = lo;
+  j = mid;
+  k = lo;
+  while ( ( i < mid ) && ( j < hi ) ) {
+    if ( (*comp) ( a [j], tmp [i] ) < 0 ) {
+      a [ k ++ ] = a [ j ++ ];
+    }
+    else {
+      a [ k ++ ] = tmp [ i ++ ];
+    }
+  }
+  while ( i < mid ) {
+    a [ k ++ ] = tmp [ i ++ ];
+  }
+}
+
+
+void reverse_elements
+       ( a, n )
+ELEMENT
+  a [];
+int
+  n;
+{
+  int
+    i;
+  ELEMENT
+    x;
+
+  for ( i = 0; i < n / 2; i ++ ) {
+    x = a [i];
+    a [i] = a [ n - 1 - i ];
+    a [ n - 1 - i ] = x;
+  }
+}
+
+
+/****************************************************************
+**  sort_elements
+**
+**  Sorts an element array in increasing order. Equal elements
+**  keep their relative order.
+**
+**  IN  : a    = element array.
+**        n    = number of elements in a.
+**        comp = compare function (see add_list).
+**
+**  OUT : a is sorted. Arrays which are already in increasing or
+**        strictly decreasing order are handled in linear time.
+****************************************************************/
+
+void sort_elements
+       ( a, n, comp )
+ELEMENT
+  a [];
+int
+  n;
+#ifndef BSDUNIX
+int
+  (*comp) ( ELEMENT, ELEMENT );
+#else
+int
+  (*comp) ();
+#endif
+{
+  int
+    i;
+  ELEMENT
+    *tmp;
+
+  /* Test for sorted input */
+  for ( i = 1; ( i < n ) && ( (*comp) ( a [ i - 1 ], a [i] ) <= 0 ); i ++ )
+    ;
+  if ( i >= n ) return;
+
+  /* Reversed input (e.g. negative query numbers) is simply turned
+     around; this is only stable if no two elements are equal */
+  if ( i == 1 ) {
+    for ( i = 1; ( i < n ) && ( (*comp) ( a [ i - 1 ], a [i] ) > 0 ); i ++ )
+      ;
+    if ( i >= n ) {
+      reverse_elements ( a, n );
+      return;
+    }
+  }
+
+  tmp = (ELEMENT *) malloc ( n * sizeof ( ELEMENT ) );
+  assert ( tmp != NULL );
+  merge_sort ( a, tmp, 0, n, comp );
+  free ( tmp );
+}
+
+
+/****************************************************************
+**  radix_elements
+**
+**  Sorts an element array by an integer key, using a stable
+**  LSD radix sort with RADIX_BITS bits per pass.
+**
+**  IN  : a   = element array.
+**        n   = number of elements in a.
+**        key = function returning the integer key of an element.
+**
+**  OUT : a is sorted by increasing keys.
+****************************************************************/
+
+void radix_elements
+       ( a, n, key )
+ELEMENT
+  a [];
+int
+  n;
+#ifndef BSDUNIX
+int
+  (*key) ( ELEMENT );
+#else
+int
+  (*key) ();
+#endif
+{
+  unsigned
+    *k, *k2, *kt;
+  ELEMENT
+    *src, *dst, *t;
+  int
+    count [ RADIX_SIZE ],
+    shift, i, b, sum, c;
+  BOOL
+    sorted;
+
+  if ( n < 2 ) return;
+
+  k = (unsigned *) malloc ( n * sizeof ( unsigned ) );
+  assert ( k != NULL );
+
+  /* Get keys and test for sorted input */
+  sorted = TRUE;
+  for ( i = 0; i < n; i ++ ) {
+    k [i] = ( (unsigned) (*key) ( a [i] ) ) ^ SIGN_BIT;
+    if ( ( i > 0 ) && ( k [i] < k [ i - 1 ] ) ) sorted = FALSE;
+  }
+  if ( sorted ) {
+    free ( k );
+    return;
+  }
+
+  k2 = (unsigned *) malloc ( n * sizeof ( unsigned ) );
+  assert ( k2 != NULL );
+  dst = (ELEMENT *) malloc ( n * sizeof ( ELEMENT ) );
+  assert ( dst != NULL );
+  src = a;
+
+  for ( shift = 0; shift < (int) sizeof ( int ) * 8; shift += RADIX_BITS ) {
+
+    /* Count occurrences of each digit */
+    for ( b = 0; b < RADIX_SIZE; b ++ ) count [b] = 0;
+    for ( i = 0; i < n; i ++ ) {
+      count [ ( k [i] >> shift ) & ( RADIX_SIZE - 1 ) ] ++;
+    }
+
+    /* Skip pass if all keys have the same digit */
+    if ( count [ ( k [0] >> shift ) & ( RADIX_SIZE - 1 ) ] == n ) continue;
+
+    /* Start position of each digit */
+    sum = 0;
+    for ( b = 0; b < RADIX_SIZE; b ++ ) {
+      c = count [b];
+      count [b] = sum;
+      sum += c;
+    }
+
+    /* Distribute elements */
+    for ( i = 0; i < n; i ++ ) {
+      b = count [ ( k [i] >> shift ) & ( RADIX_SIZE - 1 ) ] ++;
+      dst [b] = src [i];
+      k2 [b] = k [i];
+    }
+
+    t = src; src = dst; dst = t;
+    kt = k; k = k2; k2 = kt;
+  }
+
+  /* Copy result back if it ended up in the scratch array */
+  if ( src != a ) {
+    for ( i = 0; i < n; i ++ ) {
+      a [i] = src [i];
+    }
+    dst = src;
+  }
+  free ( dst );
+  free ( k );
+  free ( k2 );
+}
+
+
+/****************************************************************
+**  unique_elements
+**
+**  Removes duplicates from a sorted element array. Of several
+**  equal elements, the first one is kept and the others are
+**  deallocated with free() (unless they belong to an arena).
+**
+**  IN  : a     = sorted element array.
+**        n     = number of elements in a.
+**        comp  = compare function (see add_list), or NULL if
+**                elements are compared by 'key'.
+**        key   = function returning the integer key of an
+**                element (only used if comp = NULL).
+**        merge = function called as merge ( kept, duplicate )
+**                before a duplicate is deallocated, or NULL.
+**        dispose = TRUE  --> duplicates are freed.
+**                  FALSE --> duplicates are left alone (elements
+**                            allocated in an arena).
+**
+**  OUT : The function returns the number of remaining elements.
+****************************************************************/
+
+int unique_elements
+      ( a, n, comp, key, merge, dispose )
+ELEMENT
+  a [];
+int
+  n;
+#ifndef BSDUNIX
+int
+  (*comp) ( ELEMENT, ELEMENT );
+int
+  (*key) ( ELEMENT );
+void
+  (*merge) ( ELEMENT, ELEMENT );
+#else
+int
+  (*comp) ();
+int
+  (*key) ();
+void
+  (*merge) ();
+#endif
+BOOL
+  dispose;
+{
+  int
+    i, m;
+  BOOL
+    equal;
+
+  if ( n == 0 ) return ( 0 );
+
+  m = 0;
+  for ( i = 1; i < n; i ++ ) {
+    if ( comp != NULL ) {
+      equal = ( (*comp) ( a [m], a [i] ) == 0 );
+    }
+    else {
+      equal = ( (*key) ( a [m] ) == (*key) ( a [i] ) );
+    }
+
+    if ( equal ) {
+      if ( merge != NULL ) (*merge) ( a [m], a [i] );
+      if ( dispose ) free ( a [i] );
+    }
+    else {
+      a [ ++ m ] = a [i];
+    }
+  }
+  return ( m + 1 );
+}
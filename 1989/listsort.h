@@ -0,0 +1,52 @@
+/****************************************************************
+*
+*           S O F T W A R E   S O U R C E   F I L E
+*
+*****************************************************************
+*
+*   Name of file   : listsort.h
+*   Author         : Guido Hoss
+*   Project        : ETH Diploma Thesis (SS 1989)
+*   Creation Date  : 28/04/89
+*   Type of file   : C Header File
+*
+*****************************************************************
+*
+*   COPYRIGHT (C) 1989, 2016 BY GUIDO HOSS.
+*
+*   This program is free software: you can redistribute it and/or 
+*   modify it under the terms of the GNU General Public License
+*   as published by the Free Software Foundation, either version 3
+*   of the License, or (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public
+*   License along with this program.  If not, see
+*   <http://www.gnu.org/licenses/>.
+*
+*   Git repository home: <https://github.com/ghoss/Thesis>
+*
+*****************************************************************
+* Date        :
+* Description :
+****************************************************************/   
+
+/* Sorting of element arrays, used by the list implementations to
+   finalize lists which have been built with list_append_unsorted.
+   All functions sort in increasing order and are stable. */
+
+#ifndef BSDUNIX
+void sort_elements ( ELEMENT [], int, int (*) ( ELEMENT, ELEMENT ) );
+void radix_elements ( ELEMENT [], int, int (*) ( ELEMENT ) );
+int unique_elements ( ELEMENT [], int, int (*) ( ELEMENT, ELEMENT ),
+                      int (*) ( ELEMENT ), void (*) ( ELEMENT, ELEMENT ),
+                      BOOL );
+#else
+void sort_elements ();
+void radix_elements ();
+int unique_elements ();
+#endif
@@ -20,15 +20,27 @@
 *   a separate input file. For convenience, negative document
 *   numbers are associated with queries.
 *
+*   Terms are written as numbers. The single words are numbered
+*   in the order of their first occurrence; a compound term is
+*   written as the pair of numbers of its words. The words and
+*   their numbers are written to the dictionary file:
+*
+*	<number> <TAB> <word>
+*
+*   If compiled with THREADS, the documents are parsed by several
+*   threads (see 'thread_count'). The output is the same as that
+*   of the sequential version.
+*
 *   Call Format
 *   -----------
 *
-*      parse_itemcoll <docfile> <queryfile> <stoplist>
+*      parse_itemcoll <docfile> <queryfile> <stoplist> <dictionary>
 *
-*   <docfile>   = Path name of document collection.
-*   <queryfile> = Path name of file containing test queries.
-*                 (Must have the same format as <docfile>)
-*   <stoplist>  = Path name of stop list to be used.
+*   <docfile>    = Path name of document collection.
+*   <queryfile>  = Path name of file containing test queries.
+*                  (Must have the same format as <docfile>)
+*   <stoplist>   = Path name of stop list to be used.
+*   <dictionary> = Path name of dictionary to be written.
 *
 *****************************************************************
 *
@@ -56,7 +68,7 @@
 ****************************************************************/
 
 #define PROG	"Document Collection Parser (gh, 29/04/89)\n"
-#define USAGE	"Usage: parse_itemcoll <docfile> <queryfile> <stoplist> [QUIET]\n"
+#define USAGE	"Usage: parse_itemcoll <docfile> <queryfile> <stoplist> <dictionary> [QUIET]\n"
 
 #include <ctype.h>
 #include <stdio.h>
@@ -65,28 +77,86 @@
 #endif
 #include <assert.h>
 #include <malloc.h>
+#include <stdlib.h>
 #include <string.h>
+#ifdef THREADS
+#include <pthread.h>
+#endif
 
 #include "boolean.h"
 #include "list.h"
+#include "listsort.h"
 #include "util.h"
+#include "hash.h"
+#include "reader.h"
 #include "wordstem.h"
+#include "stemcache.h"
 
 #define MAX_WORDLEN   100    /* Max. length of a single or compound word */
-#define LINE_LENGTH   100    /* Max. length of a line in the document file */
-
-
-LIST
-  doc_words = NULL,   /* list of words in document */
-  stop_words;         /* list of stop words */
-
-/* The list 'doc_words' contains elements of type TERMSTRUCT. This
-   allows us to record the term frequency along with the terms. */
+#define DOC_TERMS     1024   /* Initial size of document term table */
+#define BATCH_SIZE    65536  /* Min. size of a batch of documents */
+#define SLOTS_PER_THREAD  4  /* Batches in progress per thread */
+#define STEM_CACHE    65536  /* Number of entries of stem cache */
+#define DICT_TERMS    16384  /* Initial size of dictionary */
+
+
+/* The input is split into batches of whole documents; a new batch
+   is started at a .I line once BATCH_SIZE bytes have been collected.
+   The lines of a batch are stored one after the other, each one
+   null-terminated. The frequency tables of the documents are
+   written to the output buffer of the batch. Batches can therefore
+   be parsed independently, but their output must be written in
+   the order of the input. */
 typedef
   struct {
-    int freq;     /* frequency of term */
-    char *term;   /* term spelling */
-  } TERMSTRUCT;
+    char	*text;		/* Lines of batch */
+    unsigned	len;		/* Bytes used in 'text' */
+    unsigned	size;		/* Size of 'text' */
+    char	*out;		/* Output of batch */
+    unsigned	outlen;		/* Bytes used in 'out' */
+    unsigned	outsize;	/* Size of 'out' */
+    BOOL	query;		/* TRUE if batch is part of query file */
+    BOOL	done;		/* TRUE if batch has been parsed */
+  } BATCH;
+
+/* The terms of the current document are counted in a hash table;
+   the value of each entry is the term frequency. The table is
+   cleared after each document, but its memory is reused. Every
+   thread has a table of its own; 'doc_words' is the table of the
+   main thread. The stop words are kept in the hash table
+   'stop_words', which is only read while parsing. */
+HASH
+  doc_words,          /* words in document */
+  stop_words,         /* stop words */
+  dictionary;         /* numbers of all words */
+
+/* Stems of frequent words, shared by all threads */
+STEMCACHE
+  stem_cache;
+
+/* Batches are taken from a ring of 'num_slots' slots. Batch number
+   n uses slot n % num_slots; 'fill_seq' batches have been handed
+   to the workers, and 'write_seq' of them have been written. */
+BATCH
+  *slot;
+int
+  num_slots,
+  num_workers = 0,
+  fill_seq = 0,
+  write_seq = 0;
+
+#ifdef THREADS
+pthread_t
+  *worker;
+pthread_mutex_t
+  batch_lock = PTHREAD_MUTEX_INITIALIZER;
+pthread_cond_t
+  batch_cond = PTHREAD_COND_INITIALIZER;
+int
+  parse_seq = 0;	/* Next batch to be parsed */
+BOOL
+  finished = FALSE;	/* TRUE if no more batches will come */
+#endif
 
 FILE
   *counter;	/* Virtual file used to output running counts */
@@ -98,25 +168,39 @@ FILE
 
 #ifndef BSDUNIX
 int comp_term ( ELEMENT, ELEMENT );
-BOOL enum_proc ( ELEMENT );
-void dump_list ( int );
-void addword ( char * );
-BOOL getword ( char *, char * );
-BOOL stopword ( char * );
-void analyze ( FILE *, BOOL );
-int comp_str ( ELEMENT, ELEMENT );
-void load_stoplist ( FILE * );
+void dump_list ( HASH, int, BATCH * );
+void addword ( HASH, char *, int );
+char *getword ( char **, int * );
+BOOL stopword ( char *, int );
+void parse_batch ( BATCH *, HASH );
+int term_number ( char *, int );
+void write_batch ( BATCH * );
+void write_dictionary ( FILE * );
+void start_workers ( int );
+void *parse_worker ( void * );
+BATCH *next_batch ( BOOL );
+void submit_batch ( BATCH * );
+void finish_batches ( void );
+void analyze ( READER, BOOL );
+void load_stoplist ( READER );
 int main ( int, char *[] );
 char *uppercase ( char * );
 #else
 int comp_term ();
-BOOL enum_proc ();
 void dump_list ();
 void addword ();
-BOOL getword ();
+char *getword ();
 BOOL stopword ();
+void parse_batch ();
+int term_number ();
+void write_batch ();
+void write_dictionary ();
+void start_workers ();
+void *parse_worker ();
+BATCH *next_batch ();
+void submit_batch ();
+void finish_batches ();
 void analyze ();
-int comp_str ();
 void load_stoplist ();
 int main ();
 char *uppercase ();
@@ -158,11 +242,11 @@ char
 /****************************************************************
 **  comp_term
 **
-**  This procedure establishes an ordering of TERMSTRUCT records
+**  This procedure establishes an ordering of term table entries
 **  by comparing the lexicographical spelling of the associated
-**  terms. Used whenever a term needs to be added to 'doc_words'.
+**  terms. Used to sort the terms of a document for output.
 **
-**  IN  : t1, t2 = pointers to TERMSTRUCT's to be compared.
+**  IN  : t1, t2 = pointers to HASH_ENTRY's to be compared.
 **
 **  OUT : -1 if t1 < t2, 0 if t1 = t2, +1 if t1 > t2.
 ****************************************************************/
@@ -174,8 +258,8 @@ ELEMENT
 ELEMENT
   t2;
 {
-  return ( strcmp ( ((TERMSTRUCT *) t1) -> term, 
-		    ((TERMSTRUCT *) t2) -> term ) );
+  return ( strcmp ( ((HASH_ENTRY *) t1) -> key, 
+		    ((HASH_ENTRY *) t2) -> key ) );
 }
 
 
@@ -183,81 +267,71 @@ ELEMENT
 **  dump_list
 **
 **  Writes a frequency table of the current document to the
-**  standard output.
+**  output of a batch, sorted by terms.
 **
-**  IN  : docnum = index of current document.
-**        The contents of global list 'doc_words' are printed.
-**        If doc_words is empty, then the function returns
-**        immediately.
+**  IN  : words  = term table of the document. If it is empty,
+**                 then the function returns immediately.
+**        docnum = index of current document.
+**        b      = batch receiving the output.
 **
-**  OUT : Global list 'doc_words' is destroyed.
+**  OUT : Table 'words' is cleared.
 ****************************************************************/
 
-BOOL enum_proc
-       ( elt )
-ELEMENT
-  elt;
-{
-  char
-    *t;
-
-  /* Print frequency tf(d,s) and alphanumeric term a(s) */
-  t = ((TERMSTRUCT *) elt ) -> term;
-  printf ( "\t%d\t%s\n", ((TERMSTRUCT *) elt) -> freq, t );
-
-  /* Destroy term buffer (structure is freed by 'destroy_list') */
-  free ( t );
-  return ( TRUE );
-}
-
-
 void dump_list
-       ( docnum )
+       ( words, docnum, b )
+HASH
+  words;
 int
   docnum;
+BATCH
+  *b;
 {
-  if ( doc_words == NULL ) return;
+  int
+    i, n;
+  HASH_ENTRY
+    **entry;
 
-  if ( count_list ( doc_words ) > 0 ) {
-    /* Standard version: Ignore empty documents */
-    printf ( "%d\n", docnum );
-    enum_list ( doc_words, enum_proc, ENUM_FORWARD );
+  n = count_hash ( words );
+  if ( n == 0 ) return;
+
+  /* Standard version: Ignore empty documents */
+  reserve ( &b -> out, &b -> outsize, b -> outlen + 16 );
+  b -> outlen += sprintf ( b -> out + b -> outlen, "%d\n", docnum );
+
+  /* Print frequency tf(d,s) and alphanumeric term a(s) */
+  entry = hash_entries ( words );
+  sort_elements ( (ELEMENT *) entry, n, comp_term );
+  for ( i = 0; i < n; i ++ ) {
+    reserve ( &b -> out, &b -> outsize, 
+	      b -> outlen + entry [i] -> len + 16 );
+    b -> outlen += sprintf ( b -> out + b -> outlen, "\t%d\t%s\n", 
+			     entry [i] -> val, entry [i] -> key );
   }
-  destroy_list ( &doc_words );
+  clear_hash ( words );
 }
 
 
 /****************************************************************
 **  addword
 **
-**  Adds a word to the term list of the current document.
+**  Adds a word to the term table of the current document.
 **
-**  IN  : word = pointer to null-terminated word to be added.
-**               A duplicate of the word is generated by this
-**               procedure.
+**  IN  : words = term table of the document.
+**        word  = pointer to word to be added.
+**        len   = length of word.
 ****************************************************************/
 
 void addword
-       ( word )
+       ( words, word, len )
+HASH
+  words;
 char
   *word;
+int
+  len;
 {
-  TERMSTRUCT
-    *elt,
-    *res;
-    
-  /* Build initial term structure and add to list */
-  elt = (TERMSTRUCT *) malloc ( sizeof ( TERMSTRUCT ) );
-  assert ( elt != NULL );
-  elt -> freq = 0;
-  elt -> term = duplicate ( word );
-  res = (TERMSTRUCT *) add_list ( doc_words, (ELEMENT) elt, comp_term );
-  
-  /* if res == elt, then term was not in the list before call to add_list;
-     in that case, frequency is 0 (as initialized above). In any case,
-     increment term frequency by 1. */
-  assert ( res != NULL );
-  res -> freq ++;
+  /* A new term is copied by add_hash and has frequency 0 */
+  add_hash ( words, word, len ) -> val ++;
 }
 
 
@@ -265,17 +339,19 @@ char
 **  getword
 **
 **  Gets the next word from an input line and converts it to
-**  uppercase. Subsequent calls to 'getword' with the same line
-**  will yield the words in the line one by one.
+**  uppercase. The line is scanned only once: 'cursor' points
+**  to the first character not yet examined and is advanced
+**  past the word on each call. Case folding is done in place
+**  while scanning, and the word is terminated in place by
+**  overwriting the separator which follows it.
 **
-**  IN  : buf  = pointer to input line.
-**        word = pointer to buffer large enough to hold the next
-**               word.
+**  IN  : cursor = pointer to current position in input line.
+**        len    = pointer to variable receiving word length.
 **
-**  OUT : The contents of 'buf' are modified.
-**        'word' contains the next word found. If no word could
-**        be found, the function returns FALSE and 'word' is
-**        empty. Otherwise, the function returns TRUE.
+**  OUT : The contents of the line are modified.
+**        The function returns a pointer to the next word found
+**        in the line, and its length in '*len'. If no word could
+**        be found, the function returns NULL.
 ****************************************************************/
 
 /* A word consists of letters, which are either uppercase characters
@@ -284,48 +360,47 @@ char
 #define isletter(c)	( isalpha ( c ) || ( (c) == '_' ) )
 
 
-BOOL getword
-       ( buf, word )
+char *getword
+       ( cursor, len )
 char
-  *buf;
-char
-  *word;
+  **cursor;
+int
+  *len;
 {
   char
-    *w,
     *start, 
     *end;
     
   /* Scan for first letter of word */
-  start = buf;
+  start = *cursor;
   while ( ( *start != '\0' ) && ( ! isletter ( *start ) ) ) {
     start ++;
   }
   
-  if ( *start != '\0' ) {
-    /* Search for end of word */
-    end = start;
-    w = word;
-    while ( ( *end != '\0' ) && ( isletter ( *end ) ) ) {
-      *w = *end;
-      w ++;
-      end ++;
+  if ( *start == '\0' ) {
+    /* could not find any word */
+    *cursor = start;
+    return ( NULL );
+  }
+
+  /* Search for end of word, converting to uppercase on the way */
+  end = start;
+  while ( isletter ( *end ) ) {
+    if ( islower ( *end ) ) {
+      *end = toupper ( *end );
     }
-    
-    /* Delete everything up to end of word from 'buf' */
-    strcpy ( buf, end );
-    
-    /* Null-terminate word and convert to uppercase */
-    *w = '\0';
-    uppercase ( word );
-    return ( TRUE );
+    end ++;
   }
-  
-  else {
-    /* could not find any word */
-    *word = '\0';
-    return ( FALSE );
+  *len = end - start;
+
+  /* Terminate word; the separator is not a letter and need not be
+     scanned again */
+  if ( *end != '\0' ) {
+    *end = '\0';
+    end ++;
   }
+  *cursor = end;
+  return ( start );
 }
 
 
@@ -334,61 +409,80 @@ char
 **
 **  Tests if a given word is in the stop list.
 **
-**  IN  : word = pointer to null-terminated word to be checked.
+**  IN  : word = pointer to word to be checked.
+**        len  = length of word.
 **
 **  OUT : The function returns TRUE if the word is in the
 **        stoplist.
 ****************************************************************/
 
 BOOL stopword
-       ( word )
+       ( word, len )
 char
   *word;
+int
+  len;
 {
-  /* Check list stop_words using comp_term */
-  return ( lookup_list ( stop_words, (ELEMENT) word, comp_str ) != NULL );
+  return ( lookup_hash ( stop_words, word, len ) != NULL );
 }
 
 
 /****************************************************************
-**  analyze
+**  parse_batch
 **
-**  Reads a text collection, searching for text after .T and .W
+**  Parses a batch of lines, searching for text after .T and .W
 **  lines. Document numbers are taken from .I lines.
 **  Builds compound terms of max. 2 words if words are not
 **  separated by stop words. Stop list must have been loaded
-**  previously. Document list must have been created.
+**  previously.
 **
-**  IN  : f     = file handle of opened document file.
-**        query = TRUE  --> This is a query file;
-**                FALSE --> This is a document file.
-**                (Distinction important because negative
-**                document numbers are assigned to queries)
+**  IN  : b     = batch to be parsed. The lines are modified.
+**        words = empty term table to be used.
+**
+**  OUT : The frequency tables of the documents have been written
+**        to the output of the batch.
 ****************************************************************/
 
-#define getline()   fgets ( line, LINE_LENGTH, f );
+#define next_line(l)	( (l) + strlen ( l ) + 1 )
 
-void analyze
-       ( f, query )
-FILE
-  *f;
-BOOL
-  query;
+void parse_batch
+       ( b, words )
+BATCH
+  *b;
+HASH
+  words;
 {
   int
     res,
-    docnum;
+    docnum,
+    len,
+    prev_len,
+    curr_len;
   char
-    *ok,
-    line [ LINE_LENGTH ],
-    prev_word [ MAX_WORDLEN ],
-    curr_word [ MAX_WORDLEN ],
-    new_word [ MAX_WORDLEN ],
+    *line,
+    *last,
+    *cursor,
+    *word,
+    *prev_word,
+    *curr_word,
+    word_buf [2][ MAX_WORDLEN ],
+    new_word [ 2 * MAX_WORDLEN ],
     cmd;
+  STEM_CONTEXT
+    stem;
 
-  /* Read document file line by line */
-  ok = getline ();
-  while ( ok ) {
+  /* 'prev_word' and 'curr_word' alternate between the two buffers
+     of 'word_buf', so the current word need not be copied */
+  prev_word = word_buf [0];
+  curr_word = word_buf [1];
+
+  b -> outlen = 0;
+  docnum = 0;
+
+  /* Read batch line by line */
+  line = b -> text;
+  last = b -> text + b -> len;
+  while ( line < last ) {
 
     if ( line [0] == '.' ) {
       /* Maybe .I, .T, or .W */
@@ -396,128 +490,485 @@ BOOL
 
       if ( cmd == 'I' ) {
         /* This is a document id; dump frequency list of previous document */
-        dump_list ( docnum );
-        doc_words = create_list ();
-        assert ( doc_words != NULL );
+        dump_list ( words, docnum, b );
 
         res = sscanf ( line, ".I %d", &docnum );
         assert ( res == 1 );
 
         /* docnum contains number of current document */
-        if ( query ) {
+        if ( b -> query ) {
           /* Assign negative numbers to queries */
           docnum = - docnum;
         }
 
-        /* update running count */
-        fprintf ( counter, "%d\r", docnum );
-
         /* Read next line */
-        ok = getline ();
+        line = next_line ( line );
       }
 
       else if ( ( cmd == 'T' ) || ( cmd == 'W' ) || ( cmd == 'A' ) ) {
         /* Read text up to next command */
-        ok = getline ();
-        prev_word [0] = '\0';
+        line = next_line ( line );
+        prev_len = 0;
         
-        while ( ok && ( line [0] != '.' ) ) {
+        while ( ( line < last ) && ( line [0] != '.' ) ) {
           
-          /* Extract words from current line */
-          while ( getword ( line, curr_word ) ) {
+          /* Extract words from current line; afterwards, 'cursor'
+             points to the end of the line */
+          cursor = line;
+          while ( ( word = getword ( &cursor, &len ) ) != NULL ) {
+
+            /* Lines may be of any length, so overlong words must be
+               truncated to fit into the word buffers */
+            if ( len > MAX_WORDLEN - 2 ) {
+              len = MAX_WORDLEN - 2;
+              word [ len ] = '\0';
+            }
           
             /* Ignore if this is a stop word or shorter than 3 chars */
-            if ( stopword ( curr_word ) ) {
-              prev_word [0] = '\0';
+            if ( stopword ( word, len ) ) {
+              prev_len = 0;
               continue;
             }
-	    else if ( strlen ( curr_word ) < 3 ) {
+	    else if ( len < 3 ) {
 	      /* example: OUR COMPUTER'S MEMORY --> S becomes a word;
 		 however, we still want to be able to build multiword
 		 terms */
               continue;
             }
 
-	    /* Perform word stemming */
-	    StemEnglishWord ( curr_word );
+	    /* Perform word stemming. The stemmer may lengthen the
+	       word, so it cannot work inside 'line'. */
+	    memcpy ( curr_word, word, len + 1 );
+	    stem_cached ( stem_cache, &stem, curr_word, len );
+	    curr_len = strlen ( curr_word );
             
             /* Increase term frequency of current word */
-            addword ( curr_word );
-            if ( prev_word [0] != '\0' ) {
+            addword ( words, curr_word, curr_len );
+            if ( prev_len > 0 ) {
               /* Build multiword term <prev_word, curr_word> */
-              strcpy ( new_word, prev_word );
-              strcat ( new_word, " " );
-              strcat ( new_word, curr_word );
-              addword ( new_word );
+              memcpy ( new_word, prev_word, prev_len );
+              new_word [ prev_len ] = ' ';
+              memcpy ( new_word + prev_len + 1, curr_word, curr_len + 1 );
+              addword ( words, new_word, prev_len + 1 + curr_len );
             }
             
             /* Current word becomes previous word */
-            strcpy ( prev_word, curr_word ); 
+            word = prev_word;
+            prev_word = curr_word;
+            curr_word = word;
+            prev_len = curr_len;
           }
-          ok = getline ();
+          line = cursor + 1;
         }
       }
 
       else {
         /* some other command; ignore it */
-        ok = getline ();
+        line = next_line ( line );
       }
     }
     else {
       /* some other line */
-      ok = getline ();
+      line = next_line ( line );
     }
   }
-  dump_list ( docnum );
-  fprintf ( counter, "\n" );
+  dump_list ( words, docnum, b );
 }
 
 
 /****************************************************************
-**  load_stoplist
+**  term_number
 **
-**  Loads the stoplist into a memory list for faster subsequent
-**  access.
+**  Returns the number of a word in the dictionary. A new word
+**  is entered into the dictionary and gets the next number.
 **
-**  IN  : f = file handle of opened stop list.
+**  IN  : word, len = word and its length.
 ****************************************************************/
 
-int comp_str
-      ( s1, s2 )
-ELEMENT
-  s1;
-ELEMENT
-  s2;
+int term_number
+      ( word, len )
+char
+  *word;
+int
+  len;
 {
-  return ( strcmp ( (char *) s1, (char *) s2 ) );
+  int
+    n;
+  HASH_ENTRY
+    *e;
+
+  n = count_hash ( dictionary );
+  e = add_hash ( dictionary, word, len );
+  if ( count_hash ( dictionary ) > n ) {
+    e -> val = n;
+  }
+  return ( e -> val );
 }
 
 
-void load_stoplist
+/****************************************************************
+**  write_batch
+**
+**  Writes the output of a parsed batch to the standard output.
+**  The workers write the terms in plain text; they are replaced
+**  by their numbers here. Batches are written in input order, so
+**  the numbering does not depend on the number of threads.
+****************************************************************/
+
+void write_batch
+       ( b )
+BATCH
+  *b;
+{
+  char
+    *p, *q,
+    *last,
+    *term,
+    *blank;
+  int
+    tf;
+
+  p = b -> out;
+  last = b -> out + b -> outlen;
+  while ( p < last ) {
+    q = memchr ( p, '\n', last - p );
+    if ( *p != '\t' ) {
+      /* Document number */
+      fwrite ( p, 1, q - p + 1, stdout );
+    }
+    else {
+      /* Frequency and single word or compound term */
+      tf = (int) strtol ( p + 1, &term, 10 );
+      term ++;
+      blank = memchr ( term, ' ', q - term );
+      if ( blank == NULL ) {
+        printf ( "\t%d\t%d\n", tf, term_number ( term, q - term ) );
+      }
+      else {
+        printf ( "\t%d\t%d %d\n", tf, term_number ( term, blank - term ),
+                 term_number ( blank + 1, q - blank - 1 ) );
+      }
+    }
+    p = q + 1;
+  }
+}
+
+
+/****************************************************************
+**  write_dictionary
+**
+**  Writes all words and their numbers to the dictionary file.
+****************************************************************/
+
+void write_dictionary
        ( f )
 FILE
   *f;
 {
   int
-    count = 0;
-  ELEMENT
+    i;
+
+  for ( i = 0; i < count_hash ( dictionary ); i ++ ) {
+    fprintf ( f, "%d\t%s\n", i, hash_entry ( dictionary, i ) -> key );
+  }
+}
+
+
+#ifdef THREADS
+
+/****************************************************************
+**  parse_worker
+**
+**  Main function of a worker thread. Parses batches in the
+**  order in which they were submitted until 'finish_batches'
+**  is called.
+**
+**  IN  : arg = not used.
+****************************************************************/
+
+void *parse_worker
+        ( arg )
+void
+  *arg;
+{
+  HASH
+    words;
+  BATCH
+    *b;
+
+  words = create_hash ( DOC_TERMS );
+  while ( TRUE ) {
+    /* Wait for next batch */
+    pthread_mutex_lock ( &batch_lock );
+    while ( ( parse_seq == fill_seq ) && ! finished ) {
+      pthread_cond_wait ( &batch_cond, &batch_lock );
+    }
+    if ( parse_seq == fill_seq ) {
+      pthread_mutex_unlock ( &batch_lock );
+      break;
+    }
+    b = &slot [ parse_seq % num_slots ];
+    parse_seq ++;
+    pthread_mutex_unlock ( &batch_lock );
+
+    parse_batch ( b, words );
+
+    pthread_mutex_lock ( &batch_lock );
+    b -> done = TRUE;
+    pthread_cond_broadcast ( &batch_cond );
+    pthread_mutex_unlock ( &batch_lock );
+  }
+  destroy_hash ( &words );
+  return ( NULL );
+}
+
+#endif
+
+
+/****************************************************************
+**  start_workers
+**
+**  Allocates the batch slots and starts the worker threads.
+**  With a single thread, batches are parsed by the main thread
+**  as soon as they are submitted.
+**
+**  IN  : n = number of threads.
+****************************************************************/
+
+void start_workers
+       ( n )
+int
+  n;
+{
+  int
+    i;
+#ifdef THREADS
+  int
     res;
+#endif
+
+  num_workers = ( n > 1 ) ? n : 0;
+  num_slots = ( n > 1 ) ? n * SLOTS_PER_THREAD : 1;
+  slot = (BATCH *) malloc ( num_slots * sizeof ( BATCH ) );
+  assert ( slot != NULL );
+  for ( i = 0; i < num_slots; i ++ ) {
+    slot [i].text = slot [i].out = NULL;
+    slot [i].size = slot [i].outsize = 0;
+  }
+
+#ifdef THREADS
+  worker = (pthread_t *) malloc ( n * sizeof ( pthread_t ) );
+  assert ( worker != NULL );
+  for ( i = 0; i < num_workers; i ++ ) {
+    res = pthread_create ( &worker [i], NULL, parse_worker, NULL );
+    assert ( res == 0 );
+  }
+#endif
+}
+
+
+/****************************************************************
+**  next_batch
+**
+**  Returns an empty batch to be filled. If all slots are in use,
+**  the oldest batch is written first; the function waits until
+**  it has been parsed.
+**
+**  IN  : query = TRUE if the batch is part of the query file.
+****************************************************************/
+
+BATCH *next_batch
+         ( query )
+BOOL
+  query;
+{
+  BATCH
+    *b;
+
+  b = &slot [ fill_seq % num_slots ];
+  if ( fill_seq - write_seq == num_slots ) {
+#ifdef THREADS
+    pthread_mutex_lock ( &batch_lock );
+    while ( ! b -> done ) {
+      pthread_cond_wait ( &batch_cond, &batch_lock );
+    }
+    pthread_mutex_unlock ( &batch_lock );
+#endif
+    write_batch ( b );
+    write_seq ++;
+  }
+  b -> len = 0;
+  b -> query = query;
+  b -> done = FALSE;
+  return ( b );
+}
+
+
+/****************************************************************
+**  submit_batch
+**
+**  Hands a filled batch over to the workers.
+****************************************************************/
+
+void submit_batch
+       ( b )
+BATCH
+  *b;
+{
+  if ( num_workers == 0 ) {
+    parse_batch ( b, doc_words );
+    b -> done = TRUE;
+    fill_seq ++;
+    return;
+  }
+#ifdef THREADS
+  pthread_mutex_lock ( &batch_lock );
+  fill_seq ++;
+  pthread_cond_broadcast ( &batch_cond );
+  pthread_mutex_unlock ( &batch_lock );
+#endif
+}
+
+
+/****************************************************************
+**  finish_batches
+**
+**  Writes all outstanding batches and stops the workers.
+****************************************************************/
+
+void finish_batches
+       ( )
+{
+  BATCH
+    *b;
+  int
+    i;
+
+  while ( write_seq < fill_seq ) {
+    b = &slot [ write_seq % num_slots ];
+#ifdef THREADS
+    pthread_mutex_lock ( &batch_lock );
+    while ( ! b -> done ) {
+      pthread_cond_wait ( &batch_cond, &batch_lock );
+    }
+    pthread_mutex_unlock ( &batch_lock );
+#endif
+    write_batch ( b );
+    write_seq ++;
+  }
+
+#ifdef THREADS
+  pthread_mutex_lock ( &batch_lock );
+  finished = TRUE;
+  pthread_cond_broadcast ( &batch_cond );
+  pthread_mutex_unlock ( &batch_lock );
+  for ( i = 0; i < num_workers; i ++ ) {
+    pthread_join ( worker [i], NULL );
+  }
+  free ( worker );
+#endif
+
+  for ( i = 0; i < num_slots; i ++ ) {
+    if ( slot [i].text != NULL ) free ( slot [i].text );
+    if ( slot [i].out != NULL ) free ( slot [i].out );
+  }
+  free ( slot );
+}
+
+
+/****************************************************************
+**  analyze
+**
+**  Reads a text collection and splits it into batches, which
+**  are parsed by 'parse_batch'. 'start_workers' must have been
+**  called previously.
+**
+**  IN  : r     = reader of document file.
+**        query = TRUE  --> This is a query file;
+**                FALSE --> This is a document file.
+**                (Distinction important because negative
+**                document numbers are assigned to queries)
+****************************************************************/
+
+void analyze
+       ( r, query )
+READER
+  r;
+BOOL
+  query;
+{
+  int
+    len,
+    docnum;
   char
-    *w, word [ MAX_WORDLEN ];
+    *text,
+    *line;
+  BATCH
+    *b;
+
+  b = next_batch ( query );
+
+  /* Read document file line by line */
+  while ( read_line ( r ) ) {
+    text = line_text ( r, &len );
+
+    if ( ( len >= 2 ) && ( text [0] == '.' ) && ( text [1] == 'I' ) ) {
+      /* Start of a document; begin a new batch if this one is full */
+      if ( b -> len >= BATCH_SIZE ) {
+        submit_batch ( b );
+        b = next_batch ( query );
+      }
+    }
+
+    /* Append line to batch */
+    reserve ( &b -> text, &b -> size, b -> len + len + 1 );
+    line = b -> text + b -> len;
+    memcpy ( line, text, len );
+    line [ len ] = '\0';
+    b -> len += len + 1;
+
+    if ( ( len >= 2 ) && ( line [0] == '.' ) && ( line [1] == 'I' ) &&
+         ( sscanf ( line, ".I %d", &docnum ) == 1 ) ) {
+      /* update running count */
+      fprintf ( counter, "%d\r", query ? - docnum : docnum );
+    }
+  }
+  submit_batch ( b );
+  fprintf ( counter, "\n" );
+}
+
+
+/****************************************************************
+**  load_stoplist
+**
+**  Loads the stoplist into a hash table for faster subsequent
+**  access.
+**
+**  IN  : r = reader of stop list.
+****************************************************************/
 
-  stop_words = create_list ();
+void load_stoplist
+       ( r )
+READER
+  r;
+{
+  int
+    count = 0;
+  char
+    word [ MAX_WORDLEN ];
 
-  /* Read stop words, one at a time */
-  while ( fscanf ( f, " %s", word ) > 0 ) {
+  stop_words = create_hash ( 0 );
 
-    /* Since the list contains pointers to the strings, we must make a copy */
-    w = uppercase ( duplicate ( word ) );
-    res = add_list ( stop_words, (ELEMENT) w, comp_str );
-    assert ( res != NULL );
+  /* Read stop words, one at a time; the table makes its own copy */
+  while ( read_line ( r ) ) {
+    while ( get_word ( r, word, MAX_WORDLEN ) ) {
+      uppercase ( word );
+      add_hash ( stop_words, word, strlen ( word ) );
 
-    /* Show running count */
-    count ++;
-    fprintf ( counter, "%d\r", count );
+      /* Show running count */
+      count ++;
+      fprintf ( counter, "%d\r", count );
+    }
   }
   fprintf ( counter, "\n" );
 }
@@ -534,16 +985,21 @@ int
 char
   *argv [];
 {
+  READER
+    docfile,
+    stoplist,
+    queryfile;
+  unsigned long
+    hits,
+    misses;
   FILE
-    *docfile,
-    *stoplist,
-    *queryfile;
+    *dict;
 
   /* Program title */
   fprintf ( stderr, PROG );
 
   /* Get verbose or quiet mode */
-  if ( ( argc == 5 ) && ( *argv [4] == 'Q' ) ) {
+  if ( ( argc == 6 ) && ( *argv [5] == 'Q' ) ) {
     /* in case of quiet mode: redirect running counts to /dev/null */
     counter = fopen ( "/dev/null", "r" );
     assert ( counter != NULL );
@@ -553,33 +1009,51 @@ char
     counter = stderr;
   }
 
-  if ( argc < 4 ) {
+  if ( argc < 5 ) {
     fprintf ( stderr, USAGE );
     return ( 1 );
   }
 
   /* Open document file, query file, and stop list */
   
-  docfile = open_file ( argv [1] );
-  queryfile = open_file ( argv [2] );
-  stoplist = open_file ( argv [3] );
+  docfile = open_reader ( argv [1] );
+  queryfile = open_reader ( argv [2] );
+  stoplist = open_reader ( argv [3] );
 
   /* Load the entire stop list into memory */
   fprintf ( stderr, "Loading stop list.\n" );
   load_stoplist ( stoplist );
 
   /* Read the document collection */
+  doc_words = create_hash ( DOC_TERMS );
+  stem_cache = create_stemcache ( STEM_CACHE );
+  dictionary = create_hash ( DICT_TERMS );
+  start_workers ( thread_count () );
   fprintf ( stderr, "Reading documents.\n" );
   analyze ( docfile, FALSE );
 
   /* Read test queries */
   fprintf ( stderr, "Reading queries.\n" );
   analyze ( queryfile, TRUE );
-
-  fclose ( docfile );
-  fclose ( queryfile );
-  fclose ( stoplist );
-  destroy_list ( &stop_words );
+  finish_batches ();
+
+  stemcache_stats ( stem_cache, &hits, &misses );
+  fprintf ( stderr, "Stem cache: %lu hits, %lu misses.\n", hits, misses );
+
+  /* Write dictionary */
+  fprintf ( stderr, "Writing dictionary: %d words.\n", 
+	    count_hash ( dictionary ) );
+  dict = create_file ( argv [4] );
+  write_dictionary ( dict );
+  fclose ( dict );
+
+  close_reader ( &docfile );
+  close_reader ( &queryfile );
+  close_reader ( &stoplist );
+  destroy_hash ( &stop_words );
+  destroy_hash ( &doc_words );
+  destroy_stemcache ( &stem_cache );
+  destroy_hash ( &dictionary );
 
   return ( 0 );
 }
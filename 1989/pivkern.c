@@ -0,0 +1,516 @@
+/****************************************************************
+*
+*           S O F T W A R E   S O U R C E   F I L E
+*
+*****************************************************************
+*
+*   Name of file   : pivkern.c
+*   Author         : Guido Hoss
+*   Project        : ETH Diploma Thesis (SS 1989)
+*   Creation Date  : 13/05/89
+*   Type of file   : C Language File
+*
+*
+*   Description
+*   -----------
+*   Pivot step and search kernels of the simplex tableau, see
+*   pivkern.h.
+*
+*****************************************************************
+*
+*   COPYRIGHT (C) 1989, 2016 BY GUIDO HOSS.
+*
+*   This program is free software: you can redistribute it and/or 
+*   modify it under the terms of the GNU General Public License
+*   as published by the Free Software Foundation, either version 3
+*   of the License, or (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public
+*   License along with this program.  If not, see
+*   <http://www.gnu.org/licenses/>.
+*
+*   Git repository home: <https://github.com/ghoss/Thesis>
+*
+*****************************************************************
+* Date        :
+* Description :
+****************************************************************/   
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "pivkern.h"
+
+
+/* The kernels must not fuse a multiplication and an addition
+   (FMA): every element is rounded as in the scalar code, or the
+   kernels would give different results */
+#if defined ( __clang__ )
+#pragma STDC FP_CONTRACT OFF
+#elif defined ( __GNUC__ )
+#pragma GCC optimize ( "fp-contract=off" )
+#endif
+
+/* SIMD kernels need the vector extensions of GNU C on x86-64,
+   and a tableau of floats */
+#if defined ( __GNUC__ ) && defined ( __x86_64__ ) && ! defined ( NO_SIMD ) \
+    && ! defined ( DOUBLE ) && ! defined ( LONG_DOUBLE )
+#define SIMD_KERNELS
+#include <immintrin.h>
+#endif
+
+
+/****************************************************************
+**  Forward declarations (compiler type checking)
+****************************************************************/
+
+#ifndef BSDUNIX
+void update_scalar ( REAL *, REAL *, REAL_ARG, int );
+int max_pos_scalar ( REAL *, int );
+int ratio_pos_scalar ( REAL *, REAL *, int, REAL_ARG );
+#else
+void update_scalar ();
+int max_pos_scalar ();
+int ratio_pos_scalar ();
+#endif
+#ifdef SIMD_KERNELS
+__attribute__ (( target ( "avx2" ) ))
+void update_avx2 ( float *, float *, double, int );
+__attribute__ (( target ( "avx2" ) ))
+int max_pos_avx2 ( float *, int );
+__attribute__ (( target ( "avx2" ) ))
+int ratio_pos_avx2 ( float *, float *, int, double );
+__attribute__ (( target ( "avx512f" ) ))
+void update_avx512 ( float *, float *, double, int );
+__attribute__ (( target ( "avx512f" ) ))
+int max_pos_avx512 ( float *, int );
+__attribute__ (( target ( "avx512f" ) ))
+int ratio_pos_avx512 ( float *, float *, int, double );
+#endif
+
+
+/* Available kernels, fastest last */
+PIVOT_KERNEL
+  pivot_kernels [] = {
+    { "scalar", update_scalar, max_pos_scalar, ratio_pos_scalar },
+#ifdef SIMD_KERNELS
+    { "avx2", update_avx2, max_pos_avx2, ratio_pos_avx2 },
+    { "avx512", update_avx512, max_pos_avx512, ratio_pos_avx512 },
+#endif
+  };
+
+
+/****************************************************************
+**  update_scalar
+**
+**  Scalar kernels, used on all processors.
+**
+**  IN  : row  = row to be updated.
+**        prow = pivot row.
+**        f    = factor (a REAL value).
+**        len  = number of elements.
+**
+**  OUT : row [k] := row [k] + f * prow [k]
+****************************************************************/
+
+void update_scalar
+       ( row, prow, f, len )
+REAL
+  *row, *prow;
+REAL_ARG
+  f;
+int
+  len;
+{
+  REAL
+    g;
+  int
+    k;
+
+  /* Calculate in REAL, like the rest of the matrix */
+  g = (REAL) f;
+  for ( k = 0; k < len; k ++ ) {
+    row [k] = row [k] + g * prow [k];
+  }
+}
+
+
+/****************************************************************
+**  max_pos_scalar
+**
+**  IN  : v   = objective row.
+**        len = number of elements.
+**
+**  OUT : Function returns the position of the first largest
+**        element of v which is greater than 0.0, or -1.
+****************************************************************/
+
+int max_pos_scalar
+      ( v, len )
+REAL
+  *v;
+int
+  len;
+{
+  REAL
+    max;
+  int
+    k, q;
+
+  q = -1;
+  max = 0.0;
+  for ( k = 0; k < len; k ++ ) {
+    if ( v [k] > max ) {
+      q = k;
+      max = v [k];
+    }
+  }
+  return ( q );
+}
+
+
+/****************************************************************
+**  ratio_pos_scalar
+**
+**  IN  : col = pivot column (0.0 in rows which do not take part).
+**        rhs = constants of the rows.
+**        len = number of rows.
+**        lim = quotients must be greater than this value (a
+**              REAL value).
+**
+**  OUT : Function returns the first row i with col [i] < 0.0
+**        whose quotient rhs [i] / col [i] is largest, or -1.
+****************************************************************/
+
+int ratio_pos_scalar
+      ( col, rhs, len, lim )
+REAL
+  *col, *rhs;
+int
+  len;
+REAL_ARG
+  lim;
+{
+  REAL
+    quot, min;
+  int
+    i, p;
+
+  min = (REAL) lim;
+  p = -1;
+  for ( i = 0; i < len; i ++ ) {
+    if ( col [i] < 0.0 ) {
+      quot = rhs [i] / col [i];
+      if ( quot > min ) {
+        p = i;
+        min = quot;
+      }
+    }
+  }
+  return ( p );
+}
+
+
+#ifdef SIMD_KERNELS
+
+/****************************************************************
+**  update_avx2, max_pos_avx2, ratio_pos_avx2
+**
+**  AVX2 kernels (same parameters as the scalar kernels). The
+**  ratio test keeps the largest quotient and its row in each
+**  lane; the lanes are then merged. Remaining elements are left
+**  to the scalar code.
+****************************************************************/
+
+__attribute__ (( target ( "avx2" ) ))
+void update_avx2
+       ( row, prow, f, len )
+float
+  *row, *prow;
+double
+  f;
+int
+  len;
+{
+  __m256
+    fv;
+  int
+    k;
+
+  fv = _mm256_set1_ps ( (float) f );
+  for ( k = 0; k + 8 <= len; k += 8 ) {
+    _mm256_storeu_ps ( row + k, 
+      _mm256_add_ps ( _mm256_loadu_ps ( row + k ), 
+                      _mm256_mul_ps ( fv, _mm256_loadu_ps ( prow + k ) ) ) );
+  }
+  update_scalar ( row + k, prow + k, f, len - k );
+}
+
+
+__attribute__ (( target ( "avx2" ) ))
+int max_pos_avx2
+      ( v, len )
+float
+  *v;
+int
+  len;
+{
+  __m256
+    mv, x;
+  float
+    lane [8], max;
+  int
+    k;
+
+  /* Largest element */
+  mv = _mm256_setzero_ps ();
+  for ( k = 0; k + 8 <= len; k += 8 ) {
+    mv = _mm256_max_ps ( mv, _mm256_loadu_ps ( v + k ) );
+  }
+  _mm256_storeu_ps ( lane, mv );
+  max = 0.0;
+  for ( k = 0; k < 8; k ++ ) {
+    if ( lane [k] > max ) max = lane [k];
+  }
+  for ( k = len & ~7; k < len; k ++ ) {
+    if ( v [k] > max ) max = v [k];
+  }
+  if ( max == 0.0 ) return ( -1 );
+
+  /* Its first position */
+  x = _mm256_set1_ps ( max );
+  for ( k = 0; k + 8 <= len; k += 8 ) {
+    if ( _mm256_movemask_ps ( _mm256_cmp_ps ( _mm256_loadu_ps ( v + k ), x,
+                                              _CMP_EQ_OQ ) ) != 0 ) break;
+  }
+  while ( v [k] != max ) k ++;
+  return ( k );
+}
+
+
+__attribute__ (( target ( "avx2" ) ))
+int ratio_pos_avx2
+      ( col, rhs, len, lim )
+float
+  *col, *rhs;
+int
+  len;
+double
+  lim;
+{
+  __m256
+    best, c, quot, upd, zero;
+  __m256i
+    idx, pos, eight;
+  float
+    lane [8], min;
+  int
+    lpos [8], i, p;
+
+  min = (float) lim;
+  zero = _mm256_setzero_ps ();
+  best = _mm256_set1_ps ( min );
+  pos = _mm256_set1_epi32 ( -1 );
+  idx = _mm256_setr_epi32 ( 0, 1, 2, 3, 4, 5, 6, 7 );
+  eight = _mm256_set1_epi32 ( 8 );
+  for ( i = 0; i + 8 <= len; i += 8 ) {
+    c = _mm256_loadu_ps ( col + i );
+    quot = _mm256_div_ps ( _mm256_loadu_ps ( rhs + i ), c );
+    upd = _mm256_and_ps ( _mm256_cmp_ps ( c, zero, _CMP_LT_OQ ),
+                          _mm256_cmp_ps ( quot, best, _CMP_GT_OQ ) );
+    best = _mm256_blendv_ps ( best, quot, upd );
+    pos = _mm256_castps_si256 ( _mm256_blendv_ps ( _mm256_castsi256_ps ( pos ),
+            _mm256_castsi256_ps ( idx ), upd ) );
+    idx = _mm256_add_epi32 ( idx, eight );
+  }
+
+  /* Merge the lanes: largest quotient, lowest row */
+  _mm256_storeu_ps ( lane, best );
+  _mm256_storeu_si256 ( (__m256i *) lpos, pos );
+  p = -1;
+  for ( i = 0; i < 8; i ++ ) {
+    if ( ( lpos [i] >= 0 ) && 
+         ( ( lane [i] > min ) || ( ( lane [i] == min ) && ( lpos [i] < p ) ) ) ) {
+      p = lpos [i];
+      min = lane [i];
+    }
+  }
+
+  /* Remaining rows */
+  i = ratio_pos_scalar ( col + ( len & ~7 ), rhs + ( len & ~7 ), len & 7, min );
+  return ( ( i >= 0 ) ? ( len & ~7 ) + i : p );
+}
+
+
+/****************************************************************
+**  update_avx512, max_pos_avx512, ratio_pos_avx512
+**
+**  AVX-512 kernels, like the AVX2 kernels.
+****************************************************************/
+
+__attribute__ (( target ( "avx512f" ) ))
+void update_avx512
+       ( row, prow, f, len )
+float
+  *row, *prow;
+double
+  f;
+int
+  len;
+{
+  __m512
+    fv;
+  int
+    k;
+
+  fv = _mm512_set1_ps ( (float) f );
+  for ( k = 0; k + 16 <= len; k += 16 ) {
+    _mm512_storeu_ps ( row + k, 
+      _mm512_add_ps ( _mm512_loadu_ps ( row + k ), 
+                      _mm512_mul_ps ( fv, _mm512_loadu_ps ( prow + k ) ) ) );
+  }
+  update_scalar ( row + k, prow + k, f, len - k );
+}
+
+
+__attribute__ (( target ( "avx512f" ) ))
+int max_pos_avx512
+      ( v, len )
+float
+  *v;
+int
+  len;
+{
+  __m512
+    mv, x;
+  float
+    max;
+  int
+    k;
+
+  /* Largest element */
+  mv = _mm512_setzero_ps ();
+  for ( k = 0; k + 16 <= len; k += 16 ) {
+    mv = _mm512_max_ps ( mv, _mm512_loadu_ps ( v + k ) );
+  }
+  max = _mm512_reduce_max_ps ( mv );
+  for ( k = len & ~15; k < len; k ++ ) {
+    if ( v [k] > max ) max = v [k];
+  }
+  if ( max == 0.0 ) return ( -1 );
+
+  /* Its first position */
+  x = _mm512_set1_ps ( max );
+  for ( k = 0; k + 16 <= len; k += 16 ) {
+    if ( _mm512_cmp_ps_mask ( _mm512_loadu_ps ( v + k ), x, _CMP_EQ_OQ ) != 0 ) {
+      break;
+    }
+  }
+  while ( v [k] != max ) k ++;
+  return ( k );
+}
+
+
+__attribute__ (( target ( "avx512f" ) ))
+int ratio_pos_avx512
+      ( col, rhs, len, lim )
+float
+  *col, *rhs;
+int
+  len;
+double
+  lim;
+{
+  __m512
+    best, c, quot, zero;
+  __m512i
+    idx, pos, sixteen;
+  __mmask16
+    upd;
+  float
+    lane [16], min;
+  int
+    lpos [16], i, p;
+
+  min = (float) lim;
+  zero = _mm512_setzero_ps ();
+  best = _mm512_set1_ps ( min );
+  pos = _mm512_set1_epi32 ( -1 );
+  idx = _mm512_setr_epi32 ( 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 );
+  sixteen = _mm512_set1_epi32 ( 16 );
+  for ( i = 0; i + 16 <= len; i += 16 ) {
+    c = _mm512_loadu_ps ( col + i );
+    quot = _mm512_div_ps ( _mm512_loadu_ps ( rhs + i ), c );
+    upd = _mm512_cmp_ps_mask ( c, zero, _CMP_LT_OQ ) &
+          _mm512_cmp_ps_mask ( quot, best, _CMP_GT_OQ );
+    best = _mm512_mask_mov_ps ( best, upd, quot );
+    pos = _mm512_mask_mov_epi32 ( pos, upd, idx );
+    idx = _mm512_add_epi32 ( idx, sixteen );
+  }
+
+  /* Merge the lanes: largest quotient, lowest row */
+  _mm512_storeu_ps ( lane, best );
+  _mm512_storeu_si512 ( lpos, pos );
+  p = -1;
+  for ( i = 0; i < 16; i ++ ) {
+    if ( ( lpos [i] >= 0 ) && 
+         ( ( lane [i] > min ) || ( ( lane [i] == min ) && ( lpos [i] < p ) ) ) ) {
+      p = lpos [i];
+      min = lane [i];
+    }
+  }
+
+  /* Remaining rows */
+  i = ratio_pos_scalar ( col + ( len & ~15 ), rhs + ( len & ~15 ), len & 15, min );
+  return ( ( i >= 0 ) ? ( len & ~15 ) + i : p );
+}
+
+#endif
+
+
+/****************************************************************
+**  select_pivot_kernel
+**
+**  Selects the fastest kernels the processor supports.
+**
+**  IN  : size = sizeof ( REAL ) of the caller; it must have been
+**               compiled with the same precision.
+**
+**  OUT : Function returns the kernels.
+****************************************************************/
+
+PIVOT_KERNEL *select_pivot_kernel
+                ( size )
+int
+  size;
+{
+  char
+    *s;
+
+  if ( size != (int) sizeof ( REAL ) ) {
+    fprintf ( stderr, "pivkern: compiled for %s, caller uses %d bytes\n",
+              REAL_NAME, size );
+    assert ( size == (int) sizeof ( REAL ) );
+  }
+
+  s = getenv ( "PIVOT_KERNEL" );
+  if ( s == NULL ) s = "avx512";
+#ifdef SIMD_KERNELS
+  __builtin_cpu_init ();
+  if ( ( strcmp ( s, "avx512" ) == 0 ) && __builtin_cpu_supports ( "avx512f" ) ) {
+    return ( &pivot_kernels [2] );
+  }
+  if ( ( ( strcmp ( s, "avx512" ) == 0 ) || ( strcmp ( s, "avx2" ) == 0 ) ) &&
+       __builtin_cpu_supports ( "avx2" ) ) {
+    return ( &pivot_kernels [1] );
+  }
+#endif
+  return ( &pivot_kernels [0] );
+}
@@ -0,0 +1,91 @@
+/****************************************************************
+*
+*           S O F T W A R E   S O U R C E   F I L E
+*
+*****************************************************************
+*
+*   Name of file   : pivkern.h
+*   Author         : Guido Hoss
+*   Project        : ETH Diploma Thesis (SS 1989)
+*   Creation Date  : 13/05/89
+*   Type of file   : C Header File
+*
+*****************************************************************
+*
+*   COPYRIGHT (C) 1989, 2016 BY GUIDO HOSS.
+*
+*   This program is free software: you can redistribute it and/or 
+*   modify it under the terms of the GNU General Public License
+*   as published by the Free Software Foundation, either version 3
+*   of the License, or (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public
+*   License along with this program.  If not, see
+*   <http://www.gnu.org/licenses/>.
+*
+*   Git repository home: <https://github.com/ghoss/Thesis>
+*
+*****************************************************************
+* Date        :
+* Description :
+****************************************************************/   
+
+/* Kernels of the simplex tableau (see simplex.c). A pivot step
+   adds a multiple of the pivot row to every other row:
+
+      row [k] := row [k] + f * prow [k]       (k = 0..len-1)
+
+   Step 'PIV' looks for the first largest positive element of the
+   objective row, and the ratio test for the first largest
+   quotient rhs [i] / col [i] among the negative elements of the
+   pivot column. All kernels give exactly the same results: the
+   SIMD kernels do the same operations on several elements at
+   once, and resolve ties between lanes by the lowest index. The
+   kernels are selected at run time by the features of the
+   processor; the environment variable PIVOT_KERNEL (scalar, avx2
+   or avx512) limits the choice.
+
+   The elements of the tableau are of type REAL: float, or double
+   and long double if compiled with DOUBLE or LONG_DOUBLE. The
+   SIMD kernels only exist for float. Scalar parameters are passed
+   as REAL_ARG, which a REAL is promoted to. select_pivot_kernel
+   checks that the caller was compiled with the same REAL. */
+
+#if defined ( LONG_DOUBLE )
+typedef long double REAL;
+typedef long double REAL_ARG;
+#define REAL_NAME	"long double"
+#elif defined ( DOUBLE )
+typedef double REAL;
+typedef double REAL_ARG;
+#define REAL_NAME	"double"
+#else
+typedef float REAL;
+typedef double REAL_ARG;
+#define REAL_NAME	"float"
+#endif
+
+typedef
+  struct {
+    char	*name;
+#ifndef BSDUNIX
+    void	(*update) ( REAL *, REAL *, REAL_ARG, int );
+    int		(*max_pos) ( REAL *, int );
+    int		(*ratio_pos) ( REAL *, REAL *, int, REAL_ARG );
+#else
+    void	(*update) ();
+    int		(*max_pos) ();
+    int		(*ratio_pos) ();
+#endif
+  } PIVOT_KERNEL;
+
+#ifndef BSDUNIX
+PIVOT_KERNEL *select_pivot_kernel ( int );
+#else
+PIVOT_KERNEL *select_pivot_kernel ();
+#endif
@@ -0,0 +1,224 @@
+/****************************************************************
+*
+*           S O F T W A R E   S O U R C E   F I L E
+*
+*****************************************************************
+*
+*   Name of file   : pivtest.c
+*   Author         : Guido Hoss
+*   Project        : ETH Diploma Thesis (SS 1989)
+*   Creation Date  : 13/05/89
+*   Type of file   : C Language File
+*
+*   Description
+*   -----------
+*   Checks that all pivot kernels of the simplex tableau (see
+*   pivkern.h) give exactly the same results as the scalar
+*   kernels: the row update, the search for the pivot column
+*   (step 'PIV') and the ratio test. The vectors are random, with
+*   few distinct values so that there are many ties, and of all
+*   lengths up to MAX_LEN, so that every remainder of the SIMD
+*   loops occurs.
+*
+*   The program should be compiled with the same options as
+*   optimize (e.g. -O2, PRECISION); kernels which the processor
+*   does not support are skipped.
+*
+*   Call Format
+*   -----------
+*	pivtest
+*
+*   The exit status is 0 if all kernels agree, 1 otherwise.
+*
+*****************************************************************
+*
+*   COPYRIGHT (C) 1989, 2016 BY GUIDO HOSS.
+*
+*   This program is free software: you can redistribute it and/or
+*   modify it under the terms of the GNU General Public License
+*   as published by the Free Software Foundation, either version 3
+*   of the License, or (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public
+*   License along with this program.  If not, see
+*   <http://www.gnu.org/licenses/>.
+*
+*   Git repository home: <https://github.com/ghoss/Thesis>
+*
+*****************************************************************
+* Date        :
+* Description :
+****************************************************************/
+
+#define PROG	"Pivot Kernel Test (gh, 13/05/89)\n"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "pivkern.h"
+
+#define MAX_LEN		80	/* Longest vector */
+#define ROUNDS		200	/* Random vectors per length */
+
+char
+  *names [] = { "PIVOT_KERNEL=scalar", "PIVOT_KERNEL=avx2",
+                "PIVOT_KERNEL=avx512" };
+
+
+/****************************************************************
+**  Procedure declarations
+****************************************************************/
+
+#ifndef BSDUNIX
+int main ( int, char * [] );
+long random_num ( void );
+REAL random_real ( void );
+long check_kernel ( PIVOT_KERNEL *, PIVOT_KERNEL * );
+#else
+int main ();
+long random_num ();
+REAL random_real ();
+long check_kernel ();
+#endif
+
+
+/****************************************************************
+**  random_num
+**
+**  Returns a pseudo-random number in [0, 2^31) (see listbench.c).
+****************************************************************/
+
+long random_num
+       ( )
+{
+  static unsigned long
+    seed = 1;
+
+  seed = ( seed * 1103515245L + 12345L ) & 0xffffffffL;
+  return ( (long) ( ( seed >> 1 ) & 0x7fffffffL ) );
+}
+
+
+/****************************************************************
+**  random_real
+**
+**  Returns a random element: 0.0 in one of four cases, else one
+**  of 16 values in [-1.0, 1.0) which are not exact in binary.
+****************************************************************/
+
+REAL random_real
+       ( )
+{
+  if ( random_num () % 4 == 0 ) {
+    return ( 0.0 );
+  }
+  return ( (REAL) ( random_num () % 16 - 8 ) / 7.3 );
+}
+
+
+/****************************************************************
+**  check_kernel
+**
+**  Compares the kernels k with the reference kernels s.
+**
+**  OUT : Function returns the number of differences.
+****************************************************************/
+
+long check_kernel
+       ( k, s )
+PIVOT_KERNEL
+  *k;
+PIVOT_KERNEL
+  *s;
+{
+  REAL
+    row1 [ MAX_LEN ], row2 [ MAX_LEN ], prow [ MAX_LEN ],
+    col [ MAX_LEN ], rhs [ MAX_LEN ], f, lim;
+  long
+    diff;
+  int
+    len, r, i;
+
+  diff = 0;
+  for ( len = 0; len <= MAX_LEN; len ++ ) {
+    for ( r = 0; r < ROUNDS; r ++ ) {
+      for ( i = 0; i < len; i ++ ) {
+        row1 [i] = row2 [i] = random_real ();
+        prow [i] = random_real ();
+        col [i] = random_real ();
+        rhs [i] = fabs ( (double) random_real () );
+      }
+      f = random_real () * 3.1;
+
+      /* Row update */
+      (*s -> update) ( row1, prow, f, len );
+      (*k -> update) ( row2, prow, f, len );
+      if ( ( len > 0 ) &&
+           ( memcmp ( row1, row2, len * sizeof ( REAL ) ) != 0 ) ) {
+        diff ++;
+      }
+
+      /* Step 'PIV' */
+      if ( (*s -> max_pos) ( row1, len ) != (*k -> max_pos) ( row1, len ) ) {
+        diff ++;
+      }
+
+      /* Ratio test, without and with a limit */
+      lim = ( r % 2 ) ? - HUGE_VAL : - 0.5;
+      if ( (*s -> ratio_pos) ( col, rhs, len, (REAL_ARG) lim ) !=
+           (*k -> ratio_pos) ( col, rhs, len, (REAL_ARG) lim ) ) {
+        diff ++;
+      }
+    }
+  }
+  return ( diff );
+}
+
+
+/****************************************************************
+**  main
+****************************************************************/
+
+int main
+      ( argc, argv )
+int
+  argc;
+char
+  *argv [];
+{
+  PIVOT_KERNEL
+    *s, *k;
+  long
+    diff;
+  int
+    i, failed;
+
+  /* Program title */
+  fprintf ( stderr, PROG );
+
+  putenv ( names [0] );
+  s = select_pivot_kernel ( sizeof ( REAL ) );
+  printf ( "Reference: %s, %s\n", s -> name, REAL_NAME );
+
+  failed = 0;
+  for ( i = 1; i < (int) ( sizeof ( names ) / sizeof ( char * ) ); i ++ ) {
+    putenv ( names [i] );
+    k = select_pivot_kernel ( sizeof ( REAL ) );
+    if ( strcmp ( k -> name, strchr ( names [i], '=' ) + 1 ) != 0 ) {
+      printf ( "%-8s not available\n", strchr ( names [i], '=' ) + 1 );
+      continue;
+    }
+    diff = check_kernel ( k, s );
+    printf ( "%-8s %ld differences\n", k -> name, diff );
+    if ( diff > 0 ) failed = 1;
+  }
+
+  return ( failed );
+}
@@ -0,0 +1,711 @@
+/****************************************************************
+*
+*           S O F T W A R E   S O U R C E   F I L E
+*
+*****************************************************************
+*
+*   Name of file   : reader.c 
+*   Author         : Guido Hoss
+*   Project        : ETH Diploma Thesis (SS 1989)
+*   Creation Date  : 05/05/89
+*   Type of file   : C Language File
+*
+*   Description
+*   -----------
+*   Line and field reader for the input files of the system, see
+*   reader.h. Regular files are mapped into memory; pipes and
+*   files which cannot be mapped are read in large blocks. The
+*   numeric field parsers replace sscanf, which is by far the
+*   most expensive part of reading large weight files.
+*
+*****************************************************************
+*
+*   COPYRIGHT (C) 1989, 2016 BY GUIDO HOSS.
+*
+*   This program is free software: you can redistribute it and/or 
+*   modify it under the terms of the GNU General Public License
+*   as published by the Free Software Foundation, either version 3
+*   of the License, or (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public
+*   License along with this program.  If not, see
+*   <http://www.gnu.org/licenses/>.
+*
+*   Git repository home: <https://github.com/ghoss/Thesis>
+*
+*****************************************************************
+* Date        :
+* Description :
+****************************************************************/   
+
+#include <stdio.h>
+#ifdef MSDOS
+#include <process.h>
+#else
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#endif
+#include <malloc.h>
+#include <assert.h>
+#include <string.h>
+#include <stdlib.h>
+#include <ctype.h>
+
+#include "boolean.h"
+#include "util.h"
+#include "reader.h"
+
+#define READ_BUFFER	262144	/* Initial size of stream buffer */
+#define MAX_EXACT	15	/* Significant digits held exactly in a double */
+#define MAX_POWER	22	/* Largest exact power of 10 in a double */
+
+/* Every line ends with a newline character, which the field parsers
+   use as a sentinel: 'end' points to it. In a mapped file, this is
+   only true if the file ends with a newline; other files are read
+   as streams, where a newline is appended to the last line. */
+struct reader_header {
+  char		*buf;		/* Stream buffer or mapped file */
+  size_t	size;		/* Size of buffer or mapping */
+  char		*fill;		/* End of valid data in 'buf' */
+  char		*next;		/* Start of next line */
+  char		*line;		/* Start of current line */
+  char		*pos;		/* Parse position in current line */
+  char		*end;		/* End of current line */
+  FILE		*file;		/* Stream, or NULL if file is mapped */
+  BOOL		own;		/* TRUE if reader must close 'file' */
+  BOOL		eof;		/* TRUE if stream is exhausted */
+  BOOL		pushed;		/* TRUE if line must be delivered again */
+  char		*copy;		/* Buffer of 'line_string' */
+  unsigned	copysize;	/* Size of 'copy' */
+};
+
+#define isblank_char(c)	( ( (c) != '\n' ) && isspace ( c ) )
+
+double
+  power10 [ MAX_POWER + 1 ] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+    1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+    1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+  };
+
+
+/****************************************************************
+**  Forward declarations (compiler type checking)
+****************************************************************/
+
+#ifndef BSDUNIX
+void refill ( READER );
+void skip_blanks ( READER );
+#else
+void refill ();
+void skip_blanks ();
+#endif
+
+
+/****************************************************************
+**  stream_reader
+**
+**  Creates a reader for an open stream (e.g. stdin).
+**
+**  IN  : f = handle to open file.
+**
+**  OUT : Function returns a handle to the reader. The stream is
+**        not closed by 'close_reader'.
+****************************************************************/
+
+READER stream_reader
+         ( f )
+FILE
+  *f;
+{
+  READER
+    r;
+
+  r = (READER) malloc ( sizeof ( READER_HEADER ) );
+  assert ( r != NULL );
+  r -> size = READ_BUFFER;
+  r -> buf = malloc ( r -> size + 1 );	/* room for final newline */
+  assert ( r -> buf != NULL );
+  r -> fill = r -> next = r -> buf;
+  r -> line = r -> pos = r -> end = r -> buf;
+  r -> file = f;
+  r -> own = FALSE;
+  r -> eof = FALSE;
+  r -> pushed = FALSE;
+  r -> copy = NULL;
+  r -> copysize = 0;
+  return ( r );
+}
+
+
+/****************************************************************
+**  open_reader
+**
+**  Opens a file for reading. Like 'open_file', the program is
+**  aborted if the file cannot be opened.
+**
+**  IN  : s = pointer to null-terminated file name.
+**
+**  OUT : Function returns a handle to the reader.
+****************************************************************/
+
+READER open_reader
+         ( s )
+char
+  *s;
+{
+  FILE
+    *f;
+  READER
+    r;
+#ifndef MSDOS
+  struct stat
+    st;
+  char
+    *map;
+#endif
+
+  f = open_file ( s );
+
+#ifndef MSDOS
+  /* Map regular files which end with a newline */
+  if ( ( fstat ( fileno ( f ), &st ) == 0 ) && S_ISREG ( st.st_mode ) &&
+       ( st.st_size > 0 ) ) {
+    map = mmap ( NULL, (size_t) st.st_size, PROT_READ, MAP_PRIVATE, 
+                 fileno ( f ), (off_t) 0 );
+    if ( map != (char *) MAP_FAILED ) {
+      if ( map [ st.st_size - 1 ] == '\n' ) {
+        r = (READER) malloc ( sizeof ( READER_HEADER ) );
+        assert ( r != NULL );
+        r -> buf = map;
+        r -> size = st.st_size;
+        r -> fill = map + st.st_size;
+        r -> next = r -> line = r -> pos = r -> end = map;
+        r -> file = NULL;
+        r -> own = FALSE;
+        r -> eof = TRUE;
+        r -> pushed = FALSE;
+        r -> copy = NULL;
+        r -> copysize = 0;
+        fclose ( f );
+        return ( r );
+      }
+      munmap ( map, (size_t) st.st_size );
+    }
+  }
+#endif
+
+  r = stream_reader ( f );
+  r -> own = TRUE;
+  return ( r );
+}
+
+
+/****************************************************************
+**  close_reader
+**
+**  Closes a reader and frees its buffers.
+**
+**  IN  : r = pointer to handle of reader.
+**  OUT : '*r' is set to NULL.
+****************************************************************/
+
+void close_reader
+       ( r )
+READER
+  *r;
+{
+  if ( *r == NULL ) return;
+  if ( (*r) -> file == NULL ) {
+#ifndef MSDOS
+    munmap ( (*r) -> buf, (*r) -> size );
+#endif
+  }
+  else {
+    free ( (*r) -> buf );
+    if ( (*r) -> own ) fclose ( (*r) -> file );
+  }
+  if ( (*r) -> copy != NULL ) free ( (*r) -> copy );
+  free ( *r );
+  *r = NULL;
+}
+
+
+/****************************************************************
+**  rewind_reader
+**
+**  Positions a reader at the start of its file again. Not
+**  possible for readers of pipes.
+**
+**  IN  : r = handle to reader.
+****************************************************************/
+
+void rewind_reader
+       ( r )
+READER
+  r;
+{
+  if ( r -> file != NULL ) {
+    rewind ( r -> file );
+    r -> fill = r -> buf;
+    r -> eof = FALSE;
+  }
+  r -> next = r -> line = r -> pos = r -> end = r -> buf;
+  r -> pushed = FALSE;
+}
+
+
+/****************************************************************
+**  refill
+**
+**  Reads more data from the stream of a reader. The unread part
+**  of the buffer is moved to its start; if it fills the whole
+**  buffer, the buffer is enlarged.
+**
+**  IN  : r = handle to reader.
+****************************************************************/
+
+void refill
+       ( r )
+READER
+  r;
+{
+  size_t
+    used, n;
+
+  used = r -> fill - r -> next;
+  if ( used == r -> size ) {
+    /* A single line fills the buffer */
+    r -> size *= 2;
+    r -> buf = realloc ( r -> buf, r -> size + 1 );
+    assert ( r -> buf != NULL );
+    r -> next = r -> buf;
+  }
+  else if ( r -> next != r -> buf ) {
+    memmove ( r -> buf, r -> next, used );
+    r -> next = r -> buf;
+  }
+  r -> fill = r -> buf + used;
+
+  n = fread ( r -> fill, 1, r -> size - used, r -> file );
+  if ( n == 0 ) {
+    r -> eof = TRUE;
+  }
+  r -> fill += n;
+}
+
+
+/****************************************************************
+**  read_line
+**
+**  Advances a reader to the next line of its file.
+**
+**  IN  : r = handle to reader.
+**
+**  OUT : Function returns FALSE at the end of the file. Otherwise,
+**        the fields of the new line can be parsed.
+****************************************************************/
+
+BOOL read_line
+       ( r )
+READER
+  r;
+{
+  char
+    *e;
+
+  if ( r -> pushed ) {
+    r -> pushed = FALSE;
+    r -> pos = r -> line;
+    return ( TRUE );
+  }
+
+  while ( ( e = memchr ( r -> next, '\n', r -> fill - r -> next ) ) 
+          == NULL ) {
+    if ( r -> eof ) {
+      if ( r -> next == r -> fill ) return ( FALSE );
+
+      /* Last line of a stream without newline */
+      e = r -> fill;
+      *e = '\n';
+      r -> line = r -> pos = r -> next;
+      r -> end = e;
+      r -> next = r -> fill;
+      return ( TRUE );
+    }
+    refill ( r );
+  }
+
+  r -> line = r -> pos = r -> next;
+  r -> end = e;
+  r -> next = e + 1;
+  return ( TRUE );
+}
+
+
+/****************************************************************
+**  skip_blanks
+**
+**  Advances the parse position of a reader over blanks, but not
+**  beyond the end of the line.
+****************************************************************/
+
+void skip_blanks
+       ( r )
+READER
+  r;
+{
+  char
+    *p;
+
+  p = r -> pos;
+  while ( isblank_char ( *p ) ) {
+    p ++;
+  }
+  r -> pos = p;
+}
+
+
+/****************************************************************
+**  get_int
+**
+**  Parses a decimal integer field (same syntax as "%d").
+**
+**  IN  : r = handle to reader.
+**        v = pointer to variable receiving the value.
+**
+**  OUT : Function returns FALSE if no integer could be found at
+**        the current position; 'v' is not changed then.
+****************************************************************/
+
+BOOL get_int
+       ( r, v )
+READER
+  r;
+int
+  *v;
+{
+  char
+    *p;
+  BOOL
+    neg = FALSE;
+  int
+    n = 0;
+
+  skip_blanks ( r );
+  p = r -> pos;
+  if ( ( *p == '-' ) || ( *p == '+' ) ) {
+    neg = ( *p == '-' );
+    p ++;
+  }
+  if ( ! isdigit ( *p ) ) return ( FALSE );
+
+  while ( isdigit ( *p ) ) {
+    n = n * 10 + ( *p - '0' );
+    p ++;
+  }
+  *v = neg ? -n : n;
+  r -> pos = p;
+  return ( TRUE );
+}
+
+
+/****************************************************************
+**  get_float
+**
+**  Parses a floating point field (same as "%f", without "inf"
+**  and "nan"). Numbers with at most MAX_EXACT significant digits
+**  and a small exponent are converted with one rounded
+**  multiplication or division, which gives the correctly rounded
+**  double; all other numbers are left to strtod.
+**
+**  IN  : r = handle to reader.
+**        v = pointer to variable receiving the value.
+**
+**  OUT : Function returns FALSE if no number could be found at
+**        the current position; 'v' is not changed then.
+****************************************************************/
+
+BOOL get_float
+       ( r, v )
+READER
+  r;
+float
+  *v;
+{
+  char
+    *p,
+    *start;
+  BOOL
+    neg = FALSE,
+    digits = FALSE;
+  double
+    m = 0.0;
+  int
+    sig = 0,
+    scale = 0,
+    e = 0,
+    eneg;
+
+  skip_blanks ( r );
+  start = p = r -> pos;
+  if ( ( *p == '-' ) || ( *p == '+' ) ) {
+    neg = ( *p == '-' );
+    p ++;
+  }
+
+  /* Integer part */
+  while ( isdigit ( *p ) ) {
+    digits = TRUE;
+    if ( ( sig > 0 ) || ( *p != '0' ) ) {
+      m = m * 10.0 + ( *p - '0' );
+      sig ++;
+    }
+    p ++;
+  }
+
+  /* Fraction */
+  if ( *p == '.' ) {
+    p ++;
+    while ( isdigit ( *p ) ) {
+      digits = TRUE;
+      if ( ( sig > 0 ) || ( *p != '0' ) ) {
+        m = m * 10.0 + ( *p - '0' );
+        sig ++;
+      }
+      scale --;
+      p ++;
+    }
+  }
+  if ( ! digits ) return ( FALSE );
+
+  /* Exponent */
+  if ( ( ( *p == 'e' ) || ( *p == 'E' ) ) && 
+       ( isdigit ( p [1] ) || 
+         ( ( ( p [1] == '-' ) || ( p [1] == '+' ) ) && isdigit ( p [2] ) ) ) ) {
+    p ++;
+    eneg = ( *p == '-' );
+    if ( ( *p == '-' ) || ( *p == '+' ) ) p ++;
+    while ( isdigit ( *p ) ) {
+      if ( e < 10000 ) e = e * 10 + ( *p - '0' );
+      p ++;
+    }
+    scale += eneg ? -e : e;
+  }
+
+  if ( ( sig <= MAX_EXACT ) && ( scale >= -MAX_POWER ) && 
+       ( scale <= MAX_POWER ) ) {
+    m = ( scale < 0 ) ? m / power10 [ -scale ] : m * power10 [ scale ];
+    *v = (float) ( neg ? -m : m );
+  }
+  else {
+    *v = (float) strtod ( start, NULL );
+  }
+  r -> pos = p;
+  return ( TRUE );
+}
+
+
+/****************************************************************
+**  get_word
+**
+**  Parses a field of non-blank characters (same as "%s").
+**
+**  IN  : r    = handle to reader.
+**        s    = buffer receiving the null-terminated word.
+**        size = size of buffer; longer words are truncated.
+**
+**  OUT : Function returns FALSE if the rest of the line is blank.
+****************************************************************/
+
+BOOL get_word
+       ( r, s, size )
+READER
+  r;
+char
+  *s;
+int
+  size;
+{
+  char
+    *p;
+
+  skip_blanks ( r );
+  p = r -> pos;
+  if ( p == r -> end ) return ( FALSE );
+
+  while ( ! isspace ( *p ) ) {
+    if ( size > 1 ) {
+      *s ++ = *p;
+      size --;
+    }
+    p ++;
+  }
+  *s = '\0';
+  r -> pos = p;
+  return ( TRUE );
+}
+
+
+/****************************************************************
+**  get_char
+**
+**  Parses a single non-blank character (same as " %c").
+**
+**  IN  : r = handle to reader.
+**        c = pointer to variable receiving the character.
+**
+**  OUT : Function returns FALSE if the rest of the line is blank.
+****************************************************************/
+
+BOOL get_char
+       ( r, c )
+READER
+  r;
+char
+  *c;
+{
+  skip_blanks ( r );
+  if ( r -> pos == r -> end ) return ( FALSE );
+  *c = *( r -> pos ++ );
+  return ( TRUE );
+}
+
+
+/****************************************************************
+**  line_has
+**
+**  Tests if a character occurs anywhere in the current line.
+****************************************************************/
+
+BOOL line_has
+       ( r, c )
+READER
+  r;
+int
+  c;
+{
+  return ( memchr ( r -> line, c, r -> end - r -> line ) != NULL );
+}
+
+
+/****************************************************************
+**  line_string
+**
+**  Returns a copy of the current line, without the newline.
+**
+**  IN  : r = handle to reader.
+**
+**  OUT : Function returns a pointer to a null-terminated copy of
+**        the line. The copy may be modified; it is overwritten by
+**        the next call to 'line_string'.
+****************************************************************/
+
+char *line_string
+        ( r )
+READER
+  r;
+{
+  unsigned
+    len;
+
+  len = r -> end - r -> line;
+  if ( len + 1 > r -> copysize ) {
+    if ( r -> copy != NULL ) free ( r -> copy );
+    r -> copysize = len + 1;
+    r -> copy = malloc ( r -> copysize );
+    assert ( r -> copy != NULL );
+  }
+  memcpy ( r -> copy, r -> line, len );
+  r -> copy [ len ] = '\0';
+  return ( r -> copy );
+}
+
+
+/****************************************************************
+**  line_text
+**
+**  Returns the current line in place, without copying it.
+**
+**  IN  : r   = handle to reader.
+**        len = pointer to variable receiving the line length.
+**
+**  OUT : Function returns a pointer to the first character of
+**        the line. The line is not null-terminated and must not
+**        be modified; it is valid until the next 'read_line'.
+****************************************************************/
+
+char *line_text
+        ( r, len )
+READER
+  r;
+int
+  *len;
+{
+  *len = r -> end - r -> line;
+  return ( r -> line );
+}
+
+
+/****************************************************************
+**  next_record
+**
+**  Skips to the next header line, i.e. the next line which does
+**  not begin with a blank, and parses the number at its start.
+**
+**  IN  : r   = handle to reader.
+**        key = pointer to variable receiving the number.
+**
+**  OUT : Function returns FALSE at the end of the file.
+****************************************************************/
+
+BOOL next_record
+       ( r, key )
+READER
+  r;
+int
+  *key;
+{
+  while ( read_line ( r ) ) {
+    if ( ( r -> line != r -> end ) && ! isspace ( *( r -> line ) ) &&
+         get_int ( r, key ) ) {
+      return ( TRUE );
+    }
+  }
+  return ( FALSE );
+}
+
+
+/****************************************************************
+**  next_entry
+**
+**  Advances to the next body line of the current record. Empty
+**  lines are skipped.
+**
+**  IN  : r = handle to reader.
+**
+**  OUT : Function returns FALSE at the end of the record; the
+**        header of the next record is kept for 'next_record'.
+****************************************************************/
+
+BOOL next_entry
+       ( r )
+READER
+  r;
+{
+  while ( read_line ( r ) ) {
+    if ( r -> line == r -> end ) continue;
+    if ( ! isspace ( *( r -> line ) ) ) {
+      r -> pushed = TRUE;
+      return ( FALSE );
+    }
+    return ( TRUE );
+  }
+  return ( FALSE );
+}
@@ -0,0 +1,92 @@
+/****************************************************************
+*
+*           S O F T W A R E   S O U R C E   F I L E
+*
+*****************************************************************
+*
+*   Name of file   : reader.h
+*   Author         : Guido Hoss
+*   Project        : ETH Diploma Thesis (SS 1989)
+*   Creation Date  : 05/05/89
+*   Type of file   : C Header File
+*
+*****************************************************************
+*
+*   COPYRIGHT (C) 1989, 2016 BY GUIDO HOSS.
+*
+*   This program is free software: you can redistribute it and/or 
+*   modify it under the terms of the GNU General Public License
+*   as published by the Free Software Foundation, either version 3
+*   of the License, or (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public
+*   License along with this program.  If not, see
+*   <http://www.gnu.org/licenses/>.
+*
+*   Git repository home: <https://github.com/ghoss/Thesis>
+*
+*****************************************************************
+* Date        :
+* Description :
+****************************************************************/   
+
+/* A reader delivers the lines of an input file one by one. Lines
+   may have any length. The fields of the current line are parsed
+   from left to right with get_int, get_float, get_word etc.; each
+   of them skips leading blanks and returns FALSE if the field is
+   missing, so a line can be interpreted with "as many fields as
+   possible" just like sscanf.
+
+   Many files of the system consist of records: a header line
+   beginning with a number, followed by body lines which are
+   indented by a tab, e.g.
+
+      17 :
+   	4
+   	139
+
+   next_record skips to the next header line and parses its number,
+   next_entry reads the body lines of the record one by one. */
+typedef
+  struct reader_header READER_HEADER;
+
+typedef
+  READER_HEADER *READER;
+
+
+#ifndef BSDUNIX
+READER open_reader ( char * );
+READER stream_reader ( FILE * );
+void close_reader ( READER * );
+void rewind_reader ( READER );
+BOOL read_line ( READER );
+BOOL get_int ( READER, int * );
+BOOL get_float ( READER, float * );
+BOOL get_word ( READER, char *, int );
+BOOL get_char ( READER, char * );
+BOOL line_has ( READER, int );
+char *line_string ( READER );
+char *line_text ( READER, int * );
+BOOL next_record ( READER, int * );
+BOOL next_entry ( READER );
+#else
+READER open_reader ();
+READER stream_reader ();
+void close_reader ();
+void rewind_reader ();
+BOOL read_line ();
+BOOL get_int ();
+BOOL get_float ();
+BOOL get_word ();
+BOOL get_char ();
+BOOL line_has ();
+char *line_string ();
+char *line_text ();
+BOOL next_record ();
+BOOL next_entry ();
+#endif
@@ -0,0 +1,784 @@
+/****************************************************************
+*
+*           S O F T W A R E   S O U R C E   F I L E
+*
+*****************************************************************
+*
+*   Name of file   : revsimp.c
+*   Author         : Guido Hoss
+*   Project        : ETH Diploma Thesis (SS 1989)
+*   Creation Date  : 12/05/89
+*   Type of file   : C Language File
+*
+*
+*   Description
+*   -----------
+*   Revised simplex method for sparse linear programs with bounded
+*   variables, see revsimp.h.
+*
+*   Only the nonzero coefficients of the constraint matrix are
+*   stored, by columns. The inverse of the basis is kept in
+*   product form, as a file of eta vectors: each change of the
+*   basis appends one eta vector. After REFACTOR changes, the
+*   basis is refactorised: the eta file is rebuilt from the
+*   basic columns by Gaussian elimination with partial pivoting,
+*   starting from the unit basis of the slack variables.
+*
+*   The bounds of the variables are not constraints of the
+*   program. A nonbasic variable may take any value within its
+*   bounds (the initial solution need not be a vertex); it is
+*   moved up or down as its reduced cost demands, and if it
+*   reaches its other bound first, it simply changes its bound
+*   instead of entering the basis.
+*
+*****************************************************************
+*
+*   COPYRIGHT (C) 1989, 2016 BY GUIDO HOSS.
+*
+*   This program is free software: you can redistribute it and/or 
+*   modify it under the terms of the GNU General Public License
+*   as published by the Free Software Foundation, either version 3
+*   of the License, or (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public
+*   License along with this program.  If not, see
+*   <http://www.gnu.org/licenses/>.
+*
+*   Git repository home: <https://github.com/ghoss/Thesis>
+*
+*****************************************************************
+* Date        :
+* Description :
+****************************************************************/   
+
+#include <stdio.h>
+#include <malloc.h>
+#include <math.h>
+#include <assert.h>
+
+#include "boolean.h"
+#include "util.h"
+#include "revsimp.h"
+
+
+/* Tolerances of the calculation */
+#define DUAL_TOL	1.0e-7	/* smallest reduced cost of an improvement */
+#define PIVOT_TOL	1.0e-9	/* smallest pivot element */
+#define FEAS_TOL	1.0e-6	/* largest violation of a bound */
+
+/* Number of basis changes after which the basis is refactorised */
+#define REFACTOR	64
+
+/* Number of degenerate steps after which Bland's rule is used
+   to prevent cycling */
+#define DEGEN_LIMIT	50
+
+
+typedef
+  struct {
+    int		num;		/* Number of eta vectors */
+    int		*pivot;		/* Pivot row of each eta vector */
+    int		*first;		/* First element of each eta vector */
+    int		*index;		/* Row of each element */
+    double	*value;		/* Value of each element */
+    unsigned	pivot_size,	/* Sizes of the buffers in bytes */
+		first_size,
+		index_size,
+		value_size;
+  } ETA_FILE;
+
+typedef
+  struct {
+    LP		lp;		/* The linear program */
+    int		m;		/* Number of constraints */
+    int		n;		/* Number of variables (without slacks) */
+    double	*val;		/* Value of each variable (n+m) */
+    double	*lo;		/* Lower bound of each variable (n+m) */
+    double	*hi;		/* Upper bound of each variable (n+m) */
+    int		*head;		/* Basic variable of each row (m) */
+    int		*pos;		/* Row of each basic variable, or -1 (n+m) */
+    int		updates;	/* Basis changes since refactorisation */
+    int		refactors;	/* Number of refactorisations */
+    int		replaced;	/* Columns replaced by slack variables */
+    ETA_FILE	eta;		/* Inverse of the basis */
+  } SOLVER;
+
+
+/****************************************************************
+**  Forward declarations (compiler type checking)
+****************************************************************/
+
+#ifndef BSDUNIX
+void ftran ( ETA_FILE *, double [] );
+void btran ( ETA_FILE *, double [] );
+void add_eta ( ETA_FILE *, double [], int, int );
+void load_column ( SOLVER *, int, double [] );
+double reduced_cost ( SOLVER *, double [], int );
+void basic_values ( SOLVER *, double [] );
+BOOL refactor ( SOLVER *, double [] );
+#else
+void ftran ();
+void btran ();
+void add_eta ();
+void load_column ();
+double reduced_cost ();
+void basic_values ();
+BOOL refactor ();
+#endif
+
+
+/****************************************************************
+**  create_lp
+**
+**  Allocates a linear program.
+**
+**  IN  : rows     = number of constraints.
+**        cols     = number of variables.
+**        nonzeros = number of nonzero coefficients.
+**
+**  OUT : Function returns the program. The constants and the
+**        objective function are 0.0, the bounds are infinite.
+****************************************************************/
+
+LP create_lp
+     ( rows, cols, nonzeros )
+int
+  rows;
+int
+  cols;
+int
+  nonzeros;
+{
+  LP
+    lp;
+  int
+    k;
+
+  lp = (LP) malloc ( sizeof ( LP_STRUCT ) );
+  assert ( lp != NULL );
+  lp -> rows = rows;
+  lp -> cols = cols;
+  lp -> start = (int *) calloc ( cols + 1, sizeof ( int ) );
+  lp -> row = (int *) calloc ( nonzeros + 1, sizeof ( int ) );
+  lp -> coef = (double *) calloc ( nonzeros + 1, sizeof ( double ) );
+  lp -> konst = (double *) calloc ( rows + 1, sizeof ( double ) );
+  lp -> obj = (double *) calloc ( cols + 1, sizeof ( double ) );
+  lp -> lower = (double *) calloc ( cols + 1, sizeof ( double ) );
+  lp -> upper = (double *) calloc ( cols + 1, sizeof ( double ) );
+  assert ( ( lp -> start != NULL ) && ( lp -> row != NULL ) && 
+           ( lp -> coef != NULL ) && ( lp -> konst != NULL ) &&
+           ( lp -> obj != NULL ) && ( lp -> lower != NULL ) &&
+           ( lp -> upper != NULL ) );
+
+  for ( k = 0; k < cols; k ++ ) {
+    lp -> lower [k] = -HUGE_VAL;
+    lp -> upper [k] = HUGE_VAL;
+  }
+  return ( lp );
+}
+
+
+/****************************************************************
+**  destroy_lp
+**
+**  Frees a linear program.
+**
+**  IN  : lp = pointer to the program, which is set to NULL.
+****************************************************************/
+
+void destroy_lp
+       ( lp )
+LP
+  *lp;
+{
+  free ( (*lp) -> start );
+  free ( (*lp) -> row );
+  free ( (*lp) -> coef );
+  free ( (*lp) -> konst );
+  free ( (*lp) -> obj );
+  free ( (*lp) -> lower );
+  free ( (*lp) -> upper );
+  free ( *lp );
+  *lp = NULL;
+}
+
+
+/****************************************************************
+**  ftran, btran
+**
+**  Multiply a vector with the inverse of the basis B. Each eta
+**  vector E differs from the unit matrix only in its pivot
+**  column; B = inverse ( E[num-1] * .. * E[0] ).
+**
+**  IN  : e = eta file.
+**        v = vector of dimension m.
+**
+**  OUT : ftran: v := inverse ( B ) * v 
+**        btran: v := transpose ( inverse ( B ) ) * v
+****************************************************************/
+
+void ftran
+       ( e, v )
+ETA_FILE
+  *e;
+double
+  v [];
+{
+  int
+    j, k;
+  double
+    t;
+
+  for ( k = 0; k < e -> num; k ++ ) {
+    t = v [ e -> pivot [k] ];
+    if ( t == 0.0 ) continue;
+    v [ e -> pivot [k] ] = 0.0;
+    for ( j = e -> first [k]; j < e -> first [ k + 1 ]; j ++ ) {
+      v [ e -> index [j] ] += e -> value [j] * t;
+    }
+  }
+}
+
+
+void btran
+       ( e, v )
+ETA_FILE
+  *e;
+double
+  v [];
+{
+  int
+    j, k;
+  double
+    t;
+
+  for ( k = e -> num - 1; k >= 0; k -- ) {
+    t = 0.0;
+    for ( j = e -> first [k]; j < e -> first [ k + 1 ]; j ++ ) {
+      t += e -> value [j] * v [ e -> index [j] ];
+    }
+    v [ e -> pivot [k] ] = t;
+  }
+}
+
+
+/****************************************************************
+**  add_eta
+**
+**  Appends the eta vector which replaces the basis column in
+**  row p by a new column.
+**
+**  IN  : e     = eta file.
+**        alpha = new column multiplied by the inverse of the
+**                current basis (see ftran).
+**        p     = pivot row; alpha [p] must not be zero.
+**        m     = dimension of alpha.
+****************************************************************/
+
+void add_eta
+       ( e, alpha, p, m )
+ETA_FILE
+  *e;
+double
+  alpha [];
+int
+  p;
+int
+  m;
+{
+  int
+    i, k;
+  double
+    piv;
+
+  reserve ( (char **) &e -> pivot, &e -> pivot_size, 
+            ( e -> num + 1 ) * sizeof ( int ) );
+  reserve ( (char **) &e -> first, &e -> first_size, 
+            ( e -> num + 2 ) * sizeof ( int ) );
+  k = e -> first [ e -> num ];
+  reserve ( (char **) &e -> index, &e -> index_size, ( k + m ) * sizeof ( int ) );
+  reserve ( (char **) &e -> value, &e -> value_size, 
+            ( k + m ) * sizeof ( double ) );
+
+  /* The pivot element comes first, so that ftran may clear it */
+  piv = alpha [p];
+  e -> index [k] = p;
+  e -> value [k] = 1.0 / piv;
+  k ++;
+  for ( i = 0; i < m; i ++ ) {
+    if ( ( i != p ) && ( alpha [i] != 0.0 ) ) {
+      e -> index [k] = i;
+      e -> value [k] = - alpha [i] / piv;
+      k ++;
+    }
+  }
+  e -> pivot [ e -> num ] = p;
+  e -> num ++;
+  e -> first [ e -> num ] = k;
+}
+
+
+/****************************************************************
+**  load_column
+**
+**  Sets a vector to a column of the program. The constraints
+**  are written as  y[i] - sum ( k, a[ik]*x[k] ) = c[i]; the
+**  column of a variable x[k] holds the coefficients -a[ik],
+**  that of a slack variable y[i] (variable n+i) the unit
+**  vector e[i].
+**
+**  IN  : s = solver.
+**        j = variable (0..n+m-1).
+**
+**  OUT : v = column of variable j.
+****************************************************************/
+
+void load_column
+       ( s, j, v )
+SOLVER
+  *s;
+int
+  j;
+double
+  v [];
+{
+  LP
+    lp;
+  int
+    i;
+
+  lp = s -> lp;
+  for ( i = 0; i < s -> m; i ++ ) {
+    v [i] = 0.0;
+  }
+  if ( j < s -> n ) {
+    for ( i = lp -> start [j]; i < lp -> start [ j + 1 ]; i ++ ) {
+      v [ lp -> row [i] ] = - lp -> coef [i];
+    }
+  }
+  else {
+    v [ j - s -> n ] = 1.0;
+  }
+}
+
+
+/****************************************************************
+**  reduced_cost
+**
+**  IN  : s = solver.
+**        y = prices of the constraints (see btran).
+**        j = nonbasic variable.
+**
+**  OUT : Function returns the change of the objective function
+**        per unit increase of variable j.
+****************************************************************/
+
+double reduced_cost
+         ( s, y, j )
+SOLVER
+  *s;
+double
+  y [];
+int
+  j;
+{
+  LP
+    lp;
+  double
+    d;
+  int
+    i;
+
+  if ( j >= s -> n ) {
+    return ( - y [ j - s -> n ] );
+  }
+  lp = s -> lp;
+  d = lp -> obj [j];
+  for ( i = lp -> start [j]; i < lp -> start [ j + 1 ]; i ++ ) {
+    d += lp -> coef [i] * y [ lp -> row [i] ];
+  }
+  return ( d );
+}
+
+
+/****************************************************************
+**  basic_values
+**
+**  Calculates the values of the basic variables from those of
+**  the nonbasic variables.
+**
+**  IN  : s    = solver.
+**        work = vector of dimension m.
+****************************************************************/
+
+void basic_values
+       ( s, work )
+SOLVER
+  *s;
+double
+  work [];
+{
+  LP
+    lp;
+  int
+    i, j;
+
+  lp = s -> lp;
+  for ( i = 0; i < s -> m; i ++ ) {
+    work [i] = lp -> konst [i];
+  }
+  for ( j = 0; j < s -> n + s -> m; j ++ ) {
+    if ( s -> pos [j] >= 0 ) continue;
+    if ( j < s -> n ) {
+      for ( i = lp -> start [j]; i < lp -> start [ j + 1 ]; i ++ ) {
+        work [ lp -> row [i] ] += lp -> coef [i] * s -> val [j];
+      }
+    }
+    else {
+      work [ j - s -> n ] -= s -> val [j];
+    }
+  }
+  ftran ( &s -> eta, work );
+  for ( i = 0; i < s -> m; i ++ ) {
+    s -> val [ s -> head [i] ] = work [i];
+  }
+}
+
+
+/****************************************************************
+**  refactor
+**
+**  Rebuilds the eta file of the basis. The basic columns are
+**  eliminated one after the other, sparsest first, from the unit
+**  basis; each takes the row of a nonbasic slack variable with
+**  the largest element as its pivot. A column without a usable
+**  pivot (the basis is singular) leaves the basis at its current
+**  value, and the slack variable of the remaining row enters;
+**  these replacements are counted in s->replaced.
+**
+**  IN  : s    = solver.
+**        work = vector of dimension m.
+**
+**  OUT : The function returns FALSE if a basic variable of the
+**        new basis lies outside its bounds by more than FEAS_TOL
+**        (relative); the solution is then no longer feasible.
+****************************************************************/
+
+BOOL refactor
+       ( s, work )
+SOLVER
+  *s;
+double
+  work [];
+{
+  LP
+    lp;
+  int
+    *order,	/* basic columns, sorted by number of elements */
+    *count,	/* first position in 'order' by number of elements */
+    i, j, k, p, len, num;
+  double
+    max, lo, hi;
+
+  lp = s -> lp;
+  order = (int *) calloc ( s -> m + 1, sizeof ( int ) );
+  count = (int *) calloc ( s -> m + 2, sizeof ( int ) );
+  assert ( ( order != NULL ) && ( count != NULL ) );
+
+  /* Sort the basic columns by their number of elements */
+  num = 0;
+  for ( i = 0; i < s -> m; i ++ ) {
+    j = s -> head [i];
+    if ( j < s -> n ) {
+      count [ lp -> start [ j + 1 ] - lp -> start [j] + 1 ] ++;
+      num ++;
+    }
+  }
+  for ( len = 1; len <= s -> m; len ++ ) {
+    count [len] += count [ len - 1 ];
+  }
+  for ( i = 0; i < s -> m; i ++ ) {
+    j = s -> head [i];
+    if ( j < s -> n ) {
+      order [ count [ lp -> start [ j + 1 ] - lp -> start [j] ] ++ ] = j;
+      s -> pos [j] = -1;
+    }
+  }
+
+  /* Rows of the basic slack variables stay, the others are free */
+  for ( i = 0; i < s -> m; i ++ ) {
+    s -> head [i] = ( s -> pos [ s -> n + i ] >= 0 ) ? s -> n + i : -1;
+  }
+
+  s -> eta.num = 0;
+  for ( k = 0; k < num; k ++ ) {
+    j = order [k];
+    load_column ( s, j, work );
+    ftran ( &s -> eta, work );
+    p = -1;
+    max = PIVOT_TOL;
+    for ( i = 0; i < s -> m; i ++ ) {
+      if ( ( s -> head [i] < 0 ) && ( fabs ( work [i] ) > max ) ) {
+        p = i;
+        max = fabs ( work [i] );
+      }
+    }
+    if ( p >= 0 ) {
+      add_eta ( &s -> eta, work, p, s -> m );
+      s -> head [p] = j;
+      s -> pos [j] = p;
+    }
+    else {
+      s -> replaced ++;
+    }
+  }
+
+  /* Fill remaining rows with their slack variables */
+  for ( i = 0; i < s -> m; i ++ ) {
+    if ( s -> head [i] < 0 ) {
+      s -> head [i] = s -> n + i;
+      s -> pos [ s -> n + i ] = i;
+    }
+  }
+
+  basic_values ( s, work );
+  s -> updates = 0;
+  s -> refactors ++;
+  free ( order );
+  free ( count );
+
+  /* The basic variables must still lie within their bounds */
+  for ( i = 0; i < s -> m; i ++ ) {
+    j = s -> head [i];
+    lo = s -> lo [j];
+    hi = s -> hi [j];
+    if ( ( s -> val [j] < lo - FEAS_TOL * ( 1.0 + fabs ( lo ) ) ) ||
+         ( s -> val [j] > hi + FEAS_TOL * ( 1.0 + fabs ( hi ) ) ) ) {
+      fprintf ( stderr, "refactor: variable %d out of bounds, val %f\n",
+                j + 1, s -> val [j] );
+      return ( FALSE );
+    }
+  }
+  return ( TRUE );
+}
+
+
+/****************************************************************
+**  revised_simplex
+**
+**  Solves a linear program (see revsimp.h) with the revised
+**  simplex method.
+**
+**  IN  : lp = linear program.
+**        x  = initial solution, which must satisfy all
+**             constraints. Values outside the bounds are moved
+**             to the bounds.
+**
+**  OUT : If the program has a solution, then x contains the
+**        optimal values of the n variables and the function
+**        returns TRUE. Otherwise, the function returns FALSE
+**        and the contents of x are invalid.
+****************************************************************/
+
+BOOL revised_simplex
+       ( lp, x )
+LP
+  lp;
+double
+  x [];
+{
+  SOLVER
+    s;
+  double
+    *y,		/* prices of the constraints */
+    *alpha,	/* column of the entering variable */
+    d, dq, dir, t, a, quot, max;
+  int
+    i, j, k, m, n, p, q,
+    iterations, flips,
+    degenerate;	/* number of consecutive steps of length 0 */
+  BOOL
+    bland,
+    feasible;	/* FALSE if refactorisation lost feasibility */
+
+  m = lp -> rows;
+  n = lp -> cols;
+  s.lp = lp;
+  s.m = m;
+  s.n = n;
+  s.val = (double *) calloc ( n + m, sizeof ( double ) );
+  s.lo = (double *) calloc ( n + m, sizeof ( double ) );
+  s.hi = (double *) calloc ( n + m, sizeof ( double ) );
+  s.head = (int *) calloc ( m + 1, sizeof ( int ) );
+  s.pos = (int *) calloc ( n + m, sizeof ( int ) );
+  y = (double *) calloc ( m + 1, sizeof ( double ) );
+  alpha = (double *) calloc ( m + 1, sizeof ( double ) );
+  assert ( ( s.val != NULL ) && ( s.lo != NULL ) && ( s.hi != NULL ) &&
+           ( s.head != NULL ) && ( s.pos != NULL ) && ( y != NULL ) &&
+           ( alpha != NULL ) );
+  s.updates = s.refactors = s.replaced = 0;
+  s.eta.num = 0;
+  s.eta.pivot = s.eta.first = s.eta.index = NULL;
+  s.eta.value = NULL;
+  s.eta.pivot_size = s.eta.first_size = 0;
+  s.eta.index_size = s.eta.value_size = 0;
+  reserve ( (char **) &s.eta.first, &s.eta.first_size, sizeof ( int ) );
+  s.eta.first [0] = 0;
+
+  /* The variables are nonbasic at their initial values; the
+     slack variables form the initial basis */
+  for ( j = 0; j < n; j ++ ) {
+    assert ( lp -> lower [j] <= lp -> upper [j] );
+    s.lo [j] = lp -> lower [j];
+    s.hi [j] = lp -> upper [j];
+    s.val [j] = x [j];
+    if ( s.val [j] < s.lo [j] ) s.val [j] = s.lo [j];
+    if ( s.val [j] > s.hi [j] ) s.val [j] = s.hi [j];
+    s.pos [j] = -1;
+  }
+  for ( i = 0; i < m; i ++ ) {
+    s.lo [ n + i ] = 0.0;
+    s.hi [ n + i ] = HUGE_VAL;
+    s.head [i] = n + i;
+    s.pos [ n + i ] = i;
+  }
+  basic_values ( &s, y );
+
+  /* The initial solution must satisfy the constraints */
+  for ( i = 0; i < m; i ++ ) {
+    if ( s.val [ n + i ] < 0.0 ) {
+      fprintf ( stderr, "Warning: inaccuracy, row %d, val %f\n", i + 1,
+                s.val [ n + i ] );
+      lp -> konst [i] -= s.val [ n + i ];
+      s.val [ n + i ] = 0.0;
+    }
+  }
+
+  iterations = flips = degenerate = 0;
+  bland = FALSE;
+  feasible = TRUE;
+  do {
+    if ( ( s.updates >= REFACTOR ) && ( ! refactor ( &s, y ) ) ) {
+      feasible = FALSE;
+      break;
+    }
+
+    /* Step 'PIV': find the nonbasic variable with the largest
+       reduced cost which may still move in its direction */
+    for ( i = 0; i < m; i ++ ) {
+      j = s.head [i];
+      y [i] = ( j < n ) ? lp -> obj [j] : 0.0;
+    }
+    btran ( &s.eta, y );
+
+    q = -1;
+    dq = max = 0.0;
+    for ( j = 0; j < n + m; j ++ ) {
+      if ( s.pos [j] >= 0 ) continue;
+      d = reduced_cost ( &s, y, j );
+      if ( ( ( d > DUAL_TOL ) && ( s.val [j] < s.hi [j] ) ) ||
+           ( ( d < -DUAL_TOL ) && ( s.val [j] > s.lo [j] ) ) ) {
+        if ( fabs ( d ) > max ) {
+          q = j;
+          dq = d;
+          max = fabs ( d );
+          if ( bland ) break;
+        }
+      }
+    }
+
+    /* Exit loop if no variable improves the objective function */
+    if ( q < 0 ) break;
+    dir = ( dq > 0.0 ) ? 1.0 : -1.0;
+
+    /* Ratio test: the basic variable which first reaches a bound
+       as q moves by t in direction dir. If q reaches its own
+       other bound first, p remains -1. */
+    load_column ( &s, q, alpha );
+    ftran ( &s.eta, alpha );
+    t = ( dir > 0.0 ) ? s.hi [q] - s.val [q] : s.val [q] - s.lo [q];
+    p = -1;
+    for ( i = 0; i < m; i ++ ) {
+      a = dir * alpha [i];
+      k = s.head [i];
+      if ( ( a > PIVOT_TOL ) && ( s.lo [k] != -HUGE_VAL ) ) {
+        quot = ( s.val [k] - s.lo [k] ) / a;
+      }
+      else if ( ( a < -PIVOT_TOL ) && ( s.hi [k] != HUGE_VAL ) ) {
+        quot = ( s.hi [k] - s.val [k] ) / -a;
+      }
+      else {
+        continue;
+      }
+      if ( quot < 0.0 ) quot = 0.0;
+
+      /* Of equal steps, take the largest pivot element (or the
+         lowest variable with Bland's rule) */
+      if ( ( quot < t ) || 
+           ( ( quot == t ) && ( p >= 0 ) &&
+             ( bland ? ( k < s.head [p] ) : 
+                       ( fabs ( alpha [i] ) > fabs ( alpha [p] ) ) ) ) ) {
+        p = i;
+        t = quot;
+      }
+    }
+
+    /* If t is infinite, the system does not have a solution! */
+    if ( t == HUGE_VAL ) break;
+
+    /* Move q and the basic variables */
+    s.val [q] += dir * t;
+    for ( i = 0; i < m; i ++ ) {
+      if ( alpha [i] != 0.0 ) {
+        s.val [ s.head [i] ] -= dir * t * alpha [i];
+      }
+    }
+    degenerate = ( t == 0.0 ) ? degenerate + 1 : 0;
+    bland = ( degenerate >= DEGEN_LIMIT );
+
+    if ( p < 0 ) {
+      /* q changes its bound */
+      s.val [q] = ( dir > 0.0 ) ? s.hi [q] : s.lo [q];
+      flips ++;
+      continue;
+    }
+
+    /* Step 'AT': q replaces the basic variable of row p, which
+       leaves at the bound it has reached */
+    k = s.head [p];
+    s.val [k] = ( dir * alpha [p] > 0.0 ) ? s.lo [k] : s.hi [k];
+    s.pos [k] = -1;
+    s.head [p] = q;
+    s.pos [q] = p;
+    add_eta ( &s.eta, alpha, p, m );
+    s.updates ++;
+    iterations ++;
+  } while ( TRUE );   /* = endless loop */
+
+  /* Step 'LOES' */
+  for ( j = 0; j < n; j ++ ) {
+    x [j] = s.val [j];
+  }
+
+  fprintf ( stderr, "Iterations: %d, bound changes: %d, refactorisations: %d "
+            "(singular columns replaced: %d)\n",
+            iterations, flips, s.refactors, s.replaced );
+
+  free ( s.val );
+  free ( s.lo );
+  free ( s.hi );
+  free ( s.head );
+  free ( s.pos );
+  free ( y );
+  free ( alpha );
+  free ( s.eta.pivot );
+  free ( s.eta.first );
+  free ( s.eta.index );
+  free ( s.eta.value );
+  return ( feasible && ( q < 0 ) );
+}
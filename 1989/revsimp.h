@@ -0,0 +1,77 @@
+/****************************************************************
+*
+*           S O F T W A R E   S O U R C E   F I L E
+*
+*****************************************************************
+*
+*   Name of file   : revsimp.h
+*   Author         : Guido Hoss
+*   Project        : ETH Diploma Thesis (SS 1989)
+*   Creation Date  : 12/05/89
+*   Type of file   : C Header File
+*
+*****************************************************************
+*
+*   COPYRIGHT (C) 1989, 2016 BY GUIDO HOSS.
+*
+*   This program is free software: you can redistribute it and/or 
+*   modify it under the terms of the GNU General Public License
+*   as published by the Free Software Foundation, either version 3
+*   of the License, or (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public
+*   License along with this program.  If not, see
+*   <http://www.gnu.org/licenses/>.
+*
+*   Git repository home: <https://github.com/ghoss/Thesis>
+*
+*****************************************************************
+* Date        :
+* Description :
+****************************************************************/   
+
+/* A linear program in the form used by the simplex procedure of
+   simplex.c: maximize
+
+      z = sum ( k=1..n, b[k]*x[k] )
+
+   subject to the m constraints
+
+      y[i] = sum ( k=1..n, a[ik]*x[k] ) + c[i] >= 0   (i=1..m)
+
+   and the bounds lower[k] <= x[k] <= upper[k]. Infinite bounds
+   are given as -HUGE_VAL and HUGE_VAL. The matrix a is stored
+   by columns, and only its nonzero elements: column k consists
+   of the coefficients coef [j] in rows row [j] (counted from 0),
+   for start [k] <= j < start [k+1]. */
+
+typedef
+  struct {
+    int		rows;		/* Number of constraints m */
+    int		cols;		/* Number of variables n */
+    int		*start;		/* First element of each column (n+1) */
+    int		*row;		/* Row of each element */
+    double	*coef;		/* Value of each element */
+    double	*konst;		/* Constants c[i] (m) */
+    double	*obj;		/* Objective function b[k] (n) */
+    double	*lower;		/* Lower bounds (n) */
+    double	*upper;		/* Upper bounds (n) */
+  } LP_STRUCT;
+
+typedef
+  LP_STRUCT *LP;
+
+#ifndef BSDUNIX
+LP create_lp ( int, int, int );
+void destroy_lp ( LP * );
+BOOL revised_simplex ( LP, double [] );
+#else
+LP create_lp ();
+void destroy_lp ();
+BOOL revised_simplex ();
+#endif
@@ -0,0 +1,240 @@
+/****************************************************************
+*
+*           S O F T W A R E   S O U R C E   F I L E
+*
+*****************************************************************
+*
+*   Name of file   : rsvkern.c
+*   Author         : Guido Hoss
+*   Project        : ETH Diploma Thesis (SS 1989)
+*   Creation Date  : 11/05/89
+*   Type of file   : C Language File
+*
+*   Description
+*   -----------
+*   Kernels for the RSV values of a query with dense concept
+*   vectors of documents, see rsvkern.h.
+*
+*****************************************************************
+*
+*   COPYRIGHT (C) 1989, 2016 BY GUIDO HOSS.
+*
+*   This program is free software: you can redistribute it and/or 
+*   modify it under the terms of the GNU General Public License
+*   as published by the Free Software Foundation, either version 3
+*   of the License, or (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public
+*   License along with this program.  If not, see
+*   <http://www.gnu.org/licenses/>.
+*
+*   Git repository home: <https://github.com/ghoss/Thesis>
+*
+*****************************************************************
+* Date        :
+* Description :
+****************************************************************/   
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "rsvkern.h"
+
+/* SIMD kernels need the vector extensions of GNU C on x86-64 */
+#if defined ( __GNUC__ ) && defined ( __x86_64__ ) && ! defined ( NO_SIMD )
+#define SIMD_KERNELS
+#include <immintrin.h>
+#endif
+
+
+/****************************************************************
+**  Forward declarations (compiler type checking)
+****************************************************************/
+
+#ifdef SIMD_KERNELS
+__attribute__ (( target ( "avx2" ) ))
+void dense_avx2 ( int, int *, int *, double *, double *, double *, 
+                  double * );
+__attribute__ (( target ( "avx512f" ) ))
+void dense_avx512 ( int, int *, int *, double *, double *, double *, 
+                    double * );
+#endif
+
+
+/****************************************************************
+**  dense_scalar
+**
+**  Scalar kernel, used on all processors.
+**
+**  IN  : num   = number of documents.
+**        first = first [j] is the position of the first concept
+**                of document j (num + 1 entries).
+**        atom  = concepts of the documents.
+**        wgt   = weights of the concepts.
+**        qw    = weight of each concept in the query.
+**        aw    = weight of each concept.
+**
+**  OUT : rsv [j] is the RSV of document j.
+****************************************************************/
+
+void dense_scalar
+       ( num, first, atom, wgt, qw, aw, rsv )
+int
+  num;
+int
+  *first, *atom;
+double
+  *wgt, *qw, *aw, *rsv;
+{
+  double
+    s;
+  int
+    i, j, a;
+
+  for ( j = 0; j < num; j ++ ) {
+    s = 0.0;
+    for ( i = first [j]; i < first [ j + 1 ]; i ++ ) {
+      a = atom [i];
+      s += ( qw [a] * wgt [i] * aw [a] );
+    }
+    rsv [j] = s;
+  }
+}
+
+
+#ifdef SIMD_KERNELS
+
+/****************************************************************
+**  dense_avx2, dense_avx512
+**
+**  SIMD kernels (same parameters as dense_scalar). Each lane
+**  walks the concepts of one document; lanes whose document
+**  has no more concepts add 0.0. The remaining documents are
+**  left to the scalar kernel.
+****************************************************************/
+
+__attribute__ (( target ( "avx2" ) ))
+void dense_avx2
+       ( num, first, atom, wgt, qw, aw, rsv )
+int
+  num;
+int
+  *first, *atom;
+double
+  *wgt, *qw, *aw, *rsv;
+{
+  __m128i
+    pos, end, act, a, one;
+  __m256d
+    sum, m, w, q, x, zero;
+  int
+    j;
+
+  one = _mm_set1_epi32 ( 1 );
+  zero = _mm256_setzero_pd ();
+  for ( j = 0; j + 4 <= num; j += 4 ) {
+    pos = _mm_loadu_si128 ( (__m128i *) ( first + j ) );
+    end = _mm_loadu_si128 ( (__m128i *) ( first + j + 1 ) );
+    sum = zero;
+    act = _mm_cmplt_epi32 ( pos, end );
+    while ( _mm_movemask_epi8 ( act ) != 0 ) {
+      m = _mm256_castsi256_pd ( _mm256_cvtepi32_epi64 ( act ) );
+      a = _mm_mask_i32gather_epi32 ( _mm_setzero_si128 (), atom, pos, act, 4 );
+      w = _mm256_mask_i32gather_pd ( zero, wgt, pos, m, 8 );
+      q = _mm256_mask_i32gather_pd ( zero, qw, a, m, 8 );
+      x = _mm256_mask_i32gather_pd ( zero, aw, a, m, 8 );
+      sum = _mm256_add_pd ( sum, _mm256_mul_pd ( _mm256_mul_pd ( q, w ), x ) );
+      pos = _mm_add_epi32 ( pos, one );
+      act = _mm_cmplt_epi32 ( pos, end );
+    }
+    _mm256_storeu_pd ( rsv + j, sum );
+  }
+  dense_scalar ( num - j, first + j, atom, wgt, qw, aw, rsv + j );
+}
+
+
+__attribute__ (( target ( "avx512f" ) ))
+void dense_avx512
+       ( num, first, atom, wgt, qw, aw, rsv )
+int
+  num;
+int
+  *first, *atom;
+double
+  *wgt, *qw, *aw, *rsv;
+{
+  __m512i
+    pos, end, one;
+  __m256i
+    a;
+  __m512d
+    sum, w, q, x, zero;
+  __mmask8
+    act;
+  int
+    j;
+
+  one = _mm512_set1_epi64 ( 1 );
+  zero = _mm512_setzero_pd ();
+  for ( j = 0; j + 8 <= num; j += 8 ) {
+    pos = _mm512_cvtepi32_epi64 ( _mm256_loadu_si256 ( (__m256i *) ( first + j ) ) );
+    end = _mm512_cvtepi32_epi64 ( _mm256_loadu_si256 ( (__m256i *) ( first + j + 1 ) ) );
+    sum = zero;
+    act = _mm512_cmplt_epi64_mask ( pos, end );
+    while ( act != 0 ) {
+      a = _mm512_mask_i64gather_epi32 ( _mm256_setzero_si256 (), act, pos, atom, 4 );
+      w = _mm512_mask_i64gather_pd ( zero, act, pos, wgt, 8 );
+      q = _mm512_mask_i32gather_pd ( zero, act, a, qw, 8 );
+      x = _mm512_mask_i32gather_pd ( zero, act, a, aw, 8 );
+      sum = _mm512_mask_add_pd ( sum, act, sum, 
+                                 _mm512_mul_pd ( _mm512_mul_pd ( q, w ), x ) );
+      pos = _mm512_add_epi64 ( pos, one );
+      act = _mm512_cmplt_epi64_mask ( pos, end );
+    }
+    _mm512_storeu_pd ( rsv + j, sum );
+  }
+  dense_scalar ( num - j, first + j, atom, wgt, qw, aw, rsv + j );
+}
+
+#endif
+
+
+/****************************************************************
+**  select_kernel
+**
+**  Selects the fastest kernel the processor supports.
+**
+**  OUT : Function returns the kernel; *name is set to its name.
+****************************************************************/
+
+RSV_KERNEL select_kernel
+             ( name )
+char
+  **name;
+{
+  char
+    *s;
+
+  s = getenv ( "RSV_KERNEL" );
+  if ( s == NULL ) s = "avx512";
+#ifdef SIMD_KERNELS
+  __builtin_cpu_init ();
+  if ( ( strcmp ( s, "avx512" ) == 0 ) && __builtin_cpu_supports ( "avx512f" ) ) {
+    *name = "avx512";
+    return ( dense_avx512 );
+  }
+  if ( ( ( strcmp ( s, "avx512" ) == 0 ) || ( strcmp ( s, "avx2" ) == 0 ) ) &&
+       __builtin_cpu_supports ( "avx2" ) ) {
+    *name = "avx2";
+    return ( dense_avx2 );
+  }
+#endif
+  *name = "scalar";
+  return ( dense_scalar );
+}
@@ -0,0 +1,67 @@
+/****************************************************************
+*
+*           S O F T W A R E   S O U R C E   F I L E
+*
+*****************************************************************
+*
+*   Name of file   : rsvkern.h
+*   Author         : Guido Hoss
+*   Project        : ETH Diploma Thesis (SS 1989)
+*   Creation Date  : 11/05/89
+*   Type of file   : C Header File
+*
+*****************************************************************
+*
+*   COPYRIGHT (C) 1989, 2016 BY GUIDO HOSS.
+*
+*   This program is free software: you can redistribute it and/or 
+*   modify it under the terms of the GNU General Public License
+*   as published by the Free Software Foundation, either version 3
+*   of the License, or (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public
+*   License along with this program.  If not, see
+*   <http://www.gnu.org/licenses/>.
+*
+*   Git repository home: <https://github.com/ghoss/Thesis>
+*
+*****************************************************************
+* Date        :
+* Description :
+****************************************************************/   
+
+/* A scoring kernel calculates the RSV values of a range of
+   documents with one query. The documents are given as concept
+   vectors: the concepts of document j are atom [i] with weights
+   wgt [i], for first [j] <= i < first [j+1], in increasing order.
+   The query is scattered into a dense array qw, which holds the
+   weight of each concept in the query (0.0 if it does not occur);
+   aw holds the weight of each concept. The RSV of document j is
+
+      rsv [j] = sum of qw [a] * wgt [i] * aw [a],  a = atom [i],
+
+   added in the order of the concepts. All kernels give exactly the
+   same values: the SIMD kernels process several documents at a
+   time, one per vector lane, so every sum is still formed in the
+   same order. The kernel is selected at run time by the features
+   of the processor; the environment variable RSV_KERNEL (scalar,
+   avx2 or avx512) limits the choice. */
+
+#ifndef BSDUNIX
+typedef void ( *RSV_KERNEL ) ( int, int *, int *, double *, double *, 
+                               double *, double * );
+
+void dense_scalar ( int, int *, int *, double *, double *, double *, 
+                    double * );
+RSV_KERNEL select_kernel ( char ** );
+#else
+typedef void ( *RSV_KERNEL ) ();
+
+void dense_scalar ();
+RSV_KERNEL select_kernel ();
+#endif
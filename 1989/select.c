@@ -60,24 +60,23 @@
 
 #include "boolean.h"
 #include "list.h"
+#include "intlist.h"
 #include "util.h"
+#include "reader.h"
+#include "atomidx.h"
 
-#define LINE_LENGTH	100
 
 typedef 
   struct {
     int		doc;		/* Document or query number */
-    LIST	concepts;	/* List of contained atomic concepts */
+    INTLIST	concepts;	/* List of contained atomic concepts */
   } DOC_STRUCT;
 
-typedef
-  struct {
-    int		atom;		/* Atom number */
-  } ATOM_STRUCT;
 
+INTLIST
+  glob_temp;	/* Common negative concepts of a preference */
 
 LIST
-  glob_temp,
   query_list,	/* Queries and their concepts */
   doc_list;	/* Normal documents and their concepts */
 
@@ -91,69 +90,26 @@ FILE
 
 #ifndef BSDUNIX
 int main ( int, char * [] );
-void read_concepts ( FILE * );
-void read_prefs ( FILE * );
-BOOL enum_primary ( ELEMENT, ELEMENT );
-void add_atom ( LIST, int );
+void read_concepts ( ATOM_INDEX );
+void read_prefs ( READER );
+BOOL enum_primary ( int );
 int comp_doc ( ELEMENT, ELEMENT );
-int comp_atom ( ELEMENT, ELEMENT );
 #else
 int main ();
 void read_concepts ();
 void read_prefs ();
 BOOL enum_primary ();
-void add_atom ();
 int comp_doc ();
-int comp_atom ();
 #endif
 
 
-/****************************************************************
-**  add_atom
-**
-**  Adds an atomic concept to a specified list.
-**
-**  IN  : list = Handle to created list.
-**        atom = Number of atom to add to list.
-****************************************************************/   
-
-int comp_atom
-      ( a1, a2 )
-ELEMENT
-  a1;
-ELEMENT
-  a2;
-{
-  return ( ((ATOM_STRUCT *) a1) -> atom - ((ATOM_STRUCT *) a2) -> atom );
-}
-
-
-void add_atom
-       ( list, atom )
-LIST
-  list;
-int
-  atom;
-{
-  ATOM_STRUCT
-    *atm;
-  
-  atm = (ATOM_STRUCT *) malloc ( sizeof ( ATOM_STRUCT ) );
-  assert ( atm != NULL );
-  
-  atm -> atom = atom;
-  atm = (ATOM_STRUCT *) add_list ( list, (ELEMENT) atm, comp_atom );
-  assert ( atm != NULL );
-}
-
-
 /****************************************************************
 **  read_concepts
 **
 **  Reads ATOM_DOCS file. Builds inverted list "doc -> concept"
 **  for documents and queries.
 **
-**  IN  : f = handle to open ATOM_DOCS file.
+**  IN  : x = atom index (ATOM_DOCS file).
 ****************************************************************/   
 
 int comp_doc
@@ -168,34 +124,39 @@ ELEMENT
 
 
 void read_concepts
-       ( f )
-FILE
-  *f;
+       ( x )
+ATOM_INDEX
+  x;
 {
-  char
-    line [ LINE_LENGTH ];
   DOC_STRUCT
     *curr_doc;
+  POSTINGS
+    p;
   int
     curr_atom,
-    d, n;
+    totaldocs,
+    i, d;
+
+  /* The index knows the total number of documents */
+  totaldocs = index_docs ( x );
 
   /* Create empty lists */
-  doc_list = create_list ();
+  doc_list = create_list_sized ( totaldocs );
   assert ( doc_list != NULL );
   query_list = create_list ();
   assert ( query_list != NULL );
-  
-  /* Ignore first line of ATOM_DOCS */
-  fgets ( line, LINE_LENGTH, f );
 
-  /* Read ATOM_DOCS file, line by line */
-  while ( fgets ( line, LINE_LENGTH, f ) ) {
+  /* Read ATOM_DOCS file, one concept at a time */
+  for ( i = 0; i < index_atoms ( x ); i ++ ) {
+    curr_atom = index_atom ( x, i );
+      
+    /* Running count */
+    fprintf ( counter, "%d\r", curr_atom );
   
-    n = sscanf ( line, " %d", &d );
-    assert ( n == 1 );
-    
-    if ( strchr ( line, ':' ) == NULL ) {
+    open_postings ( x, i, &p );
+    while ( next_posting ( &p ) ) {
+      d = p.doc;
+
       /* Number of new document */
       curr_doc = (DOC_STRUCT *) malloc ( sizeof ( DOC_STRUCT ) );
       assert ( curr_doc != NULL );
@@ -215,18 +176,10 @@ FILE
       }
       assert ( curr_doc != NULL );
       if ( curr_doc -> concepts == NULL ) {
-        curr_doc -> concepts = create_list ();
-        assert ( curr_doc -> concepts != NULL );
+        curr_doc -> concepts = create_intlist ( 0 );
       }
 
-      add_atom ( curr_doc -> concepts, curr_atom );
-    }
-    else {
-      /* Number of concept */
-      curr_atom = d;
-      
-      /* Running count */
-      fprintf ( counter, "%d\r", d );
+      add_intlist ( curr_doc -> concepts, curr_atom );
     }
   }
   
@@ -239,25 +192,18 @@ FILE
 **
 **  Reads preferences and checks each one for common concepts.
 **
-**  IN  : f = handle to open EVAL_PREF file.
+**  IN  : r = reader of EVAL_PREF file.
 ****************************************************************/   
 
 BOOL enum_primary
-       ( a1, a2 )
-ELEMENT
-  a1;
-ELEMENT
-  a2;
+       ( atom )
+int
+  atom;
 {
-  int
-    atom;
-  
-  atom = ((ATOM_STRUCT *) a1) -> atom;
-  
   /* Add each common atomic concept to glob_temp if
      the atom is negative (negative atoms will be optimized) */
   if ( atom < 0 ) {
-    add_atom ( glob_temp, atom );
+    add_intlist ( glob_temp, atom );
   }
   
   return ( TRUE );
@@ -265,13 +211,12 @@ ELEMENT
 
 
 void read_prefs
-       ( f )
-FILE
-  *f;
+       ( r )
+READER
+  r;
 {
   char
-    type,
-    line [ LINE_LENGTH ];
+    type;
   int
     q, d1, d2, n, i;
   DOC_STRUCT
@@ -279,12 +224,14 @@ FILE
     *doc1, *doc2;
 
   i = 0;
+  glob_temp = create_intlist ( 0 );
 
   /* Read EVAL_PREF file, line by line */
-  while ( fgets ( line, LINE_LENGTH, f ) ) {
+  while ( read_line ( r ) ) {
   
-    n = sscanf ( line, " %c %d %d %d", &type, &q, &d1, &d2 );
-    assert ( n == 4 );
+    n = get_char ( r, &type ) && get_int ( r, &q ) && get_int ( r, &d1 ) &&
+        get_int ( r, &d2 );
+    assert ( n );
     
     if ( type == 'C' ) {
       /* Ignore preferences which are just necessary for cost function */
@@ -304,27 +251,25 @@ FILE
     assert ( doc1 != NULL );
     assert ( doc2 != NULL );
     
-    glob_temp = create_list ();
-    assert ( glob_temp != NULL );
+    clear_intlist ( glob_temp );
 
     /* Find union of negative concepts in query and doc1 */
-    find_union ( query -> concepts, doc1 -> concepts, comp_atom, enum_primary );
+    find_union_int ( query -> concepts, doc1 -> concepts, enum_primary );
     
     /* Find union of concepts in query and doc2 */
-    find_union ( query -> concepts, doc2 -> concepts, comp_atom, enum_primary );
+    find_union_int ( query -> concepts, doc2 -> concepts, enum_primary );
     
-    if ( count_list ( glob_temp ) > 0 ) {
+    if ( count_intlist ( glob_temp ) > 0 ) {
       /* Print preference */
       printf ( "%c\t%d\t%d\t%d\n", type, q, d1, d2 );
     }
-    
-    destroy_list ( &glob_temp );
 
     /* Running count */
     i ++;
     fprintf ( counter, "%d\r", i );
   }
 
+  destroy_intlist ( &glob_temp );
   fprintf ( counter, "\n" );
 }
 
@@ -340,8 +285,10 @@ int
 char
   *argv [];
 {
-  FILE
-    *f;
+  READER
+    r;
+  ATOM_INDEX
+    x;
     
   /* Program title */
   fprintf ( stderr, PROG );
@@ -363,14 +310,15 @@ char
   
   /* Read list of atomic concepts */
   fprintf ( stderr, "Reading atomic concepts.\n" );
-  f = open_file ( argv [1] );
-  read_concepts ( f );
-  fclose ( f );
+  x = open_index ( argv [1] );
+  read_concepts ( x );
+  close_index ( &x );
   
   /* Read preferences */
   fprintf ( stderr, "Reading preferences.\n" );
-  read_prefs ( stdin );
-  fclose ( f );
+  r = stream_reader ( stdin );
+  read_prefs ( r );
+  close_reader ( &r );
   
   return ( 0 );
 }
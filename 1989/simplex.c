@@ -21,6 +21,7 @@
 *   Call Format
 *   -----------
 *	optimize <eval-pref> <doc-descr> <concepts> <atom-docs>
+*		 [--revised | --bounded | --stable | --refine] [QUIET]
 *
 *   where <eval-pref> is the file containing the satisfied and
 *   unsatisfied preferences, <doc-descr> contains the weights of
@@ -30,6 +31,45 @@
 *
 *   The optimized weights are written to the standard output.
 *
+*   With --revised, the problem is solved by the revised simplex
+*   method on its sparse constraint matrix (see revsimp.h), with
+*   the bounds of the weights handled as such instead of as
+*   constraint rows. This needs far less memory and time for
+*   large numbers of weights; an optimal solution is found as
+*   well, though not necessarily the same one if the optimum is
+*   not unique.
+*
+*   Otherwise, the simplex tableau is held in one block of memory,
+*   row by row, and the pivot steps are done by the kernels in
+*   pivkern.h, which use the vector instructions of the processor
+*   if available. The results are the same on all processors.
+*   By default, the tableau has a row for each minimum and
+*   maximum weight (4.2, 4.3). With --bounded, these 2n rows are
+*   left out: the weights are bounded variables, whose bounds are
+*   observed by the ratio test (see 'ratio_row'). The tableau
+*   is then about 2n rows smaller, and each pivot step cheaper;
+*   the pivot steps differ, so the solution may differ from the
+*   default one if the optimum is not unique.
+*
+*   If compiled with THREADS, the rows of a pivot step are updated
+*   by several threads (see 'thread_count') in blocks of rows, and
+*   the search for the pivot column and row is divided among them
+*   as well. Ties are resolved as in the sequential version, so
+*   the results are the same. Small tableaus are processed by a
+*   single thread.
+*
+*   The tableau is calculated in float, or in double or long
+*   double if compiled with DOUBLE or LONG_DOUBLE (see Makefile,
+*   PRECISION). With --stable, the pivot row is chosen by the
+*   ratio test of Harris, with tolerances, among the rows which
+*   are nearly as restrictive as the textbook's; slightly negative
+*   constants are set to 0.0 without warning. The tableau is also
+*   calculated again from the original equations every few pivot
+*   steps and at the end (see 'refactor_tableau'). --refine does
+*   the same, and improves each row of this calculation by a step
+*   of iterative refinement. The number of such corrections is
+*   reported at the end.
+*
 *   If the string QUIET is specified as the last parameter,
 *   running counts are not written to the screen.
 *
@@ -59,7 +99,7 @@
 ****************************************************************/   
 
 #define PROG	"Atomic Concept Weight Optimization (gh, 04/05/89)\n"
-#define USAGE	"optimize <eval-pref> <doc-descr> <concepts> <atom-wgts> [QUIET]\n"
+#define USAGE	"optimize <eval-pref> <doc-descr> <concepts> <atom-wgts>\n\t[--revised | --bounded | --stable | --refine] [QUIET]\n"
 
 #ifdef MSDOS
 #include <process.h>
@@ -69,12 +109,18 @@
 #include <math.h>
 #include <malloc.h>
 #include <string.h>
+#ifdef THREADS
+#include <pthread.h>
+#endif
 
 #include "boolean.h"
 #include "list.h"
 #include "util.h"
+#include "reader.h"
+#include "descr.h"
+#include "revsimp.h"
+#include "pivkern.h"
 
-#define LINE_LENGTH	100
 
 
 /* Low and high bounds of atomic concept weights */
@@ -86,6 +132,30 @@
 /* Natural logarithm of 2.0 */
 #define log_2	log ( 2.0 )
 
+/* Parallel pivot steps (see 'start_team') */
+#define BLOCK_BYTES	32768L	/* size of a block of rows */
+#define MIN_PARALLEL	262144L	/* tableau elements for more threads */
+
+/* Jobs of the threads in a pivot step (see 'run_share') */
+#define JOB_UPDATE	1	/* update the rows with the pivot row */
+#define JOB_PIV		2	/* search the pivot column */
+#define JOB_RATIO	3	/* search the pivot row */
+#define JOB_HARRIS	4	/* search the pivot row, second pass */
+#define JOB_REFACTOR	5	/* calculate the rows again */
+#define JOB_QUIT	6	/* terminate the thread */
+
+/* Tolerances of the stable mode (--stable) */
+#if defined ( DOUBLE ) || defined ( LONG_DOUBLE )
+#define TOL_FEAS	1.0e-9	/* constants of rows */
+#define TOL_PIVOT	1.0e-11	/* elements of the pivot column */
+#else
+#define TOL_FEAS	1.0e-5
+#define TOL_PIVOT	1.0e-7
+#endif
+
+/* Pivot steps between two refactorisations, per weight */
+#define REFACTOR	2
+
 
 typedef
   struct {
@@ -127,29 +197,116 @@ LIST
   atom_list,   /* all atomic concepts and their matrix indices */
   sign_list;   /* signs used in documents in the EVAL_PREF file */
 
+ARENA
+  sign_arena,   /* elements of 'sign_list' and its atom lists */
+  unused_arena; /* elements of 'unused_wgts' */
+
 int
   serial,	/* used by 'make_docatoms' */
   num_prefs,	/* number of preferences in EVAL_PREF file */
   num_weights;	/* number of weights to optimize */
 
 /* Optimization matrix */
+REAL
+  *tableau,	/* rows of the matrix, see make_tableau */
+  *original;	/* matrix before elimination (--stable) */
+
+/* RSV equations of the revised method (--revised), by rows:
+   equation i has the elements eq_start[i]..eq_start[i+1]-1 */
+int
+  *eq_start,	/* first element of each equation */
+  *eq_col,	/* column of each element, counted from 0 */
+  num_nonzeros;	/* number of elements of all equations */
 float
-  **translation,	/* ptr to array of translation equations */
-  **min_weights,	/* ptr to array of lower bound equation vectors */
-  **max_weights,	/* ptr to array of upper bound equation vectors */
-  **rsv_eq;	/* ptr to array of RSV equation vectors */
+  *eq_val,	/* value of each element */
+  *eq_konst;	/* constant of each equation */
+
+long
+  width;	/* number of elements per row of tableau */
+
+PIVOT_KERNEL
+  *pivot_kernel;	/* kernels of the pivot step */
+
+REAL
+  *ratio_col,	/* pivot column, used by the ratio test */
+  *ratio_rhs,	/* constants, used by the ratio test */
+  *row_range,	/* upper bound of the variable of each row */
+  *col_range;	/* ... and of each column (--bounded) */
+
+/* Current job of the threads; see 'run_share' */
+int
+  team_size,	/* number of threads, including the main thread */
+  job_kind,	/* JOB_xxx */
+  job_n,	/* dimensions of the tableau */
+  job_m,
+  job_p,	/* pivot row and column */
+  job_q,
+  *job_ba,	/* see 'simplex' */
+  *job_nb,
+  *part_pos,	/* result of each thread (0..team_size-1) */
+  *part_count;	/* corrections of each thread */
+REAL
+  *part_val,	/* value at part_pos */
+  *job_prow,	/* pivot row */
+  job_lim;	/* quotient limit of JOB_HARRIS */
+REAL_ARG
+  *job_lu;	/* LU decomposition, see 'refactor_tableau' */
+int
+  *job_perm;
+BOOL
+  *job_trans;	/* see 'simplex' */
+
+/* Counters of the stable mode */
+int
+  harris_count,		/* pivot rows chosen by size */
+  clamp_count,		/* negative constants set to 0.0 */
+  refactor_count,	/* refactorisations */
+  refine_count;		/* rows improved by refinement */
+double
+  max_drift;		/* largest change by a refactorisation */
+
+/* Counters of the bounded mode */
+int
+  flip_count,		/* columns which reached their bound */
+  upper_count;		/* pivot rows which reached their bound */
+
+#ifdef THREADS
+pthread_mutex_t
+  team_lock = PTHREAD_MUTEX_INITIALIZER;
+pthread_cond_t
+  job_cond = PTHREAD_COND_INITIALIZER,	/* new job */
+  done_cond = PTHREAD_COND_INITIALIZER;	/* job done */
+pthread_t
+  *team;	/* worker threads 1..team_size-1 */
+long
+  job_serial;	/* number of the current job */
+int
+  busy;		/* worker threads still working on the job */
+#endif
 
 float
-  *cost;	/* pointer to vector of cost function */
+  *cost,	/* pointer to vector of cost function */
+  *low_bound,	/* lower bound of each weight (4.2) */
+  *high_bound;	/* upper bound of each weight (4.3) */
 
 /* Global variables used for RSV calculation */
 float
   glob_const,	/* used by calc_rsv */
   glob_wgt,
   *glob_v;
+int
+  *glob_index,	/* matrix indices set by calc_rsv */
+  glob_count;	/* number of entries in glob_index */
 
 BOOL
-  glob_bool;	/* Used by 'calc_rsv' */
+  glob_bool,	/* Used by 'calc_rsv' */
+  revised,	/* TRUE: use the revised simplex method (--revised) */
+  bounded,	/* TRUE: bounds of the weights as such (--bounded) */
+  stable,	/* TRUE: Harris ratio test, refactorisation (--stable) */
+  refine;	/* TRUE: with iterative refinement (--refine) */
+
+DESCR
+  glob_descr;	/* Used by 'read_document' */
   
 FILE
   *counter;	/* Virtual file used to output running counts */
@@ -163,20 +320,36 @@ FILE
 int main ( int, char * [] );  
 BOOL calc_rsv ( int, int, float [], float * );
 BOOL simplex ( int, int, float [] );
-float *matrix_ptr ( int, int );
-void process_pref ( FILE * );
+BOOL sparse_simplex ( int, int, float [] );
+void alloc_tableau ( int, int );
+void make_tableau ( int, int, float [] );
+void exchange ( int, int, int, int );
+void start_team ( int );
+void stop_team ( void );
+void run_share ( int );
+void run_job ( int );
+int piv_column ( int, int );
+int ratio_row ( int, int, int, BOOL * );
+void expression ( int, int, REAL_ARG [], REAL_ARG * );
+void solve_row ( int, REAL_ARG [], REAL_ARG [] );
+void refactor_row ( int, int, REAL_ARG [], REAL_ARG [], REAL_ARG [] );
+BOOL refactor_tableau ( int, int, int *, int * );
+void process_pref ( READER );
 int comp_doc ( ELEMENT, ELEMENT );
 int comp_sign ( ELEMENT, ELEMENT );
 int comp_atom ( ELEMENT, ELEMENT );
+BOOL copy_atom ( ELEMENT );
+void merge_signs ( ELEMENT, ELEMENT );
 int comp_wgt ( ELEMENT, ELEMENT );
 void add_doc ( int );
-void process_documents ( FILE * );
-void process_concepts ( FILE * );
+void process_documents ( DESCR );
+BOOL read_document ( ELEMENT );
+void process_concepts ( READER );
 int matrix_index ( int );
-void init_weights ( FILE *, float [] );
-void calc_equations ( FILE *, float [] );
+void init_weights ( READER, float [] );
+void calc_equations ( READER, float [] );
 float *alloc_vector ( void );
-int enum_pref ( FILE *, BOOL );
+int enum_pref ( READER, BOOL );
 BOOL enum_results ( ELEMENT );
 BOOL make_docatoms ( ELEMENT );
 void print_results ( float [] );
@@ -185,20 +358,39 @@ BOOL destroy_atoms ( ELEMENT );
 BOOL union_proc ( ELEMENT, ELEMENT );
 int comp_unused ( ELEMENT, ELEMENT );
 void add_unused ( int, float );
+void inaccuracy ( char *, int, REAL_ARG );
 void eliminate ( int, int, int *, int *, BOOL * );
+void complement_row ( int, int );
+void complement_column ( int, int, int );
 void serialize_atoms ();
 #else
 int main ();  
 BOOL calc_rsv ();
 BOOL simplex ();
-float *matrix_ptr ();
+BOOL sparse_simplex ();
+void alloc_tableau ();
+void make_tableau ();
+void exchange ();
+void start_team ();
+void stop_team ();
+void run_share ();
+void run_job ();
+int piv_column ();
+int ratio_row ();
+void expression ();
+void solve_row ();
+void refactor_row ();
+BOOL refactor_tableau ();
 void process_pref ();
 int comp_doc ();
 int comp_sign ();
 int comp_atom ();
+BOOL copy_atom ();
+void merge_signs ();
 int comp_wgt ();
 void add_doc ();
 void process_documents ();
+BOOL read_document ();
 void process_concepts ();
 int matrix_index ();
 void init_weights ();
@@ -213,7 +405,10 @@ BOOL destroy_atoms ();
 BOOL union_proc ();
 int comp_unused ();
 void add_unused ();
+void inaccuracy ();
 void eliminate ();
+void complement_row ();
+void complement_column ();
 void serialize_atoms ();
 #endif
 
@@ -257,7 +452,7 @@ int
 **
 **  Builds a list of signs and atomic concepts of each sign.
 **
-**  IN  : f = handle to the open CONCEPTS file.
+**  IN  : r = reader of the CONCEPTS file.
 ****************************************************************/ 
 
 int comp_sign
@@ -282,13 +477,44 @@ ELEMENT
 }
 
 
+/* Signs normally occur only once in the CONCEPTS file. If a sign
+   occurs again, its atoms are copied to the first entry. */
+
+BOOL copy_atom
+       ( a )
+ELEMENT
+  a;
+{
+  ATOM_STRUCT
+    *atm;
+
+  atm = (ATOM_STRUCT *) arena_alloc ( sign_arena, sizeof ( ATOM_STRUCT ) );
+  assert ( atm != NULL );
+  *atm = *((ATOM_STRUCT *) a);
+  atm = (ATOM_STRUCT *) add_list ( glob_list, (ELEMENT) atm, comp_atom );
+  assert ( atm != NULL );
+  return ( TRUE );
+}
+
+
+void merge_signs
+       ( s1, s2 )
+ELEMENT
+  s1;
+ELEMENT
+  s2;
+{
+  glob_list = ((SIGN_STRUCT *) s1) -> atoms;
+  enum_list ( ((SIGN_STRUCT *) s2) -> atoms, copy_atom, ENUM_FORWARD );
+  destroy_list ( &((SIGN_STRUCT *) s2) -> atoms );
+}
+
+
 void process_concepts
-       ( f )
-FILE 
-  *f;
+       ( r )
+READER
+  r;
 {
-  char
-    line [ LINE_LENGTH ];
   SIGN_STRUCT
     *sgn;
   LIST
@@ -301,43 +527,42 @@ FILE
   /* Create list of ALL atomic concepts */
   sign_list = create_list ();
   assert ( sign_list != NULL );
+  sign_arena = create_arena ( 0 );
+  list_set_arena ( sign_list, sign_arena );
 
-  /* Read file line by line */
-  while ( fgets ( line, LINE_LENGTH, f ) ) {
+  /* Read one sign record at a time */
+  while ( next_record ( r, &d ) ) {
   
-    /* Read a number */
-    n = sscanf ( line, " %d", &d );
-    assert ( n == 1 );
-    
-    /* If number followed by a colon, then this is a sign index */
-    if ( strchr ( line, ':' ) != NULL ) {
-      /* Set sign entry in sign_list */
-      sgn = (SIGN_STRUCT *) malloc ( sizeof ( SIGN_STRUCT ) );
-      assert ( sgn != NULL );
-      sgn -> sign = d;
-      sgn -> atoms = NULL;
-      sgn = (SIGN_STRUCT *) add_list ( sign_list, (ELEMENT) sgn, comp_sign );
-      assert ( sgn != NULL );
-      if ( sgn -> atoms == NULL ) {
-        sgn -> atoms = create_list ();
-        assert ( sgn -> atoms != NULL );
-      }
-      list = sgn -> atoms;
+    /* Set sign entry in sign_list */
+    sgn = (SIGN_STRUCT *) arena_alloc ( sign_arena, sizeof ( SIGN_STRUCT ) );
+    assert ( sgn != NULL );
+    sgn -> sign = d;
+    sgn -> atoms = create_list ();
+    assert ( sgn -> atoms != NULL );
+    list_set_arena ( sgn -> atoms, sign_arena );
+    list_append_unsorted ( sign_list, (ELEMENT) sgn );
+    list = sgn -> atoms;
       
-      /* running count */
-      fprintf ( counter, "%d\r", d );
-    }
+    /* running count */
+    fprintf ( counter, "%d\r", d );
     
-    else {
+    while ( next_entry ( r ) ) {
       /* Add atomic concept to concept list of current sign */
-      atm = (ATOM_STRUCT *) malloc ( sizeof ( ATOM_STRUCT ) );
+      n = get_int ( r, &d );
+      assert ( n );
+      atm = (ATOM_STRUCT *) arena_alloc ( sign_arena, sizeof ( ATOM_STRUCT ) );
       assert ( atm != NULL );
       atm -> atom = d;
-      atm = (ATOM_STRUCT *) add_list ( list, (ELEMENT) atm, comp_atom );
-      assert ( atm != NULL );
+      list_append_unsorted ( list, (ELEMENT) atm );
     }
+
+    /* Sort atoms of sign */
+    list_finalize ( list, comp_atom, NULL );
   }
   
+  /* Sort the sign list */
+  list_finalize ( sign_list, comp_sign, merge_signs );
+
   fprintf ( counter, "\n" );
 }
 
@@ -345,12 +570,11 @@ FILE
 /****************************************************************
 **  process_documents
 **
-**  Looks at each document description in the DOC_DESCR file;
-**  if the document occurs in a preference relation, then the
-**  sign weights for this document are read. Otherwise, the
-**  document and its signs are ignored.
+**  Looks up the description of each document which occurs in
+**  a preference relation and reads the sign weights of this
+**  document. All other documents are ignored.
 **
-**  IN  : f = handle to the open DOC_DESCR file.
+**  IN  : d = document descriptions (DOC_DESCR file).
 ****************************************************************/ 
 
 int comp_wgt
@@ -373,7 +597,7 @@ ELEMENT
     *a;
 
   /* duplicate atom and add to 'glob_list' */
-  a = (WGT_STRUCT *) malloc ( sizeof ( WGT_STRUCT ) );
+  a = (WGT_STRUCT *) arena_alloc ( main_arena (), sizeof ( WGT_STRUCT ) );
   assert ( a != NULL );
   a -> d_atom = ((ATOM_STRUCT *) e) -> atom;
   a -> weight = 0.0;
@@ -387,62 +611,50 @@ ELEMENT
 }
 
 
-void process_documents
-       ( f )
-FILE 
-  *f;
+BOOL read_document
+       ( e )
+ELEMENT
+  e;
 {
-  char
-    line [ LINE_LENGTH ];
-  BOOL
-    active = FALSE;
   SIGN_STRUCT
     t, *sgn;
   DOC_STRUCT
-    t1, *doc;
-  float
-    w;
+    *doc;
+  DESCR_WGT
+    *w;
   int
-    d, n;
-
-  /* Read file line by line */
-  while ( fgets ( line, LINE_LENGTH, f ) ) {
-  
-    /* Interpret as much fields as possible */
-    n = sscanf ( line, " %d %f", &d, &w );
-    switch ( n ) {
-      
-      case 1 :
-        /* One field -> new document number; update running count */
-        fprintf ( counter, "%d\r", d );
-        
-        /* Is document in doc_list? */
-        t1.index = d;
-        doc = (DOC_STRUCT *) lookup_list ( doc_list, (ELEMENT) &t1, comp_doc );
-        if ( doc != NULL ) {
-          active = TRUE;
-          glob_list = doc -> docatoms;
-        }
-        else {
-          active = FALSE;
-        }
-        break;
-        
-      case 2 :
-        /* Two fields -> sign index and weight */
-        if ( active ) {
-          /* Find sign in sign_list */
-          t.sign = d;
-          sgn = (SIGN_STRUCT *) lookup_list ( sign_list, (ELEMENT) &t, comp_sign );
-          assert ( sgn != NULL );
+    i, j;
+
+  /* Find description of document in 'glob_descr' */
+  doc = (DOC_STRUCT *) e;
+  fprintf ( counter, "%d\r", doc -> index );
+  i = find_descr ( glob_descr, doc -> index );
+  if ( i < 0 ) return ( TRUE );
+  glob_list = doc -> docatoms;
+
+  w = descr_wgts ( glob_descr, i );
+  for ( j = 0; j < descr_count ( glob_descr, i ); j ++ ) {
+    /* Find sign in sign_list */
+    t.sign = w [j].sign;
+    sgn = (SIGN_STRUCT *) lookup_list ( sign_list, (ELEMENT) &t, comp_sign );
+    assert ( sgn != NULL );
         
-          /* Add atoms of sign to 'glob_list' */
-          glob_wgt = w;
-          enum_list ( sgn -> atoms, make_docatoms, ENUM_FORWARD );
-        }
-        break;
-    }
+    /* Add atoms of sign to 'glob_list' */
+    glob_wgt = w [j].weight;
+    enum_list ( sgn -> atoms, make_docatoms, ENUM_FORWARD );
   }
+  return ( TRUE );
+}
+
+
+void process_documents
+       ( d )
+DESCR
+  d;
+{
+  glob_descr = d;
+  enum_list ( doc_list, read_document, ENUM_FORWARD );
+  fprintf ( counter, "\n" );
 }
 
 
@@ -453,7 +665,7 @@ FILE
 **  frequency for each atomic concept. Stores this frequency
 **  at the correct place in the solution vector.
 **
-**  IN  : f = handle to opened ATOM_DOCS file.
+**  IN  : r = reader of ATOM_DOCS file.
 **        x = pointer to previously allocated array with as much
 **            elements as there are atomic concepts.
 **
@@ -484,7 +696,7 @@ float
     *unused;
 
   /* Add unused atom to internal list for rsv calculation */
-  unused = (IDF_STRUCT *) malloc ( sizeof ( IDF_STRUCT ) );
+  unused = (IDF_STRUCT *) arena_alloc ( unused_arena, sizeof ( IDF_STRUCT ) );
   assert ( unused != NULL );
   unused -> u_atom = atom;
   unused -> idf = idf;
@@ -495,16 +707,13 @@ float
 
 
 void init_weights
-       ( f, x )
-FILE
-  *f;
+       ( r, x )
+READER
+  r;
 float
   x [];
 {
-  char
-    line [ LINE_LENGTH ];
   float
-    *arr,
     idf;
   int
     matidx,
@@ -513,29 +722,21 @@ float
   /* Create list for unused weights which are needed in rsv calculation */
   unused_wgts = create_list ();
   assert ( unused_wgts != NULL );
+  unused_arena = create_arena ( 0 );
+  list_set_arena ( unused_wgts, unused_arena );
 
-  /* Create equation vector for translation equations */
-  translation = (float **) calloc ( num_weights, sizeof ( float * ) );
-  assert ( translation != NULL );
-  
   /* Read file line by line */
-  while ( fgets ( line, LINE_LENGTH, f ) ) {
+  while ( read_line ( r ) ) {
   
-    /* Read a number */
-    n = sscanf ( line, " %d %f", &curratom, &idf );
-    assert ( n == 2 );
+    /* Read atomic concept and its idf */
+    n = get_int ( r, &curratom ) && get_float ( r, &idf );
+    assert ( n );
     
     /* Check if we need this weight */
     matidx = matrix_index ( curratom );
     if ( matidx != -1 ) {
       /* This concept is used in one or more documents */
       x [ matidx ] = idf;
-
-      /* Create translation equation */
-      arr = alloc_vector ();
-      arr [ matidx ] = 1.0;
-      arr [ num_weights ] = idf;
-      translation [ matidx ] = arr;
     }
     else {
       /* Unused concept, so write value directly to output */
@@ -576,7 +777,7 @@ int
   DOC_STRUCT
     *doc;
   
-  doc = (DOC_STRUCT *) malloc ( sizeof ( DOC_STRUCT ) );
+  doc = (DOC_STRUCT *) arena_alloc ( main_arena (), sizeof ( DOC_STRUCT ) );
   assert ( doc != NULL );
   doc -> index = d;
   doc -> docatoms = NULL;
@@ -586,6 +787,7 @@ int
   if ( doc -> docatoms == NULL ) {
     doc -> docatoms = create_list ();
     assert ( doc -> docatoms != NULL );
+    list_set_arena ( doc -> docatoms, main_arena () );
   }
 }
 
@@ -596,30 +798,31 @@ int
 **  Processes evaluated preferences. Simply reads the document
 **  numbers which occur in the preference file.
 **
-**  IN  : f = handle to open 'EVAL_PREF' file.
+**  IN  : r = reader of 'EVAL_PREF' file.
 ****************************************************************/ 
 
 void process_pref
-       ( f )
-FILE
-  *f;
+       ( r )
+READER
+  r;
 {
   int
     d, d1, d2,
     res;
   char
-    type,
-    line [ LINE_LENGTH ];
+    type;
     
   doc_list = create_list ();
   assert ( doc_list != NULL );
+  list_set_arena ( doc_list, main_arena () );
   
   /* Read one line at a time */
-  while ( fgets ( line, LINE_LENGTH, f ) ) {
+  while ( read_line ( r ) ) {
   
     /* Parse preference type and 3 document numbers */
-    res = sscanf ( line, "%c %d %d %d", &type, &d, &d1, &d2 );
-    assert ( res == 4 );
+    res = get_char ( r, &type ) && get_int ( r, &d ) && 
+          get_int ( r, &d1 ) && get_int ( r, &d2 );
+    assert ( res );
     
     /* Insert documents d, d1, d2 into document list */
     add_doc ( d );
@@ -649,7 +852,7 @@ int
   ATOM_STRUCT
     *atm;
   
-  atm = (ATOM_STRUCT *) malloc ( sizeof ( ATOM_STRUCT ) );
+  atm = (ATOM_STRUCT *) arena_alloc ( main_arena (), sizeof ( ATOM_STRUCT ) );
   assert ( atm != NULL );
   
   /* Add atom to 'atom_list' */
@@ -684,13 +887,12 @@ ELEMENT
 
 
 void serialize_atoms
-       ( f )
-FILE
-  *f;
+       ( r )
+READER
+  r;
 {
   char
-    type,
-    line [ LINE_LENGTH ];
+    type;
   int
     q, d1, d2, n, i;
   DOC_STRUCT
@@ -698,6 +900,7 @@ FILE
     
   atom_list = create_list ();
   assert ( atom_list != NULL );
+  list_set_arena ( atom_list, main_arena () );
   
   /* Read preference file. Only optimize atoms which occur in query 
      and at least one document */
@@ -705,10 +908,11 @@ FILE
   serial = i = 0;
   
   /* Read EVAL_PREF file, line by line */
-  while ( fgets ( line, LINE_LENGTH, f ) ) {
+  while ( read_line ( r ) ) {
   
-    n = sscanf ( line, " %c %d %d %d", &type, &q, &d1, &d2 );
-    assert ( n == 4 );
+    n = get_char ( r, &type ) && get_int ( r, &q ) && get_int ( r, &d1 ) &&
+        get_int ( r, &d2 );
+    assert ( n );
     
     /* Don't optimize weights in satisfied preferences. */
     if ( ( type == '+' ) || ( type == 'C' ) ) continue;
@@ -726,10 +930,12 @@ FILE
     assert ( doc2 != NULL );
     
     /* Find union of concepts in query and doc1, build glob_atoms list */
-    find_union ( query -> docatoms, doc1 -> docatoms, comp_wgt, enum_primary );
+    find_union_gallop ( query -> docatoms, doc1 -> docatoms, comp_wgt,
+                        enum_primary );
     
     /* Find union of concepts in query and doc2 */
-    find_union ( query -> docatoms, doc2 -> docatoms, comp_wgt, enum_primary );
+    find_union_gallop ( query -> docatoms, doc2 -> docatoms, comp_wgt,
+                        enum_primary );
     
     /* Running count */
     i ++;
@@ -741,80 +947,15 @@ FILE
 
 
 /****************************************************************
-**  matrix_ptr
-**
-**  Gets a pointer to the matrix element in (row, col). Used to
-**  simplify the procedures 'elt' and 'set'.
-**  The matrix is interpreted as follows:
-**
-**  row = 0 .. rsv_equations - 1 : 
-**        RSV equations of satisfied and unsatisfied preferences
-**        (4.4 and 4.5 in the thesis, p.78 ).
-**
-**  row = rsv_equations .. rsv_equations + num_weights - 1 :
-**        mininum weight equations (4.2)
-**
-**  row = rsv_equations + num_weights .. rsv_equations + 2*num_weights - 1 :
-**        maximum weight equations (4.3)
-**
-**  row = rsv_equations + 2*num_weights:
-**        cost function (4.1, p.77)
+**  row_ptr
 **
-**  IN  : row, col = row and column of the desired element.
+**  Returns a pointer to the first element of a row of the
+**  optimization matrix.
 **
-**  OUT : A pointer to the element is returned.
+**  IN  : row = row number. The first row index is 1.
 ****************************************************************/ 
 
-float *matrix_ptr
-          ( row, col )
-int
-  row;
-int
-  col;
-{
-  float
-    *base;
-
-  /* Decrement row and column to map 1..x to 0..x-1 (c array
-     indexing convention */
-  row --;
-  col --;
-  assert ( row >= 0 );
-  assert ( ( col >= 0 ) && ( col <= num_weights ) );
-
-  if ( row < num_weights ) {
-    /* translation equations */
-    base = translation [ row ];
-  }
-  else {
-    row -= num_weights;
-    if ( row < num_prefs ) {
-      /* RSV equation */
-      base = rsv_eq [ row ];
-    }
-    else {
-      row -= num_prefs;
-      if ( row < num_weights ) {
-        /* mininum weight constraints */
-        base = min_weights [ row ];
-      }
-      else {
-        row -= num_weights;
-        if ( row < num_weights ) {
-          /* maximum weight constraints */
-	  base = max_weights [ row ];
-        }
-        else {
-          /* cost function */
-  	  assert ( row == num_weights );
-	  base = cost;
-	}
-      }
-    }
-  }
-  
-  return ( & ( base [ col ] ) );
-}
+#define row_ptr(row)	( tableau + ( (row) - 1 ) * width )
 
 
 /****************************************************************
@@ -823,12 +964,12 @@ int
 **  Returns the value of an element of the optimization matrix
 **
 **  IN  : row, col = row and column of the element. The first
-**                   row/column index is 0.
+**                   row/column index is 1.
 **
 **  OUT : The function returns matrix [ row, col ].
 ****************************************************************/ 
 
-#define elt(row,col)	(*matrix_ptr((row),(col)))
+#define elt(row,col)	( row_ptr ( row ) [ (col) - 1 ] )
 
 
 /****************************************************************
@@ -837,136 +978,1118 @@ int
 **  Sets the value of an element of the optimization matrix
 **
 **  IN  : row, col = row and column of the element. The first
-**                   row/column index is 0.
+**                   row/column index is 1.
 **        value    = new value of the matrix element.
 **                   matrix [ row, col ] := value;
 ****************************************************************/ 
 
-#define set(row,col,value)	{ *matrix_ptr((row),(col)) = (value); }
+#define set(row,col,value)	{ row_ptr ( row ) [ (col) - 1 ] = (value); }
 
 
 /****************************************************************
-**  calc_rsv
+**  alloc_tableau
 **
-**  IN  : d1, d2 = numbers of the two documents
-**        const  = pointer to variable where constant factor 
-**                 of RSV is to be stored.
-**        v      = pointer to vector where factors of individual
-**                 weights are to be stored.
+**  Allocates the optimization matrix of the simplex tableau (see
+**  'make_tableau'), initialized to zero.
 **
-**  OUT : The vector v is filled with the appropriate values.
-**        The value of the constant factor is returned.
-****************************************************************/
+**  IN  : n = number of weights.
+**        m = number of constraint equations.
+****************************************************************/ 
 
-BOOL union_proc
-       ( a1, a2 )
-ELEMENT
-  a1;
-ELEMENT
-  a2;
+void alloc_tableau
+       ( n, m )
+int
+  n;
+int
+  m;
 {
-  float
-    p;
-  WGT_STRUCT
-    *at1, *at2;
+  char
+    *base;
   int
-    matidx;
-  IDF_STRUCT
-    t, *unused;
+    w;
 
-  at1 = (WGT_STRUCT *) a1;
-  at2 = (WGT_STRUCT *) a2;
-  assert ( at1 -> d_atom == at2 -> d_atom );
-  
-  /* Multiply weights */
-  p = ( at1 -> weight * at2 -> weight );
-  
-  /* Set vector element of this atomic concept. The atom is not
-     necessarily used because there is a limit on the number of atoms
-     that can be optimized. */
-  matidx = matrix_index ( at1 -> d_atom );
-  if ( matidx != -1 ) {
-    glob_v [ matidx ] = p;
-    if ( p != 0.0 ) {
-      glob_bool = TRUE;
-    }
-  }
-  else {
-    /* unused atom; look up in unused_wgts and add to constant factor */
-    t.u_atom = at1 -> d_atom;
-    unused = (IDF_STRUCT *) lookup_list ( unused_wgts, 
-               (ELEMENT) &t, comp_unused );
-    assert ( unused != NULL );
-    glob_const += ( p * unused -> idf );
+  w = 64 / sizeof ( REAL );
+  width = ( ( n + w ) / w ) * w;
+  base = (char *) calloc ( ( m + 1 ) * width * sizeof ( REAL ) + 64, 1 );
+  if ( base == NULL ) {
+    fprintf ( stderr, "Matrix mem alloc failed: %d rows\n", m + 1 );
+    assert ( FALSE );
   }
-
-  return ( TRUE );
+  tableau = (REAL *) ( ( (unsigned long) base + 63 ) & ~63UL );
 }
 
 
-BOOL calc_rsv
-         ( d1, d2, v, const )
+/****************************************************************
+**  make_tableau
+**
+**  Creates the optimization matrix of the simplex tableau as one
+**  block of memory, row by row. A row has n+1 elements, padded
+**  with zeros to a multiple of 64 bytes; the first row is
+**  aligned to 64 bytes. The matrix is interpreted as
+**  follows:
+**
+**  row = 1 .. n :
+**        translation equations (weights >= 0)
+**
+**  row = n + 1 .. n + num_prefs :
+**        RSV equations of satisfied and unsatisfied preferences
+**        (4.4 and 4.5 in the thesis, p.78 ).
+**
+**  row = n + num_prefs + 1 .. 2*n + num_prefs :
+**        mininum weight equations (4.2)
+**
+**  row = 2*n + num_prefs + 1 .. 3*n + num_prefs = m :
+**        maximum weight equations (4.3)
+**
+**  row = m + 1:
+**        cost function (4.1, p.77)
+**
+**  With --bounded, the minimum and maximum weight equations do
+**  not exist (m = n + num_prefs). The translation equations are
+**  relative to the lower bounds instead, and the maximum weight
+**  is the upper bound of their variables (see 'ratio_row').
+**
+**  The block is allocated by 'alloc_tableau', and the RSV
+**  equations are written into it by 'enum_pref'; the other
+**  equations are created here from the bounds and the cost
+**  function.
+**
+**  IN  : n = number of weights.
+**        m = number of constraint equations.
+**        x = initial weights, to which the translation equations
+**            are relative.
+****************************************************************/ 
+
+void make_tableau
+       ( n, m, x )
 int
-  d1;
+  n;
 int
-  d2;
-float
-  v [];
+  m;
 float
-  *const;
+  x [];
 {
-  DOC_STRUCT
-    t, *q, *d;
+  REAL
+    *row, low;
+  int
+    i, k;
+
+  assert ( m == ( bounded ? n : 3 * n ) + num_prefs );
+  assert ( tableau != NULL );
+  row_range = col_range = NULL;
+  if ( bounded ) {
+    row_range = (REAL *) calloc ( m + 1, sizeof ( REAL ) );
+    col_range = (REAL *) calloc ( n + 1, sizeof ( REAL ) );
+    assert ( ( row_range != NULL ) && ( col_range != NULL ) );
+    for ( i = 1; i <= m; i ++ ) {
+      row_range [i] = HUGE_VAL;
+    }
+    for ( k = 1; k <= n; k ++ ) {
+      col_range [k] = HUGE_VAL;
+    }
+  }
 
-  glob_v = v;
+  for ( i = 0; i < n; i ++ ) {
+
+    /* Translation equations */
+    row = row_ptr ( i + 1 );
+    row [i] = 1.0;
+    row [n] = x [i];
+    if ( bounded ) {
+      /* weight - low >= 0, with range high - low */
+      low = ( low_bound [i] > 0.0 ) ? low_bound [i] : 0.0;
+      row [n] = x [i] - low;
+      row_range [ i + 1 ] = high_bound [i] - low;
+      if ( row [n] < 0.0 ) {
+        inaccuracy ( "simplex", i + 1, row [n] );
+        row [n] = 0.0;
+      }
+      if ( row [n] > row_range [ i + 1 ] ) {
+        inaccuracy ( "simplex", i + 1, row_range [ i + 1 ] - row [n] );
+        row [n] = row_range [ i + 1 ];
+      }
+      continue;
+    }
 
-  /* Get document descriptions of d1 and d2 and store into global vars */
-  t.index = d1;
-  q = (DOC_STRUCT *) lookup_list ( doc_list, (ELEMENT) &t, comp_doc );
-  assert ( q != NULL );
+    /* Low bounds */
+    row = row_ptr ( n + num_prefs + i + 1 );
+    row [i] = 1.0;
+    row [n] = - low_bound [i];
 
-  t.index = d2;
-  d = (DOC_STRUCT *) lookup_list ( doc_list, (ELEMENT) &t, comp_doc );
-  assert ( d != NULL );
+    /* High bounds */
+    row = row_ptr ( 2 * n + num_prefs + i + 1 );
+    row [i] = -1.0;
+    row [n] = high_bound [i];
+  }
 
-  glob_const = 0.0;
-  glob_bool = FALSE;
-  
-  find_union ( q -> docatoms, d -> docatoms, comp_wgt, union_proc );
-  *const = glob_const;
-  
-  return ( glob_bool );
+  /* Cost function */
+  row = row_ptr ( m + 1 );
+  for ( k = 0; k <= n; k ++ ) {
+    row [k] = cost [k];
+  }
+
+  ratio_col = (REAL *) calloc ( m + 1, sizeof ( REAL ) );
+  ratio_rhs = (REAL *) calloc ( m + 1, sizeof ( REAL ) );
+  assert ( ( ratio_col != NULL ) && ( ratio_rhs != NULL ) );
+  pivot_kernel = select_pivot_kernel ( sizeof ( REAL ) );
+  fprintf ( stderr, "Pivot kernel: %s, %s\n", pivot_kernel -> name, 
+            REAL_NAME );
+
+  if ( ( m + 1 ) * width >= MIN_PARALLEL ) {
+    start_team ( thread_count () );
+  }
+  else {
+    start_team ( 1 );
+  }
+  fprintf ( stderr, "Pivot threads: %d\n", team_size );
 }
 
 
+#ifdef THREADS
+
 /****************************************************************
-**  calc_equations
-**
-**  Calculates the constraint equations which must be satisfied
-**  by the optimized weights, as well as the cost function.
-**
-**  IN  : x = vector containing the inverse document frequency
-**            of all atomic concepts. This vector is used to
-**            generate equations (4.2, 4.3) on p.78 of the thesis.
+**  pivot_worker
 **
-**  OUT : dryrun = FALSE:
-**        The global vectors min_weights, max_weights, rsv_eq,
-**        and cost are initialized with the appropriate values.
-**        These vectors constitute the optimization matrix.
+**  Main function of a worker thread. Does its share of each job
+**  until it gets JOB_QUIT.
 **
-**        dryrun = TRUE:
-**        Nothing is changed. The function returns the number
-**        of actual matrix rows. The caller should then allocate
-**        memory for the rsv_eq vector and call calc_equations
-**        a second time with dryrun = FALSE.
+**  IN  : arg = number of the thread (1..team_size-1).
 ****************************************************************/
 
-float *alloc_vector
-	  ( )
+void *pivot_worker
+        ( arg )
+void
+  *arg;
 {
-  float 
-    *v;
-
+  long
+    seen;
+  int
+    kind;
+
+  seen = 0;
+  while ( TRUE ) {
+    /* Wait for next job */
+    pthread_mutex_lock ( &team_lock );
+    while ( job_serial == seen ) {
+      pthread_cond_wait ( &job_cond, &team_lock );
+    }
+    seen = job_serial;
+    kind = job_kind;
+    pthread_mutex_unlock ( &team_lock );
+    if ( kind == JOB_QUIT ) break;
+
+    run_share ( (int) (long) arg );
+
+    pthread_mutex_lock ( &team_lock );
+    if ( -- busy == 0 ) {
+      pthread_cond_signal ( &done_cond );
+    }
+    pthread_mutex_unlock ( &team_lock );
+  }
+  return ( NULL );
+}
+
+#endif
+
+
+/****************************************************************
+**  start_team
+**
+**  Starts the threads which do the pivot steps. The main thread
+**  is one of them; it does the first share of each job.
+**
+**  IN  : n = number of threads.
+****************************************************************/
+
+void start_team
+       ( n )
+int
+  n;
+{
+#ifdef THREADS
+  int
+    i, res;
+#endif
+
+  team_size = n;
+  part_pos = (int *) calloc ( n, sizeof ( int ) );
+  part_count = (int *) calloc ( n, sizeof ( int ) );
+  part_val = (REAL *) calloc ( n, sizeof ( REAL ) );
+  assert ( ( part_pos != NULL ) && ( part_count != NULL ) && 
+           ( part_val != NULL ) );
+#ifdef THREADS
+  if ( n > 1 ) {
+    job_serial = 0;
+    team = (pthread_t *) malloc ( n * sizeof ( pthread_t ) );
+    assert ( team != NULL );
+    for ( i = 1; i < n; i ++ ) {
+      res = pthread_create ( &team [i], NULL, pivot_worker, 
+                             (void *) (long) i );
+      assert ( res == 0 );
+    }
+  }
+#endif
+}
+
+
+/****************************************************************
+**  stop_team
+**
+**  Terminates the threads started by 'start_team'.
+****************************************************************/
+
+void stop_team
+       ( )
+{
+#ifdef THREADS
+  int
+    i;
+
+  if ( team_size > 1 ) {
+    run_job ( JOB_QUIT );
+    for ( i = 1; i < team_size; i ++ ) {
+      pthread_join ( team [i], NULL );
+    }
+    free ( team );
+  }
+#endif
+  free ( part_pos );
+  free ( part_count );
+  free ( part_val );
+  team_size = 0;
+}
+
+
+/****************************************************************
+**  run_share
+**
+**  Does the share of thread t of the current job:
+**
+**  JOB_UPDATE   : adds the pivot row, multiplied by the element
+**                 in the pivot column, to each row except the
+**                 pivot row (see 'exchange'). The rows are
+**                 divided into blocks of BLOCK_BYTES, which are
+**                 assigned to the threads in turn.
+**  JOB_PIV      : searches a range of the columns for the first
+**                 largest positive element of the cost function.
+**  JOB_RATIO    : searches a range of the rows for the first row
+**                 with the largest quotient (ratio test). With
+**                 --bounded, a row whose variable increases is
+**                 limited by its upper bound. With
+**                 --stable, negative constants are set to 0.0
+**                 first, and the quotients are calculated with
+**                 the tolerances (see 'ratio_row').
+**  JOB_HARRIS   : searches a range of the rows for the first row
+**                 with the largest pivot element among those
+**                 whose quotient is at least job_lim.
+**  JOB_REFACTOR : calculates the rows again, in blocks like
+**                 JOB_UPDATE (see 'refactor_tableau').
+**
+**  The searches leave the position found (or -1) and its value
+**  in part_pos [t] and part_val [t]; the ranges are in the order
+**  of the threads. Corrections are counted in part_count [t],
+**  the largest change of JOB_REFACTOR is left in part_val [t].
+**
+**  IN  : t = number of the thread (0..team_size-1).
+****************************************************************/
+
+void run_share
+       ( t )
+int
+  t;
+{
+  REAL
+    *row, f;
+  REAL_ARG
+    *a, *b, *r;
+  long
+    rows, first;
+  int
+    i, j, lo, hi;
+
+  part_count [t] = 0;
+  if ( ( job_kind == JOB_UPDATE ) || ( job_kind == JOB_REFACTOR ) ) {
+    rows = BLOCK_BYTES / ( width * (long) sizeof ( REAL ) );
+    if ( rows < 1 ) rows = 1;
+    a = b = r = NULL;
+    if ( job_kind == JOB_REFACTOR ) {
+      a = (REAL_ARG *) calloc ( 3 * job_n, sizeof ( REAL_ARG ) );
+      assert ( a != NULL );
+      b = a + job_n;
+      r = b + job_n;
+    }
+    part_val [t] = 0.0;
+    for ( first = 1 + t * rows; first <= job_m + 1; 
+          first += team_size * rows ) {
+      for ( i = first; ( i < first + rows ) && ( i <= job_m + 1 ); i ++ ) {
+        if ( job_kind == JOB_REFACTOR ) {
+          refactor_row ( i, t, a, b, r );
+          continue;
+        }
+        if ( i == job_p ) continue;
+        row = row_ptr ( i );
+        f = row [ job_q - 1 ];
+        if ( f != 0.0 ) {
+          (*pivot_kernel -> update) ( row, job_prow, f, (int) width );
+        }
+        row [ job_q - 1 ] = f / job_prow [ job_q - 1 ];
+      }
+    }
+    if ( a != NULL ) free ( a );
+    return;
+  }
+
+  if ( job_kind == JOB_PIV ) {
+    lo = (int) ( (long) job_n * t / team_size );
+    hi = (int) ( (long) job_n * ( t + 1 ) / team_size );
+    row = row_ptr ( job_m + 1 );
+    j = (*pivot_kernel -> max_pos) ( row + lo, hi - lo );
+    if ( j >= 0 ) {
+      part_val [t] = row [ lo + j ];
+      j += lo;
+    }
+    part_pos [t] = j;
+    return;
+  }
+
+  lo = (int) ( (long) job_m * t / team_size );
+  hi = (int) ( (long) job_m * ( t + 1 ) / team_size );
+  if ( job_kind == JOB_HARRIS ) {
+    j = -1;
+    f = 0.0;
+    for ( i = lo; i < hi; i ++ ) {
+      if ( ( ratio_col [i] < f ) && 
+           ( row_ptr ( i + 1 ) [ job_n ] / ratio_col [i] >= job_lim ) ) {
+        j = i;
+        f = ratio_col [i];
+      }
+    }
+    part_pos [t] = j;
+    part_val [t] = f;
+    return;
+  }
+
+  assert ( job_kind == JOB_RATIO );
+  for ( i = lo; i < hi; i ++ ) {
+    /* Translation equations are not considered since they do not 
+       exist in the scheme anymore */
+    row = row_ptr ( i + 1 );
+    if ( ! stable ) {
+      ratio_col [i] = job_trans [ i + 1 ] ? 0.0 : row [ job_q - 1 ];
+      ratio_rhs [i] = row [ job_n ];
+      if ( ( row_range != NULL ) && ( ratio_col [i] > 0.0 ) &&
+           ( row_range [ i + 1 ] != HUGE_VAL ) ) {
+        /* Distance to the upper bound, as if complemented */
+        ratio_col [i] = - ratio_col [i];
+        ratio_rhs [i] = row_range [ i + 1 ] - ratio_rhs [i];
+      }
+      continue;
+    }
+    if ( job_trans [ i + 1 ] ) {
+      ratio_col [i] = 0.0;
+    }
+    else {
+      if ( row [ job_n ] < 0.0 ) {
+        row [ job_n ] = 0.0;
+        part_count [t] ++;
+      }
+      ratio_col [i] = ( row [ job_q - 1 ] < - TOL_PIVOT ) ? 
+                        row [ job_q - 1 ] : 0.0;
+    }
+    ratio_rhs [i] = row [ job_n ] + TOL_FEAS;
+  }
+  j = (*pivot_kernel -> ratio_pos) ( ratio_col + lo, ratio_rhs + lo, 
+                                     hi - lo, (REAL_ARG) - HUGE_VAL );
+  if ( j >= 0 ) {
+    j += lo;
+    part_val [t] = ratio_rhs [j] / ratio_col [j];
+  }
+  part_pos [t] = j;
+}
+
+
+/****************************************************************
+**  run_job
+**
+**  Runs a job on all threads and waits until it is done. The
+**  parameters of the job are in the global variables job_xxx.
+**
+**  IN  : kind = JOB_xxx.
+****************************************************************/
+
+void run_job
+       ( kind )
+int
+  kind;
+{
+  job_kind = kind;
+#ifdef THREADS
+  if ( team_size > 1 ) {
+    pthread_mutex_lock ( &team_lock );
+    busy = team_size - 1;
+    job_serial ++;
+    pthread_cond_broadcast ( &job_cond );
+    pthread_mutex_unlock ( &team_lock );
+    if ( kind == JOB_QUIT ) return;
+
+    run_share ( 0 );
+
+    pthread_mutex_lock ( &team_lock );
+    while ( busy > 0 ) {
+      pthread_cond_wait ( &done_cond, &team_lock );
+    }
+    pthread_mutex_unlock ( &team_lock );
+    return;
+  }
+#endif
+  run_share ( 0 );
+}
+
+
+/****************************************************************
+**  piv_column
+**
+**  Step 'PIV': searches the first largest positive element of
+**  the cost function.
+**
+**  IN  : n, m = see 'simplex'.
+**
+**  OUT : Function returns the pivot column q, or 0 if there is
+**        no positive element.
+****************************************************************/
+
+int piv_column
+      ( n, m )
+int
+  n;
+int
+  m;
+{
+  REAL
+    max;
+  int
+    t, q;
+
+  job_n = n;
+  job_m = m;
+  run_job ( JOB_PIV );
+
+  /* First range with the largest element */
+  q = 0;
+  max = 0.0;
+  for ( t = 0; t < team_size; t ++ ) {
+    if ( ( part_pos [t] >= 0 ) && ( part_val [t] > max ) ) {
+      q = part_pos [t] + 1;
+      max = part_val [t];
+    }
+  }
+  return ( q );
+}
+
+
+/****************************************************************
+**  ratio_row
+**
+**  Searches the pivot row for column q: the first row whose
+**  element in column q is negative and whose quotient of the
+**  constant and this element is largest. Translation equations
+**  are not considered.
+**
+**  With --stable, the ratio test of Harris is used instead. The
+**  first pass finds the largest quotient with the constants
+**  increased by TOL_FEAS, among the elements below -TOL_PIVOT.
+**  The second pass chooses, among the rows whose quotient is at
+**  least as large, the first one with the largest element in
+**  column q. This avoids small pivots; the constants which
+**  become negative by at most TOL_FEAS are set to 0.0 in the
+**  next ratio test.
+**
+**  With --bounded, the variables of the rows and columns have
+**  upper bounds as well (row_range, col_range). A row whose
+**  variable reaches its upper bound first is complemented
+**  (see 'complement_row') and becomes the pivot row. If the
+**  variable of column q reaches its own bound first, or at the
+**  same time, the column is complemented instead and no pivot
+**  step is needed.
+**
+**  IN  : n, m  = see 'simplex'.
+**        q     = pivot column.
+**        trans = see 'simplex'.
+**
+**  OUT : Function returns the pivot row p, 0 if there is none,
+**        or -1 if column q was complemented.
+****************************************************************/
+
+int ratio_row
+      ( n, m, q, trans )
+int
+  n;
+int
+  m;
+int
+  q;
+BOOL
+  *trans;
+{
+  REAL
+    max;
+  int
+    t, p, first;
+
+  job_n = n;
+  job_m = m;
+  job_q = q;
+  job_trans = trans;
+  run_job ( JOB_RATIO );
+
+  /* First range with the largest quotient */
+  p = 0;
+  max = - HUGE_VAL;
+  for ( t = 0; t < team_size; t ++ ) {
+    clamp_count += part_count [t];
+    if ( ( part_pos [t] >= 0 ) && ( part_val [t] > max ) ) {
+      p = part_pos [t] + 1;
+      max = part_val [t];
+    }
+  }
+  if ( row_range != NULL ) {
+    if ( ( col_range [q] != HUGE_VAL ) && 
+         ( ( p == 0 ) || ( - col_range [q] >= max ) ) ) {
+      complement_column ( n, m, q );
+      return ( -1 );
+    }
+    if ( ( p != 0 ) && ( elt ( p, q ) > 0.0 ) ) {
+      complement_row ( n, p );
+    }
+  }
+  if ( ( ! stable ) || ( p == 0 ) ) {
+    return ( p );
+  }
+
+  /* Second pass: first range with the largest pivot */
+  first = p;
+  job_lim = max;
+  run_job ( JOB_HARRIS );
+  p = 0;
+  max = 0.0;
+  for ( t = 0; t < team_size; t ++ ) {
+    if ( ( part_pos [t] >= 0 ) && ( part_val [t] < max ) ) {
+      p = part_pos [t] + 1;
+      max = part_val [t];
+    }
+  }
+  assert ( p != 0 );
+  if ( p != first ) {
+    harris_count ++;
+  }
+  return ( p );
+}
+
+
+/****************************************************************
+**  exchange
+**
+**  Step 'AT': exchanges the variables of row p and column q by
+**  a pivot step on the matrix. The rows are updated each with
+**  the pivot row (see pivkern.h), by all threads (see
+**  'run_share'). Every element is calculated by the same
+**  operations as in the book, so the results do not depend on
+**  the order of the rows. A row whose element in column q is
+**  zero only changes in this element.
+**
+**  IN  : n, m = see 'simplex'.
+**        p, q = pivot row and column.
+****************************************************************/ 
+
+void exchange
+       ( n, m, p, q )
+int
+  n;
+int
+  m;
+int
+  p;
+int
+  q;
+{
+  REAL
+    *prow,
+    pivot;
+  int
+    k;
+
+  prow = row_ptr ( p );
+  pivot = prow [ q - 1 ];
+  for ( k = 0; k <= n; k ++ ) {
+    if ( k != q - 1 ) {
+      prow [k] = - prow [k] / pivot;
+    }
+  }
+
+  /* The pivot element is still in prow [q-1] */
+  job_n = n;
+  job_m = m;
+  job_p = p;
+  job_q = q;
+  job_prow = prow;
+  run_job ( JOB_UPDATE );
+  prow [ q - 1 ] = 1.0 / pivot;
+
+  /* The variables exchange their bounds as well */
+  if ( row_range != NULL ) {
+    pivot = row_range [p];
+    row_range [p] = col_range [q];
+    col_range [q] = pivot;
+  }
+}
+
+
+/****************************************************************
+**  orig_ptr
+**
+**  Returns a pointer to the first element of a row of the
+**  matrix before elimination (see 'refactor_tableau').
+**
+**  IN  : row = row number. The first row index is 1.
+****************************************************************/ 
+
+#define orig_ptr(row)	( original + ( (row) - 1 ) * width )
+
+
+/****************************************************************
+**  expression
+**
+**  Gets a variable of the tableau as expression of the original
+**  variables (the columns before elimination):
+**
+**     v = sum ( k=1..n, a[k]*x[k] ) + c
+**
+**  IN  : v = variable as in the vectors ba and nb of 'simplex':
+**            k > 0 is x[k], -i < 0 is y[i], i = 1..m+1 (m+1
+**            is the cost function).
+**        n = number of original variables.
+**        a = vector to receive the coefficients (0..n-1).
+**        c = variable to receive the constant.
+****************************************************************/ 
+
+void expression
+       ( v, n, a, c )
+int
+  v;
+int
+  n;
+REAL_ARG
+  a [];
+REAL_ARG
+  *c;
+{
+  REAL
+    *row;
+  int
+    k;
+
+  if ( v > 0 ) {
+    for ( k = 0; k < n; k ++ ) {
+      a [k] = 0.0;
+    }
+    a [ v - 1 ] = 1.0;
+    *c = 0.0;
+  }
+  else {
+    row = orig_ptr ( - v );
+    for ( k = 0; k < n; k ++ ) {
+      a [k] = row [k];
+    }
+    *c = row [n];
+  }
+}
+
+
+/****************************************************************
+**  solve_row
+**
+**  Solves the system B' * t = a with the LU decomposition of B'
+**  in job_lu and job_perm (see 'refactor_tableau').
+**
+**  IN  : n = dimension of the system.
+**        a = right-hand side (0..n-1).
+**        t = vector to receive the solution (0..n-1).
+****************************************************************/ 
+
+void solve_row
+       ( n, a, t )
+int
+  n;
+REAL_ARG
+  a [];
+REAL_ARG
+  t [];
+{
+  REAL_ARG
+    *lu, s;
+  int
+    j, k;
+
+  /* L * y = P * a */
+  for ( j = 0; j < n; j ++ ) {
+    lu = job_lu + (long) j * n;
+    s = a [ job_perm [j] ];
+    for ( k = 0; k < j; k ++ ) {
+      s -= lu [k] * t [k];
+    }
+    t [j] = s;
+  }
+
+  /* U * t = y */
+  for ( j = n - 1; j >= 0; j -- ) {
+    lu = job_lu + (long) j * n;
+    s = t [j];
+    for ( k = j + 1; k < n; k ++ ) {
+      s -= lu [k] * t [k];
+    }
+    t [j] = s / lu [j];
+  }
+}
+
+
+/****************************************************************
+**  refactor_row
+**
+**  Calculates row i of the tableau again (see
+**  'refactor_tableau'). The row is the solution t of B' * t = a,
+**  where a holds the coefficients of the variable of the row;
+**  its constant is c - t * cb. With --refine, the residual a - B' * t is
+**  calculated in long double, and t is corrected by the
+**  solution of B' * d = residual.
+**
+**  IN  : i       = row (1..m+1).
+**        t       = number of the thread.
+**        a, b, r = vectors of dimension n, used as work space.
+****************************************************************/ 
+
+void refactor_row
+       ( i, t, a, b, r )
+int
+  i;
+int
+  t;
+REAL_ARG
+  a [];
+REAL_ARG
+  b [];
+REAL_ARG
+  r [];
+{
+  REAL
+    *row;
+  REAL_ARG
+    c, d;
+  long double
+    s;
+  int
+    j, k, v, n;
+
+  n = job_n;
+  v = ( i <= job_m ) ? job_nb [i] : - i;
+  expression ( v, n, a, &c );
+  solve_row ( n, a, b );
+
+  if ( refine ) {
+    /* r = a - B' * b; column j of B' is the variable ba [j+1] */
+    for ( k = 0; k < n; k ++ ) {
+      r [k] = a [k];
+    }
+    for ( j = 0; j < n; j ++ ) {
+      v = job_ba [ j + 1 ];
+      if ( v > 0 ) {
+        r [ v - 1 ] -= b [j];
+      }
+    }
+    for ( k = 0; k < n; k ++ ) {
+      s = r [k];
+      for ( j = 0; j < n; j ++ ) {
+        v = job_ba [ j + 1 ];
+        if ( v < 0 ) {
+          s -= (long double) orig_ptr ( - v ) [k] * b [j];
+        }
+      }
+      r [k] = (REAL_ARG) s;
+    }
+    solve_row ( n, r, a );
+    for ( j = 0; j < n; j ++ ) {
+      b [j] += a [j];
+    }
+    part_count [t] ++;
+  }
+
+  /* Constant: c - b * cb */
+  s = c;
+  for ( j = 0; j < n; j ++ ) {
+    v = job_ba [ j + 1 ];
+    if ( v < 0 ) {
+      s -= (long double) b [j] * orig_ptr ( - v ) [n];
+    }
+  }
+
+  /* Store row, remember largest change */
+  row = row_ptr ( i );
+  for ( k = 0; k <= n; k ++ ) {
+    d = ( k < n ) ? b [k] : (REAL_ARG) s;
+    if ( fabs ( (double) ( d - row [k] ) ) > part_val [t] ) {
+      part_val [t] = fabs ( (double) ( d - row [k] ) );
+    }
+    row [k] = d;
+  }
+}
+
+
+/****************************************************************
+**  refactor_tableau
+**
+**  Calculates the tableau again from the matrix before the
+**  elimination (original), so that the round-off errors of the
+**  pivot steps since then are removed (--stable). The variables
+**  of the columns (ba) are y = B * x + cb in the original
+**  variables x. A row with the variable v = a * x + c then is
+**
+**     v = a * inverse(B) * y + c - a * inverse(B) * cb.
+**
+**  B' (the transposed matrix) is decomposed into L * U with
+**  partial pivoting once; the rows are then calculated by all
+**  threads (see 'refactor_row').
+**
+**  IN  : n, m   = see 'simplex'.
+**        ba, nb = variables of the columns and rows.
+**
+**  OUT : Function returns TRUE if the tableau was calculated
+**        again; FALSE if B is singular in the precision used.
+****************************************************************/ 
+
+BOOL refactor_tableau
+       ( n, m, ba, nb )
+int
+  n;
+int
+  m;
+int
+  *ba;
+int
+  *nb;
+{
+  REAL_ARG
+    *lu, *col, c, max, f;
+  int
+    h, i, j, k, p;
+  BOOL
+    ok;
+
+  lu = (REAL_ARG *) calloc ( (long) n * n, sizeof ( REAL_ARG ) );
+  col = (REAL_ARG *) calloc ( n, sizeof ( REAL_ARG ) );
+  job_perm = (int *) calloc ( n, sizeof ( int ) );
+  assert ( ( lu != NULL ) && ( col != NULL ) && ( job_perm != NULL ) );
+
+  /* Column j of B' holds the coefficients of ba [j+1] */
+  for ( j = 0; j < n; j ++ ) {
+    expression ( ba [ j + 1 ], n, col, &c );
+    for ( k = 0; k < n; k ++ ) {
+      lu [ (long) k * n + j ] = col [k];
+    }
+  }
+  for ( k = 0; k < n; k ++ ) {
+    job_perm [k] = k;
+  }
+
+  /* Decomposition with partial pivoting; rows are exchanged */
+  ok = TRUE;
+  for ( j = 0; ( j < n ) && ok; j ++ ) {
+    p = j;
+    max = fabs ( (double) lu [ (long) j * n + j ] );
+    for ( i = j + 1; i < n; i ++ ) {
+      if ( fabs ( (double) lu [ (long) i * n + j ] ) > max ) {
+        p = i;
+        max = fabs ( (double) lu [ (long) i * n + j ] );
+      }
+    }
+    if ( max == 0.0 ) {
+      ok = FALSE;
+      break;
+    }
+    if ( p != j ) {
+      for ( k = 0; k < n; k ++ ) {
+        f = lu [ (long) p * n + k ];
+        lu [ (long) p * n + k ] = lu [ (long) j * n + k ];
+        lu [ (long) j * n + k ] = f;
+      }
+      h = job_perm [p];
+      job_perm [p] = job_perm [j];
+      job_perm [j] = h;
+    }
+    for ( i = j + 1; i < n; i ++ ) {
+      f = lu [ (long) i * n + j ] / lu [ (long) j * n + j ];
+      lu [ (long) i * n + j ] = f;
+      if ( f == 0.0 ) continue;
+      for ( k = j + 1; k < n; k ++ ) {
+        lu [ (long) i * n + k ] -= f * lu [ (long) j * n + k ];
+      }
+    }
+  }
+
+  if ( ok ) {
+    job_n = n;
+    job_m = m;
+    job_ba = ba;
+    job_nb = nb;
+    job_lu = lu;
+    run_job ( JOB_REFACTOR );
+    for ( i = 0; i < team_size; i ++ ) {
+      refine_count += part_count [i];
+      if ( part_val [i] > max_drift ) {
+        max_drift = part_val [i];
+      }
+    }
+    refactor_count ++;
+  }
+  else {
+    fprintf ( stderr, "refactor_tableau: basis singular, skipped\n" );
+  }
+
+  free ( lu );
+  free ( col );
+  free ( job_perm );
+  return ( ok );
+}
+
+
+/****************************************************************
+**  calc_rsv
+**
+**  IN  : d1, d2 = numbers of the two documents
+**        konst  = pointer to variable where constant factor 
+**                 of RSV is to be stored.
+**        v      = pointer to vector where factors of individual
+**                 weights are to be stored.
+**
+**  OUT : The vector v is filled with the appropriate values.
+**        The value of the constant factor is returned. The
+**        indices of the elements which were set are appended
+**        to glob_index (at most num_weights); the others are
+**        not changed.
+****************************************************************/
+
+BOOL union_proc
+       ( a1, a2 )
+ELEMENT
+  a1;
+ELEMENT
+  a2;
+{
+  float
+    p;
+  WGT_STRUCT
+    *at1, *at2;
+  int
+    matidx;
+  IDF_STRUCT
+    t, *unused;
+
+  at1 = (WGT_STRUCT *) a1;
+  at2 = (WGT_STRUCT *) a2;
+  assert ( at1 -> d_atom == at2 -> d_atom );
+  
+  /* Multiply weights */
+  p = ( at1 -> weight * at2 -> weight );
+  
+  /* Set vector element of this atomic concept. The atom is not
+     necessarily used because there is a limit on the number of atoms
+     that can be optimized. */
+  matidx = matrix_index ( at1 -> d_atom );
+  if ( matidx != -1 ) {
+    glob_v [ matidx ] = p;
+    glob_index [ glob_count ++ ] = matidx;
+    if ( p != 0.0 ) {
+      glob_bool = TRUE;
+    }
+  }
+  else {
+    /* unused atom; look up in unused_wgts and add to constant factor */
+    t.u_atom = at1 -> d_atom;
+    unused = (IDF_STRUCT *) lookup_list ( unused_wgts, 
+               (ELEMENT) &t, comp_unused );
+    assert ( unused != NULL );
+    glob_const += ( p * unused -> idf );
+  }
+
+  return ( TRUE );
+}
+
+
+BOOL calc_rsv
+         ( d1, d2, v, konst )
+int
+  d1;
+int
+  d2;
+float
+  v [];
+float
+  *konst;
+{
+  DOC_STRUCT
+    t, *q, *d;
+
+  glob_v = v;
+
+  /* Get document descriptions of d1 and d2 and store into global vars */
+  t.index = d1;
+  q = (DOC_STRUCT *) lookup_list ( doc_list, (ELEMENT) &t, comp_doc );
+  assert ( q != NULL );
+
+  t.index = d2;
+  d = (DOC_STRUCT *) lookup_list ( doc_list, (ELEMENT) &t, comp_doc );
+  assert ( d != NULL );
+
+  glob_const = 0.0;
+  glob_bool = FALSE;
+  
+  find_union_gallop ( q -> docatoms, d -> docatoms, comp_wgt, union_proc );
+  *konst = glob_const;
+  
+  return ( glob_bool );
+}
+
+
+/****************************************************************
+**  calc_equations
+**
+**  Calculates the constraint equations which must be satisfied
+**  by the optimized weights, as well as the cost function.
+**
+**  IN  : x = vector containing the inverse document frequency
+**            of all atomic concepts. This vector is used to
+**            generate the bounds (4.2, 4.3) on p.78 of the thesis.
+**
+**  OUT : dryrun = FALSE:
+**        The RSV equations are written into the simplex tableau
+**        (or, with --revised, their nonzero elements into the
+**        global vectors eq_xxx), and cost is initialized;
+**        low_bound and high_bound hold the bounds of the weights.
+**        The bounds are not stored as equations (see
+**        make_tableau). No dense equation vectors are built.
+**
+**        dryrun = TRUE:
+**        Nothing is changed. The function returns the number
+**        of actual matrix rows, and num_nonzeros is set to the
+**        number of their nonzero elements. The caller should
+**        then allocate the tableau or the eq_xxx vectors and
+**        call enum_pref a second time with dryrun = FALSE.
+****************************************************************/
+
+float *alloc_vector
+	  ( )
+{
+  float 
+    *v;
+
   /* Note that calloc initializes the vector to zero */
   v = (float *) calloc ( num_weights + 1, sizeof ( float ) );
   if ( v == NULL ) {
@@ -979,21 +2102,22 @@ float *alloc_vector
 
 int enum_pref
        ( prefs, dryrun )
-FILE
-  *prefs;
+READER
+  prefs;
 BOOL
   dryrun;
 {
   float
     c1, c2,
     *v1, *v2, 
-    sign;
+    sign, val;
+  REAL
+    *row;
   int
-    i, d, d1, d2,
-    idx, res;
+    i, k, d, d1, d2,
+    idx, res, count;
   char
-    type,
-    line [ LINE_LENGTH ];
+    type;
   BOOL 
     nonzero1,
     nonzero2;
@@ -1001,26 +2125,35 @@ BOOL
     num_plus,
     num_minus;
 
-  num_plus = num_minus = idx = 0;
+  num_plus = num_minus = idx = count = 0;
+  row = NULL;
+
+  /* v1 and v2 are only used at the elements listed in glob_index,
+     and cleared again after each preference */
+  v1 = alloc_vector ();
+  v2 = alloc_vector ();
+  glob_index = (int *) calloc ( 2 * num_weights + 1, sizeof ( int ) );
+  assert ( glob_index != NULL );
   
   /* Read preference file again */
-  while ( fgets ( line, LINE_LENGTH, prefs ) ) {
+  while ( read_line ( prefs ) ) {
   
     /* Parse preference type and 3 document numbers */
-    res = sscanf ( line, "%c %d %d %d", &type, &d, &d1, &d2 );
-    assert ( res == 4 );
+    res = get_char ( prefs, &type ) && get_int ( prefs, &d ) && 
+          get_int ( prefs, &d1 ) && get_int ( prefs, &d2 );
+    assert ( res );
 
     /* Calculate RSV( d, d1 ) and RSV( d, d2 ) */
-    v1 = alloc_vector ();
-    v2 = alloc_vector ();
+    glob_count = 0;
     nonzero1 = calc_rsv ( d, d1, v1, &c1 );
     nonzero2 = calc_rsv ( d, d2, v2, &c2 );
 
     /* check if any atomic concept occurs in one of the documents and the query */
     if ( ( ! nonzero1 ) && ( ! nonzero2 ) ) {
       /* No common concepts, so ignore preference */
-      free ( v1 );
-      free ( v2 );
+      for ( i = 0; i < glob_count; i ++ ) {
+        v1 [ glob_index [i] ] = v2 [ glob_index [i] ] = 0.0;
+      }
       continue;
     }
     
@@ -1032,15 +2165,6 @@ BOOL
       num_minus ++;
     }
     
-    if ( dryrun ) {
-      /* Don't actually perform calculations; simply count number of
-         preferences with common concepts */
-      if ( type != 'C' ) idx ++;
-      free ( v1 );
-      free ( v2 );
-      continue;
-    }
-    
     /* Get difference between both RSV values; negate vector elements if
        this preference is satisfied (equation 4.4) */
     if ( ( type == '-' ) || ( type == 'C' ) ) {
@@ -1051,32 +2175,67 @@ BOOL
       /* satisfied */
       sign = -1.0;
     }
-    
-    /* Add result to matrix and throw away v1, v2 */
-    for ( i = 0; i < num_weights; i ++ ) {
-      v1 [i] = ( v1 [i] - v2 [i] ) * sign;
-    }
-    v1 [ num_weights ] = sign * ( EPSILON + ( c1 - c2 ) );
- 
-    if ( type != 'C' ) {
-      rsv_eq [ idx ] = v1;
-      alloc_count ++;
-      idx ++;
+    if ( ( ! dryrun ) && ( type != 'C' ) && ( tableau != NULL ) ) {
+      row = row_ptr ( num_weights + idx + 1 );
     }
-    free ( v2 );
 
-    /* If this is an unsatisfied preference, add vector v1 to cost function */
-    if ( ( type == '-' ) || ( type == 'C' ) ) {
-      for ( i = 0; i <= num_weights; i ++ ) {
-	/* We perform a subtraction because cost must be MINIMIZED */
-        cost [i] -= v1 [i];
+    /* Add the nonzero elements to the matrix and clear v1, v2; an
+       index listed twice gives 0.0 the second time. In a dry run,
+       the elements are only counted. */
+    for ( i = 0; i < glob_count; i ++ ) {
+      k = glob_index [i];
+      val = ( v1 [k] - v2 [k] ) * sign;
+      v1 [k] = v2 [k] = 0.0;
+      if ( val == 0.0 ) continue;
+
+      if ( ( ! dryrun ) && ( ( type == '-' ) || ( type == 'C' ) ) ) {
+        /* Unsatisfied preference: add the element to the cost
+           function. We perform a subtraction because cost must
+           be MINIMIZED */
+        cost [k] -= val;
+      }
+      if ( type == 'C' ) continue;
+
+      if ( dryrun ) {
+        /* Only count the element */
+      }
+      else if ( tableau != NULL ) {
+        row [k] = val;
       }
-      if ( type == 'C' ) {
-        free ( v1 );
+      else {
+        eq_col [ count ] = k;
+        eq_val [ count ] = val;
       }
+      count ++;
+    }
+    if ( dryrun ) {
+      if ( type != 'C' ) idx ++;
+      continue;
+    }
+
+    val = sign * ( EPSILON + ( c1 - c2 ) );
+    if ( ( type == '-' ) || ( type == 'C' ) ) {
+      cost [ num_weights ] -= val;
     }
+    if ( type == 'C' ) continue;
+    if ( tableau != NULL ) {
+      row [ num_weights ] = val;
+    }
+    else {
+      eq_konst [ idx ] = val;
+      eq_start [ idx + 1 ] = count;
+    }
+    idx ++;
   }
   
+  free ( v1 );
+  free ( v2 );
+  free ( glob_index );
+  glob_index = NULL;
+  if ( dryrun ) {
+    num_nonzeros = count;
+  }
+
   fprintf ( stderr, "Preferences: %d\n", idx );
   fprintf ( stderr, "Total + : %d, - : %d\n", num_plus, num_minus );
   assert ( num_plus + num_minus == idx );
@@ -1088,54 +2247,50 @@ BOOL
 
 void calc_equations
        ( prefs, x )
-FILE
-  *prefs;
+READER
+  prefs;
 float
   x [];
 {
   int
     i;
-  float
-    *arr;
 
   /* Satisfied and unsatisfied preferences and cost function */
   cost = alloc_vector ();
   fprintf ( stderr, "   cost/rsv simulation\n" );
   num_prefs = enum_pref ( prefs, TRUE );
   
-  /* Allocate sufficient memory for the matrix rows */
-  rsv_eq = (float **) calloc ( num_prefs, sizeof ( float * ) );
-  assert ( rsv_eq != NULL );
+  /* Allocate sufficient memory for the matrix rows: the simplex
+     tableau, or the nonzero elements for the revised method */
+  if ( revised ) {
+    eq_start = (int *) calloc ( num_prefs + 1, sizeof ( int ) );
+    eq_konst = (float *) calloc ( num_prefs + 1, sizeof ( float ) );
+    eq_col = (int *) calloc ( num_nonzeros + 1, sizeof ( int ) );
+    eq_val = (float *) calloc ( num_nonzeros + 1, sizeof ( float ) );
+    assert ( ( eq_start != NULL ) && ( eq_konst != NULL ) && 
+             ( eq_col != NULL ) && ( eq_val != NULL ) );
+  }
+  else {
+    alloc_tableau ( num_weights, 
+                    ( bounded ? 1 : 3 ) * num_weights + num_prefs );
+  }
 
   /* Call enum_pref a second time */
-  rewind ( prefs );
+  rewind_reader ( prefs );
   fprintf ( stderr, "   cost/rsv calculation\n" );
   enum_pref ( prefs, FALSE );
 
   /* List of unused weights is no longer needed */
-  destroy_list ( &unused_wgts );
+  destroy_list_arena ( &unused_wgts );
   
-  /* Allocate arrays of pointers to vectors */
-  min_weights = (float **) calloc ( num_weights, sizeof ( float * ) );
-  assert ( min_weights != NULL );
-  max_weights = (float **) calloc ( num_weights, sizeof ( float * ) );
-  assert ( max_weights != NULL );
-
   /* Low and high bounds of atomic weights */
   fprintf ( stderr, "   min/max\n" );
+  low_bound = (float *) calloc ( num_weights + 1, sizeof ( float ) );
+  high_bound = (float *) calloc ( num_weights + 1, sizeof ( float ) );
+  assert ( ( low_bound != NULL ) && ( high_bound != NULL ) );
   for ( i = 0; i < num_weights; i ++ ) {
-
-    /* Low bounds */
-    arr = alloc_vector ();
-    arr [i] = 1.0;
-    arr [ num_weights ] = - C1 * x [i];
-    min_weights [i] = arr;
-   
-    /* High bounds */
-    arr = alloc_vector ();
-    arr [i] = -1.0;
-    arr [ num_weights ] = C2 * x [i];
-    max_weights [i] = arr;
+    low_bound [i] = C1 * x [i];
+    high_bound [i] = C2 * x [i];
   }
 }
 
@@ -1176,11 +2331,45 @@ float
 }
 
 
+/****************************************************************
+**  inaccuracy
+**
+**  Reports a constant of the tableau which has the wrong sign
+**  because of round-off errors; the caller sets it to 0.0. With
+**  --stable, this is expected: it is only counted.
+**
+**  IN  : where = name of the procedure.
+**        row   = row of the constant.
+**        val   = value of the constant (a REAL value).
+****************************************************************/
+
+void inaccuracy
+       ( where, row, val )
+char
+  *where;
+int
+  row;
+REAL_ARG
+  val;
+{
+  if ( stable ) {
+    clamp_count ++;
+  }
+  else {
+    fprintf ( stderr, "%s: inaccuracy, row %d, val = %f\n", where, row, 
+              (double) val );
+  }
+}
+
+
 /****************************************************************
 **  eliminate 
 **
 **  Performs elimination of free variables (see book, pp.72)
 **
+**  With --bounded, the ratio test also considers the rows whose
+**  variable reaches its upper bound (see 'ratio_row').
+**
 **  IN  : n = Number of variables to be maximized.
 **        m = Number of constraint equations to be satisfied.
 **        a = Matrix with n+1 columns and m+1 rows. Rows 1..m
@@ -1209,61 +2398,56 @@ BOOL
   *trans;
 {
   int
-    h, i, k, p, q;
-  float
+    h, i, p, q;
+  REAL
     max,
-    pivot,
     quot,
-    temp;
+    temp,
+    konst,
+    dir;
+  BOOL
+    upper,	/* p reaches its upper bound (--bounded) */
+    at_upper;
 
-  /* Eliminate all 'n' free variables; pivot column is q */
+  /* Eliminate all 'n' free variables; pivot column is q. The
+     variable decreases if its cost is not positive; dir is the
+     sign of its change */
   for ( q = 1; q <= n; q ++ ) {
 
     p = 0;
-    if ( elt ( m + 1, q ) > 0.0 ) { 
-      max = -99999999999.9;  /* This should read 'minus infinity' */
-      for ( i = 1; i <= m; i ++ ) {
-	if ( ! trans [i] ) {
-          temp = elt ( i, q );
-          if ( temp < 0.0 ) {
-            quot = elt ( i, n + 1 ) / temp;
-	    if ( quot >= 0.0 ) {
-	      fprintf ( stderr, "eliminate: inaccuracy, val = %f\n", elt
-	      ( i, n + 1 ) );
-	      set ( i, n + 1, 0.0 );
-	      quot = 0.0;
-            }
-	    assert ( quot <= 0.0 );
-            if ( quot > max ) {	
-              p = i;
-              max = quot;
-	    }
-	  }
-        }
+    dir = ( elt ( m + 1, q ) > 0.0 ) ? 1.0 : -1.0;
+    max = ( dir > 0.0 ) ? - HUGE_VAL : HUGE_VAL;
+    upper = FALSE;
+    for ( i = 1; i <= m; i ++ ) {
+      if ( trans [i] ) continue;
+      temp = elt ( i, q );
+      konst = elt ( i, n + 1 );
+      at_upper = ( row_range != NULL ) && ( dir * temp > 0.0 ) &&
+                 ( row_range [i] != HUGE_VAL );
+      if ( at_upper ) {
+        /* With --bounded, the row increases to its upper bound;
+           treat it as if complemented */
+        temp = - temp;
+        konst = row_range [i] - konst;
       }
-    }
-    else {
-      max = 99999999999.9;  /* This should read 'infinity' */
-      for ( i = 1; i <= m; i ++ ) {
-	if ( ! trans [i] ) {
-          temp = elt ( i, q );
-          if ( temp > 0.0 ) {
-            quot = elt ( i, n + 1 ) / temp;
-	    if ( quot < 0.0 ) {
-	      fprintf ( stderr, "eliminate: inaccuracy, val = %f\n", elt
-	      ( i, n + 1 ) );
-	      set ( i, n + 1, 0.0 );
-	      quot = 0.0;
-            }
-	    assert ( quot >= 0.0 );
-            if ( quot < max ) {	
-              p = i;
-              max = quot;
-	    }
-          }
-        }
+      if ( dir * temp >= 0.0 ) continue;
+
+      quot = konst / temp;
+      if ( ( dir > 0.0 ) ? ( quot >= 0.0 ) : ( quot < 0.0 ) ) {
+        inaccuracy ( "eliminate", i, konst );
+        set ( i, n + 1, at_upper ? row_range [i] : 0.0 );
+        quot = 0.0;
+      }
+      assert ( dir * quot <= 0.0 );
+      if ( ( dir > 0.0 ) ? ( quot > max ) : ( quot < max ) ) {
+        p = i;
+        max = quot;
+        upper = at_upper;
       }
     }
+    if ( upper ) {
+      complement_row ( n, p );
+    }
 
     /* If p is zero, the system does not have a solution! */
     assert ( p != 0 );
@@ -1273,23 +2457,7 @@ BOOL
     nb [p] = ba [q];
     ba [q] = h;
     trans [p] = TRUE;
-    pivot = elt ( p, q );
-
-    for ( k = 1; k <= n + 1; k ++ ) {
-      if ( k != q ) {
-        set ( p, k, - elt ( p, k ) / pivot );
-        for ( i = 1; i <= m + 1; i ++ ) {
-	  if ( i != p ) {
-            set ( i, k, elt (i, k) + elt (i, q) * elt (p, k) );
-	  }
-        }
-      }
-    }
-
-    for ( i = 1; i <= m + 1; i ++ ) {
-      set ( i, q, elt ( i, q ) / pivot );
-    }
-    set ( p, q, 1.0 / pivot );
+    exchange ( n, m, p, q );
 
     /* Running count */
     fprintf ( counter, "%d\r", q );
@@ -1299,6 +2467,74 @@ BOOL
 }
 
 
+/****************************************************************
+**  complement_row
+**
+**  With --bounded: replaces the variable v of row p by U - v,
+**  where U is its upper bound. The new variable is 0 where v
+**  reaches U, so that the row can be the pivot row of a
+**  variable which increases v.
+**
+**  IN  : n = see 'simplex'.
+**        p = row.
+****************************************************************/ 
+
+void complement_row
+       ( n, p )
+int
+  n;
+int
+  p;
+{
+  REAL
+    *row;
+  int
+    k;
+
+  row = row_ptr ( p );
+  for ( k = 0; k < n; k ++ ) {
+    row [k] = - row [k];
+  }
+  row [n] = row_range [p] - row [n];
+  upper_count ++;
+}
+
+
+/****************************************************************
+**  complement_column
+**
+**  With --bounded: replaces the variable v of column q, which
+**  has reached its upper bound U, by U - v. Every row gets
+**  U times its element in column q added to its constant, and
+**  the element changes its sign. The new variable is 0 again.
+**
+**  IN  : n, m = see 'simplex'.
+**        q    = column.
+****************************************************************/ 
+
+void complement_column
+       ( n, m, q )
+int
+  n;
+int
+  m;
+int
+  q;
+{
+  REAL
+    *row;
+  int
+    i;
+
+  for ( i = 1; i <= m + 1; i ++ ) {
+    row = row_ptr ( i );
+    row [n] += row [ q - 1 ] * col_range [q];
+    row [ q - 1 ] = - row [ q - 1 ];
+  }
+  flip_count ++;
+}
+
+
 /****************************************************************
 **  simplex
 **
@@ -1333,6 +2569,10 @@ BOOL
 **        and the function returns TRUE.
 **        Otherwise, the function returns FALSE and the contents
 **        of x are invalid.
+**
+**  The matrix is created by 'make_tableau' when the procedure
+**  starts. With option --revised, the system is solved by the
+**  procedure 'sparse_simplex' instead, without the matrix.
 ****************************************************************/
 
 BOOL simplex
@@ -1347,16 +2587,19 @@ float
   int
     h, i, j, k, p, q, temp2,
     iterations,
+    since,   /* pivot steps since the last refactorisation */
     *ba,     /* dynamic array, dim n */
     *nb;     /* dynamic array, dim m */
   BOOL
     *trans;	/* dynamic, dim m */
-  float
-    max,
-    pivot,
-    quot,
+  REAL
     temp;
 
+  if ( revised ) {
+    return ( sparse_simplex ( n, m, x ) );
+  }
+  make_tableau ( n, m, x );
+
   /* Allocate ba and nb vectors; dimension n+1 so we can address
      from 1..n */
   ba = (int *) calloc ( n + 1, sizeof ( int ) );
@@ -1388,15 +2631,24 @@ float
     set ( i, n + 1, elt ( i, n + 1 ) + temp );   /* a[in] is c[i] */
     if ( i <= m ) {
       if ( elt ( i, n + 1 ) < 0.0 ) {
-	fprintf ( stderr, "Warning: inaccuracy, row %d, val %f\n", i, elt
-	( i, n + 1 ) );
+	inaccuracy ( "simplex", i, elt ( i, n + 1 ) );
 	set ( i, n + 1, 0.0 );
       }
     }
   }
 
+  /* Keep the matrix for refactorisation */
+  if ( stable ) {
+    original = (REAL *) malloc ( ( m + 1 ) * width * sizeof ( REAL ) );
+    assert ( original != NULL );
+    memcpy ( original, tableau, ( m + 1 ) * width * sizeof ( REAL ) );
+  }
+
   fprintf ( stderr, "Elimination.\n" );
   eliminate ( n, m, ba, nb, trans );
+  if ( stable ) {
+    refactor_tableau ( n, m, ba, nb );
+  }
 
 #ifndef NDEBUG
   /* Perform test to see if all c[i] elements positive (except those
@@ -1404,8 +2656,7 @@ float
   for ( i = 1; i <= m; i ++ ) {
     if ( ! trans [i] ) {
       if ( elt ( i, n + 1 ) < 0.0 ) {
-	fprintf ( stderr, "inaccurracy after elimination, val=%f\n", 
-	  elt ( i, n + 1 ) );
+	inaccuracy ( "elimination", i, elt ( i, n + 1 ) );
         set ( i, n + 1, 0.0 );
       }
       assert ( elt ( i, n + 1 ) >= 0.0 );
@@ -1415,42 +2666,31 @@ float
 
   fprintf ( stderr, "Calculation loop start.\n" );
   iterations = 0;
+  since = 0;
   
   do {
-    q = 0;
-    max = 0.0;
-
-    /* Step 'PIV' */
-    for ( k = 1; k <= n; k ++ ) {
-      temp = elt ( m + 1, k );
-      if ( temp > max ) {
-        q = k;
-        max = temp;
-      }
+    /* Step 'PIV': first largest positive element of the cost
+       function */
+    q = piv_column ( n, m );
+
+    /* With --stable, the optimum must hold after refactorisation */
+    if ( ( q == 0 ) && stable && ( since > 0 ) ) {
+      refactor_tableau ( n, m, ba, nb );
+      since = 0;
+      q = piv_column ( n, m );
     }
 
     /* Exit while-loop if q is zero */
     if ( q == 0 ) break;
 
-    p = 0;
-    max = -99999999999.9;  /* This should read 'minus infinity' */
-    for ( i = 1; i <= m; i ++ ) {
-      /* Translation equations are not considered since they do not 
-	 exist in the scheme anymore */
-      if ( ! trans [i] ) {
-        temp = elt ( i, q );
-        if ( temp < 0.0 ) {
-          quot = elt ( i, n + 1 ) / temp;
-          if ( quot > max ) {	
-            p = i;
-            max = quot;
-          }
-        }
-      }
-    }
+    p = ratio_row ( n, m, q, trans );
+
+    /* With --bounded, column q may have been complemented */
+    if ( p < 0 ) continue;
 
     /* If p is zero, the system does not have a solution! */
     if ( p == 0 ) {
+      stop_team ();
       return ( FALSE );
     }
 
@@ -1458,27 +2698,16 @@ float
     h = nb [p];
     nb [p] = ba [q];
     ba [q] = h;
-    pivot = elt ( p, q );
-
-    for ( k = 1; k <= n + 1; k ++ ) {
-      if ( k != q ) {
-        set ( p, k, - elt ( p, k ) / pivot );
-        for ( i = 1; i <= m + 1; i ++ ) {
-          if ( i != p ) {
-            set ( i, k, elt (i, k) + elt (i, q) * elt (p, k) );
-          }
-        }
-      }
-    }
-
-    for ( i = 1; i <= m + 1; i ++ ) {
-      set ( i, q, elt ( i, q ) / pivot );
-    }
-
-    set ( p, q, 1.0 / pivot );
+    exchange ( n, m, p, q );
 
     iterations ++;
+    since ++;
+    if ( stable && ( since >= REFACTOR * n ) ) {
+      refactor_tableau ( n, m, ba, nb );
+      since = 0;
+    }
   } while ( TRUE );   /* = endless loop */
+  stop_team ();
 
   /* Step 'LOES' */
   for ( i = 1; i <= m; i ++ ) {
@@ -1491,10 +2720,165 @@ float
   }
 
   fprintf ( stderr, "Iterations: %d\n", iterations );
+  if ( bounded ) {
+    fprintf ( stderr, "Columns at their bound: %d, rows at their "
+              "bound: %d\n", flip_count, upper_count );
+  }
+  if ( stable ) {
+    fprintf ( stderr, "Harris pivots: %d, constants set to 0: %d\n",
+              harris_count, clamp_count );
+    fprintf ( stderr, "Refactorisations: %d, largest change %g, "
+              "refined rows: %d\n", refactor_count, max_drift, 
+              refine_count );
+  }
   return ( TRUE );
 }
 
 
+/****************************************************************
+**  sparse_simplex
+**
+**  Solves the system of 'simplex' with the revised simplex
+**  method (see revsimp.h). Only the nonzero coefficients of the
+**  RSV equations are passed on. The bounds of the weights are
+**  handled by the method as such: low_bound and high_bound, and
+**  0.0 (translation equations). RSV equations with a single
+**  coefficient are bounds as well.
+**
+**  IN  : n, m, x = see 'simplex'. Only the nonzero elements of
+**                  the RSV equations (eq_xxx, see 'enum_pref')
+**                  and the cost function exist; the equations
+**                  are freed once the matrix is built. The
+**                  simplex tableau is not created.
+**
+**  OUT : see 'simplex'.
+****************************************************************/
+
+BOOL sparse_simplex
+       ( n, m, x )
+int
+  n;
+int
+  m;
+float
+  x [];
+{
+  LP
+    lp;
+  int
+    *fill,	/* next position in each column */
+    i, j, k, rows, nonzeros, count, first,
+    pass;
+  double
+    *xd,	/* solution vector */
+    c, bound, x0;
+  BOOL
+    ok;
+
+  /* Pass 0 counts the coefficients of each column and sets the
+     bounds, pass 1 distributes the coefficients */
+  lp = NULL;
+  fill = (int *) calloc ( n + 1, sizeof ( int ) );
+  xd = (double *) calloc ( n + 1, sizeof ( double ) );
+  assert ( ( fill != NULL ) && ( xd != NULL ) );
+  for ( pass = 0; pass < 2; pass ++ ) {
+    rows = nonzeros = 0;
+    for ( i = 0; i < num_prefs; i ++ ) {
+      first = eq_start [i];
+      count = eq_start [ i + 1 ] - first;
+      c = eq_konst [i];
+
+      if ( count > 1 ) {
+        for ( j = first; j < eq_start [ i + 1 ]; j ++ ) {
+          k = eq_col [j];
+          if ( pass == 0 ) {
+            fill [ k + 1 ] ++;
+          }
+          else {
+            lp -> row [ fill [k] ] = rows;
+            lp -> coef [ fill [k] ] = eq_val [j];
+            fill [k] ++;
+          }
+        }
+        if ( pass == 1 ) {
+          lp -> konst [ rows ] = c;
+        }
+        rows ++;
+        nonzeros += count;
+      }
+      else if ( ( count == 1 ) && ( pass == 1 ) ) {
+        /* a * x[k] + c >= 0. Like the other equations (see
+           'revised_simplex'), it is relaxed if the initial
+           value x0 of the weight does not satisfy it. */
+        k = eq_col [ first ];
+        bound = - c / eq_val [ first ];
+        x0 = x [k];
+        if ( x0 < low_bound [k] ) x0 = low_bound [k];
+        if ( x0 > high_bound [k] ) x0 = high_bound [k];
+        if ( x0 < 0.0 ) x0 = 0.0;
+        if ( ( eq_val [ first ] > 0.0 ) ? ( bound > x0 ) : ( bound < x0 ) ) {
+          fprintf ( stderr, "Warning: inaccuracy, bound of weight %d, "
+                    "val %f\n", k + 1, bound - x0 );
+          bound = x0;
+        }
+        if ( eq_val [ first ] > 0.0 ) {
+          if ( bound > lp -> lower [k] ) {
+            lp -> lower [k] = bound;
+          }
+        }
+        else {
+          if ( bound < lp -> upper [k] ) {
+            lp -> upper [k] = bound;
+          }
+        }
+      }
+    }
+
+    if ( pass == 0 ) {
+      /* Turn counts into positions */
+      lp = create_lp ( rows, n, nonzeros );
+      for ( k = 1; k <= n; k ++ ) {
+        fill [k] += fill [ k - 1 ];
+      }
+      for ( k = 0; k <= n; k ++ ) {
+        lp -> start [k] = fill [k];
+      }
+
+      /* Bounds; weights are never negative */
+      for ( k = 0; k < n; k ++ ) {
+        lp -> lower [k] = ( low_bound [k] > 0.0 ) ? low_bound [k] : 0.0;
+        lp -> upper [k] = high_bound [k];
+      }
+    }
+  }
+
+  /* The equations are no longer needed */
+  free ( eq_start );
+  free ( eq_col );
+  free ( eq_val );
+  free ( eq_konst );
+  eq_start = eq_col = NULL;
+  eq_val = eq_konst = NULL;
+
+  fprintf ( stderr, "Sparse matrix: %d rows, %d nonzeros.\n", rows, 
+            nonzeros );
+  for ( k = 0; k < n; k ++ ) {
+    lp -> obj [k] = cost [k];
+    xd [k] = x [k];
+  }
+
+  ok = revised_simplex ( lp, xd );
+  for ( k = 0; k < n; k ++ ) {
+    x [k] = (float) xd [k];
+  }
+
+  destroy_lp ( &lp );
+  free ( fill );
+  free ( xd );
+  return ( ok );
+}
+
+
 /****************************************************************
 **  destroy_signlist
 **
@@ -1516,7 +2900,7 @@ void destroy_signlist
        ( )
 {
   enum_list ( sign_list, destroy_atoms, ENUM_FORWARD );
-  destroy_list ( &sign_list );
+  destroy_list_arena ( &sign_list );
 }
 
 
@@ -1533,58 +2917,93 @@ char
 {
   BOOL
     ok;
-  FILE
-    *prefs, *f;
+  READER
+    prefs, r;
+  DESCR
+    d;
   float
     *x;   /* Pointer to the (dynamic) solution vector */
+  int
+    i;
 
   /* Program title */
   fprintf ( stderr, PROG );
   fprintf ( stderr, "Parameters: C1 = %f, C2 = %f\n", C1, C2 );
 
   /* Get verbose or quiet mode */
-  if ( ( argc == 6 ) && ( *argv [5] == 'Q' ) ) {
+  if ( ( argc >= 6 ) && ( strcmp ( argv [ argc - 1 ], "QUIET" ) == 0 ) ) {
     /* in case of quiet mode: redirect running counts to /dev/null */
     counter = fopen ( "/dev/null", "r" );
     assert ( counter != NULL );
+    argc --;
   }
   else {
     /* verbose mode: redirect running counts to stderr */
     counter = stderr;
   }
 
+  /* Get options */
+  ok = TRUE;
+  revised = bounded = stable = refine = FALSE;
+  for ( i = 5; i < argc; i ++ ) {
+    if ( strcmp ( argv [i], "--revised" ) == 0 ) {
+      revised = TRUE;
+    }
+    else if ( strcmp ( argv [i], "--bounded" ) == 0 ) {
+      bounded = TRUE;
+    }
+    else if ( strcmp ( argv [i], "--stable" ) == 0 ) {
+      stable = TRUE;
+    }
+    else if ( strcmp ( argv [i], "--refine" ) == 0 ) {
+      stable = refine = TRUE;
+    }
+    else {
+      ok = FALSE;
+    }
+  }
+  if ( revised && stable ) {
+    /* The revised method has no tableau to stabilize */
+    ok = FALSE;
+  }
+  if ( bounded && ( revised || stable ) ) {
+    /* The revised method has bounds anyway; the refactorisation
+       does not know the complemented variables */
+    ok = FALSE;
+  }
+
   /* Check parameters */
-  if ( argc < 5 ) {
+  if ( ( argc < 5 ) || ( ! ok ) ) {
     fprintf ( stderr, USAGE );
     return ( 1 );
   }
   
   /* Read preferences into memory */
   fprintf ( stderr, "Reading preferences.\n" );
-  prefs = open_file ( argv [1] );
+  prefs = open_reader ( argv [1] );
   process_pref ( prefs );
-  fclose ( prefs );
+  close_reader ( &prefs );
 
   /* Read atomic concepts of each sign */
   fprintf ( stderr, "Reading atomic concepts.\n" );
-  f = open_file ( argv [3] );
-  process_concepts ( f );
-  fclose ( f );
+  r = open_reader ( argv [3] );
+  process_concepts ( r );
+  close_reader ( &r );
   
   /* Read document descriptions (only those which are necessary) */
   fprintf ( stderr, "Reading document descriptions.\n" );
-  f = open_file ( argv [2] );
-  process_documents ( f );
-  fclose ( f );
+  d = open_descr ( argv [2] );
+  process_documents ( d );
+  close_descr ( &d );
   
   /* Destroy sign list to save memory */
   destroy_signlist ();
   
   /* Create ranking of atoms */
   fprintf ( stderr, "Serializing atoms.\n" );
-  prefs = open_file ( argv [1] );
+  prefs = open_reader ( argv [1] );
   serialize_atoms ( prefs );
-  fclose ( prefs );
+  close_reader ( &prefs );
   num_weights = count_list ( atom_list );
   fprintf ( stderr, "Weights to optimize: %d\n", num_weights );
   
@@ -1592,20 +3011,21 @@ char
      First, allocate memory for solution vector */
   fprintf ( stderr, "Initializing weights.\n" );
   x = alloc_vector ();
-  f = open_file ( argv [4] );
-  init_weights ( f, x );
-  fclose ( f );
+  r = open_reader ( argv [4] );
+  init_weights ( r, x );
+  close_reader ( &r );
   
   /* Calculate coefficients for each RSV constraint */
   fprintf ( stderr, "Calculating RSV values.\n" );
-  prefs = open_file ( argv [1] );
+  prefs = open_reader ( argv [1] );
   calc_equations ( prefs, x );
-  fclose ( prefs );
+  close_reader ( &prefs );
   
   /* Tackle the optimization problem */
   fprintf ( stderr, "Simplex algorithm.\n" );
   
-  ok = simplex ( num_weights, num_weights * 3 + num_prefs, x );
+  ok = simplex ( num_weights, 
+                 num_weights * ( bounded ? 1 : 3 ) + num_prefs, x );
   assert ( ok );
 
   /* Print results */
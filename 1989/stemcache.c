@@ -0,0 +1,279 @@
+/****************************************************************
+*
+*           S O F T W A R E   S O U R C E   F I L E
+*
+*****************************************************************
+*
+*   Name of file   : stemcache.c 
+*   Author         : Guido Hoss
+*   Project        : ETH Diploma Thesis (SS 1989)
+*   Creation Date  : 06/05/89
+*   Type of file   : C Language File
+*
+*   Description
+*   -----------
+*   Cache of word stems, see stemcache.h. The cache is a direct
+*   mapped table: the hash code of a word selects the only entry
+*   where the word may be stored. The entries are divided into
+*   stripes, each of them protected by a lock of its own, so
+*   threads seldom have to wait for each other.
+*
+*****************************************************************
+*
+*   COPYRIGHT (C) 1989, 2016 BY GUIDO HOSS.
+*
+*   This program is free software: you can redistribute it and/or 
+*   modify it under the terms of the GNU General Public License
+*   as published by the Free Software Foundation, either version 3
+*   of the License, or (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public
+*   License along with this program.  If not, see
+*   <http://www.gnu.org/licenses/>.
+*
+*   Git repository home: <https://github.com/ghoss/Thesis>
+*
+*****************************************************************
+* Date        :
+* Description :
+****************************************************************/   
+
+#include <stdio.h>
+#ifdef MSDOS
+#include <process.h>
+#endif
+#include <malloc.h>
+#include <assert.h>
+#include <string.h>
+#ifdef THREADS
+#include <pthread.h>
+#endif
+
+#include "boolean.h"
+#include "hash.h"
+#include "wordstem.h"
+#include "stemcache.h"
+
+#define KEY_LENGTH	24	/* Longer words are not cached */
+#define STEM_GROWTH	2	/* Max. number of letters added by stemmer */
+#define NUM_STRIPES	64	/* Number of locks, must be a power of 2 */
+#define MIN_ENTRIES	NUM_STRIPES
+
+typedef
+  struct {
+    unsigned	code;		/* Hash code of word */
+    int		len;		/* Length of word, 0 = free */
+    int		slen;		/* Length of stem */
+    char	key [ KEY_LENGTH ];
+    char	stem [ KEY_LENGTH + STEM_GROWTH ];
+  } CACHE_ENTRY;
+
+/* Entry i belongs to stripe i % NUM_STRIPES. The counters of a
+   stripe are updated while its lock is held. */
+typedef
+  struct {
+#ifdef THREADS
+    pthread_mutex_t	lock;
+#endif
+    unsigned long	hits;
+    unsigned long	misses;
+  } CACHE_STRIPE;
+
+struct stemcache_header {
+  CACHE_ENTRY	*entry;		/* Table of entries */
+  unsigned	mask;		/* Number of entries - 1 */
+  CACHE_STRIPE	stripe [ NUM_STRIPES ];
+};
+
+#ifdef THREADS
+#define lock_stripe(s)		pthread_mutex_lock ( &(s) -> lock )
+#define unlock_stripe(s)	pthread_mutex_unlock ( &(s) -> lock )
+#else
+#define lock_stripe(s)
+#define unlock_stripe(s)
+#endif
+
+
+/****************************************************************
+**  create_stemcache
+**
+**  Creates a new, empty stem cache.
+**
+**  IN  : size = number of entries. It is rounded up to a power
+**               of 2.
+**
+**  OUT : Function returns a handle to the new cache.
+****************************************************************/
+
+STEMCACHE create_stemcache
+            ( size )
+int
+  size;
+{
+  STEMCACHE
+    cache;
+  unsigned
+    n;
+  int
+    i;
+
+  cache = (STEMCACHE) malloc ( sizeof ( STEMCACHE_HEADER ) );
+  assert ( cache != NULL );
+
+  for ( n = MIN_ENTRIES; n < (unsigned) size; n <<= 1 );
+  cache -> mask = n - 1;
+  cache -> entry = (CACHE_ENTRY *) calloc ( n, sizeof ( CACHE_ENTRY ) );
+  assert ( cache -> entry != NULL );
+
+  for ( i = 0; i < NUM_STRIPES; i ++ ) {
+#ifdef THREADS
+    pthread_mutex_init ( &cache -> stripe [i].lock, NULL );
+#endif
+    cache -> stripe [i].hits = 0;
+    cache -> stripe [i].misses = 0;
+  }
+  return ( cache );
+}
+
+
+/****************************************************************
+**  destroy_stemcache
+**
+**  Frees a stem cache.
+**
+**  IN  : cache = pointer to handle of cache.
+**  OUT : '*cache' is set to NULL.
+****************************************************************/
+
+void destroy_stemcache
+       ( cache )
+STEMCACHE
+  *cache;
+{
+#ifdef THREADS
+  int
+    i;
+#endif
+
+  if ( *cache == NULL ) return;
+#ifdef THREADS
+  for ( i = 0; i < NUM_STRIPES; i ++ ) {
+    pthread_mutex_destroy ( &(*cache) -> stripe [i].lock );
+  }
+#endif
+  free ( (*cache) -> entry );
+  free ( *cache );
+  *cache = NULL;
+}
+
+
+/****************************************************************
+**  stem_cached
+**
+**  Stems a word, using the cache if possible. Words which are
+**  not in the cache are stemmed with 'StemWord' and entered
+**  into the cache.
+**
+**  IN  : cache = handle to cache.
+**        c     = stemmer context of calling thread.
+**        word  = null-terminated word in uppercase letters. The
+**                buffer must have room for 2 more letters.
+**        len   = length of word.
+**
+**  OUT : 'word' contains the root.
+****************************************************************/
+
+void stem_cached
+       ( cache, c, word, len )
+STEMCACHE
+  cache;
+STEM_CONTEXT
+  *c;
+char
+  *word;
+int
+  len;
+{
+  unsigned
+    code, i;
+  CACHE_ENTRY
+    *e;
+  CACHE_STRIPE
+    *s;
+  int
+    slen;
+  char
+    key [ KEY_LENGTH ];
+
+  if ( len >= KEY_LENGTH ) {
+    /* Too long to be cached */
+    StemWord ( c, word );
+    return;
+  }
+
+  code = hash_code ( word, len );
+  i = code & cache -> mask;
+  e = &cache -> entry [i];
+  s = &cache -> stripe [ i & ( NUM_STRIPES - 1 ) ];
+
+  lock_stripe ( s );
+  if ( ( e -> len == len ) && ( e -> code == code ) && 
+       ( memcmp ( e -> key, word, len ) == 0 ) ) {
+    memcpy ( word, e -> stem, e -> slen + 1 );
+    s -> hits ++;
+    unlock_stripe ( s );
+    return;
+  }
+  s -> misses ++;
+  unlock_stripe ( s );
+
+  /* Stem word without holding the lock, then enter it */
+  memcpy ( key, word, len );
+  StemWord ( c, word );
+  slen = strlen ( word );
+  assert ( slen <= len + STEM_GROWTH );
+
+  lock_stripe ( s );
+  e -> code = code;
+  e -> len = len;
+  e -> slen = slen;
+  memcpy ( e -> key, key, len );
+  memcpy ( e -> stem, word, slen + 1 );
+  unlock_stripe ( s );
+}
+
+
+/****************************************************************
+**  stemcache_stats
+**
+**  Returns the number of cache hits and misses so far.
+****************************************************************/
+
+void stemcache_stats
+       ( cache, hits, misses )
+STEMCACHE
+  cache;
+unsigned long
+  *hits;
+unsigned long
+  *misses;
+{
+  int
+    i;
+  CACHE_STRIPE
+    *s;
+
+  *hits = *misses = 0;
+  for ( i = 0; i < NUM_STRIPES; i ++ ) {
+    s = &cache -> stripe [i];
+    lock_stripe ( s );
+    *hits += s -> hits;
+    *misses += s -> misses;
+    unlock_stripe ( s );
+  }
+}
@@ -0,0 +1,62 @@
+/****************************************************************
+*
+*           S O F T W A R E   S O U R C E   F I L E
+*
+*****************************************************************
+*
+*   Name of file   : stemcache.h
+*   Author         : Guido Hoss
+*   Project        : ETH Diploma Thesis (SS 1989)
+*   Creation Date  : 06/05/89
+*   Type of file   : C Header File
+*
+*****************************************************************
+*
+*   COPYRIGHT (C) 1989, 2016 BY GUIDO HOSS.
+*
+*   This program is free software: you can redistribute it and/or 
+*   modify it under the terms of the GNU General Public License
+*   as published by the Free Software Foundation, either version 3
+*   of the License, or (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public
+*   License along with this program.  If not, see
+*   <http://www.gnu.org/licenses/>.
+*
+*   Git repository home: <https://github.com/ghoss/Thesis>
+*
+*****************************************************************
+* Date        :
+* Description :
+****************************************************************/   
+
+/* A stem cache remembers the stems of recently stemmed words, so
+   the stemmer need not be run again for frequent words. The cache
+   has a fixed number of entries; a new word replaces the word
+   which occupied its entry before. If compiled with THREADS, the
+   cache may be used by several threads at the same time (each of
+   them with a stemmer context of its own). wordstem.h must be
+   included first. */
+typedef
+  struct stemcache_header STEMCACHE_HEADER;
+
+typedef
+  STEMCACHE_HEADER *STEMCACHE;
+
+
+#ifndef BSDUNIX
+STEMCACHE create_stemcache ( int );
+void destroy_stemcache ( STEMCACHE * );
+void stem_cached ( STEMCACHE, STEM_CONTEXT *, char *, int );
+void stemcache_stats ( STEMCACHE, unsigned long *, unsigned long * );
+#else
+STEMCACHE create_stemcache ();
+void destroy_stemcache ();
+void stem_cached ();
+void stemcache_stats ();
+#endif
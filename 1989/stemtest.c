@@ -17,11 +17,17 @@
 *   Call Format
 *   -----------
 *	stemtest [word]
+*	stemtest BENCH <textfile> [rounds]
 *
 *   If no word is specified on the command line, the program
 *   prompts with 'word?'. The user may stop the program by
 *   pressing Return.
 *
+*   In BENCH mode, all words of a text file are stemmed 'rounds'
+*   times (default 10), first without and then with a stem cache.
+*   The throughput of both variants and the cache hit rate are
+*   printed.
+*
 *****************************************************************
 *
 *   COPYRIGHT (C) 1989, 2016 BY GUIDO HOSS.
@@ -50,15 +56,30 @@
 #include <stdio.h>
 #include <string.h>
 #include <ctype.h>
+#include <stdlib.h>
+#include <malloc.h>
+#include <assert.h>
+#include <time.h>
 #include "boolean.h"
 #include "util.h"
+#include "reader.h"
 #include "wordstem.h"
+#include "stemcache.h"
 
 #ifndef BSDUNIX
+char *uppercase ( char * );
+int load_words ( char *, char *** );
+void benchmark ( char *, int );
 void main ( int, char *[] );
+#else
+char *uppercase ();
+int load_words ();
+void benchmark ();
 #endif
 
 #define MAX_WORDLEN	50
+#define BENCH_ROUNDS	10	/* Default number of rounds */
+#define BENCH_CACHE	65536	/* Entries of stem cache */
 
 
 char *uppercase 
@@ -78,6 +99,148 @@ char
 }
 
 
+/****************************************************************
+**  load_words
+**
+**  Loads all words of a text file. A word is a sequence of
+**  letters; words shorter than 3 letters are ignored, just as
+**  in parse_itemcoll.
+**
+**  IN  : name  = name of text file.
+**        words = pointer to variable receiving the array of words.
+**
+**  OUT : Function returns the number of words. The words are
+**        in uppercase and allocated in the main arena.
+****************************************************************/
+
+int load_words
+      ( name, words )
+char
+  *name;
+char
+  ***words;
+{
+  READER
+    r;
+  char
+    *p, *q;
+  int
+    n, total;
+
+  n = 0;
+  total = 1024;
+  *words = (char **) malloc ( total * sizeof ( char * ) );
+  assert ( *words != NULL );
+
+  r = open_reader ( name );
+  while ( read_line ( r ) ) {
+    p = line_string ( r );
+    while ( *p != '\0' ) {
+      /* Skip to next word and search its end */
+      while ( ( *p != '\0' ) && ! isalpha ( *p ) ) p ++;
+      for ( q = p; isalpha ( *q ); q ++ );
+      if ( q - p >= 3 ) {
+        if ( q - p >= MAX_WORDLEN - 2 ) p [ MAX_WORDLEN - 3 ] = '\0';
+        if ( *q != '\0' ) *q ++ = '\0';
+        if ( n == total ) {
+          total *= 2;
+          *words = (char **) realloc ( *words, total * sizeof ( char * ) );
+          assert ( *words != NULL );
+        }
+        (*words) [ n ++ ] = uppercase ( duplicate ( p ) );
+      }
+      p = q;
+    }
+  }
+  close_reader ( &r );
+  return ( n );
+}
+
+
+/****************************************************************
+**  benchmark
+**
+**  Measures the throughput of the stemmer with and without stem
+**  cache, and checks that both give the same stems.
+**
+**  IN  : name   = name of text file.
+**        rounds = number of times the words are stemmed.
+****************************************************************/
+
+void benchmark
+       ( name, rounds )
+char
+  *name;
+int
+  rounds;
+{
+  char
+    **words,
+    plain [ MAX_WORDLEN ],
+    cached [ MAX_WORDLEN ];
+  int
+    i, k, n, len;
+  STEM_CONTEXT
+    c;
+  STEMCACHE
+    cache;
+  clock_t
+    start;
+  double
+    t;
+  unsigned long
+    hits, misses;
+
+  n = load_words ( name, &words );
+  printf ( "%d words, %d rounds\n", n, rounds );
+  if ( n == 0 ) return;
+
+  /* Stemmer alone */
+  start = clock ();
+  for ( k = 0; k < rounds; k ++ ) {
+    for ( i = 0; i < n; i ++ ) {
+      strcpy ( plain, words [i] );
+      StemWord ( &c, plain );
+    }
+  }
+  t = (double) ( clock () - start ) / CLOCKS_PER_SEC;
+  printf ( "Stemmer     : %8.3f s, %10.0f words/s\n", t, 
+	   t > 0.0 ? n * (double) rounds / t : 0.0 );
+
+  /* Stemmer with cache */
+  cache = create_stemcache ( BENCH_CACHE );
+  start = clock ();
+  for ( k = 0; k < rounds; k ++ ) {
+    for ( i = 0; i < n; i ++ ) {
+      len = strlen ( words [i] );
+      memcpy ( cached, words [i], len + 1 );
+      stem_cached ( cache, &c, cached, len );
+    }
+  }
+  t = (double) ( clock () - start ) / CLOCKS_PER_SEC;
+  stemcache_stats ( cache, &hits, &misses );
+  printf ( "Stem cache  : %8.3f s, %10.0f words/s\n", t, 
+	   t > 0.0 ? n * (double) rounds / t : 0.0 );
+  printf ( "Cache hits  : %lu (%.1f%%), misses: %lu\n", hits,
+	   100.0 * hits / ( hits + misses ), misses );
+
+  /* Both variants must give the same stems */
+  for ( i = 0; i < n; i ++ ) {
+    strcpy ( plain, words [i] );
+    StemWord ( &c, plain );
+    len = strlen ( words [i] );
+    memcpy ( cached, words [i], len + 1 );
+    stem_cached ( cache, &c, cached, len );
+    if ( strcmp ( plain, cached ) != 0 ) {
+      printf ( "Mismatch: %s --> %s / %s\n", words [i], plain, cached );
+    }
+  }
+
+  destroy_stemcache ( &cache );
+  free ( words );
+}
+
+
 void main
        ( argc, argv )
 int 
@@ -88,7 +251,11 @@ char
   char
     word [ MAX_WORDLEN ];
 
-  if ( argc == 1 ) {
+  if ( ( argc >= 3 ) && ( strcmp ( argv [1], "BENCH" ) == 0 ) ) {
+    /* benchmark mode */
+    benchmark ( argv [2], ( argc > 3 ) ? atoi ( argv [3] ) : BENCH_ROUNDS );
+  }
+  else if ( argc == 1 ) {
     /* endless loop */
     while ( TRUE ) {
       printf ( "word? [Return = end] " );
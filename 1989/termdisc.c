@@ -60,9 +60,9 @@
 #include "boolean.h"
 #include "list.h"
 #include "util.h"
+#include "descr.h"
 
 #define MAX_WORDLEN	100
-#define LINE_LENGTH	100
 
 typedef
   struct {
@@ -90,7 +90,7 @@ float
 ** 
 **  Reads the doc-descr file.
 **
-**  IN  : f = handle to open DOC-DESCR file.
+**  IN  : d = document descriptions (DOC-DESCR file).
 ****************************************************************/
 
 int comp_doc
@@ -116,24 +116,20 @@ ELEMENT
 
 
 void read_wgts 
-       ( f )
-FILE
-  *f;
+       ( d )
+DESCR
+  d;
 {
-  char
-    line [ LINE_LENGTH ];
   DOC_STRUCT
     *doc;
   WGT_STRUCT
     *wgt;
   LIST
     list;
-  float 
-    w;
-  BOOL
-    active;
+  DESCR_WGT
+    *w;
   int
-    d, n;
+    i, j;
 
   /* Create sign and document list */
   doc_list = create_list ();
@@ -143,57 +139,43 @@ FILE
 
   numdocs = 0.0;
   
-  /* Read file line by line */
-  while ( fgets ( line, LINE_LENGTH, f ) ) {
-  
-    /* Interpret as much fields as possible */
-    n = sscanf ( line, " %d %f", &d, &w );
-
-    switch ( n ) {
-      
-      case 1 :
-        /* One field -> new document number; update running count */
-	active = ( d >= 0 );
-	if ( ! active ) continue;
-
-        doc = (DOC_STRUCT *) malloc ( sizeof ( DOC_STRUCT ) );
-        assert ( doc != NULL );
-        doc -> index = d;
-        doc -> signs = NULL;
-        doc = (DOC_STRUCT *) add_list ( doc_list, (ELEMENT) doc, comp_doc );
-        assert ( doc != NULL );
-        assert ( doc -> signs == NULL );
-        doc -> signs = create_list ();
-        list = doc -> signs;
-        assert ( list != NULL );
-        
-        numdocs ++;
-        break;
-        
-      case 2 :
-        /* Two fields -> sign index and weight; add sign to list of doc */
-        if ( ! active ) continue;
-
-        /* Add sign and weight to list of current document */
-        wgt = (WGT_STRUCT *) malloc ( sizeof ( WGT_STRUCT ) );
-        assert ( wgt != NULL );
-        wgt -> sign = d;
-        wgt -> weight = w;
-        wgt = (WGT_STRUCT *) add_list ( list, (ELEMENT) wgt, comp_wgt );
-        assert ( wgt != NULL );
+  /* Look at one document at a time; queries are ignored */
+  for ( i = 0; i < descr_docs ( d ); i ++ ) {
+    if ( descr_index ( d, i ) < 0 ) continue;
+
+    doc = (DOC_STRUCT *) malloc ( sizeof ( DOC_STRUCT ) );
+    assert ( doc != NULL );
+    doc -> index = descr_index ( d, i );
+    doc -> signs = NULL;
+    doc = (DOC_STRUCT *) add_list ( doc_list, (ELEMENT) doc, comp_doc );
+    assert ( doc != NULL );
+    assert ( doc -> signs == NULL );
+    doc -> signs = create_list ();
+    list = doc -> signs;
+    assert ( list != NULL );
         
-        /* Add sign and weight to centroid */
-        wgt = (WGT_STRUCT *) malloc ( sizeof ( WGT_STRUCT ) );
-        assert ( wgt != NULL );
-        wgt -> sign = d;
-        wgt -> weight = 0.0;
+    numdocs ++;
+
+    w = descr_wgts ( d, i );
+    for ( j = 0; j < descr_count ( d, i ); j ++ ) {
+      /* Add sign and weight to list of current document */
+      wgt = (WGT_STRUCT *) malloc ( sizeof ( WGT_STRUCT ) );
+      assert ( wgt != NULL );
+      wgt -> sign = w [j].sign;
+      wgt -> weight = w [j].weight;
+      wgt = (WGT_STRUCT *) add_list ( list, (ELEMENT) wgt, comp_wgt );
+      assert ( wgt != NULL );
         
-        /* Will be discarded automatically if already entered */
-        wgt = (WGT_STRUCT *) add_list ( centroid, (ELEMENT) wgt, comp_wgt );
-        assert ( wgt != NULL );
-        wgt -> weight += w;
+      /* Add sign and weight to centroid */
+      wgt = (WGT_STRUCT *) malloc ( sizeof ( WGT_STRUCT ) );
+      assert ( wgt != NULL );
+      wgt -> sign = w [j].sign;
+      wgt -> weight = 0.0;
         
-        break;
+      /* Will be discarded automatically if already entered */
+      wgt = (WGT_STRUCT *) add_list ( centroid, (ELEMENT) wgt, comp_wgt );
+      assert ( wgt != NULL );
+      wgt -> weight += w [j].weight;
     }
   }
   
@@ -267,13 +249,13 @@ DOC_STRUCT
   /* Subtract document vector d from centroid and square */
   
   /* Handle common signs */
-  find_union ( d -> signs, centroid, comp_wgt, enum_signs1 );
+  find_union_gallop ( d -> signs, centroid, comp_wgt, enum_signs1 );
   
   /* Handle signs only in centroid */
-  find_diff ( centroid, d -> signs, comp_wgt, enum_signs3 );
+  find_diff_gallop ( centroid, d -> signs, comp_wgt, enum_signs3 );
   
   /* Handle signs only in d */
-  find_diff ( d -> signs, centroid, comp_wgt, enum_signs2 );
+  find_diff_gallop ( d -> signs, centroid, comp_wgt, enum_signs2 );
   
   return ( sqrt ( temp_dist ) );
 }
@@ -316,8 +298,8 @@ int
 char
   *argv [];
 {
-  FILE
-    *f;
+  DESCR
+    d;
     
   /* Program title */
   fprintf ( stderr, PROG );
@@ -330,9 +312,9 @@ char
   
   /* Read sign weights into memory */
   fprintf ( stderr, "Reading sign weights.\n" );
-  f = open_file ( argv [1] );
-  read_wgts ( f );
-  fclose ( f );
+  d = open_descr ( argv [1] );
+  read_wgts ( d );
+  close_descr ( &d );
   
   /* Calculate average value */
   fprintf ( stderr, "Documents: %d\n", (int) numdocs );
@@ -51,8 +51,6 @@
 #define PROG	"Term Frequency Calculation (09/08/89, gh)\n"
 #define USAGE	"termfreq <doc-descr> [QUIET]\n"
 
-#define LINE_LENGTH	100
-
 #include <stdio.h>
 #include <assert.h>
 #include <malloc.h>
@@ -60,6 +58,7 @@
 #include "boolean.h"
 #include "list.h"
 #include "util.h"
+#include "descr.h"
 
 
 typedef
@@ -83,7 +82,7 @@ LIST
 **  Reads sign weights and updates term frequency for each
 **  sign.
 **
-**  IN  : f = handle to open doc-descr file.
+**  IN  : d = document descriptions (doc-descr file).
 ****************************************************************/   
 
 int comp_freq
@@ -98,16 +97,14 @@ ELEMENT
  
  
 void load_signs 
-       ( f )
-FILE 
-  *f;
+       ( d )
+DESCR
+  d;
 {
-  char
-    line [ LINE_LENGTH ];
-  float 
-    w;
+  DESCR_WGT
+    *w;
   int
-    n, d;
+    i, j;
   FREQ_STRUCT
     *freq;
     
@@ -117,18 +114,19 @@ FILE
 
   numdocs = 0.0; 
   
-  /* Read file line by line */
-  while ( fgets ( line, LINE_LENGTH, f ) ) {
-  
-    /* Interpret as much fields as possible */
-    n = sscanf ( line, " %d %f", &d, &w );
-    if ( n == 2 ) {
-      /* Two fields -> sign index and weight */
-           
+  /* Look at one document at a time */
+  for ( i = 0; i < descr_docs ( d ); i ++ ) {
+    /* document number; running count */
+    fprintf ( counter, "%d\r", descr_index ( d, i ) );
+    numdocs ++;
+
+    /* Update term frequency of each sign of the document */
+    w = descr_wgts ( d, i );
+    for ( j = 0; j < descr_count ( d, i ); j ++ ) {
       /* Find sign in sign_list */
       freq = (FREQ_STRUCT *) malloc ( sizeof ( FREQ_STRUCT ) );
       assert ( freq != NULL );
-      freq -> sign = d;
+      freq -> sign = w [j].sign;
       freq -> freq = 0.0;
       
       /* Structure will be destroyed automatically if sign already in list */
@@ -137,11 +135,6 @@ FILE
       
       freq -> freq ++;
     }
-    else {
-      /* document number; running count */
-      fprintf ( counter, "%d\r", d );
-      numdocs ++;
-    }
   }
   
   fprintf ( counter, "\n" );
@@ -183,8 +176,8 @@ int
 char
   *argv [];
 {
-  FILE
-    *f;
+  DESCR
+    d;
 
   /* Program title */
   fprintf ( stderr, PROG );
@@ -207,12 +200,12 @@ char
   }
   
   /* Open sign file */
-  f = open_file ( argv [1] );
+  d = open_descr ( argv [1] );
   
   /* Load signs into memory */
   fprintf ( stderr, "Building distribution table.\n" );
-  load_signs ( f );
-  fclose ( f );
+  load_signs ( d );
+  close_descr ( &d );
 
   fprintf ( stderr, "Starting output.\n" );
   output_freq ();  
@@ -0,0 +1,474 @@
+/****************************************************************
+*
+*           S O F T W A R E   S O U R C E   F I L E
+*
+*****************************************************************
+*
+*   Name of file   : topktest.c
+*   Author         : Guido Hoss
+*   Project        : ETH Diploma Thesis (SS 1989)
+*   Creation Date  : 14/05/89
+*   Type of file   : C Language File
+*
+*   Description
+*   -----------
+*   Checks that calc_rsv with --top-k writes exactly the k best
+*   lines of the full calculation for each query. Random
+*   document descriptions, concepts and weights are written to
+*   files in the current directory, and calc_rsv is run on them
+*   once in full and once with --top-k k for several k, among
+*   them k >= the number of documents. For each query, the k
+*   lines of the full output with the highest RSV values (ties
+*   are broken by the lower document index) must be the lines
+*   of the top-k output, in the same order.
+*
+*   All weights are multiples of 1/4, so the RSV values are
+*   calculated and printed exactly, and there are many ties.
+*
+*   The program calc_rsv must be in the current directory (see
+*   Makefile); the test files are removed at the end.
+*
+*   Call Format
+*   -----------
+*	topktest
+*
+*   The exit status is 0 if all outputs agree, 1 otherwise.
+*
+*****************************************************************
+*
+*   COPYRIGHT (C) 1989, 2016 BY GUIDO HOSS.
+*
+*   This program is free software: you can redistribute it and/or
+*   modify it under the terms of the GNU General Public License
+*   as published by the Free Software Foundation, either version 3
+*   of the License, or (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public
+*   License along with this program.  If not, see
+*   <http://www.gnu.org/licenses/>.
+*
+*   Git repository home: <https://github.com/ghoss/Thesis>
+*
+*****************************************************************
+* Date        :
+* Description :
+****************************************************************/
+
+#define PROG	"Top-k Test (gh, 14/05/89)\n"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <malloc.h>
+#include <assert.h>
+
+#include "boolean.h"
+
+#define CALC_RSV	"./calc_rsv"
+#define DESCR_FILE	"topktest.dsc"
+#define CONCEPT_FILE	"topktest.con"
+#define WGT_FILE	"topktest.wgt"
+#define FULL_FILE	"topktest.all"
+#define TOP_FILE	"topktest.top"
+
+#define MAX_CMD		200	/* Longest command line */
+
+typedef
+  struct {
+    int		docs;		/* Number of documents */
+    int		queries;	/* Number of queries */
+    int		signs;		/* Number of signs */
+    int		atoms;		/* Number of atomic concepts */
+    int		per_doc;	/* Max. signs per document */
+  } DATA_SET;
+
+typedef
+  struct {
+    int		query;
+    int		doc;
+    double	rsv;
+  } LINE;
+
+DATA_SET
+  sets [] = {
+    { 40, 5, 12, 8, 4 },		/* small, many ties */
+    { 300, 12, 60, 40, 6 },		/* sparse */
+    { 2000, 8, 30, 30, 10 }		/* long postings */
+  };
+
+int
+  tops [] = { 1, 2, 3, 5, 10, 50 };	/* k < number of docs */
+
+#define NUM_TOPS	( (int) ( sizeof ( tops ) / sizeof ( int ) ) )
+
+
+/****************************************************************
+**  Procedure declarations
+****************************************************************/
+
+#ifndef BSDUNIX
+int main ( int, char * [] );
+long random_num ( void );
+double random_wgt ( void );
+void write_files ( DATA_SET * );
+LINE *read_lines ( char *, int * );
+int comp_best ( const void *, const void * );
+int comp_doc ( const void *, const void * );
+long check_top ( LINE *, int, LINE *, int, int );
+long run_top ( LINE *, int, int );
+#else
+int main ();
+long random_num ();
+double random_wgt ();
+void write_files ();
+LINE *read_lines ();
+int comp_best ();
+int comp_doc ();
+long check_top ();
+long run_top ();
+#endif
+
+
+/****************************************************************
+**  random_num
+**
+**  Returns a pseudo-random number in [0, 2^31) (see listbench.c).
+****************************************************************/
+
+long random_num
+       ( )
+{
+  static unsigned long
+    seed = 1;
+
+  seed = ( seed * 1103515245L + 12345L ) & 0xffffffffL;
+  return ( (long) ( ( seed >> 1 ) & 0x7fffffffL ) );
+}
+
+
+/****************************************************************
+**  random_wgt
+**
+**  Returns a random weight: one of 0.25, 0.5, .. 2.0.
+****************************************************************/
+
+double random_wgt
+         ( )
+{
+  return ( (double) ( random_num () % 8 + 1 ) / 4.0 );
+}
+
+
+/****************************************************************
+**  write_files
+**
+**  Writes random document descriptions (documents 0..docs-1,
+**  queries -1..-queries), concepts and weights of atomic
+**  concepts. Every sign has 1..3 atomic concepts, and every
+**  atomic concept belongs to some sign.
+**
+**  IN  : s = size of the data.
+****************************************************************/
+
+void write_files
+       ( s )
+DATA_SET
+  *s;
+{
+  FILE
+    *f;
+  int
+    d, i, k, n, sign;
+
+  f = fopen ( DESCR_FILE, "w" );
+  assert ( f != NULL );
+  for ( d = - s -> queries; d < s -> docs; d ++ ) {
+    fprintf ( f, "%d\n", d );
+
+    /* Increasing signs */
+    n = (int) ( random_num () % s -> per_doc ) + 1;
+    sign = 0;
+    for ( i = 0; i < n; i ++ ) {
+      sign += (int) ( random_num () % ( s -> signs / n ) ) + 1;
+      if ( sign > s -> signs ) break;
+      fprintf ( f, "\t%d\t%f\n", sign, random_wgt () );
+    }
+  }
+  fclose ( f );
+
+  f = fopen ( CONCEPT_FILE, "w" );
+  assert ( f != NULL );
+  for ( sign = 1; sign <= s -> signs; sign ++ ) {
+    fprintf ( f, "%d\n", sign );
+    fprintf ( f, "\t%d\n", ( sign - 1 ) % s -> atoms + 1 );
+    n = (int) ( random_num () % 3 );
+    for ( i = 0; i < n; i ++ ) {
+      k = (int) ( random_num () % s -> atoms ) + 1;
+      fprintf ( f, "\t%d\n", k );
+    }
+  }
+  fclose ( f );
+
+  f = fopen ( WGT_FILE, "w" );
+  assert ( f != NULL );
+  for ( k = 1; k <= s -> atoms; k ++ ) {
+    fprintf ( f, "%d\t%f\n", k, random_wgt () );
+  }
+  fclose ( f );
+}
+
+
+/****************************************************************
+**  read_lines
+**
+**  Reads an output file of calc_rsv.
+**
+**  IN  : name = file name.
+**        num  = variable to receive the number of lines.
+**
+**  OUT : Function returns the lines (allocated).
+****************************************************************/
+
+LINE *read_lines
+        ( name, num )
+char
+  *name;
+int
+  *num;
+{
+  FILE
+    *f;
+  LINE
+    *l;
+  int
+    size;
+
+  f = fopen ( name, "r" );
+  assert ( f != NULL );
+  size = 1024;
+  l = (LINE *) malloc ( size * sizeof ( LINE ) );
+  assert ( l != NULL );
+  *num = 0;
+  while ( fscanf ( f, "%d %d %lf", &l [ *num ].query, &l [ *num ].doc,
+                   &l [ *num ].rsv ) == 3 ) {
+    if ( ++ ( *num ) == size ) {
+      size *= 2;
+      l = (LINE *) realloc ( l, size * sizeof ( LINE ) );
+      assert ( l != NULL );
+    }
+  }
+  fclose ( f );
+  return ( l );
+}
+
+
+/****************************************************************
+**  comp_best, comp_doc
+**
+**  Order of the lines of a query: highest RSV value first and
+**  lower document index on ties, resp. by document index.
+****************************************************************/
+
+int comp_best
+      ( a, b )
+const void
+  *a;
+const void
+  *b;
+{
+  const LINE
+    *l1 = (const LINE *) a,
+    *l2 = (const LINE *) b;
+
+  if ( l1 -> rsv != l2 -> rsv ) {
+    return ( ( l1 -> rsv > l2 -> rsv ) ? -1 : 1 );
+  }
+  return ( l1 -> doc - l2 -> doc );
+}
+
+
+int comp_doc
+      ( a, b )
+const void
+  *a;
+const void
+  *b;
+{
+  return ( ((const LINE *) a) -> doc - ((const LINE *) b) -> doc );
+}
+
+
+/****************************************************************
+**  check_top
+**
+**  Compares the top-k output with the best k lines of each
+**  query of the full output.
+**
+**  IN  : all, num_all = full output.
+**        top, num_top = top-k output.
+**        k            = number of lines per query.
+**
+**  OUT : Function returns the number of differences.
+****************************************************************/
+
+long check_top
+       ( all, num_all, top, num_top, k )
+LINE
+  *all;
+int
+  num_all;
+LINE
+  *top;
+int
+  num_top;
+int
+  k;
+{
+  LINE
+    *best;
+  long
+    diff;
+  int
+    i, j, n, t;
+
+  best = (LINE *) malloc ( ( num_all + 1 ) * sizeof ( LINE ) );
+  assert ( best != NULL );
+  diff = 0;
+  t = 0;
+  for ( i = 0; i < num_all; i += n ) {
+
+    /* Lines of the query, best k of them in order of documents */
+    for ( n = 0; ( i + n < num_all ) &&
+                 ( all [ i + n ].query == all [i].query ); n ++ ) {
+      best [n] = all [ i + n ];
+    }
+    qsort ( best, n, sizeof ( LINE ), comp_best );
+    j = ( n < k ) ? n : k;
+    qsort ( best, j, sizeof ( LINE ), comp_doc );
+
+    for ( j = 0; ( j < n ) && ( j < k ); j ++, t ++ ) {
+      if ( ( t >= num_top ) || ( top [t].query != best [j].query ) ||
+           ( top [t].doc != best [j].doc ) ||
+           ( top [t].rsv != best [j].rsv ) ) {
+        diff ++;
+      }
+    }
+  }
+  if ( t != num_top ) {
+    diff ++;
+  }
+  free ( best );
+  return ( diff );
+}
+
+
+/****************************************************************
+**  run_top
+**
+**  Runs calc_rsv with --top-k k and checks its output.
+**
+**  IN  : all, num_all = full output.
+**        k            = number of lines per query.
+**
+**  OUT : Function returns the number of differences.
+****************************************************************/
+
+long run_top
+       ( all, num_all, k )
+LINE
+  *all;
+int
+  num_all;
+int
+  k;
+{
+  char
+    cmd [ MAX_CMD ];
+  LINE
+    *top;
+  long
+    diff;
+  int
+    num_top;
+
+  sprintf ( cmd, "%s %s %s %s --top-k %d QUIET > %s 2> /dev/null",
+            CALC_RSV, DESCR_FILE, CONCEPT_FILE, WGT_FILE, k, TOP_FILE );
+  if ( system ( cmd ) != 0 ) {
+    printf ( "calc_rsv --top-k %d failed\n", k );
+    return ( 1 );
+  }
+  top = read_lines ( TOP_FILE, &num_top );
+  diff = check_top ( all, num_all, top, num_top, k );
+  free ( top );
+  return ( diff );
+}
+
+
+/****************************************************************
+**  main
+****************************************************************/
+
+int main
+      ( argc, argv )
+int
+  argc;
+char
+  *argv [];
+{
+  char
+    cmd [ MAX_CMD ];
+  LINE
+    *all;
+  long
+    diff;
+  int
+    k [ NUM_TOPS + 2 ],	/* values of k of a data set */
+    i, j, num_k, num_all, failed;
+
+  /* Program title */
+  fprintf ( stderr, PROG );
+
+  failed = 0;
+  for ( i = 0; i < (int) ( sizeof ( sets ) / sizeof ( DATA_SET ) ); i ++ ) {
+    write_files ( &sets [i] );
+    sprintf ( cmd, "%s %s %s %s QUIET > %s 2> /dev/null", CALC_RSV,
+              DESCR_FILE, CONCEPT_FILE, WGT_FILE, FULL_FILE );
+    if ( system ( cmd ) != 0 ) {
+      printf ( "calc_rsv failed\n" );
+      failed = 1;
+      break;
+    }
+    all = read_lines ( FULL_FILE, &num_all );
+    printf ( "%d documents, %d queries, %d lines\n", sets [i].docs,
+             sets [i].queries, num_all );
+
+    /* Some k below the number of documents, then k = docs and
+       k > docs, which give the full output */
+    num_k = 0;
+    for ( j = 0; j < NUM_TOPS; j ++ ) {
+      if ( tops [j] < sets [i].docs ) {
+        k [ num_k ++ ] = tops [j];
+      }
+    }
+    k [ num_k ++ ] = sets [i].docs;
+    k [ num_k ++ ] = sets [i].docs + 7;
+
+    for ( j = 0; j < num_k; j ++ ) {
+      diff = run_top ( all, num_all, k [j] );
+      printf ( "  k = %-6d %ld differences\n", k [j], diff );
+      if ( diff > 0 ) failed = 1;
+    }
+    free ( all );
+  }
+
+  remove ( DESCR_FILE );
+  remove ( CONCEPT_FILE );
+  remove ( WGT_FILE );
+  remove ( FULL_FILE );
+  remove ( TOP_FILE );
+  return ( failed );
+}
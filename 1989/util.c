@@ -46,9 +46,40 @@
 #include <assert.h>
 #include <string.h>
 #include <malloc.h>
+#include <stdlib.h>
+#ifdef THREADS
+#include <unistd.h>
+#endif
 
 #include "util.h"
 
+#define BLOCK_SIZE	65536	/* Default size of an arena block */
+#define MAX_THREADS	64	/* Upper limit of 'thread_count' */
+
+/* Arena memory is allocated in blocks. The blocks of an arena are
+   chained, the current block is the first one. Object sizes are
+   rounded up to a multiple of the size of a double, so every
+   object is suitably aligned. */
+typedef
+  struct arena_block {
+    struct arena_block	*next;		/* Previously used block */
+    unsigned		size;		/* Usable bytes in block */
+    unsigned		used;		/* Bytes allocated */
+    double		data [1];	/* Start of memory */
+  } ARENA_BLOCK;
+
+struct arena_header {
+  ARENA_BLOCK	*block;		/* Current block */
+  unsigned	blocksize;	/* Size of a new block */
+  char		*last;		/* Last object allocated */
+};
+
+#define ALIGN(n)	( ( (n) + sizeof ( double ) - 1 ) & \
+			  ~ ( sizeof ( double ) - 1 ) )
+
+ARENA
+  arena_main = NULL;		/* Arena used by 'duplicate' */
+
 
 /****************************************************************
 **  duplicate
@@ -57,7 +88,8 @@
 **
 **  IN  : s = string to be duplicated.
 **
-**  OUT : Function returns a pointer to a copy of s.
+**  OUT : Function returns a pointer to a copy of s. The copy is
+**        allocated in the main arena, so it must NOT be freed.
 ****************************************************************/
 
 char *duplicate
@@ -65,14 +97,7 @@ char *duplicate
 char
   *s;
 {
-  char
-    *s1;
-
-  s1 = (char *) malloc ( strlen ( s ) + 1 );
-  assert ( s1 != NULL );
-
-  strcpy ( s1, s );
-  return ( s1 );
+  return ( arena_duplicate ( main_arena (), s ) );
 }
 
 
@@ -104,3 +129,296 @@ char
   }
   return ( f );
 }
+
+
+/****************************************************************
+**  create_file
+**
+**  Creates a file for writing, prints an error message if file
+**  could not be created, and aborts the program.
+**
+**  IN  : s = pointer to null-terminated file name.
+**
+**  OUT : Function returns a handle to the new file. If not
+**        successful, then function calls exit(1).
+****************************************************************/
+
+FILE *create_file
+       ( s )
+char
+  *s;
+{
+  FILE
+    *f;
+
+  f = fopen ( s, "w" );
+  if ( f == NULL ) {
+    /* Could not create -> print error message and exit */
+    perror ( s );
+    exit ( 1 );
+  }
+  return ( f );
+}
+
+
+/****************************************************************
+**  create_arena
+**
+**  Creates a new, empty arena.
+**
+**  IN  : blocksize = size of the memory blocks to be allocated,
+**                    or 0 for the default size.
+**
+**  OUT : Function returns a handle to the new arena.
+****************************************************************/
+
+ARENA create_arena
+        ( blocksize )
+unsigned
+  blocksize;
+{
+  ARENA
+    arena;
+
+  arena = (ARENA) malloc ( sizeof ( ARENA_HEADER ) );
+  assert ( arena != NULL );
+  arena -> block = NULL;
+  arena -> blocksize = ( blocksize > 0 ) ? ALIGN ( blocksize ) : BLOCK_SIZE;
+  arena -> last = NULL;
+  return ( arena );
+}
+
+
+/****************************************************************
+**  destroy_arena
+**
+**  Frees an arena together with all objects allocated in it.
+**
+**  IN  : arena = pointer to handle of arena.
+**  OUT : '*arena' is set to NULL.
+****************************************************************/
+
+void destroy_arena
+       ( arena )
+ARENA
+  *arena;
+{
+  ARENA_BLOCK
+    *b, *next;
+
+  if ( *arena == NULL ) return;
+  for ( b = (*arena) -> block; b != NULL; b = next ) {
+    next = b -> next;
+    free ( b );
+  }
+  if ( *arena == arena_main ) arena_main = NULL;
+  free ( *arena );
+  *arena = NULL;
+}
+
+
+/****************************************************************
+**  clear_arena
+**
+**  Frees all objects of an arena at once, but keeps the arena
+**  for further allocations. The most recent block is kept, so
+**  an arena which is cleared and refilled repeatedly does not
+**  call malloc again in the steady state.
+**
+**  IN  : arena = handle to arena.
+****************************************************************/
+
+void clear_arena
+       ( arena )
+ARENA
+  arena;
+{
+  ARENA_BLOCK
+    *b, *next;
+
+  if ( arena -> block == NULL ) return;
+  for ( b = arena -> block -> next; b != NULL; b = next ) {
+    next = b -> next;
+    free ( b );
+  }
+  arena -> block -> next = NULL;
+  arena -> block -> used = 0;
+  arena -> last = NULL;
+}
+
+
+/****************************************************************
+**  arena_alloc
+**
+**  Allocates an object in an arena.
+**
+**  IN  : arena = handle to arena.
+**        n     = size of the object in bytes.
+**
+**  OUT : Function returns a pointer to the object. Objects which
+**        are larger than the block size get a block of their own.
+****************************************************************/
+
+char *arena_alloc
+        ( arena, n )
+ARENA
+  arena;
+unsigned
+  n;
+{
+  ARENA_BLOCK
+    *b;
+  unsigned
+    size;
+  char
+    *p;
+
+  n = ALIGN ( n );
+  b = arena -> block;
+
+  if ( ( b == NULL ) || ( b -> used + n > b -> size ) ) {
+    size = ( n > arena -> blocksize ) ? n : arena -> blocksize;
+    b = (ARENA_BLOCK *) malloc ( sizeof ( ARENA_BLOCK ) + size );
+    assert ( b != NULL );
+    b -> size = size;
+    b -> used = 0;
+    b -> next = arena -> block;
+    arena -> block = b;
+  }
+
+  p = (char *) b -> data + b -> used;
+  b -> used += n;
+  arena -> last = p;
+  return ( p );
+}
+
+
+/****************************************************************
+**  arena_release
+**
+**  Gives back an object to an arena. This is only possible for
+**  the object allocated last; for all other objects, the call
+**  has no effect. Typical use: an element was allocated, but
+**  add_list found it to be a duplicate.
+**
+**  IN  : arena = handle to arena.
+**        p     = pointer to object.
+****************************************************************/
+
+void arena_release
+       ( arena, p )
+ARENA
+  arena;
+char
+  *p;
+{
+  if ( ( p != NULL ) && ( p == arena -> last ) ) {
+    arena -> block -> used = p - (char *) arena -> block -> data;
+    arena -> last = NULL;
+  }
+}
+
+
+/****************************************************************
+**  arena_duplicate
+**
+**  Same as 'duplicate', but the copy is allocated in 'arena'.
+****************************************************************/
+
+char *arena_duplicate
+        ( arena, s )
+ARENA
+  arena;
+char
+  *s;
+{
+  char
+    *s1;
+
+  s1 = arena_alloc ( arena, (unsigned) strlen ( s ) + 1 );
+  strcpy ( s1, s );
+  return ( s1 );
+}
+
+
+/****************************************************************
+**  reserve
+**
+**  Makes sure that a buffer has room for 'n' more bytes.
+**
+**  IN  : buf  = pointer to buffer, or to NULL.
+**        size = pointer to size of buffer.
+**        need = number of bytes needed in total.
+**
+**  OUT : The buffer has been enlarged to at least 'need' bytes;
+**        its contents have been kept.
+****************************************************************/
+
+void reserve
+       ( buf, size, need )
+char
+  **buf;
+unsigned
+  *size;
+unsigned
+  need;
+{
+  if ( need <= *size ) return;
+  *size = ( need > 2 * *size ) ? need : 2 * *size;
+  *buf = ( *buf == NULL ) ? malloc ( *size ) : realloc ( *buf, *size );
+  assert ( *buf != NULL );
+}
+
+
+/****************************************************************
+**  main_arena
+**
+**  Returns the main arena of the program, which is created on
+**  the first call. Objects which live until the end of the
+**  program should be allocated there.
+****************************************************************/
+
+ARENA main_arena
+        ( )
+{
+  if ( arena_main == NULL ) {
+    arena_main = create_arena ( 0 );
+  }
+  return ( arena_main );
+}
+
+
+/****************************************************************
+**  thread_count
+**
+**  Returns the number of worker threads a program should use.
+**  The number is taken from the environment variable NTHREADS;
+**  if it is not set, one thread per processor is used.
+**
+**  OUT : Function returns a number between 1 and MAX_THREADS.
+**        Programs compiled without THREADS always get 1.
+****************************************************************/
+
+int thread_count
+      ( )
+{
+#ifdef THREADS
+  char
+    *s;
+  int
+    n;
+
+  s = getenv ( "NTHREADS" );
+  if ( s != NULL ) {
+    n = atoi ( s );
+  }
+  else {
+    n = (int) sysconf ( _SC_NPROCESSORS_ONLN );
+  }
+  if ( n < 1 ) n = 1;
+  if ( n > MAX_THREADS ) n = MAX_THREADS;
+  return ( n );
+#else
+  return ( 1 );
+#endif
+}
@@ -36,10 +36,41 @@
 ****************************************************************/   
 
 
+/* An arena is a region of memory from which many small objects
+   are allocated. The objects cannot be freed one by one; all of
+   them are freed at once when the arena is destroyed. This saves
+   the per-object overhead of malloc for objects which live until
+   the end of a program or of a processing step. */
+typedef
+  struct arena_header ARENA_HEADER;
+
+typedef
+  ARENA_HEADER *ARENA;
+
 #ifndef BSDUNIX
 char *duplicate ( char * );
 FILE *open_file ( char * );
+FILE *create_file ( char * );
+ARENA create_arena ( unsigned );
+void destroy_arena ( ARENA * );
+void clear_arena ( ARENA );
+char *arena_alloc ( ARENA, unsigned );
+void arena_release ( ARENA, char * );
+char *arena_duplicate ( ARENA, char * );
+void reserve ( char **, unsigned *, unsigned );
+ARENA main_arena ( void );
+int thread_count ( void );
 #else
 char *duplicate ();
 FILE *open_file ();
+FILE *create_file ();
+ARENA create_arena ();
+void destroy_arena ();
+void clear_arena ();
+char *arena_alloc ();
+void arena_release ();
+char *arena_duplicate ();
+void reserve ();
+ARENA main_arena ();
+int thread_count ();
 #endif
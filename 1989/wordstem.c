@@ -61,18 +61,142 @@
 #define S5c	512
 
 
-int
-  ruleSet,
-  endw, i, h;
-  
-char
-  ch, ck;
-  
-char *
-  word;
-  
-BOOL
-  b;
+/* The suffix rules of steps 2 to 4 are kept in tables. A rule
+   replaces 'suffix' by 'repl' if the measure of the stem is
+   greater than 'm'. Usually, the stem is the word without the
+   suffix; if 'inc' > 0, the first 'inc' letters of the suffix
+   belong to the stem (e.g. (m>1) *S ION -> S). The rules of a step
+   are grouped by the last or second last letter of the word, so
+   only few of them must be compared with the word. The first
+   applicable rule of a group is used. */
+typedef
+  struct {
+    char	*suffix;	/* Suffix to be replaced */
+    int		len;		/* Length of suffix */
+    char	*repl;		/* Replacement */
+    int		rlen;		/* Length of replacement */
+    int		m;		/* Stem must have measure > m */
+    int		inc;		/* Letters of suffix belonging to stem */
+  } RULE;
+
+#define R(s,r,m,inc)	{ s, sizeof ( s ) - 1, r, sizeof ( r ) - 1, m, inc }
+#define END_RULES	{ NULL, 0, NULL, 0, 0, 0 }
+
+
+/*
+ * Step 2 (by second last letter):
+ * ==============
+ * 1: ( m > 0 ) ATIONAL -  >  ATE	11: ( m > 0 ) IZATION	 -  >  IZE
+ * 2: ( m > 0 ) TIONAL -  >  TION	12: ( m > 0 ) ATION	 -  >  ATE
+ * 3: ( m > 0 ) ENCI -  >  ENCE	13: ( m > 0 ) ATOR	 -  >  ATE
+ * 4: ( m > 0 ) ANCI -  >  ANCE	14: ( m > 0 ) ALISM	 -  >  AL
+ * 5: ( m > 0 ) IZER -  >  IZE	15: ( m > 0 ) IVENESS	 -  >  IVE
+ * 6: ( m > 0 ) ABLI -  >  ABLE	16: ( m > 0 ) FULNESS 	 -  >  FUL
+ * 7: ( m > 0 ) ALLI -  >  AL	17: ( m > 0 ) OUSNESS	 -  >  OUS
+ * 8: ( m > 0 ) ENTLI -  >  ENT	18: ( m > 0 ) ALITI	 -  >  AL
+ * 9: ( m > 0 ) ELI	 - > E		19: ( m > 0 ) IVITI 	 -  >  IVE
+ *10: ( m > 0 ) OUSLI -  >  OUS	20: ( m > 0 ) BILITI	 -  >  BLE
+ */
+
+RULE
+  step2_a [] = { R ( "ATIONAL", "ATE", 0, 0 ), R ( "TIONAL", "TION", 0, 0 ),
+                 END_RULES },
+  step2_c [] = { R ( "ENCI", "ENCE", 0, 0 ), R ( "ANCI", "ANCE", 0, 0 ),
+                 END_RULES },
+  step2_e [] = { R ( "IZER", "IZE", 0, 0 ), END_RULES },
+  step2_l [] = { R ( "ABLI", "ABLE", 0, 0 ), R ( "ALLI", "AL", 0, 0 ),
+                 R ( "ENTLI", "ENT", 0, 0 ), R ( "ELI", "E", 0, 0 ),
+                 R ( "OUSLI", "OUS", 0, 0 ), END_RULES },
+  step2_o [] = { R ( "IZATION", "IZE", 0, 0 ), R ( "ATION", "ATE", 0, 0 ),
+                 R ( "ATOR", "ATE", 0, 0 ), END_RULES },
+  step2_s [] = { R ( "ALISM", "AL", 0, 0 ), R ( "IVENESS", "IVE", 0, 0 ),
+                 R ( "FULNESS", "FUL", 0, 0 ), R ( "OUSNESS", "OUS", 0, 0 ),
+                 END_RULES },
+  step2_t [] = { R ( "ALITI", "AL", 0, 0 ), R ( "IVITI", "IVE", 0, 0 ),
+                 R ( "BILITI", "BLE", 0, 0 ), END_RULES };
+
+
+/*
+ * Step 3 (by last letter):
+ * ==============
+ * 1: ( m > 0 ) ICATE -  >  IC	5: ( m > 0 ) ICAL -  >  IC
+ * 2: ( m > 0 ) ATIVE -  >  	6: ( m > 0 ) FUL -  > 
+ * 3: ( m > 0 ) ALIZE -  >  AL	7: ( m > 0 ) NESS -  > 
+ * 4: ( m > 0 ) ICITI -  >  IC	
+ */
+
+RULE
+  step3_e [] = { R ( "ICATE", "IC", 0, 0 ), R ( "ALIZE", "AL", 0, 0 ),
+                 R ( "ATIVE", "", 0, 0 ), END_RULES },
+  step3_i [] = { R ( "ICITI", "IC", 0, 0 ), END_RULES },
+  step3_l [] = { R ( "ICAL", "IC", 0, 0 ), R ( "FUL", "", 0, 0 ), 
+                 END_RULES },
+  step3_s [] = { R ( "NESS", "", 0, 0 ), END_RULES };
+
+
+/*
+ * Step 4 (by second last letter):
+ * ==============
+ * 1: (m>1) AL   -  > 	 8: (m>1) ANT	 -  > 	14: (m>1) ISM -  >
+ * 2: (m>1) ANCE -  > 	 9: (m>1) EMENT	 -  >  	15: (m>1) ATE -  > 
+ * 3: (m>1) ENCE -  > 	10: (m>1) MENT	 -  > 	16: (m>1) ITI -  > 
+ * 4: (m>1) ER	 -  > 	11: (m>1) ENT	 -  > 	17: (m>1) OUS -  > 
+ * 5: (m>1) IC	 -  > 	12: (m>1) and (  *S OR	18: (m>1) IVE -  > 
+ * 6: (m>1) ABLE -  > 	          *T ) ) ION  -  > 	19: (m>1) IZE	 -  > 
+ * 7: (m>1) IBLE -  > 	13: (m>1) OU	 -  > 
+ * 
+ *  ***ERG3***	  1a: (m>1) I AL   -  > 	 1b: (m>1) U AL   -  > 
+ *			 15a: (m>1) I ATE  -  > 	15b: (m>1) U ATE  -  > 
+ */
+
+RULE
+  step4_a [] = { R ( "IAL", "", 1, 1 ), R ( "UAL", "", 1, 1 ),
+                 R ( "AL", "", 1, 0 ), END_RULES },
+  step4_c [] = { R ( "ANCE", "", 1, 0 ), R ( "ENCE", "", 1, 0 ), 
+                 END_RULES },
+  step4_e [] = { R ( "ER", "", 1, 0 ), END_RULES },
+  step4_i [] = { R ( "IC", "", 1, 0 ), END_RULES },
+  step4_l [] = { R ( "ABLE", "", 1, 0 ), R ( "IBLE", "", 1, 0 ), 
+                 END_RULES },
+  step4_n [] = { R ( "EMENT", "", 1, 0 ), R ( "MENT", "", 1, 0 ),
+                 R ( "ANT", "", 1, 0 ), R ( "ENT", "", 1, 0 ), END_RULES },
+  step4_o [] = { R ( "SION", "S", 1, 1 ), R ( "TION", "T", 1, 1 ),
+                 R ( "OU", "", 1, 0 ), END_RULES },
+  step4_s [] = { R ( "ISM", "", 1, 0 ), END_RULES },
+  step4_t [] = { R ( "IATE", "", 1, 1 ), R ( "UATE", "", 1, 1 ),
+                 R ( "ATE", "", 1, 0 ), R ( "ITI", "", 1, 0 ), END_RULES },
+  step4_u [] = { R ( "OUS", "", 1, 0 ), END_RULES },
+  step4_v [] = { R ( "IVE", "", 1, 0 ), END_RULES },
+  step4_z [] = { R ( "IZE", "", 1, 0 ), END_RULES };
+
+
+/****************************************************************
+**  Forward declarations (compiler type checking)
+****************************************************************/
+
+#ifndef BSDUNIX
+BOOL vowel ( char );
+void Step1a ( STEM_CONTEXT * );
+int MeasureM ( STEM_CONTEXT *, int );
+BOOL HasVowel ( STEM_CONTEXT *, int );
+BOOL TestO ( STEM_CONTEXT *, int );
+BOOL ApplyRules ( STEM_CONTEXT *, RULE * );
+RULE *Step2Rules ( char );
+RULE *Step3Rules ( char );
+RULE *Step4Rules ( char );
+void Step1b_5c ( STEM_CONTEXT * );
+#else
+BOOL vowel ();
+void Step1a ();
+int MeasureM ();
+BOOL HasVowel ();
+BOOL TestO ();
+BOOL ApplyRules ();
+RULE *Step2Rules ();
+RULE *Step3Rules ();
+RULE *Step4Rules ();
+void Step1b_5c ();
+#endif
    
     
 /****************************************************************
@@ -99,29 +223,35 @@ char
 ****************************************************************/   
 
 void Step1a
-       ( )
+       ( c )
+STEM_CONTEXT
+  *c;
 {
-  if ( *( word + endw ) == 'S' ) {
-    -- endw;
-    if ( *( word + endw ) == 'S' ) { 
-      ++ endw;
+  char
+    *word = c -> word;
+
+  if ( *( word + c -> endw ) == 'S' ) {
+    -- c -> endw;
+    if ( *( word + c -> endw ) == 'S' ) { 
+      ++ c -> endw;
     } 
-    else if ( ( *( word + endw ) == 'E' ) && 
-              ( ( *( word + endw - 1 ) == 'I' ) ||
-                ( ( *( word + endw - 1 ) == 'S' ) && 
-                  ( endw  > 1 ) && ( *( word + endw - 2 ) == 'S' ) ) ) ) { 
-      -- endw;
+    else if ( ( *( word + c -> endw ) == 'E' ) && 
+              ( ( *( word + c -> endw - 1 ) == 'I' ) ||
+                ( ( *( word + c -> endw - 1 ) == 'S' ) && 
+                  ( c -> endw  > 1 ) && 
+                  ( *( word + c -> endw - 2 ) == 'S' ) ) ) ) { 
+      -- c -> endw;
     }
 
 #ifndef FULL_PORTER    
     /* change to original algorithm (since we only do plural stemming) */
-    if ( *( word + endw ) == 'I' ) {
-      *( word + endw ) = 'Y';
+    if ( *( word + c -> endw ) == 'I' ) {
+      *( word + c -> endw ) = 'Y';
     }
 #endif
   
-    *( word + endw + 1 ) = '\0';
-    ruleSet |= S1a;
+    *( word + c -> endw + 1 ) = '\0';
+    c -> ruleSet |= S1a;
   }
 }
   
@@ -143,19 +273,22 @@ void Step1a
 #define STAT_WASV	2
 
 int MeasureM
-       ( until )
+       ( c, until )
+STEM_CONTEXT
+  *c;
 int
   until;
 {
   int
+    i, h,
     status;
+  char
+    ch;
     
-  i = 0; 
   h = 0;
   status = STAT_NULL;
-  while ( TRUE ) {
-    if ( i >= until ) break;
-    ch = *( word + i );
+  for ( i = 0; i < until; i ++ ) {
+    ch = *( c -> word + i );
     switch ( status ) {
     
       case STAT_NULL :
@@ -180,7 +313,6 @@ int
          }
          break;
     } 
-    i ++;
   }
   return ( h );
 }
@@ -194,18 +326,23 @@ int
 ****************************************************************/   
   
 BOOL HasVowel
-       ( until )
+       ( c, until )
+STEM_CONTEXT
+  *c;
 int
   until;
 {
-  i = 0;
-  while ( i < until ) {
+  int
+    i;
+  char
+    *word = c -> word;
+
+  for ( i = 0; i < until; i ++ ) {
     if ( vowel ( *( word + i ) ) ||
          ( ( *( word + i ) == 'Y' ) && ( i > 0 ) && 
            ! vowel ( *( word + i - 1 ) ) ) ) { 
       return ( TRUE ); 
     }
-    i ++;
   }
   return ( FALSE );
 }
@@ -219,56 +356,133 @@ int
 ****************************************************************/   
 
 BOOL TestO
-       ( until )
+       ( c, until )
+STEM_CONTEXT
+  *c;
 int
   until;
 {
+  int
+    h;
+  char
+    ch,
+    *word = c -> word;
+
   if ( until < 3 ) return ( FALSE );
   h = until - 2;
   ch = *( word + h + 1 );
-  if ( ! vowel ( *( word + h - 1 ) ) &&
-       ( vowel ( *( word + h ) ) || ( *( word + h ) == 'Y' ) ) &&
-       ( ! vowel ( ch ) && 
-         ! ( ( ch == 'W' ) || ( ch == 'X' ) || ( ch == 'Y' ) ) ) ) {
-    return ( TRUE ); 
-  }
-  else {
-    return ( FALSE );
-  }
+  return ( ! vowel ( *( word + h - 1 ) ) &&
+           ( vowel ( *( word + h ) ) || ( *( word + h ) == 'Y' ) ) &&
+           ( ! vowel ( ch ) && 
+             ! ( ( ch == 'W' ) || ( ch == 'X' ) || ( ch == 'Y' ) ) ) );
 }
   
   
 /****************************************************************
-**  HasSuffix
+**  ApplyRules
+**
+**  Replaces the suffix of 'word' by the first applicable rule
+**  of a table.
 **
-**  Checks 'word' for suffix 's' and measure > m.
+**  IN  : c    = stemmer context.
+**        rule = rule table, or NULL.
+**
+**  OUT : Function returns TRUE if a rule has been applied.
 ****************************************************************/   
 
-BOOL HasSuffix
-       ( s, m )
+BOOL ApplyRules
+       ( c, rule )
+STEM_CONTEXT
+  *c;
+RULE
+  *rule;
+{
+  int
+    len, d;
+  char
+    *word = c -> word;
+
+  if ( rule == NULL ) return ( FALSE );
+  len = c -> endw + 1;
+  for ( ; rule -> suffix != NULL; rule ++ ) {
+    d = len - rule -> len;
+    if ( ( d < 0 ) || 
+         ( memcmp ( word + d, rule -> suffix, rule -> len ) != 0 ) ||
+         ( MeasureM ( c, d + rule -> inc ) <= rule -> m ) ) {
+      continue;
+    }
+    memcpy ( word + d, rule -> repl, rule -> rlen );
+    c -> endw = d + rule -> rlen - 1;
+    *( word + c -> endw + 1 ) = '\0';
+    return ( TRUE );
+  }
+  return ( FALSE );
+}
+
+
+/****************************************************************
+**  Step2Rules, Step3Rules, Step4Rules
+**
+**  Select the rules of a step which may apply to a word.
+**
+**  IN  : ch = last (step 3) or second last letter of the word.
+**
+**  OUT : Functions return a rule table, or NULL.
+****************************************************************/   
+
+RULE *Step2Rules
+        ( ch )
 char
-  *s;
-int
-  m;
+  ch;
 {
-  char *
-    ch;
-  int 
-    d;
-   
-  h = strlen ( s ) - 1;
-  if ( h > endw ) return ( FALSE );
-  d = endw - h; 
-  i = 0;
-  ch = word + d;
-  
-  do {
-    if ( *ch != *s ) return ( FALSE );
-    i ++;
-    s ++;
-    ch ++;
-  } while ( i <= h );
-  return ( MeasureM ( d ) > m );
+  switch ( ch ) {
+    case 'A' : return ( step2_a );
+    case 'C' : return ( step2_c );
+    case 'E' : return ( step2_e );
+    case 'L' : return ( step2_l );
+    case 'O' : return ( step2_o );
+    case 'S' : return ( step2_s );
+    case 'T' : return ( step2_t );
+  }
+  return ( NULL );
+}
+
+
+RULE *Step3Rules
+        ( ch )
+char
+  ch;
+{
+  switch ( ch ) {
+    case 'E' : return ( step3_e );
+    case 'I' : return ( step3_i );
+    case 'L' : return ( step3_l );
+    case 'S' : return ( step3_s );
+  }
+  return ( NULL );
+}
+
+
+RULE *Step4Rules
+        ( ch )
+char
+  ch;
+{
+  switch ( ch ) {
+    case 'A' : return ( step4_a );
+    case 'C' : return ( step4_c );
+    case 'E' : return ( step4_e );
+    case 'I' : return ( step4_i );
+    case 'L' : return ( step4_l );
+    case 'N' : return ( step4_n );
+    case 'O' : return ( step4_o );
+    case 'S' : return ( step4_s );
+    case 'T' : return ( step4_t );
+    case 'U' : return ( step4_u );
+    case 'V' : return ( step4_v );
+    case 'Z' : return ( step4_z );
+  }
+  return ( NULL );
 }
   
   
@@ -279,22 +493,30 @@ int
 ****************************************************************/   
 
 void Step1b_5c
-       ( )
+       ( c )
+STEM_CONTEXT
+  *c;
 {
+  int
+    h, i;
   char
-    *temp;
+    ch, ck,
+    *temp,
+    *word = c -> word;
+  BOOL
+    b = FALSE;
     
-    if ( endw >= 3 ) { 
+    if ( c -> endw >= 3 ) { 
  
     /* GH
      * 
      * LY ->, TY ->
      */
      
-    if ( *( word + endw ) == 'Y' ) {
-      temp = ( word + endw - 1 );
+    if ( *( word + c -> endw ) == 'Y' ) {
+      temp = ( word + c -> endw - 1 );
       if ( ( *temp == 'L' ) || ( *temp == 'T' ) ) {
-        endw -= 2;
+        c -> endw -= 2;
         *temp = '\0';
       }
     }
@@ -307,23 +529,23 @@ void Step1b_5c
      * 3: (  *v* / ING  -  > 
      */
 
-     h = endw; b = FALSE;
+     h = c -> endw;
      if ( *( word + h ) == 'D' ) {
        h --;
        if ( *( word + h ) == 'E' ) { 
          h --;
          if ( *( word + h ) == 'E' ) {
-           if ( MeasureM ( h ) > 0 ) {
-             *( word + endw ) = '\0'; 
-             endw --;
-             ruleSet |= S1b;
+           if ( MeasureM ( c, h ) > 0 ) {
+             *( word + c -> endw ) = '\0'; 
+             c -> endw --;
+             c -> ruleSet |= S1b;
            }
          }
-         else if ( HasVowel ( h + 1 ) ) { 
-           endw --;
-           *( word + endw ) = '\0'; 
-           endw --;
-           ruleSet |= S1b;
+         else if ( HasVowel ( c, h + 1 ) ) { 
+           c -> endw --;
+           *( word + c -> endw ) = '\0'; 
+           c -> endw --;
+           c -> ruleSet |= S1b;
            b = TRUE;	     /*2*/
          }
        }
@@ -331,15 +553,15 @@ void Step1b_5c
      else if ( ( *( word + h ) == 'G' ) && 
                ( *( word + h - 1 ) == 'N' ) && 
                ( *( word + h - 2 ) == 'I' ) &&
-               HasVowel( h - 2 ) ) {
+               HasVowel( c, h - 2 ) ) {
        *( word + h - 2 ) = '\0'; 
-       endw = h - 3; 
-       ruleSet |= S1b;
+       c -> endw = h - 3; 
+       c -> ruleSet |= S1b;
        b = TRUE;		     /*3*/
      }
     }
     
-    if ( b && ( endw >= 2 ) ) {	
+    if ( b && ( c -> endw >= 2 ) ) {	
     
     /* 
      * Step 1b - b: 
@@ -352,29 +574,29 @@ void Step1b_5c
      *			8: (  m==1 and *o )   -  >  E
      */
      
-     h = endw; 
+     h = c -> endw; 
      ch = *( word + h ); 
      ck = *( word + h - 1 );
      if ( ( ( ch == 'T' ) && ( ck == 'A' ) ) ||					     /*4*/
           ( ( ch == 'L' ) && ( ck == 'B' ) ) ||					     /*5*/
           ( ( ch == 'Z' ) && ( ck == 'I' ) ) ) {				     /*6*/
-       ++ endw; 
-       *( word + endw ) = 'E'; 
-       *( word + endw + 1 ) = '\0'; 
-       ruleSet |= S1bb;
+       ++ c -> endw; 
+       *( word + c -> endw ) = 'E'; 
+       *( word + c -> endw + 1 ) = '\0'; 
+       c -> ruleSet |= S1bb;
      } 
      else if ( ( ch == ck ) &&  
                ! ( vowel ( ch ) || 
                    ( ch == 'L' ) || ( ch == 'S' ) || ( ch == 'Z' ) ) ) {
        *( word + h ) = '\0'; 
-       endw --;
-       ruleSet |= S1bb;
+       c -> endw --;
+       c -> ruleSet |= S1bb;
      } 
-     else if ( ( MeasureM ( h + 1 ) == 1 ) && TestO( h + 1 ) ) {
-       endw ++;
-       *( word + endw ) = 'E'; 
-       *( word + endw + 1 ) = '\0';
-       ruleSet |= S1bb;
+     else if ( ( MeasureM ( c, h + 1 ) == 1 ) && TestO( c, h + 1 ) ) {
+       c -> endw ++;
+       *( word + c -> endw ) = 'E'; 
+       *( word + c -> endw + 1 ) = '\0';
+       c -> ruleSet |= S1bb;
      }
     } 
     
@@ -383,377 +605,26 @@ void Step1b_5c
      *  9: (  *v* / Y  -  >  I
      */
      
-     if ( ( *( word + endw ) == 'Y' ) && HasVowel( endw ) ) {
-       *( word + endw ) = 'I'; 
-       ruleSet |= S1c;
+     if ( ( *( word + c -> endw ) == 'Y' ) && HasVowel( c, c -> endw ) ) {
+       *( word + c -> endw ) = 'I'; 
+       c -> ruleSet |= S1c;
      }
      
-    if ( endw >= 4 ) {
-    
-    /* 
-     * Step 2: 
-     * ==============
-     * 1: ( m > 0 ) ATIONAL -  >  ATE	11: ( m > 0 ) IZATION	 -  >  IZE
-     * 2: ( m > 0 ) TIONAL -  >  TIO	12: ( m > 0 ) ATION	 -  >  ATE
-     * 3: ( m > 0 ) ENCI -  >  ENC	13: ( m > 0 ) ATOR	 -  >  ATE
-     * 4: ( m > 0 ) ANCI -  >  ANC	14: ( m > 0 ) ALISM	 -  >  AL
-     * 5: ( m > 0 ) IZER -  >  IZE	15: ( m > 0 ) IVENESS	 -  >  IVE
-     * 6: ( m > 0 ) ABLI -  >  ABL	16: ( m > 0 ) FULNESS 	 -  >  FUL
-     * 7: ( m > 0 ) ALLI -  >  AL	17: ( m > 0 ) OUSNESS	 -  >  OUS
-     * 8: ( m > 0 ) ENTL -  >  ENT	18: ( m > 0 ) ALITI	 -  >  AL
-     * 9: ( m > 0 ) ELI	 - > E		19: ( m > 0 ) IVITI 	 -  >  IVE
-     *10: ( m > 0 ) OUSLI -  >  OUS	20: ( m > 0 ) BILITI	 -  >  BLE
-     */
-     
-     switch ( *( word + endw - 1 ) ) {
-       /* testet auf den zweitletzten Buchstaben und teilt auf */
-
-       case 'A' : 
-         if ( HasSuffix ( "TIONAL", 0 ) ) {
-           ruleSet |= S2;
-           if ( ( *( word + endw - 6 ) == 'A' ) && 
-                ( MeasureM ( endw - 6 ) > 0 ) ) {
-             endw -= 4;
-             *( word + endw ) = 'E'; 
-             *( word + endw + 1 ) = '\0';    /*1*/
-     	   }
-     	   else {
-     	     endw --;
-     	     *( word + endw ) = '\0';  
-     	     endw --;
-     	   }
-         }
-         break;
-         
-       case 'C' : 
-         if ( HasSuffix ( "ENCI", 0 ) || HasSuffix ( "ANCI",0 ) ) { 
-     	   *( word + endw ) = 'E'; 
-     	   ruleSet |= S2;
-         }
-         break;
-         
-       case 'E' : 
-         if ( HasSuffix ( "IZER", 0 ) ) {
-           *( word + endw ) = '\0'; 
-           endw --;
-     	   ruleSet |= S2;
-         }
-         break;
-         
-       case 'L' : 
-         if ( HasSuffix ( "ABLI", 0 ) ) {
-           *( word + endw ) = 'E';
-     	   ruleSet |= S2;
-         } 
-         else if ( HasSuffix ( "LI", 0 ) ) { 
-           endw -= 2;
-           if ( HasSuffix ( "AL", 0 ) || HasSuffix ( "ENT", 0 ) ||   /*7,8*/
-                HasSuffix ( "E", 0 ) || HasSuffix ( "OUS", 0 ) ) {  /*9,10*/
-             *( word + endw + 1 ) = '\0'; 
-     	     ruleSet |= S2;
-           }
-           else {
-             endw += 2;
-           }
-         }
-         break;
-         
-       case 'O' : 
-         if ( HasSuffix ( "ATION", 0 ) ) { 
-           endw -= 5;
-           if ( HasSuffix ( "IZ", 0 ) ) { 
-             endw ++;
-           }
-           else {
-             endw += 3;
-           }
-           *( word + endw ) = 'E'; 
-           *( word + endw + 1 ) = '\0';
-     	   ruleSet |= S2;
-         } 
-         else if ( HasSuffix ( "ATOR", 0 ) ) {
-           *( word + endw ) = '\0';  
-           endw --;
-           *( word + endw ) = 'E';    /*13*/
-     	   ruleSet |= S2;
-         }
-         break;
-         
-       case 'S' : 
-         if ( HasSuffix ( "ALISM",0 ) ) {    /*14*/
-           endw -= 2;
-           *( word + endw ) = '\0'; 
-           endw --;
-     	   ruleSet |= S2;
-         } 
-         else if ( HasSuffix ( "NESS", 0 ) ) { 
-           endw -= 4;
-           if ( HasSuffix ( "IVE", 0 ) || HasSuffix ( "FUL", 0 ) || /*15,16*/
-                HasSuffix ( "OUS",  0 ) ) {    /*17*/
-             *( word + endw + 1 ) = '\0';
-             ruleSet |= S2;
-           }
-           else {
-             endw += 4;
-           }
-         }
-         break;
-         
-       case 'T' : 
-         if ( HasSuffix ( "ITI", 0 ) ) { 
-           endw -= 3;
-           if ( HasSuffix ( "AL", 0 ) ) { 
-             ruleSet |= S2;
-           } 
-           else if ( HasSuffix ( "IV", 0 ) ) {
-             endw ++;
-             *( word + endw ) = 'E';  	    /*19*/
-             ruleSet |= S2;
-           } 
-           else if ( HasSuffix ( "BIL", 0 ) ) {	    /*20*/
-             *( word + endw ) = 'E'; 
-             *( word + endw - 1 ) = 'L';
-             ruleSet |= S2;
-           }
-           else {
-             endw += 3;
-           }
-           *( word + endw + 1 ) = '\0';
-         }
-         break;
-     }
+    /* Steps 2 to 4: see rule tables */
+    if ( ( c -> endw >= 4 ) &&
+         ApplyRules ( c, Step2Rules ( *( word + c -> endw - 1 ) ) ) ) {
+      c -> ruleSet |= S2;
+    }
+    if ( ( c -> endw >= 4 ) &&
+         ApplyRules ( c, Step3Rules ( *( word + c -> endw ) ) ) ) {
+      c -> ruleSet |= S3;
+    }
+    if ( ( c -> endw >= 5 ) &&
+         ApplyRules ( c, Step4Rules ( *( word + c -> endw - 1 ) ) ) ) {
+      c -> ruleSet |= S4;
     }
 
-    if (  endw >= 4 ) {	
-    
-    /*
-     * Step 3:
-     * ==============
-     * 1: ( m > 0 ) ICATE -  >  IC	5: ( m > 0 ) ICAL -  >  IC
-     * 2: ( m > 0 ) ATIVE -  >  	6: ( m > 0 ) FUL -  > 
-     * 3: ( m > 0 ) ALIZE -  >  L	7: ( m > 0 ) NESS -  > 
-     * 4: ( m > 0 ) ICITI -  >  IC	
-     */
-     
-     ch = *( word + endw );
-     if ( ch == 'E' ) { 
-       endw --;
-       if ( HasSuffix ( "ICAT", 0 ) || HasSuffix ( "ALIZ", 0 ) ) {
-         endw --;
-         *( word + endw ) = '\0'; 
-         endw --;
-         ruleSet |= S3;
-       } 
-       else if ( HasSuffix ( "ATIV",0 ) ) {
-         endw -= 4; 
-         *( word + endw + 1 ) = '\0';      /*2*/
-         ruleSet |= S3;
-       }
-       else {
-         endw ++;
-       }
-     } 
-     else if ( ch == 'I' ) { 
-       endw --;
-       if ( HasSuffix ( "ICIT", 0 ) ) {
-         endw --;
-         *( word + endw ) = '\0'; 	     /*4*/
-         endw --;
-         ruleSet |= S3;
-       }
-       else {
-         endw ++;
-       }
-     } 
-     else if ( ch == 'L' ) { 
-       endw --;
-       if ( HasSuffix ( "ICA", 0 ) ) {
-         *( word + endw ) = '\0';
-         endw --;		     /*5*/
-         ruleSet |= S3;
-       } 
-       else if ( HasSuffix ( "FU", 0 ) ) {
-         endw -= 2; 
-         *( word + endw + 1 ) = '\0';     /*6*/
-         ruleSet |= S3;
-       }
-       else {
-         endw ++;
-       }
-     } 
-     else if ( ch == 'S' ) { 
-       endw --;
-       if ( HasSuffix ( "NES", 0 ) ) {
-         endw -= 3; 
-         *( word + endw + 1 ) = '\0';     /*7*/
-         ruleSet |= S3;
-       }
-       else {
-         endw ++;
-       }
-     }
-    } /*Step3*/
-
-    if ( endw >=5 ) {
-    
-    /*
-     * Step 4:
-     * ==============
-     * 1: (m>1) AL   -  > 	 8: (m>1) ANT	 -  > 	14: (m>1) ISM -  >
-     * 2: (m>1) ANCE -  > 	 9: (m>1) EMENT	 -  >  	15: (m>1) ATE -  > 
-     * 3: (m>1) ENCE -  > 	10: (m>1) MENT	 -  > 	16: (m>1) ITI -  > 
-     * 4: (m>1) ER	 -  > 	11: (m>1) ENT	 -  > 	17: (m>1) OUS -  > 
-     * 5: (m>1) IC	 -  > 	12: (m>1) and (  *S OR	18: (m>1) IVE -  > 
-     * 6: (m>1) ABLE -  > 	          *T ) ) ION  -  > 	19: (m>1) IZE	 -  > 
-     * 7: (m>1) IBLE -  > 	13: (m>1) OU	 -  > 
-     * 
-     *  ***ERG3***	  1a: (m>1) IAL   -  > 	 1b: (m>1) UAL   -  > 
-     *			 15a: (m>1) IATE  -  > 	15b: (m>1) UATE  -  > 
-     */
-
-     switch ( *( word + endw - 1 ) ) {
-     
-       case 'A' : 
-         if ( ( *( word + endw ) == 'L' ) && ( MeasureM ( endw - 1 ) > 1 ) ) {
-           /***ERG3***/
-           if ( ( *( word + endw - 2 ) == 'I' ) || 
-                ( *( word + endw - 2 ) == 'U' ) ) { 	 /*1a,1b*/
-     	     endw --;
-           }
-           endw --; 
-           *( word + endw ) = '\0';
-           endw --; 
-           ruleSet |= S4;
-         }
-         break;
-         
-       case 'C' : 
-         if ( HasSuffix ( "ANCE", 1 ) || HasSuffix ( "ENCE",1 ) ) {
-     	   endw -= 4; 
-     	   *( word + endw + 1 ) = '\0';	   /*2,3*/
-           ruleSet |= S4;
-     	 }
-     	 break;
-     	 
-       case 'E' : 
-         if ( ( *( word + endw ) == 'R' ) && 
-              ( MeasureM ( endw - 1 ) > 1 ) ) {
-           endw --; 
-           *( word + endw ) = '\0'; 
-           endw --;   /*4*/
-           ruleSet |= S4;
-         }
-         break;
-         
-       case 'I' : 
-         if ( ( *( word + endw ) == 'C' ) && ( MeasureM ( endw - 1 ) > 1 ) ) {
-     	   endw --; 
-     	   *( word + endw ) = '\0'; 
-     	   endw --;   /*5*/
-           ruleSet |= S4;
-         }
-         break;
-         
-       case 'L' : 
-         if ( HasSuffix ( "ABLE", 1 ) || HasSuffix ( "IBLE", 1 ) ) {
-           endw -= 4; 
-           *( word + endw + 1 ) = '\0'; 	   /*6,7*/
-           ruleSet |= S4;
-         }
-         break;
-         
-       case 'N' : 
-         if ( *( word + endw ) == 'T' ) { 
-           endw -= 2;
-       	   if ( HasSuffix ( "EME", 1 ) ) { 
-       	     endw -= 3;
-             ruleSet |= S4; /*9*/
-       	   } 
-       	   else if ( HasSuffix ( "ME", 1 ) ) { 
-       	     endw -= 2;
-             ruleSet |= S4; /* 10 */
-       	   } 
-       	   else if ( ( ( *( word + endw ) == 'A' ) || 
-       	               ( *( word + endw ) == 'E' ) ) &&	  /*8,11*/
-       		     ( MeasureM ( endw )  >  1 ) ) { 
-             endw --;
-             ruleSet |= S4;
-           }
-       	   else {
-       	     endw += 2;
-       	   }
-       	   *( word + endw + 1 ) = '\0';
-         }
-         break;
-         
-       case 'O' : 
-         if ( HasSuffix ( "ION",1 ) ) { 
-           endw -= 3;
-       	   if ( ( *( word + endw ) == 'S' ) || ( *( word + endw ) == 'T' ) ) {
-             *( word + endw + 1 ) = '\0';     /*12*/
-             ruleSet |= S4;
-           }
-       	   else {
-       	     endw += 3;
-           }
-         } 
-         else if ( ( *( word + endw ) == 'U' ) && 
-                   ( MeasureM ( endw - 1 )  >  1 ) ) {
-           endw --; 
-           *( word + endw ) = '\0'; 
-           endw --;  /*13*/
-           ruleSet |= S4;
-         }
-         break;
-         
-       case 'S' : 
-         if ( HasSuffix ( "ISM",1 ) ) {
-     	   endw -= 3;
-     	   *( word + endw + 1 ) = '\0';    /*14*/
-           ruleSet |= S4;
-         }
-         break;
-         
-       case 'T' : 
-         if ( HasSuffix ( "ATE", 1 ) || HasSuffix ( "ITI", 1 ) ) {
-     	   endw -= 3;
-     	   /***ERG3***/
-     	   if ( ( *( word + endw + 1 ) =='A' ) && 
-     	        ( ( *( word + endw ) =='I' ) || ( *( word + endw ) =='U' ) ) ) {
-     	     endw --;       /*15a,15b*/
-           }
-           *( word + endw + 1 ) = '\0'; 
-           ruleSet |= S4;		 /*15,16*/
-         }
-         break;
-         
-       case 'U' : 
-         if ( HasSuffix ( "OUS",1 ) ) {
-     	   endw -= 3;
-           *( word + endw + 1 ) = '\0'; 
-           ruleSet |= S4;		 /* 17 */
-         }
-         break;
-         
-       case 'V' : 
-         if ( HasSuffix ( "IVE", 1 ) ) {
-     	   endw -= 3;
-           *( word + endw + 1 ) = '\0'; 
-           ruleSet |= S4;		 /* 18 */
-         }
-         break;
-
-       case 'Z' : 
-         if ( HasSuffix ( "IZE", 1 ) ) {
-     	   endw -= 3;
-           *( word + endw + 1 ) = '\0'; 
-           ruleSet |= S4;  /*19*/
-         }
-         break;
-     }
-    } /*Step4*/
-
-    if (  endw >= 2 ) {	
+    if (  c -> endw >= 2 ) {	
     
     /* 
      * Step 5a - c:
@@ -766,37 +637,70 @@ void Step1b_5c
      * c: 4: I  -  >  Y                     ***ERG1***
      */
 
-     if ( *( word + endw ) == 'E' ) { 
-       i = MeasureM ( endw );
-       if ( ( i > 1 ) || ( ( i==1 ) && ! TestO( endw ) ) ) {
-         *( word + endw ) = '\0'; 
-         endw --; 
-         ruleSet |= S5a;  /* 1, 2 */
+     if ( *( word + c -> endw ) == 'E' ) { 
+       i = MeasureM ( c, c -> endw );
+       if ( ( i > 1 ) || ( ( i==1 ) && ! TestO( c, c -> endw ) ) ) {
+         *( word + c -> endw ) = '\0'; 
+         c -> endw --; 
+         c -> ruleSet |= S5a;  /* 1, 2 */
        }
      }
 
-     if ( ( MeasureM ( endw ) > 1 ) ) { 
-       ch = *( word + endw );
-       if ( ( ch == 'L' ) && ( ch == *( word + endw - 1 ) ) ) {
-         *( word + endw ) = '\0';
-         endw --;
-         ruleSet |= S5b;  /* 3 */
+     if ( ( MeasureM ( c, c -> endw ) > 1 ) ) { 
+       ch = *( word + c -> endw );
+       if ( ( ch == 'L' ) && ( ch == *( word + c -> endw - 1 ) ) ) {
+         *( word + c -> endw ) = '\0';
+         c -> endw --;
+         c -> ruleSet |= S5b;  /* 3 */
        }
      }
 
-     if ( ruleSet != 0 ) {	  /* ***ERG1*** */
-       if ( *( word + endw ) == 'I' ) {
-         *( word + endw ) = 'Y'; 	     /*5*/
-         ruleSet |= S5c; 
-       }
-       if ( ruleSet == S1c | S5c ) { 
-         ruleSet = 0;
+     if ( c -> ruleSet != 0 ) {	  /* ***ERG1*** */
+       if ( *( word + c -> endw ) == 'I' ) {
+         *( word + c -> endw ) = 'Y'; 	     /*5*/
        }
+       c -> ruleSet = 0;
      }
     }
  }
     
     
+/****************************************************************
+**  StemWord
+**
+**  Reentrant version of 'StemEnglishWord'. All state of the
+**  stemmer is kept in the context supplied by the caller, so
+**  several threads may stem words at the same time if each of
+**  them uses a context of its own.
+**
+**  IN  : c = stemmer context.
+**        w = pointer to a null-terminated English word.
+**            The word must be in uppercase letters.
+**  OUT : 'w' contains the root.
+****************************************************************/   
+
+void StemWord
+       ( c, w )
+STEM_CONTEXT
+  *c;
+char
+  *w;
+{
+   c -> endw = strlen ( w );
+   if ( ( c -> endw > MAX_WORDLEN ) || ( c -> endw < 3 ) ) return;
+   c -> endw --;
+   c -> word = w;
+   
+   c -> ruleSet = 0; 
+   Step1a ( c );	/* Stop after here if you only want to stem plurals */
+#ifdef FULL_PORTER
+   Step1b_5c ( c ); 
+   c -> ruleSet = 0;
+   Step1b_5c ( c ); 
+#endif
+}
+    
+    
 /****************************************************************
 **  StemEnglishWord
 **
@@ -810,16 +714,8 @@ void StemEnglishWord
 char
   *w;
 {
-   endw = strlen ( w );
-   if ( ( endw > MAX_WORDLEN ) || ( endw < 3 ) ) return;
-   endw --;
-   word = w;
-   
-   ruleSet = 0; 
-   Step1a ();	/* Stop after here if you only want to stem plurals */
-#ifdef FULL_PORTER
-   Step1b_5c (); 
-   ruleSet = 0;
-   Step1b_5c (); 
-#endif
+  STEM_CONTEXT
+    c;
+
+  StemWord ( &c, w );
 }
@@ -32,8 +32,20 @@
 *
 ****************************************************************/   
 
+/* State of the stemmer while it works on a word. A context may
+   be reused for any number of words, but must not be shared by
+   threads. */
+typedef
+  struct {
+    char	*word;		/* Word being stemmed */
+    int		endw;		/* Index of last letter of word */
+    int		ruleSet;	/* Rules applied in current step */
+  } STEM_CONTEXT;
+
 #ifndef BSDUNIX
 void StemEnglishWord ( char * );
+void StemWord ( STEM_CONTEXT *, char * );
 #else
 void StemEnglishWord ();
+void StemWord ();
 #endif